@@ -0,0 +1,319 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_OBB_PACKET_H
+#define HPP_FCL_OBB_PACKET_H
+
+#include <hpp/fcl/BV/OBB.h>
+#include <hpp/fcl/BV/OBBRSS.h>
+#include <hpp/fcl/collision_data.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @addtogroup Bounding_Volume
+/// @{
+
+/// @brief Structure-of-arrays storage of up to N oriented bounding boxes.
+///
+/// Each scalar of the OBB (axes coefficients, center, extents) is stored in
+/// an `Eigen::Array` of size N, lane `k` holding the k-th box. This lets the
+/// separating axis tests below process the N boxes at once with the SIMD
+/// instructions Eigen is compiled for (SSE2, AVX, AVX512...). N = 4 fills an
+/// AVX register with doubles, N = 8 an AVX512 register.
+template <int N>
+struct OBBPacket {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Eigen::Array<FCL_REAL, N, 1> Array;
+  enum { Width = N };
+
+  /// @brief axes[i][j](k) is the coefficient (i,j) of the orientation matrix
+  /// of the k-th box.
+  Array axes[3][3];
+
+  /// @brief Centers of the boxes.
+  Array To[3];
+
+  /// @brief Half dimensions of the boxes.
+  Array extent[3];
+
+  /// @brief Number of lanes in use. The other lanes are never reported as
+  /// overlapping.
+  int size;
+
+  OBBPacket() : size(0) {
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) axes[i][j].setZero();
+      To[i].setZero();
+      extent[i].setZero();
+    }
+  }
+
+  /// @brief Store \p obb in lane \p k.
+  void set(int k, const OBB& obb) {
+    assert(k >= 0 && k < N);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) axes[i][j][k] = obb.axes(i, j);
+      To[i][k] = obb.To[i];
+      extent[i][k] = obb.extent[i];
+    }
+  }
+
+  /// @brief Store the OBB of \p bv in lane \p k.
+  void set(int k, const OBBRSS& bv) { set(k, bv.obb); }
+
+  /// @brief Append \p obb to the used lanes.
+  template <typename BV>
+  void push_back(const BV& bv) {
+    assert(size < N);
+    set(size++, bv);
+  }
+
+  /// @brief Read back the box stored in lane \p k.
+  OBB get(int k) const {
+    assert(k >= 0 && k < N);
+    OBB obb;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) obb.axes(i, j) = axes[i][j][k];
+      obb.To[i] = To[i][k];
+      obb.extent[i] = extent[i][k];
+    }
+    return obb;
+  }
+
+  /// @brief Bit mask of the lanes in use.
+  unsigned int activeMask() const {
+    return (size >= int(8 * sizeof(unsigned int))) ? ~0u
+                                                   : ((1u << size) - 1u);
+  }
+};
+
+/// @cond IGNORE
+namespace details {
+
+/// @brief Relative placement of the boxes of a packet with respect to a box
+/// b1, in the frame of b1: T is the position of the centers, B the relative
+/// orientations.
+template <int N>
+struct OBBPacketRelativePlacement {
+  typedef typename OBBPacket<N>::Array Array;
+  Array B[3][3];
+  Array T[3];
+
+  /// @param R0, T0 configuration of b1, the boxes of the packet being in
+  ///        identity configuration. This is the same convention as
+  ///        overlap(const Matrix3f&, const Vec3f&, const OBB&, const OBB&).
+  OBBPacketRelativePlacement(const Matrix3f& R0, const Vec3f& T0,
+                             const OBB& b1, const OBBPacket<N>& b2) {
+    // Same as overlap(R0, T0, b1, b2) done for every lane:
+    // B = b1.axes^T R0^T b2.axes and
+    // T = b1.axes^T (R0^T (b2.To - T0) - b1.To) = M b2.To + c
+    const Matrix3f M(b1.axes.transpose() * R0.transpose());
+    const Vec3f c(-b1.axes.transpose() * (R0.transpose() * T0 + b1.To));
+    for (int i = 0; i < 3; ++i) {
+      T[i] = c[i] + M(i, 0) * b2.To[0] + M(i, 1) * b2.To[1] +
+             M(i, 2) * b2.To[2];
+      for (int j = 0; j < 3; ++j)
+        B[i][j] = M(i, 0) * b2.axes[0][j] + M(i, 1) * b2.axes[1][j] +
+                  M(i, 2) * b2.axes[2][j];
+    }
+  }
+};
+
+template <int N>
+unsigned int toBitMask(const Eigen::Array<bool, N, 1>& lanes) {
+  unsigned int mask = 0;
+  for (int k = 0; k < N; ++k)
+    if (lanes[k]) mask |= (1u << k);
+  return mask;
+}
+
+}  // namespace details
+/// @endcond
+
+/// @brief Test one OBB against the N OBBs of a packet.
+///
+/// @param R0, T0 configuration of b1, the boxes of the packet being in
+///        identity configuration.
+/// @return a bit mask whose bit k is set iff b1 overlaps the k-th box of b2.
+///
+/// This is the same 15 axes separating axis test as
+/// overlap(const Matrix3f&, const Vec3f&, const OBB&, const OBB&), every test
+/// being evaluated on all the lanes at once.
+template <int N>
+unsigned int overlap(const Matrix3f& R0, const Vec3f& T0, const OBB& b1,
+                     const OBBPacket<N>& b2) {
+  typedef typename OBBPacket<N>::Array Array;
+  typedef Eigen::Array<bool, N, 1> Lanes;
+  const details::OBBPacketRelativePlacement<N> rel(R0, T0, b1, b2);
+  const FCL_REAL reps = 1e-6;
+  const Vec3f& a = b1.extent;
+  const Array* const b = b2.extent;
+
+  Array Bf[3][3];
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) Bf[i][j] = rel.B[i][j].abs() + reps;
+
+  Lanes disjoint(Lanes::Constant(false));
+  // Axes of b1.
+  for (int i = 0; i < 3; ++i)
+    disjoint = disjoint || (rel.T[i].abs() > a[i] + Bf[i][0] * b[0] +
+                                                 Bf[i][1] * b[1] +
+                                                 Bf[i][2] * b[2]);
+  // Axes of b2.
+  for (int j = 0; j < 3; ++j)
+    disjoint = disjoint ||
+               ((rel.B[0][j] * rel.T[0] + rel.B[1][j] * rel.T[1] +
+                 rel.B[2][j] * rel.T[2])
+                    .abs() > b[j] + Bf[0][j] * a[0] + Bf[1][j] * a[1] +
+                                 Bf[2][j] * a[2]);
+  unsigned int mask = ~details::toBitMask<N>(disjoint) & b2.activeMask();
+  if (mask == 0) return 0;
+  // Cross products of the axes.
+  for (int i = 0; i < 3; ++i) {
+    const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    for (int j = 0; j < 3; ++j) {
+      const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      const Array s = rel.T[i2] * rel.B[i1][j] - rel.T[i1] * rel.B[i2][j];
+      disjoint = disjoint ||
+                 (s.abs() > a[i1] * Bf[i2][j] + a[i2] * Bf[i1][j] +
+                                b[j1] * Bf[i][j2] + b[j2] * Bf[i][j1]);
+    }
+  }
+  return mask & ~details::toBitMask<N>(disjoint);
+}
+
+/// @brief Test one OBB against the N OBBs of a packet and compute a lower
+///        bound of the distance to the boxes which are disjoint from b1.
+///
+/// @param R0, T0 configuration of b1, the boxes of the packet being in
+///        identity configuration.
+/// @param request the security margin and the break distance are taken into
+///        account as in
+///        overlap(const Matrix3f&, const Vec3f&, const OBB&, const OBB&,
+///        const CollisionRequest&, FCL_REAL&).
+/// @retval sqrDistLowerBound for every lane whose bit is not set in the
+///         returned mask, the square of a lower bound of the distance between
+///         b1 and the k-th box. Undefined for the other lanes.
+/// @return a bit mask whose bit k is set iff b1 overlaps the k-th box of b2.
+template <int N>
+unsigned int overlap(const Matrix3f& R0, const Vec3f& T0, const OBB& b1,
+                     const OBBPacket<N>& b2, const CollisionRequest& request,
+                     typename OBBPacket<N>::Array& sqrDistLowerBound) {
+  typedef typename OBBPacket<N>::Array Array;
+  const details::OBBPacketRelativePlacement<N> rel(R0, T0, b1, b2);
+  const FCL_REAL breakDistance2 =
+      request.break_distance * request.break_distance;
+  const FCL_REAL half_margin = .5 * request.security_margin;
+
+  Vec3f a;
+  Array b[3];
+  for (int i = 0; i < 3; ++i) {
+    a[i] = (std::max)(b1.extent[i] + half_margin, FCL_REAL(0));
+    b[i] = (b2.extent[i] + half_margin).max(FCL_REAL(0));
+  }
+
+  Array Bf[3][3];
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) Bf[i][j] = rel.B[i][j].abs();
+
+  // Every test below yields a valid lower bound of the squared distance, so
+  // the largest one is kept. The cross products, which are the most
+  // expensive, are skipped when the face axes already separate all the boxes.
+  // Axes of b1.
+  Array t, lb(Array::Zero());
+  for (int i = 0; i < 3; ++i) {
+    t = (rel.T[i].abs() - a[i] - Bf[i][0] * b[0] - Bf[i][1] * b[1] -
+         Bf[i][2] * b[2])
+            .max(FCL_REAL(0));
+    lb += t * t;
+  }
+  // Axes of b2.
+  Array lb_b(Array::Zero());
+  for (int j = 0; j < 3; ++j) {
+    t = ((rel.B[0][j] * rel.T[0] + rel.B[1][j] * rel.T[1] +
+          rel.B[2][j] * rel.T[2])
+             .abs() -
+         Bf[0][j] * a[0] - Bf[1][j] * a[1] - Bf[2][j] * a[2] - b[j])
+            .max(FCL_REAL(0));
+    lb_b += t * t;
+  }
+  lb = lb.max(lb_b);
+  sqrDistLowerBound = lb;
+  unsigned int mask =
+      ~details::toBitMask<N>(lb > breakDistance2) & b2.activeMask();
+  if (mask == 0) return 0;
+  // Cross products of the axes. Nearly parallel axes are skipped.
+  for (int i = 0; i < 3; ++i) {
+    const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    for (int j = 0; j < 3; ++j) {
+      const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      const Array sinus2 = 1 - Bf[i][j] * Bf[i][j];
+      const Array s = rel.T[i2] * rel.B[i1][j] - rel.T[i1] * rel.B[i2][j];
+      t = (s.abs() - (a[i1] * Bf[i2][j] + a[i2] * Bf[i1][j] +
+                      b[j1] * Bf[i][j2] + b[j2] * Bf[i][j1]))
+              .max(FCL_REAL(0));
+      lb = (sinus2 < 1e-6).select(lb, lb.max(t * t / sinus2));
+    }
+  }
+  sqrDistLowerBound = lb;
+  return mask & ~details::toBitMask<N>(lb > breakDistance2);
+}
+
+/// @brief Same as overlap(const Matrix3f&, const Vec3f&, const OBB&,
+///        const OBBPacket<N>&) for the OBB part of an OBBRSS.
+template <int N>
+inline unsigned int overlap(const Matrix3f& R0, const Vec3f& T0,
+                            const OBBRSS& b1, const OBBPacket<N>& b2) {
+  return overlap(R0, T0, b1.obb, b2);
+}
+
+/// @brief Same as overlap(const Matrix3f&, const Vec3f&, const OBB&,
+///        const OBBPacket<N>&, const CollisionRequest&,
+///        typename OBBPacket<N>::Array&) for the OBB part of an OBBRSS.
+template <int N>
+inline unsigned int overlap(const Matrix3f& R0, const Vec3f& T0,
+                            const OBBRSS& b1, const OBBPacket<N>& b2,
+                            const CollisionRequest& request,
+                            typename OBBPacket<N>::Array& sqrDistLowerBound) {
+  return overlap(R0, T0, b1.obb, b2, request, sqrDistLowerBound);
+}
+
+/// @}
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_OBB_PACKET_H
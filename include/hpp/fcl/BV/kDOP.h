@@ -169,18 +169,23 @@ class HPP_FCL_DLLAPI KDOP {
   bool inside(const Vec3f& p) const;
 };
 
+/// @brief Check collision between two KDOPs, b1 is in configuration (R0, T0)
+/// and b2 is in identity.
+/// @note b1 is bounded by the box defined by its AABB planes, and the test is
+/// made between the KDOP bounding this box in configuration (R0, T0) and b2.
 template <short N>
-bool overlap(const Matrix3f& /*R0*/, const Vec3f& /*T0*/, const KDOP<N>& /*b1*/,
-             const KDOP<N>& /*b2*/) {
-  HPP_FCL_THROW_PRETTY("not implemented", std::logic_error);
-}
+HPP_FCL_DLLAPI bool overlap(const Matrix3f& R0, const Vec3f& T0,
+                            const KDOP<N>& b1, const KDOP<N>& b2);
 
+/// @copydoc overlap(const Matrix3f&, const Vec3f&, const KDOP<N>&, const
+/// KDOP<N>&)
+/// @retval sqrDistLowerBound squared lower bound on distance between the
+///         KDOPs if they do not overlap.
 template <short N>
-bool overlap(const Matrix3f& /*R0*/, const Vec3f& /*T0*/, const KDOP<N>& /*b1*/,
-             const KDOP<N>& /*b2*/, const CollisionRequest& /*request*/,
-             FCL_REAL& /*sqrDistLowerBound*/) {
-  HPP_FCL_THROW_PRETTY("not implemented", std::logic_error);
-}
+HPP_FCL_DLLAPI bool overlap(const Matrix3f& R0, const Vec3f& T0,
+                            const KDOP<N>& b1, const KDOP<N>& b2,
+                            const CollisionRequest& request,
+                            FCL_REAL& sqrDistLowerBound);
 
 /// @brief translate the KDOP BV
 template <short N>
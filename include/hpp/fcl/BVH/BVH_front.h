@@ -38,7 +38,7 @@
 #ifndef HPP_FCL_BVH_FRONT_H
 #define HPP_FCL_BVH_FRONT_H
 
-#include <list>
+#include <vector>
 
 #include <hpp/fcl/config.hh>
 
@@ -50,21 +50,27 @@ namespace fcl {
 /// the traversal terminates while performing a query during a given time
 /// instance. The front list reflects the subset of a BVTT that is traversed for
 /// that particular proximity query.
+///
+/// The front is stored with the part of the BVTT above it, in depth first
+/// order: each node is followed by the nodes of its subtree. A node of the
+/// front has no subtree. The next query restarts from this subtree: it
+/// refines the nodes of the front which are no longer separated, and
+/// collapses back into their parent the nodes whose siblings and parent are
+/// separated again.
 struct HPP_FCL_DLLAPI BVHFrontNode {
-  /// @brief The nodes to start in the future, i.e. the wave front of the
-  /// traversal tree.
+  /// @brief The pair of nodes of the BVTT.
   unsigned int left, right;
 
-  /// @brief The front node is not valid when collision is detected on the front
-  /// node.
-  bool valid;
+  /// @brief The number of nodes of the subtree rooted at this node, itself
+  /// included: 1 for the nodes of the front, where the traversal stopped.
+  unsigned int size;
 
   BVHFrontNode(unsigned int left_, unsigned int right_)
-      : left(left_), right(right_), valid(true) {}
+      : left(left_), right(right_), size(1) {}
 };
 
-/// @brief BVH front list is a list of front nodes.
-typedef std::list<BVHFrontNode> BVHFrontList;
+/// @brief BVH front list is a list of front nodes, stored contiguously.
+typedef std::vector<BVHFrontNode> BVHFrontList;
 
 /// @brief Add new front node into the front list
 inline void updateFrontList(BVHFrontList* front_list, unsigned int b1,
@@ -72,6 +78,21 @@ inline void updateFrontList(BVHFrontList* front_list, unsigned int b1,
   if (front_list) front_list->push_back(BVHFrontNode(b1, b2));
 }
 
+/// @brief Add the pair (b1, b2), whose subtree is then added, into the front
+/// list. Returns its position, to give to endFrontSubtree.
+inline std::size_t beginFrontSubtree(BVHFrontList* front_list,
+                                     unsigned int b1, unsigned int b2) {
+  if (!front_list) return 0;
+  front_list->push_back(BVHFrontNode(b1, b2));
+  return front_list->size() - 1;
+}
+
+/// @brief Close the subtree of the node at position \p root.
+inline void endFrontSubtree(BVHFrontList* front_list, std::size_t root) {
+  if (front_list)
+    (*front_list)[root].size = (unsigned int)(front_list->size() - root);
+}
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -43,6 +43,7 @@
 #include "hpp/fcl/collision_object.h"
 #include "hpp/fcl/BVH/BVH_internal.h"
 #include "hpp/fcl/BV/BV_node.h"
+#include "hpp/fcl/BVH/BVH_quantized.h"
 
 #include <vector>
 #include <memory>
@@ -60,6 +61,8 @@ template <typename BV>
 class BVFitter;
 template <typename BV>
 class BVSplitter;
+template <typename BV>
+class WideBVH;
 
 /// @brief A base class describing the bounding hierarchy of a mesh model or a
 /// point cloud model (which is viewed as a degraded version of mesh)
@@ -135,7 +138,17 @@ class HPP_FCL_DLLAPI BVHModelBase : public CollisionGeometry {
 
   /// @brief End BVH model construction, will build the bounding volume
   /// hierarchy
-  int endModel();
+  int endModel() { return endModel(1); }
+
+  /// @brief End BVH model construction, building the bounding volume
+  /// hierarchy with \p num_threads threads.
+  ///
+  /// The subtrees are built in parallel and the fitting of the BVs of the
+  /// first levels is split among the threads. The hierarchy is the same as
+  /// the one built by endModel().
+  /// \param[in] num_threads number of threads. 0 means using all the
+  ///            hardware threads.
+  int endModel(unsigned int num_threads);
 
   /// @brief Replace the geometry information of current frame (i.e. should have
   /// the same mesh topology with the previous frame)
@@ -170,7 +183,39 @@ class HPP_FCL_DLLAPI BVHModelBase : public CollisionGeometry {
 
   /// @brief End BVH model update, will also refit or rebuild the bounding
   /// volume hierarchy
-  int endUpdateModel(bool refit = true, bool bottomup = true);
+  int endUpdateModel(bool refit = true, bool bottomup = true) {
+    return endUpdateModel(refit, bottomup, 1);
+  }
+
+  /// @brief End BVH model update, refitting or rebuilding the bounding volume
+  /// hierarchy with \p num_threads threads.
+  ///
+  /// A bottom-up refit splits the first levels of the hierarchy into subtrees
+  /// refitted in parallel. A top-down refit fits the nodes in parallel. The
+  /// BVs are the same as with endUpdateModel().
+  /// \param[in] num_threads number of threads. 0 means using all the
+  ///            hardware threads.
+  int endUpdateModel(bool refit, bool bottomup, unsigned int num_threads);
+
+  /// @brief Move the vertices of indices \p indices to the points \p ps and
+  /// refit only the BVs of the primitives containing them and of their
+  /// ancestors, bottom-up.
+  ///
+  /// This is meant for models which deform locally (cloth, soft grippers,
+  /// depth meshes...), whose full refit costs much more than the motion of
+  /// a few vertices. It is called on a built model, instead of a
+  /// beginUpdateModel() / endUpdateModel() sequence. If the model has a
+  /// previous frame (prev_vertices), the previous position of each moved
+  /// vertex becomes its position before the call, so that the BVs enclose
+  /// the motion. Each index is expected only once.
+  ///
+  /// The parent of each node and the leaves containing each vertex are
+  /// computed at the first call after the hierarchy is built.
+  /// @return BVH_OK, BVH_ERR_BUILD_OUT_OF_SEQUENCE if the hierarchy is not
+  ///         built or BVH_ERR_INCORRECT_DATA if an index is out of range or
+  ///         the sizes of \p indices and \p ps differ.
+  int updateVertices(const std::vector<unsigned int>& indices,
+                     const std::vector<Vec3f>& ps);
 
   /// @brief Build this \ref Convex "Convex<Triangle>" representation of this
   /// model. The result is stored in attribute \ref convex. \note this only
@@ -293,11 +338,15 @@ class HPP_FCL_DLLAPI BVHModelBase : public CollisionGeometry {
   virtual void deleteBVs() = 0;
   virtual bool allocateBVs() = 0;
 
-  /// @brief Build the bounding volume hierarchy
-  virtual int buildTree() = 0;
+  /// @brief Build the bounding volume hierarchy with \p num_threads threads
+  virtual int buildTree(unsigned int num_threads) = 0;
+
+  /// @brief Refit the bounding volume hierarchy with \p num_threads threads
+  virtual int refitTree(bool bottomup, unsigned int num_threads) = 0;
 
-  /// @brief Refit the bounding volume hierarchy
-  virtual int refitTree(bool bottomup) = 0;
+  /// @brief Refit the leaves containing the vertices \p indices, and their
+  /// ancestors.
+  virtual int refitVertices(const std::vector<unsigned int>& indices) = 0;
 
   unsigned int num_tris_allocated;
   unsigned int num_vertices_allocated;
@@ -346,12 +395,14 @@ class HPP_FCL_DLLAPI BVHModel : public BVHModelBase {
   /// @brief Access the bv giving the its index
   const BVNode<BV>& getBV(unsigned int i) const {
     assert(i < num_bvs);
+    assert(bvs.get() && "the hierarchy is compressed");
     return (*bvs)[i];
   }
 
   /// @brief Access the bv giving the its index
   BVNode<BV>& getBV(unsigned int i) {
     assert(i < num_bvs);
+    assert(bvs.get() && "the hierarchy is compressed");
     return (*bvs)[i];
   }
 
@@ -369,10 +420,73 @@ class HPP_FCL_DLLAPI BVHModel : public BVHModelBase {
   /// transform related to its parent BV node. When traversing the BVH, this can
   /// save one matrix transformation.
   void makeParentRelative() {
+    wide_bvh.reset();
     Matrix3f I(Matrix3f::Identity());
     makeParentRelativeRecurse(0, I, Vec3f::Zero());
   }
 
+  /// @brief Improve the hierarchy built by endModel() with tree rotations.
+  ///
+  /// Children and grandchildren of each node are swapped as long as it
+  /// reduces the sum of the surface areas of the internal nodes, measured on
+  /// the axis aligned boxes of their primitives. This is most useful after a
+  /// build with SPLIT_METHOD_SAH. The BV of the modified nodes are then
+  /// fitted again with bv_fitter.
+  ///
+  /// It must be called before makeParentRelative() and buildWideBVH().
+  /// @return BVH_OK, or BVH_ERR_BUILD_OUT_OF_SEQUENCE if the hierarchy is not
+  ///         built.
+  int optimizeTree();
+
+  /// @brief Renumber the primitives in the order of the leaves of the
+  /// hierarchy, so that primitive_indices becomes the identity and that
+  /// neighboring leaves use neighboring triangles and vertices in memory.
+  ///
+  /// The vertices are renumbered in the order of their first use by the
+  /// triangles, the vertices used by no triangle being moved at the end. The
+  /// nodes keep their depth first layout. The indices of the contacts and of
+  /// the updates of the model then refer to the new numbering.
+  /// @param primitive_order if not NULL, set to the former index of each
+  ///        primitive (triangle, or vertex for a point cloud).
+  /// @param vertex_order if not NULL, set to the former index of each vertex.
+  /// @return BVH_OK, or BVH_ERR_BUILD_OUT_OF_SEQUENCE if the hierarchy is not
+  ///         built.
+  int reorderPrimitives(std::vector<unsigned int>* primitive_order = NULL,
+                        std::vector<unsigned int>* vertex_order = NULL);
+
+  /// @brief Build the wide version of the hierarchy (see WideBVH), with
+  /// \p width (4 or 8) children per node. When it is available, the collision
+  /// queries between two meshes use it to traverse the first mesh.
+  ///
+  /// It must be called again after each update of the model, which discards
+  /// the wide hierarchy.
+  /// @throw std::invalid_argument if the hierarchy is not built, if \p width
+  ///        is neither 4 nor 8 or if BV is neither OBB nor OBBRSS.
+  void buildWideBVH(unsigned int width = 4);
+
+  /// @brief The wide version of the hierarchy, or NULL if it was not built.
+  const WideBVH<BV>* getWideBVH() const { return wide_bvh.get(); }
+
+  /// @brief Replace the nodes of the hierarchy by a QuantizedBVH with
+  /// \p bits (8 or 16) bits per coordinate, to reduce the memory footprint.
+  ///
+  /// getBV() cannot be used on a compressed model, which only supports the
+  /// collision queries with another BVHModel. Updating or optimizing the
+  /// model, or building its wide hierarchy, first calls decompressBVH().
+  /// @throw std::invalid_argument if the hierarchy is not built or if
+  ///        \p bits is neither 8 nor 16.
+  void compressBVH(unsigned int bits = 16);
+
+  /// @brief Rebuild the nodes of a compressed hierarchy, and fit them again
+  /// to their primitives. Does nothing if the hierarchy is not compressed.
+  void decompressBVH();
+
+  /// @brief Whether the hierarchy is compressed, see compressBVH().
+  bool isCompressed() const { return quantized_bvh.get() != NULL; }
+
+  /// @brief The compressed hierarchy, or NULL if it is not compressed.
+  const QuantizedBVH* getQuantizedBVH() const { return quantized_bvh.get(); }
+
  protected:
   void deleteBVs();
   bool allocateBVs();
@@ -386,27 +500,76 @@ class HPP_FCL_DLLAPI BVHModel : public BVHModelBase {
   /// @brief Number of BV nodes in bounding volume hierarchy
   unsigned int num_bvs;
 
-  /// @brief Build the bounding volume hierarchy
-  int buildTree();
+  /// @brief Wide version of bvs, see buildWideBVH()
+  shared_ptr<const WideBVH<BV>> wide_bvh;
+
+  /// @brief Compressed version of bvs, see compressBVH()
+  shared_ptr<const QuantizedBVH> quantized_bvh;
+
+  /// @brief Build the bounding volume hierarchy with \p num_threads threads
+  int buildTree(unsigned int num_threads);
+
+  /// @brief Parent of each node, or -1 for the root, see refitVertices().
+  std::vector<int> bv_parents;
+
+  /// @brief Leaves containing each vertex, see refitVertices(). Those of
+  /// vertex i are vertex_leaves[vertex_leaves_offsets[i]] to
+  /// vertex_leaves[vertex_leaves_offsets[i + 1] - 1].
+  std::vector<unsigned int> vertex_leaves_offsets, vertex_leaves;
+
+  /// @brief Refit the bounding volume hierarchy with \p num_threads threads
+  int refitTree(bool bottomup, unsigned int num_threads);
 
-  /// @brief Refit the bounding volume hierarchy
-  int refitTree(bool bottomup);
+  /// @brief Refit the leaves containing the vertices \p indices and their
+  /// ancestors. bv_parents and vertex_leaves are computed if they are empty.
+  int refitVertices(const std::vector<unsigned int>& indices);
+
+  /// @brief Discard bv_parents and vertex_leaves, when the nodes change.
+  void clearVertexLeaves() {
+    bv_parents.clear();
+    vertex_leaves_offsets.clear();
+    vertex_leaves.clear();
+  }
 
   /// @brief Refit the bounding volume hierarchy in a top-down way (slow but
   /// more compact)
-  int refitTree_topdown();
+  int refitTree_topdown(unsigned int num_threads);
 
   /// @brief Refit the bounding volume hierarchy in a bottom-up way (fast but
   /// less compact)
-  int refitTree_bottomup();
+  int refitTree_bottomup(unsigned int num_threads);
 
-  /// @brief Recursive kernel for hierarchy construction
-  int recursiveBuildTree(int bv_id, unsigned int first_primitive,
-                         unsigned int num_primitives);
+  /// @brief Fit the BV of leaf bv_id to its primitive
+  int refitLeaf(int bv_id);
+
+  /// @brief Recursive kernel for hierarchy construction.
+  ///
+  /// The children of bv_id are stored at first_child and first_child + 1,
+  /// followed by the descendants of the left child and then those of the
+  /// right child. The nodes of a subtree thus only depend on its position, so
+  /// that subtrees can be built independently.
+  int recursiveBuildTree(BVSplitter<BV>& splitter, int bv_id,
+                         unsigned int first_primitive,
+                         unsigned int num_primitives, int first_child);
+
+  /// @brief Fit the BV of node bv_id to its primitives and, if there is more
+  /// than one, sort them between its two children.
+  /// @retval num_first_half number of primitives of the left child.
+  int splitNode(BVSplitter<BV>& splitter, int bv_id,
+                unsigned int first_primitive, unsigned int num_primitives,
+                unsigned int& num_first_half);
 
   /// @brief Recursive kernel for bottomup refitting
   int recursiveRefitTree_bottomup(int bv_id);
 
+  /// @brief Recursive kernel writing the hierarchy optimized by optimizeTree()
+  /// back into bvs and primitive_indices.
+  /// @return the number of primitives below the node.
+  unsigned int recursiveRelayoutTree(
+      const bv_node_vector_t& old_bvs, const std::vector<int>& left,
+      const std::vector<int>& right, int old_id, int bv_id,
+      unsigned int first_primitive);
+
   /// @ recursively compute each bv's transform related to its parent. For
   /// default BV, only the translation works. For oriented BV (OBB, RSS,
   /// OBBRSS), special implementation is provided.
@@ -491,6 +654,13 @@ class HPP_FCL_DLLAPI BVHModel : public BVHModelBase {
       }
     }
 
+    if ((!(quantized_bvh.get()) && other.quantized_bvh.get()) ||
+        (quantized_bvh.get() && !(other.quantized_bvh.get())))
+      return false;
+    if (quantized_bvh.get() && other.quantized_bvh.get() &&
+        *quantized_bvh != *(other.quantized_bvh))
+      return false;
+
     return true;
   }
 };
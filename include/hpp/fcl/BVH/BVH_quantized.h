@@ -0,0 +1,173 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_BVH_QUANTIZED_H
+#define HPP_FCL_BVH_QUANTIZED_H
+
+#include <hpp/fcl/BV/AABB.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace hpp {
+namespace fcl {
+
+template <typename BV>
+class BVHModel;
+
+/// @addtogroup Construction_Of_BVH
+/// @{
+
+/// @brief Compressed version of the binary hierarchy of a BVHModel, see
+/// BVHModel::compressBVH().
+///
+/// Each node stores the index of its first child, or of its primitive for a
+/// leaf, as BVNodeBase::first_child, and an axis aligned box in the frame of
+/// the model. The box is quantized with 8 or 16 bits per coordinate relative
+/// to the box of its parent: a node takes 10 or 16 bytes, instead of
+/// `sizeof(BVNode<BV>) + sizeof(unsigned int)`.
+///
+/// The boxes are rounded outward, so that a decoded box contains the
+/// primitives of the node (at both frames for a deformable model). They are
+/// decoded during the traversal, from the box of the parent.
+class HPP_FCL_DLLAPI QuantizedBVH {
+ public:
+  /// @brief Compress the hierarchy of \p model, which keeps the same nodes.
+  /// @param bits number of bits per coordinate, either 8 or 16.
+  /// @throw std::invalid_argument if the hierarchy of \p model is not built or
+  ///        if \p bits is neither 8 nor 16.
+  template <typename BV>
+  QuantizedBVH(const BVHModel<BV>& model, unsigned int bits = 16);
+
+  /// @brief Number of bits per coordinate of the boxes.
+  unsigned int bits() const { return bits_; }
+
+  /// @brief Number of nodes. The root is the node 0.
+  unsigned int getNumNodes() const { return (unsigned int)first_child.size(); }
+
+  /// @brief Whether node \p i is a leaf.
+  bool isLeaf(unsigned int i) const {
+    assert(i < first_child.size());
+    return first_child[i] < 0;
+  }
+
+  /// @brief Left child of the internal node \p i.
+  int leftChild(unsigned int i) const {
+    assert(!isLeaf(i));
+    return first_child[i];
+  }
+
+  /// @brief Right child of the internal node \p i.
+  int rightChild(unsigned int i) const {
+    assert(!isLeaf(i));
+    return first_child[i] + 1;
+  }
+
+  /// @brief Primitive of the leaf \p i.
+  int primitiveId(unsigned int i) const {
+    assert(isLeaf(i));
+    return -(first_child[i] + 1);
+  }
+
+  /// @brief Box of the root, not quantized.
+  const AABB& getRootBox() const { return root_box; }
+
+  /// @brief Decode the box of the node \p i, whose parent has the box
+  /// \p parent.
+  void decode(unsigned int i, const AABB& parent, AABB& box) const {
+    const Vec3f step = (parent.max_ - parent.min_) * inv_scale;
+    if (bits_ == 8)
+      decodeBox(codes8.data() + 6 * i, parent, step, box);
+    else
+      decodeBox(codes16.data() + 6 * i, parent, step, box);
+  }
+
+  /// @brief Equality operator: same nodes and same quantization.
+  bool operator==(const QuantizedBVH& other) const {
+    return bits_ == other.bits_ && inv_scale == other.inv_scale &&
+           root_box == other.root_box && first_child == other.first_child &&
+           codes8 == other.codes8 && codes16 == other.codes16;
+  }
+
+  /// @brief Difference operator
+  bool operator!=(const QuantizedBVH& other) const {
+    return !(*this == other);
+  }
+
+  /// @brief Memory used by the compressed hierarchy, in bytes.
+  std::size_t memUsage() const {
+    return sizeof(QuantizedBVH) + first_child.size() * sizeof(int) +
+           codes8.size() * sizeof(std::uint8_t) +
+           codes16.size() * sizeof(std::uint16_t);
+  }
+
+ protected:
+  /// @brief The minimum of the box is code[0, 3) steps above the minimum of
+  /// the parent, and its maximum code[3, 6) steps below its maximum.
+  template <typename Code>
+  static void decodeBox(const Code* code, const AABB& parent,
+                        const Vec3f& step, AABB& box) {
+    for (int k = 0; k < 3; ++k) {
+      box.min_[k] = parent.min_[k] + step[k] * FCL_REAL(code[k]);
+      box.max_[k] = parent.max_[k] - step[k] * FCL_REAL(code[k + 3]);
+    }
+  }
+
+  /// @brief Quantize \p box relative to \p parent into \p code, rounding
+  /// outward, and set \p box to the decoded box.
+  template <typename Code>
+  void encode(const AABB& parent, AABB& box, Code* code) const;
+
+  unsigned int bits_;
+
+  /// @brief Inverse of the largest code, 2^bits - 1.
+  FCL_REAL inv_scale;
+
+  AABB root_box;
+
+  /// @brief first_child[i] is BVNodeBase::first_child of node i.
+  std::vector<int> first_child;
+
+  /// @brief The quantized box of node i is min and max in
+  /// codes[6 * i, 6 * (i + 1)), in codes8 or codes16 depending on bits().
+  std::vector<std::uint8_t> codes8;
+  std::vector<std::uint16_t> codes16;
+};
+
+/// @}
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_BVH_QUANTIZED_H
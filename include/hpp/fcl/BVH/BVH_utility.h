@@ -84,9 +84,13 @@ HPP_FCL_DLLAPI BVHModel<KDOP<24> >* BVHExtract(const BVHModel<KDOP<24> >& model,
 
 /// @brief Compute the covariance matrix for a set or subset of points. if ts =
 /// null, then indices refer to points directly; otherwise refer to triangles
+///
+/// The sums are accumulated by blocks of primitives, which are processed by
+/// \p num_threads threads for large sets. The blocks are summed in the same
+/// order whatever the number of threads, so that M does not depend on it.
 HPP_FCL_DLLAPI void getCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts,
                                   unsigned int* indices, unsigned int n,
-                                  Matrix3f& M);
+                                  Matrix3f& M, unsigned int num_threads = 1);
 
 /// @brief Compute the RSS bounding volume parameters: radius, rectangle size
 /// and the origin, given the BV axises.
@@ -95,11 +99,13 @@ HPP_FCL_DLLAPI void getRadiusAndOriginAndRectangleSize(
     const Matrix3f& axes, Vec3f& origin, FCL_REAL l[2], FCL_REAL& r);
 
 /// @brief Compute the bounding volume extent and center for a set or subset of
-/// points, given the BV axises.
+/// points, given the BV axises. Large sets are processed by \p num_threads
+/// threads.
 HPP_FCL_DLLAPI void getExtentAndCenter(Vec3f* ps, Vec3f* ps2, Triangle* ts,
                                        unsigned int* indices, unsigned int n,
                                        Matrix3f& axes, Vec3f& center,
-                                       Vec3f& extent);
+                                       Vec3f& extent,
+                                       unsigned int num_threads = 1);
 
 /// @brief Compute the center and radius for a triangle's circumcircle
 HPP_FCL_DLLAPI void circumCircleComputation(const Vec3f& a, const Vec3f& b,
@@ -0,0 +1,187 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HPP_FCL_BVH_WIDE_H
+#define HPP_FCL_BVH_WIDE_H
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/BV/OBB_packet.h>
+
+#include <limits>
+#include <vector>
+
+namespace hpp {
+namespace fcl {
+
+/// @addtogroup Construction_Of_BVH
+/// @{
+
+/// @brief Whether WideBVH can be built on top of a BVHModel<BV>.
+/// Only the oriented boxes (OBB and OBBRSS) have a SIMD packet overlap test.
+template <typename BV>
+struct WideBVHSupport {
+  enum { value = false };
+};
+template <>
+struct WideBVHSupport<OBB> {
+  enum { value = true };
+};
+template <>
+struct WideBVHSupport<OBBRSS> {
+  enum { value = true };
+};
+
+/// @brief Collapsed version of the binary hierarchy of a BVHModel, where each
+/// node has up to `width()` children (4 or 8).
+///
+/// A wide node stands for a node of the binary tree. Its children are the
+/// descendants of this binary node obtained by repeatedly splitting the
+/// largest internal one, until there are `width()` of them or only leaves are
+/// left. The boxes of the children of a wide node are stored contiguously in
+/// OBBPacket, so that one node fetch is enough to test a box against all of
+/// them with overlap(const Matrix3f&, const Vec3f&, const OBB&,
+/// const OBBPacket<N>&). The nodes are laid out breadth first: the children of
+/// a wide node are contiguous in memory.
+///
+/// Every child keeps the index of the binary node it comes from, so that the
+/// primitives and the binary tree of the model can still be used.
+///
+/// The wide hierarchy is a snapshot of the binary one: it must be rebuilt after
+/// the BVHModel is updated.
+template <typename BV>
+class HPP_FCL_DLLAPI WideBVH {
+ public:
+  /// @brief Width of the SIMD packets storing the children boxes. 8-wide nodes
+  ///        use two packets.
+  enum { PacketWidth = 4 };
+  typedef OBBPacket<PacketWidth> Packet;
+  typedef std::vector<Packet, Eigen::aligned_allocator<Packet> >
+      packet_vector_t;
+
+  /// @brief Collapse the binary hierarchy of \p model.
+  /// @param width number of children per node, either 4 or 8.
+  /// @throw std::invalid_argument if the hierarchy of \p model is not built or
+  ///        if \p width is neither 4 nor 8.
+  WideBVH(const BVHModel<BV>& model, unsigned int width = 4);
+
+  /// @brief Maximal number of children of a node.
+  unsigned int width() const { return width_; }
+
+  /// @brief Number of wide nodes. The root is the node 0.
+  unsigned int getNumNodes() const { return num_nodes; }
+
+  /// @brief Number of children of node \p w.
+  int getNumChildren(unsigned int w) const {
+    assert(w < num_nodes);
+    int n = 0;
+    for (unsigned int p = 0; p < packetsPerNode(); ++p)
+      n += packets[w * packetsPerNode() + p].size;
+    return n;
+  }
+
+  /// @brief Index of the k-th child of node \p w in the wide hierarchy, or -1
+  ///        if it is a leaf of the binary tree.
+  int getChild(unsigned int w, int k) const {
+    assert(k >= 0 && k < getNumChildren(w));
+    return children[w * width_ + (unsigned int)k];
+  }
+
+  /// @brief Index, in the binary tree of the model, of the node corresponding
+  ///        to the k-th child of node \p w.
+  unsigned int getBinaryNode(unsigned int w, int k) const {
+    assert(k >= 0 && k < getNumChildren(w));
+    return binary_nodes[w * width_ + (unsigned int)k];
+  }
+
+  /// @brief Test \p bv against the boxes of all the children of node \p w.
+  ///
+  /// @param R, T configuration of \p bv, the model being in identity
+  ///        configuration. This is the same convention as
+  ///        overlap(const Matrix3f&, const Vec3f&, const OBB&, const OBB&).
+  /// @retval sqrDistLowerBound the smallest of the squared lower bounds of the
+  ///         distance to the children which do not overlap \p bv, or infinity
+  ///         if all of them overlap.
+  /// @return a bit mask whose bit k is set iff the k-th child overlaps \p bv.
+  unsigned int overlap(const Matrix3f& R, const Vec3f& T, const BV& bv,
+                       unsigned int w, const CollisionRequest& request,
+                       FCL_REAL& sqrDistLowerBound) const {
+    assert(w < num_nodes);
+    typename Packet::Array lb;
+    unsigned int mask = 0;
+    sqrDistLowerBound = std::numeric_limits<FCL_REAL>::infinity();
+    for (unsigned int p = 0; p < packetsPerNode(); ++p) {
+      const Packet& packet = packets[w * packetsPerNode() + p];
+      if (packet.size == 0) break;
+      const unsigned int m =
+          fcl::overlap(R, T, bv, packet, request, lb);
+      for (int k = 0; k < packet.size; ++k)
+        if (!(m & (1u << k)) && lb[k] < sqrDistLowerBound)
+          sqrDistLowerBound = lb[k];
+      mask |= m << (p * PacketWidth);
+    }
+    return mask;
+  }
+
+  /// @brief Memory used by the wide hierarchy, in bytes.
+  std::size_t memUsage() const {
+    return sizeof(WideBVH) + packets.size() * sizeof(Packet) +
+           children.size() * sizeof(int) +
+           binary_nodes.size() * sizeof(unsigned int);
+  }
+
+ protected:
+  unsigned int packetsPerNode() const { return width_ / PacketWidth; }
+
+  unsigned int width_;
+  unsigned int num_nodes;
+
+  /// @brief The boxes of the children of node w are in
+  /// packets[w * packetsPerNode(), (w + 1) * packetsPerNode()).
+  packet_vector_t packets;
+
+  /// @brief children[w * width() + k] is the wide node of the k-th child of
+  /// node w, -1 for a leaf.
+  std::vector<int> children;
+
+  /// @brief binary_nodes[w * width() + k] is the node of the binary tree
+  /// corresponding to the k-th child of node w.
+  std::vector<unsigned int> binary_nodes;
+};
+
+/// @}
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_BVH_WIDE_H
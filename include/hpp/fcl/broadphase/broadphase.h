@@ -40,6 +40,7 @@
 #include "hpp/fcl/broadphase/broadphase_bruteforce.h"
 #include "hpp/fcl/broadphase/broadphase_SaP.h"
 #include "hpp/fcl/broadphase/broadphase_SSaP.h"
+#include "hpp/fcl/broadphase/broadphase_continuous_SSaP.h"
 #include "hpp/fcl/broadphase/broadphase_interval_tree.h"
 #include "hpp/fcl/broadphase/broadphase_spatialhash.h"
 
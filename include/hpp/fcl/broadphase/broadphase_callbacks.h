@@ -92,6 +92,29 @@ struct HPP_FCL_DLLAPI DistanceCallBackBase {
   }
 };
 
+/// @brief Base callback class for continuous collision queries.
+struct HPP_FCL_DLLAPI ContinuousCollisionCallBackBase {
+  /// @brief Initialization of the callback before running the collision
+  /// broadphase manager.
+  virtual void init() {};
+
+  /// @brief Continuous collision evaluation between two objects whose swept
+  ///        AABBs overlap.
+  ///        This callback will cause the broadphase evaluation to stop if it
+  ///        returns true.
+  ///
+  /// @param[in] o1 Continuous collision object #1.
+  /// @param[in] o2 Continuous collision object #2.
+  virtual bool collide(ContinuousCollisionObject* o1,
+                       ContinuousCollisionObject* o2) = 0;
+
+  /// @brief Functor call associated to the collide operation.
+  virtual bool operator()(ContinuousCollisionObject* o1,
+                          ContinuousCollisionObject* o2) {
+    return collide(o1, o2);
+  }
+};
+
 }  // namespace fcl
 }  // namespace hpp
 
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_BROADPHASE_CONTINUOUS_SSAP_H
+#define HPP_FCL_BROADPHASE_CONTINUOUS_SSAP_H
+
+#include "hpp/fcl/broadphase/broadphase_continuous_collision_manager.h"
+
+namespace hpp {
+namespace fcl {
+
+/// @brief Simple sweep and prune continuous collision manager.
+///
+/// The objects are sorted by the lower bound of their swept AABB along the
+/// axis where the AABBs are the most spread, and the pairs whose swept AABBs
+/// overlap are given to the callback.
+class HPP_FCL_DLLAPI SSaPContinuousCollisionManager
+    : public BroadPhaseContinuousCollisionManager {
+ public:
+  typedef BroadPhaseContinuousCollisionManager Base;
+  using Base::update;
+
+  SSaPContinuousCollisionManager();
+
+  /// @brief add one object to the manager
+  void registerObject(ContinuousCollisionObject* obj);
+
+  /// @brief remove one object from the manager
+  void unregisterObject(ContinuousCollisionObject* obj);
+
+  /// @brief initialize the manager, related with the specific type of manager
+  void setup();
+
+  /// @brief update the condition of manager, after the motions of the objects
+  /// have changed
+  void update();
+
+  /// @brief clear the manager
+  void clear();
+
+  /// @brief return the objects managed by the manager
+  void getObjects(std::vector<ContinuousCollisionObject*>& objs) const;
+
+  /// @brief perform collision test between one object and all the objects
+  /// belonging to the manager
+  void collide(ContinuousCollisionObject* obj,
+               ContinuousCollisionCallBackBase* callback) const;
+
+  /// @brief perform collision test for the objects belonging to the manager
+  /// (i.e., N^2 self collision)
+  void collide(ContinuousCollisionCallBackBase* callback) const;
+
+  /// @brief perform collision test with objects belonging to another manager
+  void collide(BroadPhaseContinuousCollisionManager* other_manager,
+               ContinuousCollisionCallBackBase* callback) const;
+
+  /// @brief whether the manager is empty
+  bool empty() const;
+
+  /// @brief the number of objects managed by the manager
+  size_t size() const;
+
+ protected:
+  /// @brief check collision between one object and the objects of the manager,
+  /// return value is whether stop is possible
+  bool collide_(ContinuousCollisionObject* obj,
+                ContinuousCollisionCallBackBase* callback) const;
+
+  /// @brief Objects sorted according to the lower bound of their AABB along
+  /// \c axis
+  std::vector<ContinuousCollisionObject*> objs;
+
+  /// @brief Sweep axis
+  int axis;
+
+  /// @brief tag about whether the environment is maintained suitably (i.e.,
+  /// objs is sorted correctly)
+  bool setup_;
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_BROADPHASE_CONTINUOUS_SSAP_H
@@ -46,6 +46,7 @@
 #include "hpp/fcl/shape/geometric_shapes.h"
 // #include "hpp/fcl/geometry/shape/utility.h"
 #include "hpp/fcl/broadphase/broadphase_collision_manager.h"
+#include "hpp/fcl/broadphase/default_broadphase_callbacks.h"
 #include "hpp/fcl/broadphase/detail/hierarchy_tree.h"
 
 namespace hpp {
@@ -111,6 +112,42 @@ class HPP_FCL_DLLAPI DynamicAABBTreeCollisionManager
   /// (i.e., N^2 self collision)
   void collide(CollisionCallBackBase* callback) const;
 
+  typedef std::pair<CollisionObject*, CollisionObject*> CollisionPair;
+
+  /// @brief collect the pairs of objects belonging to the manager whose
+  /// bounding volumes overlap (i.e., the pairs that the N^2 self collision
+  /// would pass to its callback).
+  ///
+  /// The tree traversal is split into independent subtree pair tasks which
+  /// are processed by \p num_threads threads. The pairs are returned in the
+  /// order in which collide(CollisionCallBackBase*) visits them.
+  ///
+  /// \param[out] pairs candidate pairs. Cleared first.
+  /// \param[in] num_threads number of threads. 0 means using all the
+  /// hardware threads.
+  void getCandidatePairs(std::vector<CollisionPair>& pairs,
+                         unsigned int num_threads = 0) const;
+
+  /// @brief perform collision test for the objects belonging to the manager
+  /// (i.e., N^2 self collision), running the narrowphase in parallel.
+  ///
+  /// The candidate pairs are first collected with getCandidatePairs. The
+  /// narrowphase is then run concurrently on all of them, each thread using
+  /// its own copy of `callback->data`. The per-pair results are finally
+  /// merged into `callback->data` in the order of the serial traversal, with
+  /// the same stopping rule as defaultCollisionFunction, so that the contacts
+  /// are identical to the ones computed by collide(CollisionCallBackBase*).
+  ///
+  /// \param[in,out] callback default callback holding the request. Its result
+  /// receives the merged contacts.
+  /// \param[in] num_threads number of threads. 0 means using all the
+  /// hardware threads.
+  ///
+  /// \note Contrary to the serial version, all the candidate pairs are tested
+  /// even if the request is satisfied by the first ones.
+  void collideParallel(CollisionCallBackDefault* callback,
+                       unsigned int num_threads = 0) const;
+
   /// @brief perform distance test for the objects belonging to the manager
   /// (i.e., N^2 self distance)
   void distance(DistanceCallBackBase* callback) const;
@@ -42,9 +42,7 @@
 #include "hpp/fcl/broadphase/broadphase_callbacks.h"
 #include "hpp/fcl/collision.h"
 #include "hpp/fcl/distance.h"
-// #include "hpp/fcl/narrowphase/continuous_collision.h"
-// #include "hpp/fcl/narrowphase/continuous_collision_request.h"
-// #include "hpp/fcl/narrowphase/continuous_collision_result.h"
+#include "hpp/fcl/narrowphase/continuous_collision.h"
 // #include "hpp/fcl/narrowphase/distance_request.h"
 // #include "hpp/fcl/narrowphase/distance_result.h"
 
@@ -118,54 +116,49 @@ struct DistanceData {
 bool defaultCollisionFunction(CollisionObject* o1, CollisionObject* o2,
                               void* data);
 
-/// @brief Collision data for use with the DefaultContinuousCollisionFunction.
-/// It stores the collision request and the result given by the collision
-/// algorithm (and stores the conclusion of whether further evaluation of the
-/// broadphase collision manager has been deemed unnecessary).
-// struct DefaultContinuousCollisionData {
-//   ContinuousCollisionRequest request;
-//   ContinuousCollisionResult result;
-//
-//   /// If `true`, requests that the broadphase evaluation stop.
-//   bool done{false};
-// };
+/// @brief Collision data for use with the defaultContinuousCollisionFunction.
+/// It stores the continuous collision request, the earliest contact found by
+/// the continuous collision algorithm and the pair of objects of this contact.
+struct DefaultContinuousCollisionData {
+  DefaultContinuousCollisionData() { clear(); }
+
+  /// @brief Continuous collision request
+  ContinuousCollisionRequest request;
+
+  /// @brief Result of the pair with the earliest time of contact
+  ContinuousCollisionResult result;
+
+  /// @brief Pair with the earliest time of contact, null if there is none
+  ContinuousCollisionObject* o1;
+  ContinuousCollisionObject* o2;
+
+  /// @brief Whether the collision iteration can stop
+  bool done;
+
+  /// @brief Clears the DefaultContinuousCollisionData
+  void clear() {
+    result.clear();
+    o1 = o2 = nullptr;
+    done = false;
+  }
+};
 
 /// @brief Provides a simple callback for the continuous collision query in the
-/// BroadPhaseCollisionManager. It assumes the `data` parameter is non-null and
-/// points to an instance of DefaultContinuousCollisionData. It simply invokes
-/// the `collide()` method on the culled pair of geometries and stores the
-/// results in the data's ContinuousCollisionResult instance.
-///
-/// This callback will never cause the broadphase evaluation to terminate early.
-/// However, if the `done` member of the DefaultContinuousCollisionData is set
-/// to true, this method will simply return without doing any computation.
+/// BroadPhaseContinuousCollisionManager. It assumes the `data` parameter is
+/// non-null and points to an instance of DefaultContinuousCollisionData. It
+/// simply invokes the continuous `collide()` on the culled pair of geometries
+/// and keeps the result with the earliest time of contact.
 ///
-/// For a given instance of DefaultContinuousCollisionData, if broadphase
-/// evaluation has already terminated (i.e.,
-/// DefaultContinuousCollisionFunction() returned `true`), subsequent
-/// invocations with the same instance of CollisionData will return
-/// immediately, requesting termination of broadphase evaluation (i.e., return
-/// `true`).
+/// This callback will cause the broadphase evaluation to stop when a contact
+/// is found at time 0, since no contact can be earlier.
 ///
 /// @param o1   The first object in the culled pair.
 /// @param o2   The second object in the culled pair.
-/// @param data A non-null pointer to a CollisionData instance.
-/// @return True if the broadphase evaluation should stop.
-/// @tparam S   The scalar type with which the computation will be performed.
-// bool DefaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
-//                                         ContinuousCollisionObject* o2,
-//                                         void* data) {
-//   assert(data != nullptr);
-//   auto* cdata = static_cast<DefaultContinuousCollisionData*>(data);
-//
-//   if (cdata->done) return true;
-//
-//   const ContinuousCollisionRequest& request = cdata->request;
-//   ContinuousCollisionResult& result = cdata->result;
-//   collide(o1, o2, request, result);
-//
-//   return cdata->done;
-// }
+/// @param data A non-null pointer to a DefaultContinuousCollisionData instance.
+/// @return `true` if the broadphase evaluation should stop.
+bool defaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
+                                        ContinuousCollisionObject* o2,
+                                        void* data);
 
 /// @brief Provides a simple callback for the distance query in the
 /// BroadPhaseCollisionManager. It assumes the `data` parameter is non-null and
@@ -220,6 +213,21 @@ struct HPP_FCL_DLLAPI DistanceCallBackDefault : DistanceCallBackBase {
   virtual ~DistanceCallBackDefault() {};
 };
 
+/// @brief Default continuous collision callback, which finds the earliest
+/// contact between the continuous collision objects.
+struct HPP_FCL_DLLAPI ContinuousCollisionCallBackDefault
+    : ContinuousCollisionCallBackBase {
+  /// @brief Initialize the callback.
+  /// Clears the result and sets the done boolean to false.
+  void init() { data.clear(); }
+
+  bool collide(ContinuousCollisionObject* o1, ContinuousCollisionObject* o2);
+
+  DefaultContinuousCollisionData data;
+
+  virtual ~ContinuousCollisionCallBackDefault() {};
+};
+
 /// @brief Collision callback to collect collision pairs potentially in contacts
 struct HPP_FCL_DLLAPI CollisionCallBackCollect : CollisionCallBackBase {
   typedef std::pair<CollisionObject*, CollisionObject*> CollisionPair;
@@ -45,6 +45,8 @@
 #include <hpp/fcl/collision_func_matrix.h>
 #include <hpp/fcl/timings.h>
 
+#include <vector>
+
 namespace hpp {
 namespace fcl {
 
@@ -55,6 +57,9 @@ namespace fcl {
 /// depth; otherwise only contact primitive id is returned), this function
 /// performs the collision between them.
 /// Return value is the number of contacts generated between the two objects.
+///
+/// This function may be called concurrently from several threads, on the same
+/// geometries, as long as each thread uses its own request and result.
 HPP_FCL_DLLAPI std::size_t collide(const CollisionObject* o1,
                                    const CollisionObject* o2,
                                    const CollisionRequest& request,
@@ -76,6 +81,24 @@ HPP_FCL_DLLAPI std::size_t collide(const CollisionGeometry* o1,
 ///   ComputeCollision calc_collision (o1, o2);
 ///   std::size_t ncontacts = calc_collision(tf1, tf2, request, result);
 /// \endcode
+///
+/// When the same pair has to be tested at many configurations, use
+/// ComputeCollision::batch, which spreads the queries over several threads.
+///
+/// For a pair of shapes queried with `GJKInitialGuess::CachedSimplex`, the
+/// object keeps the last simplex of GJK and starts the next query from its
+/// vertices placed at the new poses: along a trajectory with small steps, GJK
+/// then typically converges in one or two iterations.
+///
+/// For a pair of meshes queried with `QueryRequest::enable_front_list`, the
+/// object keeps the front of the traversal of their BVHs and restarts the
+/// next query from it, rather than from the roots.
+///
+/// operator() is not thread safe: it updates the internal GJKSolver and the
+/// front list. An object shared by several threads must be used under a lock
+/// held by the caller, so that its calls are serialized. To run the queries in
+/// parallel, give each thread its own copy of the object, or use
+/// ComputeCollision::batch.
 class HPP_FCL_DLLAPI ComputeCollision {
  public:
   /// @brief Default constructor from two Collision Geometries.
@@ -85,6 +108,34 @@ class HPP_FCL_DLLAPI ComputeCollision {
                          const CollisionRequest& request,
                          CollisionResult& result) const;
 
+  /// @brief Run the collision query for a batch of pairs of transforms.
+  ///
+  /// The i-th query tests the geometries placed at `tf1s[i]` and `tf2s[i]`
+  /// and stores its output in `results[i]`. Queries are distributed over
+  /// \p num_threads threads, each of them owning its own copy of the request
+  /// and its own GJKSolver, so `request` is never modified concurrently.
+  /// With `GJKInitialGuess::CachedGuess` or `GJKInitialGuess::CachedSimplex`,
+  /// each worker warm-starts a query from the previous query it has
+  /// processed; `request` itself is left untouched.
+  ///
+  /// \param[in] tf1s placements of the first geometry.
+  /// \param[in] tf2s placements of the second geometry. Must have the same
+  /// size as \p tf1s.
+  /// \param[in] request collision request shared by all the queries.
+  /// \param[out] results one result per query. Resized if needed.
+  /// \param[in] num_threads number of threads. 0 means using all the
+  /// hardware threads.
+  /// \return the number of queries which found a collision.
+  ///
+  /// \note Contrary to ComputeCollision::operator(), this method does not
+  /// call the (possibly overloaded) virtual method ComputeCollision::run, nor
+  /// use the front list.
+  std::size_t batch(const std::vector<Transform3f>& tf1s,
+                    const std::vector<Transform3f>& tf2s,
+                    const CollisionRequest& request,
+                    std::vector<CollisionResult>& results,
+                    unsigned int num_threads = 0) const;
+
   bool operator==(const ComputeCollision& other) const {
     return o1 == other.o1 && o2 == other.o2 && solver == other.solver;
   }
@@ -105,7 +156,12 @@ class HPP_FCL_DLLAPI ComputeCollision {
 
   mutable GJKSolver solver;
 
+  /// @brief The front of the last query between two meshes, when
+  /// `QueryRequest::enable_front_list` is set.
+  mutable BVHFrontList front_list;
+
   CollisionFunctionMatrix::CollisionFunc func;
+  CollisionFunctionMatrix::BVHFrontCollisionFunc front_func;
   bool swap_geoms;
 
   virtual std::size_t run(const Transform3f& tf1, const Transform3f& tf2,
@@ -178,6 +178,9 @@ struct HPP_FCL_DLLAPI QueryRequest {
   bool enable_cached_gjk_guess;
 
   /// @brief the gjk initial guess set by user
+  /// @note With `GJKInitialGuess::CachedGuess`, every query writes here the
+  /// guess used to warm-start the next one. A request using this option must
+  /// therefore not be shared by queries running concurrently.
   mutable Vec3f cached_gjk_guess;
 
   /// @brief the support function initial guess set by user
@@ -217,6 +220,12 @@ struct HPP_FCL_DLLAPI QueryRequest {
   /// @brief threshold below which a collision is considered.
   FCL_REAL collision_distance_threshold;
 
+  /// @brief whether ComputeCollision and ComputeDistance keep the front of the
+  /// traversal of the BVHs of two meshes, to restart the next query from it.
+  /// This speeds up the queries along smooth trajectories. The models must
+  /// not be rebuilt between the queries.
+  bool enable_front_list;
+
   HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
   HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
   /// @brief Default constructor.
@@ -234,7 +243,8 @@ struct HPP_FCL_DLLAPI QueryRequest {
         epa_tolerance(EPA_DEFAULT_TOLERANCE),
         enable_timings(false),
         collision_distance_threshold(
-            Eigen::NumTraits<FCL_REAL>::dummy_precision()) {}
+            Eigen::NumTraits<FCL_REAL>::dummy_precision()),
+        enable_front_list(false) {}
 
   /// @brief Copy  constructor.
   QueryRequest(const QueryRequest& other) = default;
@@ -247,7 +257,8 @@ struct HPP_FCL_DLLAPI QueryRequest {
   /// warm-start it when reusing this collision request on the same collision
   /// pair.
   /// @note The option `gjk_initial_guess` must be set to
-  /// `GJKInitialGuess::CachedGuess` for this to work.
+  /// `GJKInitialGuess::CachedGuess` or `GJKInitialGuess::CachedSimplex` for
+  /// this to work.
   void updateGuess(const QueryResult& result) const;
 
   /// @brief whether two QueryRequest are the same or not
@@ -267,7 +278,9 @@ struct HPP_FCL_DLLAPI QueryRequest {
            epa_max_iterations == other.epa_max_iterations &&
            epa_tolerance == other.epa_tolerance &&
            enable_timings == other.enable_timings &&
-           collision_distance_threshold == other.collision_distance_threshold;
+           collision_distance_threshold ==
+               other.collision_distance_threshold &&
+           enable_front_list == other.enable_front_list;
     HPP_FCL_COMPILER_DIAGNOSTIC_POP
   }
 };
@@ -292,6 +305,7 @@ inline void QueryRequest::updateGuess(const QueryResult& result) const {
   HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
   HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
   if (gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+      gjk_initial_guess == GJKInitialGuess::CachedSimplex ||
       enable_cached_gjk_guess) {
     cached_gjk_guess = result.cached_gjk_guess;
     cached_support_func_guess = result.cached_support_func_guess;
@@ -363,6 +377,12 @@ struct HPP_FCL_DLLAPI CollisionRequest : QueryRequest {
         security_margin(0),
         break_distance(1e-3),
         distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()) {}
+
+  /// @brief Copy constructor.
+  CollisionRequest(const CollisionRequest& other) = default;
+
+  /// @brief Copy assignment operator.
+  CollisionRequest& operator=(const CollisionRequest& other) = default;
   HPP_FCL_COMPILER_DIAGNOSTIC_POP
 
   bool isSatisfied(const CollisionResult& result) const;
@@ -1015,6 +1035,13 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
   FCL_REAL rel_err;  // relative error, between 0 and 1
   FCL_REAL abs_err;  // absolute error
 
+  /// @brief whether to compute the derivatives of the distance and of the
+  /// nearest points with respect to the poses of the objects, in
+  /// `DistanceResult::dmin_distance_dtf` and
+  /// `DistanceResult::dnearest_points_dtf`.
+  /// See computeDistanceDerivatives.
+  bool enable_derivatives;
+
   /// \param enable_nearest_points_ enables the nearest points computation.
   /// \param enable_signed_distance_ allows to compute the penetration depth
   /// \param rel_err_
@@ -1027,13 +1054,15 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
       : enable_nearest_points(enable_nearest_points_),
         enable_signed_distance(enable_signed_distance_),
         rel_err(rel_err_),
-        abs_err(abs_err_) {}
+        abs_err(abs_err_),
+        enable_derivatives(false) {}
   HPP_FCL_COMPILER_DIAGNOSTIC_POP
 
   bool isSatisfied(const DistanceResult& result) const;
 
   HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
   HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
+  DistanceRequest(const DistanceRequest& other) = default;
   DistanceRequest& operator=(const DistanceRequest& other) = default;
   HPP_FCL_COMPILER_DIAGNOSTIC_POP
 
@@ -1044,7 +1073,8 @@ struct HPP_FCL_DLLAPI DistanceRequest : QueryRequest {
     return QueryRequest::operator==(other) &&
            enable_nearest_points == other.enable_nearest_points &&
            enable_signed_distance == other.enable_signed_distance &&
-           rel_err == other.rel_err && abs_err == other.abs_err;
+           rel_err == other.rel_err && abs_err == other.abs_err &&
+           enable_derivatives == other.enable_derivatives;
     HPP_FCL_COMPILER_DIAGNOSTIC_POP
   }
 };
@@ -1087,12 +1117,43 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
   /// @brief invalid contact primitive information
   static const int NONE = -1;
 
+  /// @brief Derivatives with respect to the poses of the two objects.
+  /// The first 6 columns are relative to the displacement
+  /// \f$ tf_1 \exp(v) \f$ of the first object, where \f$ v \f$ stacks the
+  /// linear and the angular velocity expressed in the frame of the first
+  /// object. The last 6 columns are relative to the same displacement of the
+  /// second object. They are not aligned, so that DistanceResult can be
+  /// stored in standard containers.
+  typedef Eigen::Matrix<FCL_REAL, 1, 12, Eigen::RowMajor | Eigen::DontAlign>
+      DistanceDerivative;
+  typedef Eigen::Matrix<FCL_REAL, 3, 12, Eigen::DontAlign> PointDerivative;
+
+  /// @brief derivative of min_distance with respect to the poses of the
+  /// objects, computed when DistanceRequest::enable_derivatives is set.
+  /// @note clear() leaves the derivatives unchanged: they are only written by
+  /// the queries which request them.
+  DistanceDerivative dmin_distance_dtf;
+
+  /// @brief derivatives of the nearest points with respect to the poses of
+  /// the objects, computed when DistanceRequest::enable_derivatives is set
+  /// and the nearest points lie on primitive shapes or triangles.
+  std::array<PointDerivative, 2> dnearest_points_dtf;
+
   DistanceResult(
       FCL_REAL min_distance_ = (std::numeric_limits<FCL_REAL>::max)())
       : min_distance(min_distance_), o1(NULL), o2(NULL), b1(NONE), b2(NONE) {
     const Vec3f nan(
         Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN()));
     nearest_points[0] = nearest_points[1] = normal = nan;
+    clearDerivatives();
+  }
+
+  /// @brief set the derivatives to NaN
+  void clearDerivatives() {
+    const FCL_REAL nan = std::numeric_limits<FCL_REAL>::quiet_NaN();
+    dmin_distance_dtf.setConstant(nan);
+    dnearest_points_dtf[0].setConstant(nan);
+    dnearest_points_dtf[1].setConstant(nan);
   }
 
   /// @brief add distance information into the result
@@ -1134,6 +1195,8 @@ struct HPP_FCL_DLLAPI DistanceResult : QueryResult {
       nearest_points[0] = other_result.nearest_points[0];
       nearest_points[1] = other_result.nearest_points[1];
       normal = other_result.normal;
+      dmin_distance_dtf = other_result.dmin_distance_dtf;
+      dnearest_points_dtf = other_result.dnearest_points_dtf;
     }
   }
 
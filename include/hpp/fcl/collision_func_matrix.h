@@ -41,6 +41,7 @@
 #include <hpp/fcl/collision_object.h>
 #include <hpp/fcl/collision_data.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/BVH/BVH_front.h>
 
 namespace hpp {
 namespace fcl {
@@ -70,6 +71,21 @@ struct HPP_FCL_DLLAPI CollisionFunctionMatrix {
   /// between objects of type1 and type2
   CollisionFunc collision_matrix[NODE_COUNT][NODE_COUNT];
 
+  /// @brief the call interface for collision between two BVH models which
+  /// restarts the traversal from \p front_list, the front of the previous
+  /// query between them, and updates it.
+  typedef std::size_t (*BVHFrontCollisionFunc)(const CollisionGeometry* o1,
+                                               const Transform3f& tf1,
+                                               const CollisionGeometry* o2,
+                                               const Transform3f& tf2,
+                                               const CollisionRequest& request,
+                                               CollisionResult& result,
+                                               BVHFrontList& front_list);
+
+  /// @brief the functions using a front list, for the pairs of BVH models of
+  /// the same type. NULL for the other pairs.
+  BVHFrontCollisionFunc front_collision_matrix[NODE_COUNT][NODE_COUNT];
+
   CollisionFunctionMatrix();
 };
 
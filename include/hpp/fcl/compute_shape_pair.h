@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_COMPUTE_SHAPE_PAIR_H
+#define HPP_FCL_COMPUTE_SHAPE_PAIR_H
+
+#include <limits>
+#include <type_traits>
+
+#include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/timings.h>
+#include <hpp/fcl/internal/shape_shape_func.h>
+#include <hpp/fcl/internal/traversal_node_bvh_shape.h>
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/internal/traversal_recurse.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief ComputeCollision for a pair of shapes whose types are known at
+/// compile time.
+///
+/// \code
+///   ComputeCollisionT<Capsule, Box> calc_collision (&capsule, &box);
+///   std::size_t ncontacts = calc_collision(tf1, tf2, request, result);
+/// \endcode
+///
+/// The query calls ShapeShapeCollide<S1, S2> directly, where ComputeCollision
+/// goes through the collision function matrix, its virtual `run` and the swap
+/// of the geometries: the specialized algorithm of the pair, or
+/// GJKSolver::shapeDistance, is inlined in operator(). The iterations of GJK
+/// run on the MinkowskiDiffT of the pair, whose support functions are
+/// inlined; EPA still calls them through MinkowskiDiff. The results are those
+/// of ComputeCollision.
+///
+/// S1 and S2 are primitive shapes, ShapeBase excluded, for which `collide` is
+/// implemented. ComputeCollisionT<BVHModel<BV>, S> handles a mesh and a
+/// primitive shape. As for ComputeCollision, operator() updates the internal
+/// GJKSolver: use one object per thread.
+template <typename S1, typename S2>
+class ComputeCollisionT {
+ public:
+  static_assert(std::is_base_of<ShapeBase, S1>::value &&
+                    !std::is_same<ShapeBase, S1>::value &&
+                    std::is_base_of<ShapeBase, S2>::value &&
+                    !std::is_same<ShapeBase, S2>::value,
+                "ComputeCollisionT only takes primitive shapes.");
+
+  ComputeCollisionT(const S1* o1, const S2* o2) : o1(o1), o2(o2) {
+    solver.keep_simplex_cached_guess = true;
+  }
+
+  std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
+                         const CollisionRequest& request,
+                         CollisionResult& result) const {
+    solver.set(request);
+
+    std::size_t res;
+    if (request.enable_timings) {
+      Timer timer;
+      res = run(tf1, tf2, request, result);
+      result.timings = timer.elapsed();
+    } else
+      res = run(tf1, tf2, request, result);
+    return res;
+  }
+
+ protected:
+  const S1* o1;
+  const S2* o2;
+
+  mutable GJKSolver solver;
+
+  std::size_t run(const Transform3f& tf1, const Transform3f& tf2,
+                  const CollisionRequest& request,
+                  CollisionResult& result) const {
+    // If security margin is set to -infinity, return that there is no
+    // collision
+    if (request.security_margin ==
+        -std::numeric_limits<FCL_REAL>::infinity()) {
+      result.clear();
+      return false;
+    }
+    const std::size_t res = ShapeShapeCollide<S1, S2>(o1, tf1, o2, tf2,
+                                                      &solver, request, result);
+    result.cached_gjk_guess = solver.cached_guess;
+    result.cached_support_func_guess = solver.support_func_cached_guess;
+    request.updateGuess(result);
+    return res;
+  }
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief ComputeCollisionT for a mesh and a primitive shape.
+///
+/// \code
+///   ComputeCollisionT<BVHModel<OBBRSS>, Box> calc_collision (&mesh, &box);
+/// \endcode
+///
+/// The hierarchy of the mesh is traversed by collisionRecurseT, which calls
+/// the tests of MeshShapeCollisionTraversalNode<BV, S> without virtual
+/// dispatch, and each triangle is tested against the shape by GJK on
+/// MinkowskiDiffT<TriangleP, S>. The results are those of ComputeCollision.
+/// The front list and the compressed hierarchies are not supported.
+template <typename BV, typename S>
+class ComputeCollisionT<BVHModel<BV>, S> {
+ public:
+  static_assert(std::is_base_of<ShapeBase, S>::value &&
+                    !std::is_same<ShapeBase, S>::value,
+                "ComputeCollisionT only takes a mesh and a primitive shape.");
+
+  ComputeCollisionT(const BVHModel<BV>* o1, const S* o2) : o1(o1), o2(o2) {}
+
+  std::size_t operator()(const Transform3f& tf1, const Transform3f& tf2,
+                         const CollisionRequest& request,
+                         CollisionResult& result) const {
+    solver.set(request);
+
+    std::size_t res;
+    if (request.enable_timings) {
+      Timer timer;
+      res = run(tf1, tf2, request, result);
+      result.timings = timer.elapsed();
+    } else
+      res = run(tf1, tf2, request, result);
+    return res;
+  }
+
+ protected:
+  const BVHModel<BV>* o1;
+  const S* o2;
+
+  mutable GJKSolver solver;
+
+  std::size_t run(const Transform3f& tf1, const Transform3f& tf2,
+                  const CollisionRequest& request,
+                  CollisionResult& result) const {
+    // If security margin is set to -infinity, return that there is no
+    // collision
+    if (request.security_margin ==
+        -std::numeric_limits<FCL_REAL>::infinity()) {
+      result.clear();
+      return false;
+    }
+    if (request.isSatisfied(result)) return result.numContacts();
+    if (request.security_margin < 0)
+      HPP_FCL_THROW_PRETTY(
+          "Negative security margin are not handled yet for BVHModel",
+          std::invalid_argument);
+
+    MeshShapeCollisionTraversalNode<BV, S, 0> node(request);
+    initialize(node, *o1, tf1, *o2, tf2, &solver, result);
+    FCL_REAL sqrDistLowerBound = 0;
+    collisionRecurseT(node, 0, 0, sqrDistLowerBound);
+
+    result.cached_gjk_guess = solver.cached_guess;
+    result.cached_support_func_guess = solver.support_func_cached_guess;
+    request.updateGuess(result);
+    return result.numContacts();
+  }
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief ComputeDistance for a pair of shapes whose types are known at
+/// compile time.
+///
+/// See ComputeCollisionT.
+template <typename S1, typename S2>
+class ComputeDistanceT {
+ public:
+  static_assert(std::is_base_of<ShapeBase, S1>::value &&
+                    !std::is_same<ShapeBase, S1>::value &&
+                    std::is_base_of<ShapeBase, S2>::value &&
+                    !std::is_same<ShapeBase, S2>::value,
+                "ComputeDistanceT only takes primitive shapes.");
+
+  ComputeDistanceT(const S1* o1, const S2* o2) : o1(o1), o2(o2) {
+    solver.keep_simplex_cached_guess = true;
+  }
+
+  FCL_REAL operator()(const Transform3f& tf1, const Transform3f& tf2,
+                      const DistanceRequest& request,
+                      DistanceResult& result) const {
+    solver.set(request);
+
+    FCL_REAL res;
+    if (request.enable_timings) {
+      Timer timer;
+      res = run(tf1, tf2, request, result);
+      result.timings = timer.elapsed();
+    } else
+      res = run(tf1, tf2, request, result);
+    return res;
+  }
+
+ protected:
+  const S1* o1;
+  const S2* o2;
+
+  mutable GJKSolver solver;
+
+  FCL_REAL run(const Transform3f& tf1, const Transform3f& tf2,
+               const DistanceRequest& request, DistanceResult& result) const {
+    const FCL_REAL res = ShapeShapeDistance<S1, S2>(o1, tf1, o2, tf2, &solver,
+                                                    request, result);
+    if (request.enable_derivatives)
+      internal::computeDistanceDerivatives(o1, tf1, o2, tf2, &solver, request,
+                                           result);
+    result.cached_gjk_guess = solver.cached_guess;
+    result.cached_support_func_guess = solver.support_func_cached_guess;
+    request.updateGuess(result);
+    return res;
+  }
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_COMPUTE_SHAPE_PAIR_H
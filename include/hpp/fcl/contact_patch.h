@@ -75,6 +75,8 @@ HPP_FCL_DLLAPI void computeContactPatch(const CollisionObject* o1,
 ///   ComputeContactPatch calc_patch (o1, o2);
 ///   calc_patch(tf1, tf2, collision_result, patch_request, patch_result);
 /// \endcode
+///
+/// See ComputeCollision for the thread safety of operator().
 class HPP_FCL_DLLAPI ComputeContactPatch {
  public:
   /// @brief Default constructor from two Collision Geometries.
@@ -412,12 +412,12 @@ inline Vec2f ContactPatchSolver::computeLineSegmentIntersection(
   const Vec2f ab = b - a;
   const Vec2f n(-ab(1), ab(0));
   const FCL_REAL denominator = n.dot(c - d);
-  if (std::abs(denominator) < std::numeric_limits<double>::epsilon()) {
+  if (std::abs(denominator) < std::numeric_limits<FCL_REAL>::epsilon()) {
     return d;
   }
   const FCL_REAL nominator = n.dot(a - d);
   FCL_REAL alpha = nominator / denominator;
-  alpha = std::min<double>(1.0, std::max<FCL_REAL>(0.0, alpha));
+  alpha = std::min<FCL_REAL>(1.0, std::max<FCL_REAL>(0.0, alpha));
   return alpha * c + (1 - alpha) * d;
 }
 
@@ -63,7 +63,18 @@ namespace hpp {
 
 namespace hpp {
 namespace fcl {
+/// @brief The scalar type of the library, double by default. The macro
+/// HPP_FCL_USE_FLOAT makes it float: the vertices, bounding volumes and GJK /
+/// EPA computations take half the memory, at the cost of precision. The
+/// CMake option HPP_FCL_BUILD_FLOAT_LIBRARY builds the hpp-fcl-float library
+/// next to hpp-fcl, and the targets linking it get the macro. Both libraries
+/// define the same symbols with different layouts: a program, and the
+/// libraries it loads, must use only one of them.
+#ifdef HPP_FCL_USE_FLOAT
+typedef float FCL_REAL;
+#else
 typedef double FCL_REAL;
+#endif
 typedef Eigen::Matrix<FCL_REAL, 3, 1> Vec3f;
 typedef Eigen::Matrix<FCL_REAL, 2, 1> Vec2f;
 typedef Eigen::Matrix<FCL_REAL, 6, 1> Vec6f;
@@ -80,9 +91,17 @@ typedef Eigen::Vector2i support_func_guess_t;
 /// DefaultGuess: Vec3f(1, 0, 0)
 /// CachedGuess: previous vector found by GJK or guess cached by the user
 /// BoundingVolumeGuess: guess using the centers of the shapes' AABB
+/// CachedSimplex: as CachedGuess, and for pairs of shapes queried through
+/// ComputeCollision or ComputeDistance, GJK starts from its previous simplex
+/// placed at the new poses of the shapes
 /// WARNING: to use BoundingVolumeGuess, computeLocalAABB must have been called
 /// on the two shapes.
-enum GJKInitialGuess { DefaultGuess, CachedGuess, BoundingVolumeGuess };
+enum GJKInitialGuess {
+  DefaultGuess,
+  CachedGuess,
+  BoundingVolumeGuess,
+  CachedSimplex
+};
 
 /// @brief Variant to use for the GJK algorithm
 enum GJKVariant { DefaultGJK, PolyakAcceleration, NesterovAcceleration };
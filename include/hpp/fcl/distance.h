@@ -43,6 +43,8 @@
 #include <hpp/fcl/distance_func_matrix.h>
 #include <hpp/fcl/timings.h>
 
+#include <vector>
+
 namespace hpp {
 namespace fcl {
 
@@ -64,6 +66,45 @@ HPP_FCL_DLLAPI FCL_REAL distance(const CollisionGeometry* o1,
                                  const DistanceRequest& request,
                                  DistanceResult& result);
 
+/// @brief Computes the derivatives of the distance and of the nearest points
+/// with respect to the poses of the objects (see
+/// DistanceResult::DistanceDerivative), from \p result, the result of the
+/// distance query between \p o1 at \p tf1 and \p o2 at \p tf2.
+///
+/// The variation of the distance is the relative velocity of the nearest
+/// points along the normal: its derivative only depends on them and on the
+/// normal, and is computed for all the geometries.
+///
+/// The nearest points are the projection of the origin onto the final simplex
+/// of GJK, or onto the final face of EPA when the objects are in collision:
+/// their derivatives are obtained by moving the vertices of this simplex with
+/// the objects. For meshes, the simplex is the one of the closest triangles,
+/// `result.b1` and `result.b2`. The derivatives are exact for polytopes,
+/// spheres and capsules and neglect the curvature of the other shapes. They
+/// are not unique when the features in contact are parallel, e.g. two
+/// parallel faces, and are set to NaN for height fields and octrees.
+///
+/// The distance queries call this function when
+/// DistanceRequest::enable_derivatives is set. For pairs of shapes, they then
+/// reuse the final simplex of their own GJK and EPA, while this function runs
+/// them again.
+HPP_FCL_DLLAPI void computeDistanceDerivatives(const CollisionGeometry* o1,
+                                               const Transform3f& tf1,
+                                               const CollisionGeometry* o2,
+                                               const Transform3f& tf2,
+                                               const DistanceRequest& request,
+                                               DistanceResult& result);
+
+namespace internal {
+/// @brief computeDistanceDerivatives using the final simplex of \p solver,
+/// if not null, when its last run was between \p o1 and \p o2.
+HPP_FCL_DLLAPI void computeDistanceDerivatives(
+    const CollisionGeometry* o1, const Transform3f& tf1,
+    const CollisionGeometry* o2, const Transform3f& tf2,
+    const GJKSolver* solver, const DistanceRequest& request,
+    DistanceResult& result);
+}  // namespace internal
+
 /// This class reduces the cost of identifying the geometry pair.
 /// This is mostly useful for repeated shape-shape queries.
 ///
@@ -71,6 +112,13 @@ HPP_FCL_DLLAPI FCL_REAL distance(const CollisionGeometry* o1,
 ///   ComputeDistance calc_distance (o1, o2);
 ///   FCL_REAL distance = calc_distance(tf1, tf2, request, result);
 /// \endcode
+///
+/// When the same pair has to be evaluated at many configurations, use
+/// ComputeDistance::batch, which spreads the queries over several threads.
+///
+/// See ComputeCollision for the warm start by `GJKInitialGuess::CachedSimplex`
+/// or `QueryRequest::enable_front_list`, and for the thread safety of
+/// operator().
 class HPP_FCL_DLLAPI ComputeDistance {
  public:
   ComputeDistance(const CollisionGeometry* o1, const CollisionGeometry* o2);
@@ -79,6 +127,24 @@ class HPP_FCL_DLLAPI ComputeDistance {
                       const DistanceRequest& request,
                       DistanceResult& result) const;
 
+  /// @brief Run the distance query for a batch of pairs of transforms.
+  ///
+  /// See ComputeCollision::batch for the threading model. The front list is
+  /// not used.
+  ///
+  /// \param[in] tf1s placements of the first geometry.
+  /// \param[in] tf2s placements of the second geometry. Must have the same
+  /// size as \p tf1s.
+  /// \param[in] request distance request shared by all the queries.
+  /// \param[out] results one result per query. Resized if needed.
+  /// \param[in] num_threads number of threads. 0 means using all the
+  /// hardware threads.
+  void batch(const std::vector<Transform3f>& tf1s,
+             const std::vector<Transform3f>& tf2s,
+             const DistanceRequest& request,
+             std::vector<DistanceResult>& results,
+             unsigned int num_threads = 0) const;
+
   bool operator==(const ComputeDistance& other) const {
     return o1 == other.o1 && o2 == other.o2 && swap_geoms == other.swap_geoms &&
            solver == other.solver && func == other.func;
@@ -100,7 +166,12 @@ class HPP_FCL_DLLAPI ComputeDistance {
 
   mutable GJKSolver solver;
 
+  /// @brief The front of the last query between two meshes, when
+  /// `QueryRequest::enable_front_list` is set.
+  mutable BVHFrontList front_list;
+
   DistanceFunctionMatrix::DistanceFunc func;
+  DistanceFunctionMatrix::BVHFrontDistanceFunc front_func;
   bool swap_geoms;
 
   virtual FCL_REAL run(const Transform3f& tf1, const Transform3f& tf2,
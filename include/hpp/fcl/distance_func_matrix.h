@@ -41,6 +41,7 @@
 #include <hpp/fcl/collision_object.h>
 #include <hpp/fcl/collision_data.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/BVH/BVH_front.h>
 
 namespace hpp {
 namespace fcl {
@@ -67,6 +68,21 @@ struct HPP_FCL_DLLAPI DistanceFunctionMatrix {
   /// between objects of type1 and type2
   DistanceFunc distance_matrix[NODE_COUNT][NODE_COUNT];
 
+  /// @brief the call interface for distance between two BVH models which
+  /// restarts the traversal from \p front_list, the front of the previous
+  /// query between them, and updates it.
+  typedef FCL_REAL (*BVHFrontDistanceFunc)(const CollisionGeometry* o1,
+                                           const Transform3f& tf1,
+                                           const CollisionGeometry* o2,
+                                           const Transform3f& tf2,
+                                           const DistanceRequest& request,
+                                           DistanceResult& result,
+                                           BVHFrontList& front_list);
+
+  /// @brief the functions using a front list, for the pairs of BVH models of
+  /// the same type. NULL for the other pairs.
+  BVHFrontDistanceFunc front_distance_matrix[NODE_COUNT][NODE_COUNT];
+
   DistanceFunctionMatrix();
 };
 
@@ -81,7 +81,7 @@
 #else
 #define HPP_FCL_ASSERT(check, message, exception) \
   {                                               \
-    HPP_FCL_UNUSED_VARIABLE(exception(message));  \
+    HPP_FCL_UNUSED_VARIABLE(sizeof(exception));   \
     assert((check) && message);                   \
   }
 #endif
@@ -132,6 +132,7 @@ using std::shared_ptr;
 class CollisionObject;
 typedef shared_ptr<CollisionObject> CollisionObjectPtr_t;
 typedef shared_ptr<const CollisionObject> CollisionObjectConstPtr_t;
+class ContinuousCollisionObject;
 class CollisionGeometry;
 typedef shared_ptr<CollisionGeometry> CollisionGeometryPtr_t;
 typedef shared_ptr<const CollisionGeometry> CollisionGeometryConstPtr_t;
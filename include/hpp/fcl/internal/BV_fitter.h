@@ -76,6 +76,13 @@ void fit<AABB>(Vec3f* ps, unsigned int n, AABB& bv);
 template <typename BV>
 class HPP_FCL_DLLAPI BVFitterTpl {
  public:
+  BVFitterTpl()
+      : vertices(NULL),
+        prev_vertices(NULL),
+        tri_indices(NULL),
+        type(BVH_MODEL_UNKNOWN),
+        num_threads(1) {}
+
   /// @brief default deconstructor
   virtual ~BVFitterTpl() {}
 
@@ -97,6 +104,10 @@ class HPP_FCL_DLLAPI BVFitterTpl {
     type = type_;
   }
 
+  /// @brief Set the number of threads used to fit a BV to a large set of
+  /// primitives. The fitted BV does not depend on it.
+  void setNumThreads(unsigned int num_threads_) { num_threads = num_threads_; }
+
   /// @brief Compute the fitting BV
   virtual BV fit(unsigned int* primitive_indices,
                  unsigned int num_primitives) = 0;
@@ -107,6 +118,7 @@ class HPP_FCL_DLLAPI BVFitterTpl {
     prev_vertices = NULL;
     tri_indices = NULL;
     type = BVH_MODEL_UNKNOWN;
+    num_threads = 1;
   }
 
  protected:
@@ -114,6 +126,7 @@ class HPP_FCL_DLLAPI BVFitterTpl {
   Vec3f* prev_vertices;
   Triangle* tri_indices;
   BVHModelType type;
+  unsigned int num_threads;
 };
 
 /// @brief The class for the default algorithm fitting a bounding volume to a
@@ -47,13 +47,37 @@
 namespace hpp {
 namespace fcl {
 
-/// @brief Three types of split algorithms are provided in FCL as default
+/// @brief Four types of split algorithms are provided in FCL as default
 enum SplitMethodType {
   SPLIT_METHOD_MEAN,
   SPLIT_METHOD_MEDIAN,
-  SPLIT_METHOD_BV_CENTER
+  SPLIT_METHOD_BV_CENTER,
+  /// Binned surface area heuristic: minimize the surface area of the boxes of
+  /// the two halves weighted by their number of primitives.
+  SPLIT_METHOD_SAH
 };
 
+namespace details {
+/// @brief Binned surface area heuristic split.
+///
+/// The centroids of the primitives are projected on each column of \p axes
+/// and sorted into bins. The boundary of bins minimizing
+/// \f$ A_l n_l + A_r n_r \f$ is selected, where \f$ A \f$ is the surface
+/// area of the box, aligned with \p axes, of the primitives of one side and
+/// \f$ n \f$ their number.
+/// @retval axis the column of \p axes along which to split,
+/// @retval split_value the primitives whose centroid projection is greater
+///         go to the right child.
+/// @return false if the centroids are all at the same place.
+HPP_FCL_DLLAPI bool computeSplit_sah(const Matrix3f& axes,
+                                     const Vec3f* vertices,
+                                     const Triangle* triangles,
+                                     const unsigned int* primitive_indices,
+                                     unsigned int num_primitives,
+                                     BVHModelType type, int& axis,
+                                     FCL_REAL& split_value);
+}  // namespace details
+
 /// @brief A class describing the split rule that splits each BV node
 template <typename BV>
 class BVSplitter {
@@ -85,6 +109,9 @@ class BVSplitter {
       case SPLIT_METHOD_BV_CENTER:
         computeRule_bvcenter(bv, primitive_indices, num_primitives);
         break;
+      case SPLIT_METHOD_SAH:
+        computeRule_sah(bv, primitive_indices, num_primitives);
+        break;
       default:
         std::cerr << "Split method not supported" << std::endl;
     }
@@ -205,6 +232,16 @@ class BVSplitter {
           (proj[num_primitives / 2] + proj[num_primitives / 2 - 1]) / 2;
     }
   }
+
+  /// @brief Split algorithm 4: Split the node according to the binned surface
+  /// area heuristic along the world axes
+  void computeRule_sah(const BV& bv, unsigned int* primitive_indices,
+                       unsigned int num_primitives) {
+    if (!details::computeSplit_sah(Matrix3f::Identity(), vertices, tri_indices,
+                                   primitive_indices, num_primitives, type,
+                                   split_axis, split_value))
+      computeRule_mean(bv, primitive_indices, num_primitives);
+  }
 };
 
 template <>
@@ -234,6 +271,11 @@ void HPP_FCL_DLLAPI BVSplitter<OBB>::computeRule_median(
     const OBB& bv, unsigned int* primitive_indices,
     unsigned int num_primitives);
 
+template <>
+void HPP_FCL_DLLAPI BVSplitter<OBB>::computeRule_sah(
+    const OBB& bv, unsigned int* primitive_indices,
+    unsigned int num_primitives);
+
 template <>
 void HPP_FCL_DLLAPI BVSplitter<RSS>::computeRule_bvcenter(
     const RSS& bv, unsigned int* primitive_indices,
@@ -249,6 +291,11 @@ void HPP_FCL_DLLAPI BVSplitter<RSS>::computeRule_median(
     const RSS& bv, unsigned int* primitive_indices,
     unsigned int num_primitives);
 
+template <>
+void HPP_FCL_DLLAPI BVSplitter<RSS>::computeRule_sah(
+    const RSS& bv, unsigned int* primitive_indices,
+    unsigned int num_primitives);
+
 template <>
 void HPP_FCL_DLLAPI BVSplitter<kIOS>::computeRule_bvcenter(
     const kIOS& bv, unsigned int* primitive_indices,
@@ -264,6 +311,11 @@ void HPP_FCL_DLLAPI BVSplitter<kIOS>::computeRule_median(
     const kIOS& bv, unsigned int* primitive_indices,
     unsigned int num_primitives);
 
+template <>
+void HPP_FCL_DLLAPI BVSplitter<kIOS>::computeRule_sah(
+    const kIOS& bv, unsigned int* primitive_indices,
+    unsigned int num_primitives);
+
 template <>
 void HPP_FCL_DLLAPI BVSplitter<OBBRSS>::computeRule_bvcenter(
     const OBBRSS& bv, unsigned int* primitive_indices,
@@ -279,6 +331,11 @@ void HPP_FCL_DLLAPI BVSplitter<OBBRSS>::computeRule_median(
     const OBBRSS& bv, unsigned int* primitive_indices,
     unsigned int num_primitives);
 
+template <>
+void HPP_FCL_DLLAPI BVSplitter<OBBRSS>::computeRule_sah(
+    const OBBRSS& bv, unsigned int* primitive_indices,
+    unsigned int num_primitives);
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_INTERNAL_PARALLEL_H
+#define HPP_FCL_INTERNAL_PARALLEL_H
+
+/// @cond INTERNAL
+
+#include <hpp/fcl/fwd.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hpp {
+namespace fcl {
+namespace internal {
+
+/// @brief Number of workers to use to process \p num_tasks tasks when
+/// \p num_threads threads are requested.
+/// A value of 0 for \p num_threads means "as many as the hardware supports".
+/// The result is always at least 1 and never greater than \p num_tasks.
+inline unsigned int getNumWorkers(unsigned int num_threads,
+                                  std::size_t num_tasks) {
+  if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+  if (num_threads == 0) num_threads = 1;
+  if (num_tasks < num_threads)
+    num_threads = (std::max)(1u, static_cast<unsigned int>(num_tasks));
+  return num_threads;
+}
+
+/// @brief Call `f(worker, i)` for every `i` in `[0, num_tasks)`, using
+/// \p num_workers threads (the calling thread being worker 0).
+///
+/// Tasks are handed out dynamically, one index at a time, so that workers
+/// which get cheap queries keep picking up new ones. `worker` is in
+/// `[0, num_workers)` and lets `f` index per-thread scratch data (solvers,
+/// results...) without any synchronization. The first exception thrown by `f`
+/// stops the distribution of new tasks and is rethrown in the calling thread.
+template <typename Function>
+void parallelFor(std::size_t num_tasks, unsigned int num_workers,
+                 Function f) {
+  if (num_tasks == 0) return;
+  if (num_workers <= 1) {
+    for (std::size_t i = 0; i < num_tasks; ++i) f(0u, i);
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto work = [&](unsigned int worker) {
+    try {
+      for (std::size_t i = next++; i < num_tasks; i = next++) f(worker, i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+      next = num_tasks;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for (unsigned int w = 1; w < num_workers; ++w)
+    threads.emplace_back(work, w);
+  work(0u);
+  for (std::size_t k = 0; k < threads.size(); ++k) threads[k].join();
+
+  if (error) std::rethrow_exception(error);
+}
+
+}  // namespace internal
+}  // namespace fcl
+}  // namespace hpp
+
+/// @endcond
+
+#endif  // HPP_FCL_INTERNAL_PARALLEL_H
@@ -43,6 +43,7 @@
 #include <hpp/fcl/data_types.h>
 #include <hpp/fcl/math/transform.h>
 #include <hpp/fcl/collision_data.h>
+#include <hpp/fcl/BV/AABB.h>
 
 namespace hpp {
 namespace fcl {
@@ -119,6 +120,56 @@ class CollisionTraversalNodeBase : public TraversalNodeBase {
   virtual void leafCollides(unsigned int /*b1*/, unsigned int /*b2*/,
                             FCL_REAL& /*sqrDistLowerBound*/) const = 0;
 
+  /// @brief Whether the traversal should use the wide hierarchy (see WideBVH)
+  /// of the first object.
+  virtual bool isFirstModelWide() const { return false; }
+
+  /// @brief BV test between node b2 of the second tree and all the children
+  /// of node w1 of the wide hierarchy of the first object.
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between b2 and the children which do not overlap it.
+  /// @return a bit mask whose bit k is set iff the k-th child overlaps b2.
+  virtual unsigned int BVOverlapsWide(unsigned int /*w1*/, unsigned int /*b2*/,
+                                      FCL_REAL& /*sqrDistLowerBound*/) const {
+    return 0;
+  }
+
+  /// @brief Get the k-th child of node w1 of the wide hierarchy of the first
+  /// object.
+  /// @retval b1 the corresponding node of the first tree.
+  /// @return the index of the child in the wide hierarchy, -1 for a leaf.
+  virtual int getFirstWideChild(unsigned int w1, int /*k*/,
+                                unsigned int& b1) const {
+    b1 = w1;
+    return -1;
+  }
+
+  /// @brief Whether one of the trees is compressed (see QuantizedBVH), in
+  /// which case the traversal tests the boxes given by getRootBoxes(),
+  /// getFirstChildBoxes() and getSecondChildBoxes() with boxesDisjoint().
+  virtual bool isQuantized() const { return false; }
+
+  /// @brief Boxes of the roots of the two trees, in the frame of their object.
+  virtual void getRootBoxes(AABB& /*box1*/, AABB& /*box2*/) const {}
+
+  /// @brief Boxes of the children of node b1 of the first tree, whose box is
+  /// \p box1.
+  virtual void getFirstChildBoxes(unsigned int /*b1*/, const AABB& /*box1*/,
+                                  AABB& /*left*/, AABB& /*right*/) const {}
+
+  /// @brief Boxes of the children of node b2 of the second tree, whose box is
+  /// \p box2.
+  virtual void getSecondChildBoxes(unsigned int /*b2*/, const AABB& /*box2*/,
+                                   AABB& /*left*/, AABB& /*right*/) const {}
+
+  /// @brief Test between the boxes of a node of each tree.
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between the boxes.
+  virtual bool boxesDisjoint(const AABB& /*box1*/, const AABB& /*box2*/,
+                             FCL_REAL& /*sqrDistLowerBound*/) const {
+    return false;
+  }
+
   /// @brief Check whether the traversal can stop
   bool canStop() const { return this->request.isSatisfied(*(this->result)); }
 
@@ -45,6 +45,7 @@
 #include <hpp/fcl/BV/BV_node.h>
 #include <hpp/fcl/BV/BV.h>
 #include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/BVH/BVH_wide.h>
 #include <hpp/fcl/internal/intersect.h>
 #include <hpp/fcl/shape/geometric_shapes.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
@@ -56,6 +57,29 @@
 namespace hpp {
 namespace fcl {
 
+namespace details {
+/// @brief Overlap test between a BV and the children of a wide node, for
+/// the BV types supported by WideBVH.
+template <typename BV, bool Supported = WideBVHSupport<BV>::value>
+struct WideBVHOverlap {
+  static unsigned int run(const WideBVH<BV>&, const Matrix3f&, const Vec3f&,
+                          const BV&, unsigned int, const CollisionRequest&,
+                          FCL_REAL&) {
+    HPP_FCL_THROW_PRETTY("should never reach this point", std::logic_error);
+  }
+};
+
+template <typename BV>
+struct WideBVHOverlap<BV, true> {
+  static unsigned int run(const WideBVH<BV>& wide, const Matrix3f& R,
+                          const Vec3f& T, const BV& bv, unsigned int w,
+                          const CollisionRequest& request,
+                          FCL_REAL& sqrDistLowerBound) {
+    return wide.overlap(R, T, bv, w, request, sqrDistLowerBound);
+  }
+};
+}  // namespace details
+
 /// @addtogroup Traversal_For_Collision
 /// @{
 
@@ -67,6 +91,8 @@ class BVHCollisionTraversalNode : public CollisionTraversalNodeBase {
       : CollisionTraversalNodeBase(request) {
     model1 = NULL;
     model2 = NULL;
+    quantized_model1 = NULL;
+    quantized_model2 = NULL;
 
     num_bv_tests = 0;
     num_leaf_tests = 0;
@@ -76,12 +102,14 @@ class BVHCollisionTraversalNode : public CollisionTraversalNodeBase {
   /// @brief Whether the BV node in the first BVH tree is leaf
   bool isFirstNodeLeaf(unsigned int b) const {
     assert(model1 != NULL && "model1 is NULL");
+    if (quantized_model1) return quantized_model1->isLeaf(b);
     return model1->getBV(b).isLeaf();
   }
 
   /// @brief Whether the BV node in the second BVH tree is leaf
   bool isSecondNodeLeaf(unsigned int b) const {
     assert(model2 != NULL && "model2 is NULL");
+    if (quantized_model2) return quantized_model2->isLeaf(b);
     return model2->getBV(b).isLeaf();
   }
 
@@ -99,33 +127,98 @@ class BVHCollisionTraversalNode : public CollisionTraversalNodeBase {
 
   /// @brief Obtain the left child of BV node in the first BVH
   int getFirstLeftChild(unsigned int b) const {
+    if (quantized_model1) return quantized_model1->leftChild(b);
     return model1->getBV(b).leftChild();
   }
 
   /// @brief Obtain the right child of BV node in the first BVH
   int getFirstRightChild(unsigned int b) const {
+    if (quantized_model1) return quantized_model1->rightChild(b);
     return model1->getBV(b).rightChild();
   }
 
   /// @brief Obtain the left child of BV node in the second BVH
   int getSecondLeftChild(unsigned int b) const {
+    if (quantized_model2) return quantized_model2->leftChild(b);
     return model2->getBV(b).leftChild();
   }
 
   /// @brief Obtain the right child of BV node in the second BVH
   int getSecondRightChild(unsigned int b) const {
+    if (quantized_model2) return quantized_model2->rightChild(b);
     return model2->getBV(b).rightChild();
   }
 
+  /// @brief Primitive of the leaf b of the first BVH
+  int getFirstPrimitiveId(unsigned int b) const {
+    if (quantized_model1) return quantized_model1->primitiveId(b);
+    return model1->getBV(b).primitiveId();
+  }
+
+  /// @brief Primitive of the leaf b of the second BVH
+  int getSecondPrimitiveId(unsigned int b) const {
+    if (quantized_model2) return quantized_model2->primitiveId(b);
+    return model2->getBV(b).primitiveId();
+  }
+
+  bool isQuantized() const {
+    return quantized_model1 != NULL || quantized_model2 != NULL;
+  }
+
+  void getRootBoxes(AABB& box1, AABB& box2) const {
+    if (quantized_model1)
+      box1 = quantized_model1->getRootBox();
+    else
+      convertBV(model1->getBV(0).bv, box1);
+    if (quantized_model2)
+      box2 = quantized_model2->getRootBox();
+    else
+      convertBV(model2->getBV(0).bv, box2);
+  }
+
+  void getFirstChildBoxes(unsigned int b1, const AABB& box1, AABB& left,
+                          AABB& right) const {
+    getChildBoxes(model1, quantized_model1, b1, box1, left, right);
+  }
+
+  void getSecondChildBoxes(unsigned int b2, const AABB& box2, AABB& left,
+                           AABB& right) const {
+    getChildBoxes(model2, quantized_model2, b2, box2, left, right);
+  }
+
   /// @brief The first BVH model
   const BVHModel<BV>* model1;
   /// @brief The second BVH model
   const BVHModel<BV>* model2;
 
-  /// @brief statistical information
+  /// @brief Compressed hierarchies of model1 and model2, or NULL if they are
+  /// not compressed.
+  const QuantizedBVH* quantized_model1;
+  const QuantizedBVH* quantized_model2;
+
+  /// @brief statistical information. When the wide hierarchy of model1 is
+  /// used, the test of a BV against all the children of a wide node counts as
+  /// one BV test.
   mutable int num_bv_tests;
   mutable int num_leaf_tests;
   mutable FCL_REAL query_time_seconds;
+
+ protected:
+  /// @brief The boxes of a compressed hierarchy are decoded from the box of
+  /// the parent. The BVs of the other hierarchy are bounded by boxes.
+  static void getChildBoxes(const BVHModel<BV>* model,
+                            const QuantizedBVH* quantized, unsigned int b,
+                            const AABB& box, AABB& left, AABB& right) {
+    if (quantized) {
+      const unsigned int l = (unsigned int)quantized->leftChild(b);
+      quantized->decode(l, box, left);
+      quantized->decode(l + 1, box, right);
+    } else {
+      const BVNode<BV>& node = model->getBV(b);
+      convertBV(model->getBV((unsigned int)node.leftChild()).bv, left);
+      convertBV(model->getBV((unsigned int)node.rightChild()).bv, right);
+    }
+  }
 };
 
 /// @brief Traversal node for collision between two meshes
@@ -143,6 +236,33 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
     vertices2 = NULL;
     tri_indices1 = NULL;
     tri_indices2 = NULL;
+    wide_model1 = NULL;
+  }
+
+  bool isFirstModelWide() const { return wide_model1 != NULL; }
+
+  /// BV test between b2 and the children of the wide node w1
+  /// @param w1 node of the wide hierarchy of model1,
+  /// @param b2 node of model2,
+  /// @retval sqrDistLowerBound square of a lower bound of the minimal
+  ///         distance between b2 and the children which do not overlap it.
+  /// @return a bit mask of the children which overlap b2.
+  unsigned int BVOverlapsWide(unsigned int w1, unsigned int b2,
+                              FCL_REAL& sqrDistLowerBound) const {
+    assert(wide_model1 != NULL && !RTIsIdentity);
+    if (this->enable_statistics) this->num_bv_tests++;
+    const unsigned int mask = details::WideBVHOverlap<BV>::run(
+        *wide_model1, RT._R(), RT._T(), this->model2->getBV(b2).bv, w1,
+        this->request, sqrDistLowerBound);
+    if (sqrDistLowerBound < std::numeric_limits<FCL_REAL>::infinity())
+      internal::updateDistanceLowerBoundFromBV(this->request, *this->result,
+                                               sqrDistLowerBound);
+    return mask;
+  }
+
+  int getFirstWideChild(unsigned int w1, int k, unsigned int& b1) const {
+    b1 = wide_model1->getBinaryNode(w1, k);
+    return wide_model1->getChild(w1, k);
   }
 
   /// BV test between b1 and b2
@@ -167,6 +287,23 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
     return disjoint;
   }
 
+  /// Test between the boxes of a node of each model, when one of them is
+  /// compressed
+  bool boxesDisjoint(const AABB& box1, const AABB& box2,
+                     FCL_REAL& sqrDistLowerBound) const {
+    if (this->enable_statistics) this->num_bv_tests++;
+    bool disjoint;
+    if (RTIsIdentity)
+      disjoint = !box1.overlap(box2, this->request, sqrDistLowerBound);
+    else
+      disjoint = !overlap(RT._R(), RT._T(), box2, box1, this->request,
+                          sqrDistLowerBound);
+    if (disjoint)
+      internal::updateDistanceLowerBoundFromBV(this->request, *this->result,
+                                               sqrDistLowerBound);
+    return disjoint;
+  }
+
   /// Intersection testing between leaves (two triangles)
   ///
   /// @param b1, b2 id of primitive in bounding volume hierarchy
@@ -185,11 +322,8 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
                     FCL_REAL& sqrDistLowerBound) const {
     if (this->enable_statistics) this->num_leaf_tests++;
 
-    const BVNode<BV>& node1 = this->model1->getBV(b1);
-    const BVNode<BV>& node2 = this->model2->getBV(b2);
-
-    int primitive_id1 = node1.primitiveId();
-    int primitive_id2 = node2.primitiveId();
+    int primitive_id1 = this->getFirstPrimitiveId(b1);
+    int primitive_id2 = this->getSecondPrimitiveId(b2);
 
     const Triangle& tri_id1 = tri_indices1[primitive_id1];
     const Triangle& tri_id2 = tri_indices2[primitive_id2];
@@ -238,6 +372,9 @@ class MeshCollisionTraversalNode : public BVHCollisionTraversalNode<BV> {
   Triangle* tri_indices1;
   Triangle* tri_indices2;
 
+  /// @brief Wide hierarchy of model1 used for the traversal, if not NULL.
+  const WideBVH<BV>* wide_model1;
+
   details::RelativeTransformation<!bool(RTIsIdentity)> RT;
 };
 
@@ -248,6 +385,11 @@ typedef MeshCollisionTraversalNode<RSS, 0> MeshCollisionTraversalNodeRSS;
 typedef MeshCollisionTraversalNode<kIOS, 0> MeshCollisionTraversalNodekIOS;
 typedef MeshCollisionTraversalNode<OBBRSS, 0> MeshCollisionTraversalNodeOBBRSS;
 
+/// @brief Traversal node for collision between two meshes of AABB. The AABBs of
+/// the second model are bounded on the fly by AABBs in the frame of the first
+/// one, so that the models need not be transformed.
+typedef MeshCollisionTraversalNode<AABB, 0> MeshCollisionTraversalNodeAABB;
+
 /// @}
 
 namespace details {
@@ -461,6 +603,11 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
       d2 = TriangleDistance::sqrTriDistance(t11, t12, t13, t21, t22, t23,
                                             RT._R(), RT._T(), P1, P2);
     FCL_REAL d = sqrt(d2);
+    // The normal is only defined between separated triangles.
+    if (d > 0)
+      normal = (P2 - P1) / d;
+    else
+      normal.setConstant(std::numeric_limits<FCL_REAL>::quiet_NaN());
 
     this->result->update(d, this->model1, this->model2, primitive_id1,
                          primitive_id2, P1, P2, normal);
@@ -508,6 +655,10 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
         init_tri1_points[0], init_tri1_points[1], init_tri1_points[2],
         init_tri2_points[0], init_tri2_points[1], init_tri2_points[2], RT._R(),
         RT._T(), p1, p2));
+    if (distance > 0)
+      normal = (p2 - p1) / distance;
+    else
+      normal.setConstant(std::numeric_limits<FCL_REAL>::quiet_NaN());
 
     result->update(distance, model1, model2, init_tri_id1, init_tri_id2, p1, p2,
                    normal);
@@ -520,6 +671,7 @@ class MeshDistanceTraversalNode : public BVHDistanceTraversalNode<BV> {
         (result->o2 == model2)) {
       result->nearest_points[0] = tf1.transform(result->nearest_points[0]);
       result->nearest_points[1] = tf1.transform(result->nearest_points[1]);
+      result->normal = tf1.getRotation() * result->normal;
     }
   }
 };
@@ -189,6 +189,9 @@ bool initialize(MeshOcTreeCollisionTraversalNode<BV>& node,
                 const BVHModel<BV>& model1, const Transform3f& tf1,
                 const OcTree& model2, const Transform3f& tf2,
                 const OcTreeSolver* otsolver, CollisionResult& result) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   node.result = &result;
 
   node.model1 = &model1;
@@ -209,6 +212,9 @@ bool initialize(OcTreeMeshCollisionTraversalNode<BV>& node,
                 const OcTree& model1, const Transform3f& tf1,
                 const BVHModel<BV>& model2, const Transform3f& tf2,
                 const OcTreeSolver* otsolver, CollisionResult& result) {
+  if (model2.isCompressed())
+    HPP_FCL_THROW_PRETTY("model2 should not be compressed.",
+                         std::invalid_argument)
   node.result = &result;
 
   node.model1 = &model1;
@@ -270,6 +276,9 @@ bool initialize(MeshOcTreeDistanceTraversalNode<BV>& node,
                 const OcTree& model2, const Transform3f& tf2,
                 const OcTreeSolver* otsolver, const DistanceRequest& request,
                 DistanceResult& result) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   node.request = request;
   node.result = &result;
 
@@ -291,6 +300,9 @@ bool initialize(OcTreeMeshDistanceTraversalNode<BV>& node, const OcTree& model1,
                 const Transform3f& tf1, const BVHModel<BV>& model2,
                 const Transform3f& tf2, const OcTreeSolver* otsolver,
                 const DistanceRequest& request, DistanceResult& result) {
+  if (model2.isCompressed())
+    HPP_FCL_THROW_PRETTY("model2 should not be compressed.",
+                         std::invalid_argument)
   node.request = request;
   node.result = &result;
 
@@ -333,6 +345,9 @@ bool initialize(MeshShapeCollisionTraversalNode<BV, S>& node,
                 const Transform3f& tf2, const GJKSolver* nsolver,
                 CollisionResult& result, bool use_refit = false,
                 bool refit_bottomup = false) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -380,6 +395,9 @@ bool initialize(MeshShapeCollisionTraversalNode<BV, S, 0>& node,
                 const BVHModel<BV>& model1, const Transform3f& tf1,
                 const S& model2, const Transform3f& tf2,
                 const GJKSolver* nsolver, CollisionResult& result) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -438,6 +456,9 @@ static inline bool setupShapeMeshCollisionOrientedNode(
     OrientedNode<S>& node, const S& model1, const Transform3f& tf1,
     const BVHModel<BV>& model2, const Transform3f& tf2,
     const GJKSolver* nsolver, CollisionResult& result) {
+  if (model2.isCompressed())
+    HPP_FCL_THROW_PRETTY("model2 should not be compressed.",
+                         std::invalid_argument)
   if (model2.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model2 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -524,6 +545,9 @@ bool initialize(
   node.tri_indices2 =
       model2.tri_indices.get() ? model2.tri_indices->data() : NULL;
 
+  node.quantized_model1 = model1.getQuantizedBVH();
+  node.quantized_model2 = model2.getQuantizedBVH();
+
   node.result = &result;
 
   return true;
@@ -562,6 +586,10 @@ bool initialize(MeshCollisionTraversalNode<BV, 0>& node,
   node.RT.T.noalias() = tf1.getRotation().transpose() *
                         (tf2.getTranslation() - tf1.getTranslation());
 
+  node.wide_model1 = model1.getWideBVH();
+  node.quantized_model1 = model1.getQuantizedBVH();
+  node.quantized_model2 = model2.getQuantizedBVH();
+
   return true;
 }
 
@@ -591,6 +619,12 @@ bool initialize(
     BVHModel<BV>& model1, Transform3f& tf1, BVHModel<BV>& model2,
     Transform3f& tf2, const DistanceRequest& request, DistanceResult& result,
     bool use_refit = false, bool refit_bottomup = false) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
+  if (model2.isCompressed())
+    HPP_FCL_THROW_PRETTY("model2 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -657,6 +691,12 @@ bool initialize(MeshDistanceTraversalNode<BV, 0>& node,
                 const BVHModel<BV>& model1, const Transform3f& tf1,
                 const BVHModel<BV>& model2, const Transform3f& tf2,
                 const DistanceRequest& request, DistanceResult& result) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
+  if (model2.isCompressed())
+    HPP_FCL_THROW_PRETTY("model2 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -701,6 +741,9 @@ bool initialize(MeshShapeDistanceTraversalNode<BV, S>& node,
                 const Transform3f& tf2, const GJKSolver* nsolver,
                 const DistanceRequest& request, DistanceResult& result,
                 bool use_refit = false, bool refit_bottomup = false) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -748,6 +791,9 @@ static inline bool setupMeshShapeDistanceOrientedNode(
     OrientedNode<S>& node, const BVHModel<BV>& model1, const Transform3f& tf1,
     const S& model2, const Transform3f& tf2, const GJKSolver* nsolver,
     const DistanceRequest& request, DistanceResult& result) {
+  if (model1.isCompressed())
+    HPP_FCL_THROW_PRETTY("model1 should not be compressed.",
+                         std::invalid_argument)
   if (model1.getModelType() != BVH_MODEL_TRIANGLES)
     HPP_FCL_THROW_PRETTY(
         "model1 should be of type BVHModelType::BVH_MODEL_TRIANGLES.",
@@ -41,6 +41,7 @@
 /// @cond INTERNAL
 
 #include <hpp/fcl/BVH/BVH_front.h>
+#include <algorithm>
 #include <queue>
 #include <hpp/fcl/internal/traversal_node_base.h>
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
@@ -59,21 +60,94 @@ void collisionRecurse(CollisionTraversalNodeBase* node, unsigned int b1,
 void collisionNonRecurse(CollisionTraversalNodeBase* node,
                          BVHFrontList* front_list, FCL_REAL& sqrDistLowerBound);
 
+/// Recurse function for collision, statically bound to the type of the
+/// traversal node: its tests are not called through the virtual table, so
+/// that they can be inlined. Neither the front list nor the wide and
+/// compressed hierarchies are handled.
+/// @param node collision node,
+/// @param b1, b2 ids of bounding volume nodes for object 1 and object 2
+/// @retval sqrDistLowerBound squared lower bound on distance between objects.
+template <typename TraversalNode>
+void collisionRecurseT(const TraversalNode& node, unsigned int b1,
+                       unsigned int b2, FCL_REAL& sqrDistLowerBound) {
+  const bool l1 = node.TraversalNode::isFirstNodeLeaf(b1);
+  const bool l2 = node.TraversalNode::isSecondNodeLeaf(b2);
+  if (l1 && l2) {
+    node.TraversalNode::leafCollides(b1, b2, sqrDistLowerBound);
+    return;
+  }
+  if (node.TraversalNode::BVDisjoints(b1, b2, sqrDistLowerBound)) return;
+
+  FCL_REAL sqrDistLowerBound1 = 0, sqrDistLowerBound2 = 0;
+  unsigned int a1 = b1, a2 = b2, c1 = b1, c2 = b2;
+  if (node.TraversalNode::firstOverSecond(b1, b2)) {
+    a1 = (unsigned int)node.TraversalNode::getFirstLeftChild(b1);
+    c1 = (unsigned int)node.TraversalNode::getFirstRightChild(b1);
+  } else {
+    a2 = (unsigned int)node.TraversalNode::getSecondLeftChild(b2);
+    c2 = (unsigned int)node.TraversalNode::getSecondRightChild(b2);
+  }
+
+  collisionRecurseT(node, a1, a2, sqrDistLowerBound1);
+  if (node.canStop()) {
+    sqrDistLowerBound = sqrDistLowerBound1;
+  } else {
+    collisionRecurseT(node, c1, c2, sqrDistLowerBound2);
+    sqrDistLowerBound = (std::min)(sqrDistLowerBound1, sqrDistLowerBound2);
+  }
+}
+
+/// Recurse function for collision, using the wide hierarchy of the first
+/// object
+/// @param node collision node, whose isFirstModelWide() is true,
+/// @param w1 id of a node of the wide hierarchy of object 1,
+/// @param b2 id of bounding volume node of object 2
+/// @retval sqrDistLowerBound squared lower bound on distance between objects.
+void collisionRecurseWide(CollisionTraversalNodeBase* node, unsigned int w1,
+                          unsigned int b2, FCL_REAL& sqrDistLowerBound);
+
+/// Recurse function for collision, when one of the hierarchies is compressed
+/// @param node collision node, whose isQuantized() is true,
+/// @param b1, b2 ids of bounding volume nodes for object 1 and object 2
+/// @param box1, box2 their boxes, from which those of their children are
+///        decoded
+/// @retval sqrDistLowerBound squared lower bound on distance between objects.
+void collisionRecurseQuantized(CollisionTraversalNodeBase* node,
+                               unsigned int b1, const AABB& box1,
+                               unsigned int b2, const AABB& box2,
+                               FCL_REAL& sqrDistLowerBound);
+
 /// @brief Recurse function for distance
 void distanceRecurse(DistanceTraversalNodeBase* node, unsigned int b1,
                      unsigned int b2, BVHFrontList* front_list);
 
+/// @brief Iterative distance traversal, with a fixed capacity stack kept
+/// sorted by BV distance lower bound: the pairs are visited best first,
+/// depth first among equal lower bounds, so that the distance bound tightens
+/// early and prunes the remaining pairs when they are popped.
+void distanceNonRecurse(DistanceTraversalNodeBase* node,
+                        BVHFrontList* front_list);
+
 /// @brief Recurse function for distance, using queue acceleration
 void distanceQueueRecurse(DistanceTraversalNodeBase* node, unsigned int b1,
                           unsigned int b2, BVHFrontList* front_list,
                           unsigned int qsize);
 
-/// @brief Recurse function for front list propagation
+/// @brief Recurse function for front list propagation: the collision query
+/// restarts from the front of the previous query, refines the nodes whose BVs
+/// overlap and collapses the nodes whose siblings and parent are disjoint
+/// again. When the query can stop, the rest of the front is kept unchanged.
 void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase* node,
                                            const CollisionRequest& request,
                                            CollisionResult& result,
                                            BVHFrontList* front_list);
 
+/// @brief Recurse function for front list propagation of the distance: the
+/// same as propagateBVHFrontListCollisionRecurse, with the nodes pruned by
+/// their BV distance lower bound in place of the disjoint ones.
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase* node,
+                                          BVHFrontList* front_list);
+
 }  // namespace fcl
 
 }  // namespace hpp
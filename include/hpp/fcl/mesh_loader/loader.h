@@ -45,6 +45,9 @@
 
 #include <map>
 #include <ctime>
+#include <future>
+#include <mutex>
+#include <vector>
 
 namespace hpp {
 namespace fcl {
@@ -57,12 +60,31 @@ class HPP_FCL_DLLAPI MeshLoader {
   virtual BVHModelPtr_t load(const std::string& filename,
                              const Vec3f& scale = Vec3f::Ones());
 
+  /// Load several files concurrently, calling MeshLoader::load for each of
+  /// them on a pool of threads.
+  /// \param filenames the files to load.
+  /// \param scales the scale of each file, or an empty vector to load them
+  ///        all with a unit scale.
+  /// \param num_threads number of threads. 0 means using all the hardware
+  ///        threads.
+  /// \return the models, in the order of \p filenames.
+  /// \throw std::invalid_argument if \p scales is neither empty nor of the
+  ///        size of \p filenames. The first exception thrown while loading a
+  ///        file is rethrown, once the files being loaded are done.
+  std::vector<BVHModelPtr_t> loadMany(
+      const std::vector<std::string>& filenames,
+      const std::vector<Vec3f>& scales = std::vector<Vec3f>(),
+      unsigned int num_threads = 0);
+
   /// Create an OcTree from a file in binary octomap format.
   /// \todo add OctreePtr_t
   virtual CollisionGeometryPtr_t loadOctree(const std::string& filename);
 
   MeshLoader(const NODE_TYPE& bvType = BV_OBBRSS) : bvType_(bvType) {}
 
+  /// Type of the bounding volumes of the loaded models.
+  NODE_TYPE getNodeType() const { return bvType_; }
+
  private:
   const NODE_TYPE bvType_;
 };
@@ -71,12 +93,28 @@ class HPP_FCL_DLLAPI MeshLoader {
 /// This class builds a new object for each different file.
 /// If method CachedMeshLoader::load is called twice with the same arguments,
 /// the second call returns the result of the first call.
+///
+/// Optionally, the built models are also stored in a directory (see
+/// CachedMeshLoader::setCacheDirectory), so that other processes loading the
+/// same file skip the parsing of the file and the construction of the
+/// hierarchy.
+///
+/// CachedMeshLoader::load can be called from several threads, e.g. by
+/// MeshLoader::loadMany. A file requested by several threads at once is
+/// loaded only once.
 class HPP_FCL_DLLAPI CachedMeshLoader : public MeshLoader {
  public:
   virtual ~CachedMeshLoader() {}
 
+  /// Copy the cache, but not the loads in progress.
+  CachedMeshLoader(const CachedMeshLoader& other);
+
   CachedMeshLoader(const NODE_TYPE& bvType = BV_OBBRSS) : MeshLoader(bvType) {}
 
+  /// \param cache_directory see CachedMeshLoader::setCacheDirectory
+  CachedMeshLoader(const NODE_TYPE& bvType, const std::string& cache_directory)
+      : MeshLoader(bvType), cache_directory_(cache_directory) {}
+
   virtual BVHModelPtr_t load(const std::string& filename, const Vec3f& scale);
 
   struct HPP_FCL_DLLAPI Key {
@@ -93,10 +131,38 @@ class HPP_FCL_DLLAPI CachedMeshLoader : public MeshLoader {
   };
   typedef std::map<Key, Value> Cache_t;
 
+  /// \warning It must not be accessed while models are being loaded.
   const Cache_t& cache() const { return cache_; }
 
+  /// Set the directory where the built models are stored.
+  ///
+  /// The models are saved in the flat binary format (see
+  /// serialization::saveToFlatBinary) in a file named after a hash of the
+  /// content of the mesh file, the scale and the bounding volume type. They
+  /// are loaded from there instead of being built again, including by other
+  /// processes. The directory is created if needed. An empty string, the
+  /// default, disables the storage of the models on disk.
+  void setCacheDirectory(const std::string& directory) {
+    cache_directory_ = directory;
+  }
+
+  const std::string& getCacheDirectory() const { return cache_directory_; }
+
  private:
+  /// Path of the file storing the model of \p filename in the cache
+  /// directory, or an empty string if \p filename cannot be read.
+  std::string cachePath(const std::string& filename, const Vec3f& scale) const;
+
+  /// Load \p filename, from the cache directory if possible.
+  BVHModelPtr_t loadUncached(const std::string& filename, const Vec3f& scale);
+
   Cache_t cache_;
+  std::string cache_directory_;
+
+  /// Protects cache_ and pending_.
+  std::mutex mutex_;
+  /// Files being loaded by a thread.
+  std::map<Key, std::shared_future<BVHModelPtr_t> > pending_;
 };
 }  // namespace fcl
 
@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_H
+#define HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_H
+
+#include <hpp/fcl/narrowphase/continuous_collision_object.h>
+#include <hpp/fcl/narrowphase/motion.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief Request of a continuous collision query.
+struct HPP_FCL_DLLAPI ContinuousCollisionRequest {
+  /// @brief Maximum number of advancement steps. When it is reached, the
+  /// objects are reported in contact at the last time proven free.
+  size_t max_iterations;
+
+  /// @brief Distance below which the objects are in contact.
+  FCL_REAL tolerance;
+
+  explicit ContinuousCollisionRequest(size_t max_iterations_ = 100,
+                                      FCL_REAL tolerance_ = 1e-4)
+      : max_iterations(max_iterations_), tolerance(tolerance_) {}
+};
+
+/// @brief Result of a continuous collision query.
+struct HPP_FCL_DLLAPI ContinuousCollisionResult {
+  /// @brief Whether the objects come in contact during the motion.
+  bool is_collide;
+
+  /// @brief Time in [0, 1] of the first contact, or 1 if there is none.
+  FCL_REAL time_of_contact;
+
+  /// @brief Poses of the objects at \c time_of_contact.
+  Transform3f contact_tf1, contact_tf2;
+
+  /// @brief Number of discrete collision and distance queries run.
+  size_t num_queries;
+
+  ContinuousCollisionResult() { clear(); }
+
+  void clear() {
+    is_collide = false;
+    time_of_contact = 1;
+    contact_tf1.setIdentity();
+    contact_tf2.setIdentity();
+    num_queries = 0;
+  }
+};
+
+/// @brief Finds the first time of contact of two objects moving along their
+/// motions from time 0 to time 1.
+///
+/// The query runs conservative advancement: at time t, the distance d between
+/// the objects, or a lower bound of it, cannot decrease faster than the sum of
+/// the ContinuousCollisionObject::getMotionBound of both objects, so that the
+/// objects are free until t + d / bound. The distance lower bound is given by
+/// ComputeCollision (the exact distance for shapes, bounds from the bounding
+/// volumes for BVHs), and by ComputeDistance when the lower bound is too small
+/// to advance.
+///
+/// \return the time of contact, 1 if there is none.
+HPP_FCL_DLLAPI FCL_REAL collide(const ContinuousCollisionObject* o1,
+                                const ContinuousCollisionObject* o2,
+                                const ContinuousCollisionRequest& request,
+                                ContinuousCollisionResult& result);
+
+/// @copydoc collide(const ContinuousCollisionObject*, const
+/// ContinuousCollisionObject*, const ContinuousCollisionRequest&,
+/// ContinuousCollisionResult&)
+///
+/// The objects move from \p tf1_beg to \p tf1_end and from \p tf2_beg to
+/// \p tf2_end, as ContinuousCollisionObject. The local AABBs of the geometries
+/// must have been computed.
+HPP_FCL_DLLAPI FCL_REAL collide(const CollisionGeometry* o1,
+                                const Transform3f& tf1_beg,
+                                const Transform3f& tf1_end,
+                                const CollisionGeometry* o2,
+                                const Transform3f& tf2_beg,
+                                const Transform3f& tf2_end,
+                                const ContinuousCollisionRequest& request,
+                                ContinuousCollisionResult& result);
+
+/// @brief Validates a path segment: finds the first time of contact of two
+/// objects moving along arbitrary motions from time 0 to time 1.
+///
+/// This runs the conservative advancement of collide(const
+/// ContinuousCollisionObject*, const ContinuousCollisionObject*, const
+/// ContinuousCollisionRequest&, ContinuousCollisionResult&) with the bound
+/// given by MotionBase::getMotionBound for the radius of each geometry: the
+/// path is certified free with, for objects far apart, much fewer queries than
+/// sampling it at a fixed step, which is moreover not a proof. The tighter the
+/// motion bounds, the fewer the queries. The local AABBs of the geometries
+/// must have been computed.
+///
+/// \return the time of contact, 1 if the path is free.
+HPP_FCL_DLLAPI FCL_REAL collide(const CollisionGeometry* o1,
+                                const MotionBase& motion1,
+                                const CollisionGeometry* o2,
+                                const MotionBase& motion2,
+                                const ContinuousCollisionRequest& request,
+                                ContinuousCollisionResult& result);
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_H
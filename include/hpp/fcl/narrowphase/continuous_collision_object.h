@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_OBJECT_H
+#define HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_OBJECT_H
+
+#include <hpp/fcl/collision_object.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief A collision geometry moving from the pose \c tf_beg at time 0 to the
+/// pose \c tf_end at time 1.
+///
+/// The motion interpolates linearly the translation and spherically the
+/// rotation (see getTransform): the translation and the angular velocity are
+/// constant. getAABB is an AABB containing the geometry during the whole
+/// motion.
+class HPP_FCL_DLLAPI ContinuousCollisionObject {
+ public:
+  ContinuousCollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
+                            bool compute_local_aabb = true)
+      : cgeom(cgeom_), user_data(nullptr) {
+    init(compute_local_aabb);
+  }
+
+  ContinuousCollisionObject(const shared_ptr<CollisionGeometry>& cgeom_,
+                            const Transform3f& tf_beg_,
+                            const Transform3f& tf_end_,
+                            bool compute_local_aabb = true)
+      : cgeom(cgeom_), tf_beg(tf_beg_), tf_end(tf_end_), user_data(nullptr) {
+    init(compute_local_aabb);
+  }
+
+  /// @brief get the type of the object
+  OBJECT_TYPE getObjectType() const { return cgeom->getObjectType(); }
+
+  /// @brief get the node type
+  NODE_TYPE getNodeType() const { return cgeom->getNodeType(); }
+
+  /// @brief get the AABB in world space of the geometry along the motion
+  const AABB& getAABB() const { return aabb; }
+
+  /// @brief compute the AABB in world space of the geometry along the motion
+  void computeAABB();
+
+  /// @brief get user data in object
+  void* getUserData() const { return user_data; }
+
+  /// @brief set user data in object
+  void setUserData(void* data) { user_data = data; }
+
+  /// @brief get the pose at time 0
+  const Transform3f& getTransformBeg() const { return tf_beg; }
+
+  /// @brief get the pose at time 1
+  const Transform3f& getTransformEnd() const { return tf_end; }
+
+  /// @brief set the poses at time 0 and 1 and update the AABB
+  void setMotion(const Transform3f& tf_beg_, const Transform3f& tf_end_) {
+    tf_beg = tf_beg_;
+    tf_end = tf_end_;
+    computeAABB();
+  }
+
+  /// @brief get the pose at time \p t in [0, 1]
+  Transform3f getTransform(FCL_REAL t) const;
+
+  /// @brief Upper bound of the speed of the points of the geometry along the
+  /// motion, in distance per unit of time.
+  FCL_REAL getMotionBound() const;
+
+  /// @brief get shared pointer to collision geometry of the object instance
+  const shared_ptr<CollisionGeometry>& collisionGeometry() const {
+    return cgeom;
+  }
+
+  /// @brief get raw pointer to collision geometry of the object instance
+  const CollisionGeometry* collisionGeometryPtr() const { return cgeom.get(); }
+
+ protected:
+  void init(bool compute_local_aabb) {
+    if (cgeom && compute_local_aabb) cgeom->computeLocalAABB();
+    computeAABB();
+  }
+
+  shared_ptr<CollisionGeometry> cgeom;
+
+  Transform3f tf_beg, tf_end;
+
+  /// @brief AABB in global coordinate of the geometry along the motion
+  AABB aabb;
+
+  /// @brief pointer to user defined data specific to this object
+  void* user_data;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_NARROWPHASE_CONTINUOUS_COLLISION_OBJECT_H
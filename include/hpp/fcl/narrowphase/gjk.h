@@ -83,6 +83,23 @@ struct HPP_FCL_DLLAPI GJK {
     }
   };
 
+  /// @brief Vertices of a simplex of GJK, expressed in the frames of the two
+  /// shapes which produced them. Contrary to the Minkowski difference points,
+  /// they remain points of the shapes when the shapes move, so that they can
+  /// be placed at new poses to warm-start GJK (see \ref evaluate).
+  struct HPP_FCL_DLLAPI SimplexGuess {
+    /// @brief shapes whose points are stored.
+    const ShapeBase* shapes[2];
+    /// @brief points of the first shape, in its frame.
+    Vec3f w0[4];
+    /// @brief points of the second shape, in its frame.
+    Vec3f w1[4];
+    /// @brief number of vertices. 0 means there is no guess.
+    vertex_id_t rank;
+
+    SimplexGuess() : rank(0) { shapes[0] = shapes[1] = nullptr; }
+  };
+
   /// @brief Status of the GJK algorithm:
   /// DidNotRun: GJK has not been run.
   /// Failed: GJK did not converge (it exceeded the maximum number of
@@ -154,9 +171,28 @@ struct HPP_FCL_DLLAPI GJK {
   void reset(size_t max_iterations_, FCL_REAL tolerance_);
 
   /// @brief GJK algorithm, given the initial value guess
+  /// @param simplex_guess if not null and computed on the same shapes as
+  /// \p shape, GJK starts from the closest point to the origin of the simplex
+  /// formed by its vertices placed at the current poses, instead of
+  /// \p guess. Its vertices being points of the Minkowski difference, GJK
+  /// may then stop after a single support call. It is ignored when the
+  /// simplex encloses the origin.
   Status evaluate(
       const MinkowskiDiff& shape, const Vec3f& guess,
-      const support_func_guess_t& supportHint = support_func_guess_t::Zero());
+      const support_func_guess_t& supportHint = support_func_guess_t::Zero(),
+      const SimplexGuess* simplex_guess = nullptr);
+
+  /// @brief GJK algorithm on shapes whose types are statically known: their
+  /// support functions are inlined in the iterations. It is instantiated for
+  /// the pairs of types given by minkowski_diff_shape.
+  /// @param shape the Minkowski difference of the shapes, whose
+  /// MinkowskiDiff is kept as \ref shape for EPA and the witness points.
+  /// See evaluate(const MinkowskiDiff&, ...) for the other parameters.
+  template <typename Shape0, typename Shape1>
+  Status evaluate(
+      const MinkowskiDiffT<Shape0, Shape1>& shape, const Vec3f& guess,
+      const support_func_guess_t& supportHint = support_func_guess_t::Zero(),
+      const SimplexGuess* simplex_guess = nullptr);
 
   /// @brief apply the support function along a direction, the result is return
   /// in sv
@@ -188,6 +224,10 @@ struct HPP_FCL_DLLAPI GJK {
   /// @brief get the guess from current simplex
   Vec3f getGuessFromSimplex() const;
 
+  /// @brief Stores the simplex of the last run in the frames of the shapes,
+  /// to warm-start a later run on the same shapes.
+  void getSimplexGuess(SimplexGuess& simplex_guess) const;
+
   /// @brief Distance threshold for early break.
   /// GJK stops when it proved the distance is more than this threshold.
   /// @note The closest points will be erroneous in this case.
@@ -222,6 +262,16 @@ struct HPP_FCL_DLLAPI GJK {
   /// Otherwise use \ref reset.
   void initialize();
 
+  /// @brief Implements both evaluate methods: the supports of \p shape are
+  /// computed by \p support_shape, which is either \p shape itself or its
+  /// MinkowskiDiffT.
+  template <typename MinkowskiDiffType>
+  Status evaluateTpl(const MinkowskiDiff& shape,
+                     const MinkowskiDiffType& support_shape,
+                     const Vec3f& guess,
+                     const support_func_guess_t& supportHint,
+                     const SimplexGuess* simplex_guess);
+
   /// @brief discard one vertex from the simplex
   inline void removeVertex(Simplex& simplex);
 
@@ -229,6 +279,20 @@ struct HPP_FCL_DLLAPI GJK {
   inline void appendVertex(Simplex& simplex, const Vec3f& v,
                            support_func_guess_t& hint);
 
+  /// @brief append one vertex to the simplex, computed by \p support_shape
+  template <typename MinkowskiDiffType>
+  inline void appendVertex(Simplex& simplex, const Vec3f& v,
+                           support_func_guess_t& hint,
+                           const MinkowskiDiffType& support_shape);
+
+  /// @brief Places the vertices of \p simplex_guess at the current poses of
+  /// the shapes and projects the origin onto their convex hull. The smallest
+  /// face containing the projection becomes the current simplex.
+  /// Since the vertices were not added in the order of GJK, the projection
+  /// tests every face of the simplex.
+  /// @return true if the origin is inside the simplex.
+  bool projectSimplexGuessOrigin(const SimplexGuess& simplex_guess);
+
   /// @brief Project origin (0) onto line a-b
   /// For a detailed explanation of how to efficiently project onto a simplex,
   /// check out Ericson's book, page 403:
@@ -278,7 +342,7 @@ struct HPP_FCL_DLLAPI EPA {
 
   /// @brief The simplex list of EPA is a linked list of faces.
   /// Note: EPA's linked list does **not** own any memory.
-  /// The memory it refers to is contiguous and owned by a std::vector.
+  /// The memory it refers to is contiguous and owned by a \ref Storage.
   struct HPP_FCL_DLLAPI SimplexFaceList {
     SimplexFace* root;
     size_t count;
@@ -327,6 +391,30 @@ struct HPP_FCL_DLLAPI EPA {
         : current_face(nullptr), first_face(nullptr), num_faces(0) {}
   };
 
+  /// @brief Memory of the polytope of EPA: its vertices and faces.
+  /// An EPA does not own its memory. It borrows the storage given by
+  /// \ref storage or, by default, the storage of the calling thread (see
+  /// \ref threadStorage). Hence copying an EPA, or a GJKSolver, does not
+  /// copy any buffer and, once the buffers of the thread are large enough
+  /// for the maximum number of iterations, EPA no longer allocates memory.
+  struct HPP_FCL_DLLAPI Storage {
+    std::vector<SimplexVertex> sv_store;
+    std::vector<SimplexFace> fc_store;
+    /// @brief EPA which last laid out its lists of faces in the storage.
+    const EPA* user;
+
+    Storage() : user(nullptr) {}
+
+    /// @brief Grows the buffers so that they hold the polytope of an EPA
+    /// running at most \p max_iterations. The buffers never shrink.
+    void reserve(size_t max_iterations);
+  };
+
+  /// @brief Storage of the calling thread, used by the EPA whose
+  /// \ref storage is null. Calling `threadStorage().reserve(n)` when a
+  /// thread starts avoids the allocation of the first penetrating query.
+  static Storage& threadStorage();
+
   enum Status {
     DidNotRun = -1,
     Failed = 0,
@@ -348,31 +436,44 @@ struct HPP_FCL_DLLAPI EPA {
   FCL_REAL depth;
   SimplexFace* closest_face;
 
+  /// @brief Storage borrowed by EPA. When null (the default), EPA uses the
+  /// storage of the calling thread.
+  /// @note A storage may be shared by several EPA, as long as they do not
+  /// run concurrently. The polytope of the last run, which \ref result and
+  /// \ref closest_face point to, is then only valid until another EPA runs
+  /// on the same storage.
+  Storage* storage;
+
  private:
   // max_iteration and tolerance are made private
   // because they are meant to be set by the `reset` function.
   size_t max_iterations;
   FCL_REAL tolerance;
 
-  std::vector<SimplexVertex> sv_store;
-  std::vector<SimplexFace> fc_store;
+  // Buffers of the storage, as laid out by the last `reset`.
+  SimplexVertex* sv_store;
+  SimplexFace* fc_store;
+  size_t max_vertex_num;
+  size_t max_face_num;
   SimplexFaceList hull, stock;
   size_t num_vertices;  // number of vertices in polytpoe constructed by EPA
   size_t iterations;
 
  public:
   EPA(size_t max_iterations_, FCL_REAL tolerance_)
-      : max_iterations(max_iterations_), tolerance(tolerance_) {
+      : storage(nullptr),
+        max_iterations(max_iterations_),
+        tolerance(tolerance_) {
     initialize();
   }
 
   /// @brief Copy constructor of EPA.
-  /// Mostly needed for the copy constructor of `GJKSolver`.
+  /// Mostly needed for the copy constructor of `GJKSolver`. The copy borrows
+  /// the same storage as \p other.
   EPA(const EPA& other)
-      : max_iterations(other.max_iterations),
-        tolerance(other.tolerance),
-        sv_store(other.sv_store),
-        fc_store(other.fc_store) {
+      : storage(other.storage),
+        max_iterations(other.max_iterations),
+        tolerance(other.tolerance) {
     initialize();
   }
 
@@ -380,10 +481,10 @@ struct HPP_FCL_DLLAPI EPA {
   size_t getNumMaxIterations() const { return max_iterations; }
 
   /// @brief Get the max number of vertices of EPA.
-  size_t getNumMaxVertices() const { return sv_store.size(); }
+  size_t getNumMaxVertices() const { return max_vertex_num; }
 
   /// @brief Get the max number of faces of EPA.
-  size_t getNumMaxFaces() const { return fc_store.size(); }
+  size_t getNumMaxFaces() const { return max_face_num; }
 
   /// @brief Get the tolerance of EPA.
   FCL_REAL getTolerance() const { return tolerance; }
@@ -398,7 +499,7 @@ struct HPP_FCL_DLLAPI EPA {
   size_t getNumFaces() const { return hull.count; }
 
   /// @brief resets the EPA algorithm, preparing it for a new run.
-  /// It potentially reallocates memory for the vertices and faces
+  /// It potentially grows the storage of the vertices and faces
   /// if the passed parameters are bigger than the previous ones.
   /// This function does **not** modify the parameters of the EPA algorithm,
   /// i.e. the maximum number of iterations and the tolerance.
@@ -410,6 +511,8 @@ struct HPP_FCL_DLLAPI EPA {
   /// \return a Status which can be demangled using (status & Valid) or
   ///         (status & Failed). The other values provide a more detailled
   ///         status
+  /// @note If another EPA has used the storage since the last \ref reset,
+  /// EPA is reset first.
   Status evaluate(GJK& gjk, const Vec3f& guess);
 
   /// Get the witness points on each object, and the corresponding normal.
@@ -428,6 +531,12 @@ struct HPP_FCL_DLLAPI EPA {
   /// Otherwise use \ref reset.
   void initialize();
 
+  /// @brief The storage used by EPA: \ref storage if set, the storage of the
+  /// calling thread otherwise.
+  Storage& getStorage() const {
+    return storage != nullptr ? *storage : threadStorage();
+  }
+
   bool getEdgeDist(SimplexFace* face, const SimplexVertex& a,
                    const SimplexVertex& b, FCL_REAL& dist);
 
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_NARROWPHASE_GJK_BATCH_H
+#define HPP_FCL_NARROWPHASE_GJK_BATCH_H
+
+#include <vector>
+
+#include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief A pair of shapes and their poses, as given to GJKBatchSolver.
+template <typename S1, typename S2>
+struct ShapePair {
+  const S1* s1;
+  Transform3f tf1;
+  const S2* s2;
+  Transform3f tf2;
+
+  ShapePair() : s1(nullptr), s2(nullptr) {}
+  ShapePair(const S1* s1_, const Transform3f& tf1_, const S2* s2_,
+            const Transform3f& tf2_)
+      : s1(s1_), tf1(tf1_), s2(s2_), tf2(tf2_) {}
+};
+
+/// @brief Output of GJKSolver::shapeDistance for one pair of shapes.
+struct HPP_FCL_DLLAPI ShapeDistanceResult {
+  FCL_REAL distance;
+  Vec3f p1, p2, normal;
+};
+
+/// @brief Distance between many pairs of primitive shapes, GJK_BATCH_SIZE
+/// pairs at a time.
+///
+/// The pairs of a batch run GJK in lockstep: each iteration computes the
+/// support points, the convergence checks and the projections onto the
+/// simplices of all the pairs with the same SIMD instructions. The pairs which
+/// have converged are skipped by the scalar steps of the next iterations
+/// (convergence checks and choice of the sub-simplex), but the SIMD steps
+/// still compute their lanes until the whole batch has converged. The
+/// projection considers every sub-simplex of the current simplex, instead of
+/// the branches of GJK::evaluate, so that all the pairs follow the same path.
+///
+/// A batch therefore costs as many iterations as its slowest pair. This makes
+/// pairs of boxes slower than with `solver.shapeDistance` when Eigen only
+/// uses SSE2: GJK needs more iterations on boxes, which also vary more between
+/// pairs (on the random pairs of test-benchmark-gjk-batch, 2.8 iterations per
+/// pair on average but 3.9 per batch of 4 pairs, against 2.3 and 2.8 for
+/// capsules), reaches the tetrahedron more often, whose projection enumerates
+/// all the sub-simplices, and the support of a box takes three selections per
+/// lane instead of one. Prefer GJKSolver for pairs of boxes unless Eigen uses
+/// wider SIMD instructions (AVX), with which both are on par.
+///
+/// The results are those of `solver.shapeDistance`, up to the tolerance of
+/// GJK. The pairs which GJK does not separate (the shapes are in collision),
+/// which run out of iterations or which hit a degenerate simplex are computed
+/// again by `solver.shapeDistance`, as are all the pairs when the parameters
+/// of `solver` are not the default GJK variant, convergence criterion and
+/// initial guess.
+///
+/// S1 and S2 are Sphere, Capsule or Box.
+template <typename S1, typename S2>
+struct HPP_FCL_DLLAPI GJKBatchSolver {
+  typedef ShapePair<S1, S2> Pair;
+
+  GJKBatchSolver() : num_fallbacks(0) {}
+
+  explicit GJKBatchSolver(const DistanceRequest& request)
+      : solver(request), num_fallbacks(0) {}
+
+  /// @brief Computes the distance between the shapes of each of the
+  /// \p num_pairs pairs, as `solver.shapeDistance` does, and stores it in
+  /// \p results, which has room for \p num_pairs results.
+  void shapeDistance(const Pair* pairs, std::size_t num_pairs,
+                     const bool compute_penetration,
+                     ShapeDistanceResult* results) const;
+
+  /// @brief See the other overload. \p results is resized to the number of
+  /// pairs.
+  void shapeDistance(const std::vector<Pair>& pairs,
+                     const bool compute_penetration,
+                     std::vector<ShapeDistanceResult>& results) const {
+    results.resize(pairs.size());
+    if (!pairs.empty())
+      shapeDistance(pairs.data(), pairs.size(), compute_penetration,
+                    results.data());
+  }
+
+  /// @brief Parameters of GJK, and solver of the pairs which are not
+  /// separated by the lockstep GJK.
+  GJKSolver solver;
+
+  /// @brief Number of pairs computed by `solver` during the last call.
+  mutable std::size_t num_fallbacks;
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_NARROWPHASE_GJK_BATCH_H
@@ -39,6 +39,8 @@
 #ifndef HPP_FCL_MINKOWSKI_DIFFERENCE_H
 #define HPP_FCL_MINKOWSKI_DIFFERENCE_H
 
+#include <type_traits>
+
 #include "hpp/fcl/shape/geometric_shapes.h"
 #include "hpp/fcl/math/transform.h"
 #include "hpp/fcl/narrowphase/support_functions.h"
@@ -180,6 +182,101 @@ struct HPP_FCL_DLLAPI MinkowskiDiff {
   }
 };
 
+/// @brief The type of the shape whose support function is called by
+/// MinkowskiDiffT on a shape of type S: S itself for the primitive shapes,
+/// ConvexBase for the convex polytopes and void for the other shapes, whose
+/// Minkowski difference is only handled by MinkowskiDiff.
+template <typename S, typename Enable = void>
+struct minkowski_diff_shape {
+  typedef void type;
+};
+
+template <typename S>
+struct minkowski_diff_shape<
+    S, typename std::enable_if<std::is_base_of<ConvexBase, S>::value>::type> {
+  typedef ConvexBase type;
+};
+
+template <>
+struct minkowski_diff_shape<TriangleP> {
+  typedef TriangleP type;
+};
+
+template <>
+struct minkowski_diff_shape<Box> {
+  typedef Box type;
+};
+
+template <>
+struct minkowski_diff_shape<Sphere> {
+  typedef Sphere type;
+};
+
+template <>
+struct minkowski_diff_shape<Ellipsoid> {
+  typedef Ellipsoid type;
+};
+
+template <>
+struct minkowski_diff_shape<Capsule> {
+  typedef Capsule type;
+};
+
+template <>
+struct minkowski_diff_shape<Cone> {
+  typedef Cone type;
+};
+
+template <>
+struct minkowski_diff_shape<Cylinder> {
+  typedef Cylinder type;
+};
+
+/// @brief Minkowski difference of two shapes whose types are statically known.
+///
+/// It wraps a MinkowskiDiff set on shapes of types Shape0 and Shape1, and calls
+/// their support functions directly instead of through
+/// MinkowskiDiff::getSupportFunc, so that they are inlined in the iterations
+/// of GJK::evaluate(const MinkowskiDiffT&, ...).
+///
+/// @tparam Shape0, Shape1 types of the shapes, as given by
+/// minkowski_diff_shape.
+/// @note As with `MinkowskiDiff::set<SupportOptions::NoSweptSphere>`, the
+/// swept-sphere radii are not taken into account by the support function.
+template <typename Shape0, typename Shape1>
+struct MinkowskiDiffT {
+  /// @brief the Minkowski difference of the two shapes.
+  const MinkowskiDiff& minkowski_difference;
+
+  /// @brief whether the shapes are expressed in the same frame.
+  const bool identity;
+
+  explicit MinkowskiDiffT(const MinkowskiDiff& md)
+      : minkowski_difference(md),
+        identity(md.oR1.isIdentity() && md.ot1.isZero()) {}
+
+  /// @brief Support function for the pair of shapes.
+  /// See MinkowskiDiff::support.
+  inline void support(const Vec3f& dir, Vec3f& supp0, Vec3f& supp1,
+                      support_func_guess_t& hint) const {
+    const MinkowskiDiff& md = minkowski_difference;
+    ShapeSupportData* data = const_cast<ShapeSupportData*>(md.data);
+    getShapeSupport<SupportOptions::NoSweptSphere>(
+        static_cast<const Shape0*>(md.shapes[0]), dir, supp0, hint[0],
+        data[0]);
+    if (identity) {
+      getShapeSupport<SupportOptions::NoSweptSphere>(
+          static_cast<const Shape1*>(md.shapes[1]), -dir, supp1, hint[1],
+          data[1]);
+    } else {
+      getShapeSupport<SupportOptions::NoSweptSphere>(
+          static_cast<const Shape1*>(md.shapes[1]), -md.oR1.transpose() * dir,
+          supp1, hint[1], data[1]);
+      supp1 = md.oR1 * supp1 + md.ot1;
+    }
+  }
+};
+
 }  // namespace details
 
 }  // namespace fcl
@@ -0,0 +1,68 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_NARROWPHASE_MOTION_H
+#define HPP_FCL_NARROWPHASE_MOTION_H
+
+#include <hpp/fcl/math/transform.h>
+
+namespace hpp {
+namespace fcl {
+
+/// @brief Rigid motion of a frame, parameterized by the time t in [0, 1].
+///
+/// Continuous collision queries only need the pose at a given time and a bound
+/// of the speed of the moving points: a motion planner validates a path by
+/// deriving this class, with the pose of a body computed from the
+/// configuration on the path and a velocity bound obtained from the joint
+/// velocities.
+class HPP_FCL_DLLAPI MotionBase {
+ public:
+  virtual ~MotionBase() {}
+
+  /// @brief get the pose at time \p t in [0, 1]
+  virtual Transform3f getTransform(FCL_REAL t) const = 0;
+
+  /// @brief Upper bound, over the whole motion, of the speed of the points
+  /// at distance at most \p radius of the origin of the moving frame, in
+  /// distance per unit of time.
+  virtual FCL_REAL getMotionBound(FCL_REAL radius) const = 0;
+};
+
+/// @brief Motion from the pose \c tf_beg at time 0 to the pose \c tf_end at
+/// time 1, interpolating linearly the translation and spherically the
+/// rotation: the translation and the angular velocity are constant.
+class HPP_FCL_DLLAPI InterpMotion : public MotionBase {
+ public:
+  /// @brief motion staying at the identity
+  InterpMotion() {}
+
+  /// @brief motion staying at \p tf
+  explicit InterpMotion(const Transform3f& tf) : tf_beg(tf), tf_end(tf) {}
+
+  InterpMotion(const Transform3f& tf_beg_, const Transform3f& tf_end_)
+      : tf_beg(tf_beg_), tf_end(tf_end_) {}
+
+  Transform3f getTransform(FCL_REAL t) const;
+
+  /// @brief the translation length plus the rotation angle times \p radius
+  FCL_REAL getMotionBound(FCL_REAL radius) const;
+
+  /// @brief get the pose at time 0
+  const Transform3f& getTransformBeg() const { return tf_beg; }
+
+  /// @brief get the pose at time 1
+  const Transform3f& getTransformEnd() const { return tf_end; }
+
+ protected:
+  Transform3f tf_beg, tf_end;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // HPP_FCL_NARROWPHASE_MOTION_H
@@ -82,6 +82,18 @@ struct HPP_FCL_DLLAPI GJKSolver {
   /// @brief smart guess for the support function
   mutable support_func_guess_t support_func_cached_guess;
 
+  /// @brief Last simplex of GJK, used as warm start by
+  /// `GJKInitialGuess::CachedSimplex`. It is emptied by the queries which
+  /// need EPA, since EPA starts from support points.
+  mutable details::GJK::SimplexGuess simplex_cached_guess;
+
+  /// @brief Whether every call of the solver queries the same pair of shapes,
+  /// so that `simplex_cached_guess` is kept from one call to the next.
+  /// ComputeCollision and ComputeDistance set it for pairs of shapes. It must
+  /// stay false otherwise: the shapes built on the fly from a BVH, a height
+  /// field or an octree share addresses, not points.
+  bool keep_simplex_cached_guess;
+
   /// @brief If GJK can guarantee that the distance between the shapes is
   /// greater than this value, it will early stop.
   FCL_REAL distance_upper_bound;
@@ -119,8 +131,8 @@ struct HPP_FCL_DLLAPI GJKSolver {
   /// certain functions of the `GJKSolver` class have specializations
   /// which don't use EPA (and/or GJK).
   /// So we give EPA's constructor a max number of iterations of zero.
-  /// Only the functions that need EPA will reset the algorithm and allocate
-  /// memory if needed.
+  /// Only the functions that need EPA will reset the algorithm and grow
+  /// the EPA storage of the thread if needed (see details::EPA::Storage).
   GJKSolver()
       : gjk(GJK_DEFAULT_MAX_ITERATIONS, GJK_DEFAULT_TOLERANCE),
         gjk_max_iterations(GJK_DEFAULT_MAX_ITERATIONS),
@@ -129,6 +141,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
         enable_cached_guess(false),  // Use gjk_initial_guess instead
         cached_guess(Vec3f(1, 0, 0)),
         support_func_cached_guess(support_func_guess_t::Zero()),
+        keep_simplex_cached_guess(false),
         distance_upper_bound((std::numeric_limits<FCL_REAL>::max)()),
         gjk_variant(GJKVariant::DefaultGJK),
         gjk_convergence_criterion(GJKConvergenceCriterion::Default),
@@ -151,6 +164,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
         epa(0, request.epa_tolerance) {
     this->cached_guess = Vec3f(1, 0, 0);
     this->support_func_cached_guess = support_func_guess_t::Zero();
+    this->keep_simplex_cached_guess = false;
 
     set(request);
   }
@@ -165,6 +179,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
     this->gjk_initial_guess = request.gjk_initial_guess;
     this->enable_cached_guess = request.enable_cached_gjk_guess;
     if (this->gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+        this->gjk_initial_guess == GJKInitialGuess::CachedSimplex ||
         this->enable_cached_guess) {
       this->cached_guess = request.cached_gjk_guess;
       this->support_func_cached_guess = request.cached_support_func_guess;
@@ -203,6 +218,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
         epa(0, request.epa_tolerance) {
     this->cached_guess = Vec3f(1, 0, 0);
     this->support_func_cached_guess = support_func_guess_t::Zero();
+    this->keep_simplex_cached_guess = false;
 
     set(request);
   }
@@ -217,6 +233,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
     this->gjk_initial_guess = request.gjk_initial_guess;
     this->enable_cached_guess = request.enable_cached_gjk_guess;
     if (this->gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+        this->gjk_initial_guess == GJKInitialGuess::CachedSimplex ||
         this->enable_cached_guess) {
       this->cached_guess = request.cached_gjk_guess;
       this->support_func_cached_guess = request.cached_support_func_guess;
@@ -226,7 +243,8 @@ struct HPP_FCL_DLLAPI GJKSolver {
     // The distance upper bound should be at least greater to the requested
     // security margin. Otherwise, we will likely miss some collisions.
     this->distance_upper_bound = (std::max)(
-        0., (std::max)(request.distance_upper_bound, request.security_margin));
+        FCL_REAL(0),
+        (std::max)(request.distance_upper_bound, request.security_margin));
     this->gjk_variant = request.gjk_variant;
     this->gjk_convergence_criterion = request.gjk_convergence_criterion;
     this->gjk_convergence_criterion_type =
@@ -253,6 +271,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
                other.enable_cached_guess &&  // use gjk_initial_guess instead
            this->cached_guess == other.cached_guess &&
            this->support_func_cached_guess == other.support_func_cached_guess &&
+           this->keep_simplex_cached_guess == other.keep_simplex_cached_guess &&
            this->gjk_max_iterations == other.gjk_max_iterations &&
            this->gjk_tolerance == other.gjk_tolerance &&
            this->distance_upper_bound == other.distance_upper_bound &&
@@ -363,6 +382,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
         guess = default_guess;
         break;
       case GJKInitialGuess::CachedGuess:
+      case GJKInitialGuess::CachedSimplex:
         guess = this->cached_guess;
         break;
       case GJKInitialGuess::BoundingVolumeGuess:
@@ -443,7 +463,32 @@ struct HPP_FCL_DLLAPI GJKSolver {
                        *(this->minkowski_difference.shapes[1]), guess,
                        support_hint);
 
-    this->gjk.evaluate(this->minkowski_difference, guess, support_hint);
+    // The simplex is only meaningful for the shapes themselves: neither the
+    // triangles expressed in the frame of the first shape nor the shapes
+    // inflated by their swept-sphere radius.
+    const bool use_simplex_guess =
+        this->gjk_initial_guess == GJKInitialGuess::CachedSimplex &&
+        this->keep_simplex_cached_guess &&
+        !relative_transformation_already_computed &&
+        _SupportOptions == details::SupportOptions::NoSweptSphere;
+    // The supports of the shapes are inlined in GJK when their types are
+    // statically known.
+    typedef typename details::minkowski_diff_shape<S1>::type Shape1;
+    typedef typename details::minkowski_diff_shape<S2>::type Shape2;
+    typedef std::integral_constant<
+        bool, !std::is_void<Shape1>::value && !std::is_void<Shape2>::value &&
+                  _SupportOptions == details::SupportOptions::NoSweptSphere>
+        StaticShapes;
+    this->evaluateGJK<Shape1, Shape2>(
+        guess, support_hint,
+        use_simplex_guess ? &this->simplex_cached_guess : nullptr,
+        StaticShapes());
+    if (use_simplex_guess) {
+      if (this->gjk.status == details::GJK::Collision)
+        this->simplex_cached_guess.rank = 0;
+      else
+        this->gjk.getSimplexGuess(this->simplex_cached_guess);
+    }
 
     switch (this->gjk.status) {
       case details::GJK::DidNotRun:
@@ -586,6 +631,25 @@ struct HPP_FCL_DLLAPI GJKSolver {
     }
   }
 
+  /// @brief Runs GJK on `minkowski_difference`, through its MinkowskiDiffT
+  /// if the types of the shapes are statically known.
+  template <typename Shape1, typename Shape2>
+  void evaluateGJK(const Vec3f& guess, const support_func_guess_t& support_hint,
+                   const details::GJK::SimplexGuess* simplex_guess,
+                   std::true_type) const {
+    this->gjk.evaluate(
+        details::MinkowskiDiffT<Shape1, Shape2>(this->minkowski_difference),
+        guess, support_hint, simplex_guess);
+  }
+
+  template <typename Shape1, typename Shape2>
+  void evaluateGJK(const Vec3f& guess, const support_func_guess_t& support_hint,
+                   const details::GJK::SimplexGuess* simplex_guess,
+                   std::false_type) const {
+    this->gjk.evaluate(this->minkowski_difference, guess, support_hint,
+                       simplex_guess);
+  }
+
   void GJKEarlyStopExtractWitnessPointsAndNormal(const Transform3f& tf1,
                                                  FCL_REAL& distance, Vec3f& p1,
                                                  Vec3f& p2,
@@ -662,7 +726,7 @@ struct HPP_FCL_DLLAPI GJKSolver {
     // This caching allows to warm-start the next GJK call.
     this->cached_guess = -(this->epa.depth * this->epa.normal);
     this->support_func_cached_guess = this->epa.support_hint;
-    distance = (std::min)(0., -this->epa.depth);
+    distance = (std::min)(FCL_REAL(0), -this->epa.depth);
     this->epa.getWitnessPointsAndNormal(this->minkowski_difference, p1, p2,
                                         normal);
     // The following is very important to understand why EPA can sometimes
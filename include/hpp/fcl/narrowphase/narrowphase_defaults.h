@@ -45,6 +45,14 @@ namespace fcl {
 
 /// GJK
 constexpr size_t GJK_DEFAULT_MAX_ITERATIONS = 128;
+#ifdef HPP_FCL_USE_FLOAT
+/// In single precision, the support points are rounded to about 1e-7 times
+/// their distance to the origin: GJK could not reach a tolerance of 1e-6 on
+/// shapes placed far from the origin and would stop after the maximum number
+/// of iterations.
+constexpr FCL_REAL GJK_DEFAULT_TOLERANCE = 1e-3;
+constexpr FCL_REAL GJK_MINIMUM_TOLERANCE = 1e-3;
+#else
 constexpr FCL_REAL GJK_DEFAULT_TOLERANCE = 1e-6;
 /// Note: if the considered shapes are on the order of the meter, and the
 /// convergence criterion of GJK is the default VDB criterion,
@@ -52,14 +60,24 @@ constexpr FCL_REAL GJK_DEFAULT_TOLERANCE = 1e-6;
 /// the micro-meter.
 /// The same is true for EPA.
 constexpr FCL_REAL GJK_MINIMUM_TOLERANCE = 1e-6;
+#endif
 
 /// EPA
 /// EPA build a polytope which maximum size is:
 ///   - `#iterations + 4` vertices
 ///   - `2 x #iterations + 4` faces
 constexpr size_t EPA_DEFAULT_MAX_ITERATIONS = 64;
-constexpr FCL_REAL EPA_DEFAULT_TOLERANCE = 1e-6;
-constexpr FCL_REAL EPA_MINIMUM_TOLERANCE = 1e-6;
+constexpr FCL_REAL EPA_DEFAULT_TOLERANCE = GJK_DEFAULT_TOLERANCE;
+constexpr FCL_REAL EPA_MINIMUM_TOLERANCE = GJK_MINIMUM_TOLERANCE;
+
+/// GJKBatchSolver
+/// Number of pairs of shapes running GJK in lockstep: one AVX register of
+/// FCL_REAL, or two SSE registers.
+#ifdef HPP_FCL_USE_FLOAT
+constexpr int GJK_BATCH_SIZE = 8;
+#else
+constexpr int GJK_BATCH_SIZE = 4;
+#endif
 
 }  // namespace fcl
 }  // namespace hpp
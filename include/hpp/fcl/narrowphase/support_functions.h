@@ -144,12 +144,12 @@ struct LargeConvex : ShapeBase {};
 /// @brief See @ref LargeConvex.
 struct SmallConvex : ShapeBase {};
 
-/// @brief Support function for large ConvexBase (>32 vertices).
+/// @brief Support function for small ConvexBase (<48 vertices).
 template <int _SupportOptions = SupportOptions::NoSweptSphere>
 void getShapeSupport(const SmallConvex* convex, const Vec3f& dir,
                      Vec3f& support, int& hint, ShapeSupportData& data);
 
-/// @brief Support function for small ConvexBase (<32 vertices).
+/// @brief Support function for large ConvexBase (>48 vertices).
 template <int _SupportOptions = SupportOptions::NoSweptSphere>
 void getShapeSupport(const LargeConvex* convex, const Vec3f& dir,
                      Vec3f& support, int& hint, ShapeSupportData& support_data);
@@ -278,7 +278,7 @@ void getShapeSupportSet(const ConvexBase* convex, SupportSet& support_set,
                         size_t /*unused*/ num_sampled_supports = 6,
                         FCL_REAL tol = 1e-3);
 
-/// @brief Support set function for large ConvexBase (>32 vertices).
+/// @brief Support set function for small ConvexBase (<48 vertices).
 /// Assumes the support set frame has already been computed.
 template <int _SupportOptions = SupportOptions::NoSweptSphere>
 void getShapeSupportSet(const SmallConvex* convex, SupportSet& support_set,
@@ -286,7 +286,7 @@ void getShapeSupportSet(const SmallConvex* convex, SupportSet& support_set,
                         size_t /*unused*/ num_sampled_supports = 6,
                         FCL_REAL tol = 1e-3);
 
-/// @brief Support set function for small ConvexBase (<32 vertices).
+/// @brief Support set function for large ConvexBase (>48 vertices).
 /// Assumes the support set frame has already been computed.
 template <int _SupportOptions = SupportOptions::NoSweptSphere>
 void getShapeSupportSet(const LargeConvex* convex, SupportSet& support_set,
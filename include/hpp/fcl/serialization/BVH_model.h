@@ -96,6 +96,7 @@ struct BVHModelAccessor : hpp::fcl::BVHModel<BV> {
   using Base::num_bvs;
   using Base::num_bvs_allocated;
   using Base::primitive_indices;
+  using Base::quantized_bvh;
 };
 }  // namespace internal
 
@@ -113,6 +114,11 @@ void save(Archive &ar, const hpp::fcl::BVHModel<BV> &bvh_model_,
   typedef BVNode<BV> Node;
 
   const Accessor &bvh_model = reinterpret_cast<const Accessor &>(bvh_model_);
+  if (bvh_model.isCompressed())
+    HPP_FCL_THROW_PRETTY(
+        "The hierarchy of the BVH model is compressed.\n"
+        "The BVHModel could not be saved.",
+        std::invalid_argument);
   ar &make_nvp("base",
                boost::serialization::base_object<BVHModelBase>(bvh_model));
 
@@ -178,6 +184,7 @@ void load(Archive &ar, hpp::fcl::BVHModel<BV> &bvh_model_,
   typedef BVNode<BV> Node;
 
   Accessor &bvh_model = reinterpret_cast<Accessor &>(bvh_model_);
+  bvh_model.quantized_bvh.reset();
 
   ar >> make_nvp("base",
                  boost::serialization::base_object<BVHModelBase>(bvh_model));
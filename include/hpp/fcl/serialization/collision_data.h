@@ -65,6 +65,7 @@ void serialize(Archive& ar, hpp::fcl::QueryRequest& query_request,
   ar& make_nvp("collision_distance_threshold",
                query_request.collision_distance_threshold);
   ar& make_nvp("enable_timings", query_request.enable_timings);
+  ar& make_nvp("enable_front_list", query_request.enable_front_list);
 }
 
 template <class Archive>
@@ -139,6 +140,7 @@ void serialize(Archive& ar, hpp::fcl::DistanceRequest& distance_request,
                distance_request.enable_signed_distance);
   ar& make_nvp("rel_err", distance_request.rel_err);
   ar& make_nvp("abs_err", distance_request.abs_err);
+  ar& make_nvp("enable_derivatives", distance_request.enable_derivatives);
 }
 
 template <class Archive>
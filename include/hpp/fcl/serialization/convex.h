@@ -16,13 +16,6 @@
 namespace boost {
 namespace serialization {
 
-namespace internal {
-struct ConvexBaseAccessor : hpp::fcl::ConvexBase {
-  typedef hpp::fcl::ConvexBase Base;
-};
-
-}  // namespace internal
-
 template <class Archive>
 void serialize(Archive& ar, hpp::fcl::ConvexBase& convex_base,
                const unsigned int /*version*/) {
@@ -111,6 +104,8 @@ void serialize(Archive& ar, hpp::fcl::ConvexBase& convex_base,
   ar& make_nvp("center", convex_base.center);
   // We don't save neighbors as they will be computed directly by calling
   // fillNeighbors.
+  // Nor the points stored as a structure of arrays.
+  if (Archive::is_loading::value) convex_base.buildPointsSoA();
 }
 
 namespace internal {
@@ -154,14 +149,53 @@ HPP_FCL_SERIALIZATION_DECLARE_EXPORT(hpp::fcl::Convex<hpp::fcl::Quadrilateral>)
 namespace hpp {
 namespace fcl {
 
-// namespace internal {
-// template <typename BV>
-// struct memory_footprint_evaluator< ::hpp::fcl::BVHModel<BV> > {
-//   static size_t run(const ::hpp::fcl::BVHModel<BV> &bvh_model) {
-//     return static_cast<size_t>(bvh_model.memUsage(false));
-//   }
-// };
-// }  // namespace internal
+namespace internal {
+struct ConvexBaseMemoryAccessor : ::hpp::fcl::ConvexBase {
+  typedef ::hpp::fcl::ConvexBase Base;
+  using Base::nneighbors_;
+};
+
+/// \brief Memory footprint of the arrays owned by a ConvexBase, including
+/// the copy of the points stored as a structure of arrays.
+inline size_t computeConvexBaseArraysMemoryFootprint(
+    const ::hpp::fcl::ConvexBase &convex_) {
+  const ConvexBaseMemoryAccessor &convex =
+      reinterpret_cast<const ConvexBaseMemoryAccessor &>(convex_);
+  size_t footprint = 0;
+  if (convex.points.get()) footprint += convex.points->size() * sizeof(Vec3f);
+  footprint += static_cast<size_t>(convex.points_soa.size()) * sizeof(FCL_REAL);
+  if (convex.normals.get())
+    footprint += convex.normals->size() * sizeof(Vec3f);
+  if (convex.offsets.get())
+    footprint += convex.offsets->size() * sizeof(FCL_REAL);
+  if (convex.neighbors.get())
+    footprint += convex.neighbors->size() * sizeof(ConvexBase::Neighbors);
+  if (convex.nneighbors_.get())
+    footprint += convex.nneighbors_->size() * sizeof(unsigned int);
+  footprint += convex.support_warm_starts.points.size() * sizeof(Vec3f) +
+               convex.support_warm_starts.indices.size() * sizeof(int);
+  return footprint;
+}
+
+template <>
+struct memory_footprint_evaluator<::hpp::fcl::ConvexBase> {
+  static size_t run(const ::hpp::fcl::ConvexBase &convex) {
+    return sizeof(::hpp::fcl::ConvexBase) +
+           computeConvexBaseArraysMemoryFootprint(convex);
+  }
+};
+
+template <typename PolygonT>
+struct memory_footprint_evaluator<::hpp::fcl::Convex<PolygonT>> {
+  static size_t run(const ::hpp::fcl::Convex<PolygonT> &convex) {
+    size_t footprint = sizeof(::hpp::fcl::Convex<PolygonT>) +
+                       computeConvexBaseArraysMemoryFootprint(convex);
+    if (convex.polygons.get())
+      footprint += convex.polygons->size() * sizeof(PolygonT);
+    return footprint;
+  }
+};
+}  // namespace internal
 
 }  // namespace fcl
 }  // namespace hpp
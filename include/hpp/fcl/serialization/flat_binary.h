@@ -0,0 +1,395 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_SERIALIZATION_FLAT_BINARY_H
+#define HPP_FCL_SERIALIZATION_FLAT_BINARY_H
+
+#include "hpp/fcl/BVH/BVH_model.h"
+#include "hpp/fcl/hfield.h"
+#include "hpp/fcl/shape/convex.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hpp {
+namespace fcl {
+namespace serialization {
+
+/// @defgroup FlatBinary Flat binary format
+///
+/// The flat binary format stores the arrays of a model (vertices, triangles,
+/// BV nodes, ...) exactly as they are laid out in memory. Loading a file maps
+/// it in memory and copies each array once into the model, with no per
+/// element decoding, so that prebuilt hierarchies are loaded in about the time
+/// it takes to read them from disk.
+///
+/// The files are tied to the machine that wrote them: loading fails if the
+/// byte order, the size of FCL_REAL or the size of the nodes differ, as well
+/// as if the format version is not the one of the library.
+/// Use the Boost.Serialization archives (see archive.h) for portable files.
+/// @{
+
+/// @brief Version of the flat binary format written by the library.
+static const std::uint32_t flat_binary_version = 1;
+
+/// @brief Kind of object stored in a flat binary file.
+enum FlatBinaryObjectType {
+  FLAT_BINARY_BVH_MODEL = 1,
+  FLAT_BINARY_CONVEX = 2,
+  FLAT_BINARY_HEIGHT_FIELD = 3
+};
+
+/// @brief Header at the beginning of every flat binary file.
+struct FlatBinaryHeader {
+  /// @brief Always "HPPFCLFB".
+  char magic[8];
+  std::uint32_t version;
+  /// @brief 0x01020304 as written by the machine which saved the file.
+  std::uint32_t byte_order;
+  /// @brief sizeof(FCL_REAL)
+  std::uint32_t scalar_size;
+  /// @brief One of FlatBinaryObjectType.
+  std::uint32_t object_type;
+  /// @brief Node type of BVH models and height fields, polygon size of
+  /// convex shapes.
+  std::uint32_t element_type;
+  /// @brief Size of the nodes or polygons, to detect layout changes.
+  std::uint32_t element_size;
+  /// @brief Size of the whole file in bytes.
+  std::uint64_t size;
+};
+
+namespace internal {
+
+/// @brief Write a flat binary file.
+///
+/// The file is the header followed by records. Each record starts on a 16
+/// bytes boundary with its size, stored on 16 bytes, followed by its data.
+class HPP_FCL_DLLAPI FlatBinaryWriter {
+ public:
+  /// @throw std::invalid_argument if the file cannot be opened.
+  FlatBinaryWriter(const std::string& filename, FlatBinaryObjectType type,
+                   std::uint32_t element_type, std::uint32_t element_size);
+
+  /// @brief Write a record of \p size bytes.
+  void write(const void* data, std::size_t size);
+
+  template <typename T>
+  void write(const T& value) {
+    write(&value, sizeof(T));
+  }
+
+  /// @brief Write the \p n first elements of \p v, or an empty record if
+  /// \p v is NULL.
+  template <typename T, typename Allocator>
+  void write(const std::shared_ptr<std::vector<T, Allocator> >& v,
+             std::size_t n) {
+    if (v.get() && n > 0) {
+      assert(n <= v->size());
+      write(v->data(), n * sizeof(T));
+    } else
+      write(NULL, 0);
+  }
+
+  /// @brief Store the file size in the header and close the file.
+  /// @throw std::invalid_argument if writing failed.
+  void close();
+
+ private:
+  void pad();
+
+  std::ofstream os;
+  std::string filename;
+  std::size_t size;
+};
+
+/// @brief Read a flat binary file, which is mapped in memory when the
+/// platform allows it.
+class HPP_FCL_DLLAPI FlatBinaryReader {
+ public:
+  /// @throw std::invalid_argument if the file cannot be read, is not a flat
+  /// binary file, or was written by another version or another kind of
+  /// machine, or if it does not store an object of the given type.
+  FlatBinaryReader(const std::string& filename, FlatBinaryObjectType type,
+                   std::uint32_t element_type, std::uint32_t element_size);
+
+  ~FlatBinaryReader();
+
+  /// @brief Return the data of the next record, which must be \p size bytes
+  /// long, or NULL if \p size is 0.
+  /// @throw std::invalid_argument if the record has another size.
+  const void* read(std::size_t size);
+
+  template <typename T>
+  void read(T& value) {
+    std::memcpy(static_cast<void*>(&value), read(sizeof(T)), sizeof(T));
+  }
+
+  /// @brief Copy the next record in a new vector of \p n elements, or reset
+  /// \p v if \p n is 0.
+  template <typename T, typename Allocator>
+  void read(std::shared_ptr<std::vector<T, Allocator> >& v, std::size_t n) {
+    const void* data = read(n * sizeof(T));
+    if (n == 0) {
+      v.reset();
+      return;
+    }
+    v.reset(new std::vector<T, Allocator>(n));
+    std::memcpy(static_cast<void*>(v->data()), data, n * sizeof(T));
+  }
+
+  /// @brief Size of the next record.
+  std::size_t nextSize() const;
+
+ private:
+  void checkHeader(FlatBinaryObjectType type, std::uint32_t element_type,
+                   std::uint32_t element_size) const;
+  void unmap();
+
+  FlatBinaryReader(const FlatBinaryReader&);
+  FlatBinaryReader& operator=(const FlatBinaryReader&);
+
+  std::string filename;
+  const char* data;
+  std::size_t size;
+  std::size_t offset;
+  /// Mapping of the file, if any.
+  void* mapping;
+  /// Content of the file, when it could not be mapped.
+  std::vector<char> buffer;
+};
+
+template <typename BV>
+struct BVHModelAccessor : BVHModel<BV> {
+  typedef BVHModel<BV> Base;
+  using Base::bvs;
+  using Base::num_bvs;
+  using Base::num_bvs_allocated;
+  using Base::num_tris_allocated;
+  using Base::num_vertex_updated;
+  using Base::num_vertices_allocated;
+  using Base::clearVertexLeaves;
+  using Base::primitive_indices;
+  using Base::quantized_bvh;
+  using Base::wide_bvh;
+};
+
+struct ConvexBaseAccessor : ConvexBase {
+  typedef ConvexBase Base;
+  using Base::nneighbors_;
+};
+
+template <typename BV>
+struct HeightFieldAccessor : HeightField<BV> {
+  typedef HeightField<BV> Base;
+  using Base::bvs;
+  using Base::heights;
+  using Base::max_height;
+  using Base::min_height;
+  using Base::num_bvs;
+  using Base::x_dim;
+  using Base::x_grid;
+  using Base::y_dim;
+  using Base::y_grid;
+};
+
+HPP_FCL_DLLAPI void writeCollisionGeometry(FlatBinaryWriter& writer,
+                                           const CollisionGeometry& geometry);
+HPP_FCL_DLLAPI void readCollisionGeometry(FlatBinaryReader& reader,
+                                          CollisionGeometry& geometry);
+
+HPP_FCL_DLLAPI void writeConvexBase(FlatBinaryWriter& writer,
+                                    const ConvexBase& convex);
+HPP_FCL_DLLAPI void readConvexBase(FlatBinaryReader& reader,
+                                   ConvexBase& convex);
+
+template <typename Derived>
+void writeMatrix(FlatBinaryWriter& writer,
+                 const Eigen::PlainObjectBase<Derived>& m) {
+  const Eigen::DenseIndex dims[2] = {m.rows(), m.cols()};
+  writer.write(dims);
+  writer.write(m.data(),
+               (std::size_t)m.size() * sizeof(typename Derived::Scalar));
+}
+
+template <typename Derived>
+void readMatrix(FlatBinaryReader& reader, Eigen::PlainObjectBase<Derived>& m) {
+  Eigen::DenseIndex dims[2];
+  reader.read(dims);
+  m.resize(dims[0], dims[1]);
+  const std::size_t size =
+      (std::size_t)m.size() * sizeof(typename Derived::Scalar);
+  const void* data = reader.read(size);
+  if (size > 0) std::memcpy(m.data(), data, size);
+}
+
+}  // namespace internal
+
+/// @brief Save a BVH model in a flat binary file.
+/// @throw std::invalid_argument if the hierarchy of a mesh is not built or is
+/// compressed, or if the file cannot be written.
+template <typename BV>
+void saveToFlatBinary(const BVHModel<BV>& model_, const std::string& filename) {
+  typedef internal::BVHModelAccessor<BV> Accessor;
+  const Accessor& model = reinterpret_cast<const Accessor&>(model_);
+  if (!(model.build_state == BVH_BUILD_STATE_PROCESSED ||
+        model.build_state == BVH_BUILD_STATE_UPDATED) &&
+      (model.getModelType() == BVH_MODEL_TRIANGLES)) {
+    HPP_FCL_THROW_PRETTY(
+        "The BVH model is not in a BVH_BUILD_STATE_PROCESSED or "
+        "BVH_BUILD_STATE_UPDATED state.\n"
+        "The BVHModel could not be saved.",
+        std::invalid_argument);
+  }
+  if (model.isCompressed())
+    HPP_FCL_THROW_PRETTY(
+        "The hierarchy of the BVH model is compressed.\n"
+        "The BVHModel could not be saved.",
+        std::invalid_argument);
+
+  internal::FlatBinaryWriter writer(filename, FLAT_BINARY_BVH_MODEL,
+                                    (std::uint32_t)model.getNodeType(),
+                                    (std::uint32_t)sizeof(BVNode<BV>));
+  internal::writeCollisionGeometry(writer, model);
+  writer.write((int)model.build_state);
+  writer.write(model.num_vertices);
+  writer.write(model.vertices, model.num_vertices);
+  writer.write(model.num_tris);
+  writer.write(model.tri_indices, model.num_tris);
+  writer.write(model.prev_vertices,
+               model.prev_vertices.get() ? model.num_vertices : 0);
+  writer.write(model.num_bvs);
+  writer.write(model.bvs, model.num_bvs);
+  const std::size_t num_primitives =
+      model.primitive_indices.get() ? model.primitive_indices->size() : 0;
+  writer.write(model.primitive_indices, num_primitives);
+  writer.close();
+}
+
+/// @brief Load a BVH model saved by saveToFlatBinary.
+/// @throw std::invalid_argument if the file is not a flat binary file of a
+/// BVHModel<BV> written by this version on this kind of machine.
+template <typename BV>
+void loadFromFlatBinary(BVHModel<BV>& model_, const std::string& filename) {
+  typedef internal::BVHModelAccessor<BV> Accessor;
+  Accessor& model = reinterpret_cast<Accessor&>(model_);
+  internal::FlatBinaryReader reader(filename, FLAT_BINARY_BVH_MODEL,
+                                    (std::uint32_t)model.getNodeType(),
+                                    (std::uint32_t)sizeof(BVNode<BV>));
+  internal::readCollisionGeometry(reader, model);
+  int build_state;
+  reader.read(build_state);
+  model.build_state = (BVHBuildState)build_state;
+  reader.read(model.num_vertices);
+  reader.read(model.vertices, model.num_vertices);
+  reader.read(model.num_tris);
+  reader.read(model.tri_indices, model.num_tris);
+  reader.read(model.prev_vertices, reader.nextSize() / sizeof(Vec3f));
+  reader.read(model.num_bvs);
+  reader.read(model.bvs, model.num_bvs);
+  reader.read(model.primitive_indices,
+              reader.nextSize() / sizeof(unsigned int));
+
+  model.num_vertices_allocated = model.num_vertices;
+  model.num_tris_allocated = model.num_tris;
+  model.num_bvs_allocated = model.num_bvs;
+  model.num_vertex_updated = 0;
+  model.convex.reset();
+  model.wide_bvh.reset();
+  model.quantized_bvh.reset();
+  model.clearVertexLeaves();
+}
+
+/// @brief Save a convex shape in a flat binary file.
+/// @throw std::invalid_argument if the file cannot be written.
+template <typename PolygonT>
+void saveToFlatBinary(const Convex<PolygonT>& convex,
+                      const std::string& filename) {
+  internal::FlatBinaryWriter writer(filename, FLAT_BINARY_CONVEX,
+                                    (std::uint32_t)PolygonT::size(),
+                                    (std::uint32_t)sizeof(PolygonT));
+  internal::writeConvexBase(writer, convex);
+  writer.write(convex.num_polygons);
+  writer.write(convex.polygons, convex.num_polygons);
+  writer.close();
+}
+
+/// @brief Load a convex shape saved by saveToFlatBinary.
+///
+/// The neighbors of the vertices are stored in the file, so that they need
+/// not be computed again.
+/// @throw std::invalid_argument if the file is not a flat binary file of a
+/// Convex<PolygonT> written by this version on this kind of machine.
+template <typename PolygonT>
+void loadFromFlatBinary(Convex<PolygonT>& convex,
+                        const std::string& filename) {
+  internal::FlatBinaryReader reader(filename, FLAT_BINARY_CONVEX,
+                                    (std::uint32_t)PolygonT::size(),
+                                    (std::uint32_t)sizeof(PolygonT));
+  internal::readConvexBase(reader, convex);
+  reader.read(convex.num_polygons);
+  reader.read(convex.polygons, convex.num_polygons);
+}
+
+/// @brief Save a height field in a flat binary file.
+/// @throw std::invalid_argument if the file cannot be written.
+template <typename BV>
+void saveToFlatBinary(const HeightField<BV>& hfield_,
+                      const std::string& filename) {
+  typedef internal::HeightFieldAccessor<BV> Accessor;
+  const Accessor& hfield = reinterpret_cast<const Accessor&>(hfield_);
+  internal::FlatBinaryWriter writer(filename, FLAT_BINARY_HEIGHT_FIELD,
+                                    (std::uint32_t)hfield.getNodeType(),
+                                    (std::uint32_t)sizeof(HFNode<BV>));
+  internal::writeCollisionGeometry(writer, hfield);
+  writer.write(hfield.x_dim);
+  writer.write(hfield.y_dim);
+  writer.write(hfield.min_height);
+  writer.write(hfield.max_height);
+  internal::writeMatrix(writer, hfield.heights);
+  internal::writeMatrix(writer, hfield.x_grid);
+  internal::writeMatrix(writer, hfield.y_grid);
+  writer.write(hfield.num_bvs);
+  writer.write(hfield.bvs.data(), hfield.bvs.size() * sizeof(HFNode<BV>));
+  writer.close();
+}
+
+/// @brief Load a height field saved by saveToFlatBinary.
+/// @throw std::invalid_argument if the file is not a flat binary file of a
+/// HeightField<BV> written by this version on this kind of machine.
+template <typename BV>
+void loadFromFlatBinary(HeightField<BV>& hfield_, const std::string& filename) {
+  typedef internal::HeightFieldAccessor<BV> Accessor;
+  Accessor& hfield = reinterpret_cast<Accessor&>(hfield_);
+  internal::FlatBinaryReader reader(filename, FLAT_BINARY_HEIGHT_FIELD,
+                                    (std::uint32_t)hfield.getNodeType(),
+                                    (std::uint32_t)sizeof(HFNode<BV>));
+  internal::readCollisionGeometry(reader, hfield);
+  reader.read(hfield.x_dim);
+  reader.read(hfield.y_dim);
+  reader.read(hfield.min_height);
+  reader.read(hfield.max_height);
+  internal::readMatrix(reader, hfield.heights);
+  internal::readMatrix(reader, hfield.x_grid);
+  internal::readMatrix(reader, hfield.y_grid);
+  reader.read(hfield.num_bvs);
+  const std::size_t num_nodes = reader.nextSize() / sizeof(HFNode<BV>);
+  const void* nodes = reader.read(num_nodes * sizeof(HFNode<BV>));
+  hfield.bvs.resize(num_nodes);
+  if (num_nodes > 0)
+    std::memcpy(static_cast<void*>(hfield.bvs.data()), nodes,
+                num_nodes * sizeof(HFNode<BV>));
+}
+
+/// @}
+
+}  // namespace serialization
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // ifndef HPP_FCL_SERIALIZATION_FLAT_BINARY_H
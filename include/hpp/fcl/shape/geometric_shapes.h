@@ -705,18 +705,53 @@ class HPP_FCL_DLLAPI ConvexBase : public ShapeBase {
   };
 
   /// @brief Above this threshold, the convex polytope is considered large.
-  /// This influcences the way the support function is computed.
-  static constexpr size_t num_vertices_large_convex_threshold = 32;
+  /// This influcences the way the support function is computed: the linear
+  /// scan over @ref points_soa is faster than the hill climbing through the
+  /// neighbors up to about this number of vertices, as measured by
+  /// test-benchmark-convex-support.
+  static constexpr size_t num_vertices_large_convex_threshold = 48;
 
   /// @brief An array of the points of the polygon.
   std::shared_ptr<std::vector<Vec3f>> points;
   unsigned int num_points;
 
+  /// @brief Number of points whose dot products with the support direction
+  /// are computed at once by the linear support function.
+  static constexpr Eigen::Index points_soa_block_size = 8;
+
+  typedef Eigen::Matrix<FCL_REAL, 3, Eigen::Dynamic, Eigen::RowMajor>
+      MatrixPointsSoA;
+
+  /// @brief The points stored as a structure of arrays: row i contains the
+  /// i-th coordinates of all the points. The columns are padded with copies of
+  /// the first point up to a multiple of points_soa_block_size.
+  /// It is built by ConvexBase::initialize and used by the linear support
+  /// function, which falls back to ConvexBase::points when
+  /// ConvexBase::isPointsSoAUpToDate returns false.
+  MatrixPointsSoA points_soa;
+
+  /// @brief The array of points from which ConvexBase::points_soa was built.
+  std::weak_ptr<std::vector<Vec3f>> points_soa_source;
+
+  /// @brief Rebuild ConvexBase::points_soa from ConvexBase::points.
+  /// It must be called after the points are modified in place, which cannot
+  /// be detected. When ConvexBase::points is replaced by another array, the
+  /// cache is ignored until this function is called.
+  void buildPointsSoA();
+
+  /// @brief Whether ConvexBase::points_soa was built from the current
+  /// ConvexBase::points array.
+  bool isPointsSoAUpToDate() const {
+    return points.get() && !points_soa_source.owner_before(points) &&
+           !points.owner_before(points_soa_source) &&
+           points_soa.cols() >= static_cast<Eigen::Index>(num_points);
+  }
+
   /// @brief An array of the normals of the polygon.
   std::shared_ptr<std::vector<Vec3f>> normals;
   /// @brief An array of the offsets to the normals of the polygon.
   /// Note: there are as many offsets as normals.
-  std::shared_ptr<std::vector<double>> offsets;
+  std::shared_ptr<std::vector<FCL_REAL>> offsets;
   unsigned int num_normals_and_offsets;
 
   /// @brief Neighbors of each vertex.
@@ -840,8 +875,8 @@ class HPP_FCL_DLLAPI ConvexBase : public ShapeBase {
         (offsets.get() && !(other.offsets.get())))
       return false;
     if (offsets.get() && other.offsets.get()) {
-      const std::vector<double>& offsets_ = *offsets;
-      const std::vector<double>& other_offsets_ = *(other.offsets);
+      const std::vector<FCL_REAL>& offsets_ = *offsets;
+      const std::vector<FCL_REAL>& other_offsets_ = *(other.offsets);
       for (unsigned int i = 0; i < num_normals_and_offsets; ++i) {
         if (offsets_[i] != other_offsets_[i]) return false;
       }
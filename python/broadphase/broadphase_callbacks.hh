@@ -41,6 +41,7 @@
 #include <hpp/fcl/broadphase/broadphase_callbacks.h>
 
 #include "../fcl.hh"
+#include "../utils/gil.hh"
 
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
@@ -54,8 +55,13 @@ struct CollisionCallBackBaseWrapper : CollisionCallBackBase,
                                       bp::wrapper<CollisionCallBackBase> {
   typedef CollisionCallBackBase Base;
 
-  void init() { this->get_override("init")(); }
+  // The callbacks may be called by a query which released the GIL.
+  void init() {
+    python::ScopedGILAcquire acquire;
+    this->get_override("init")();
+  }
   bool collide(CollisionObject* o1, CollisionObject* o2) {
+    python::ScopedGILAcquire acquire;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
     return this->get_override("collide")(o1, o2);
@@ -79,13 +85,18 @@ struct DistanceCallBackBaseWrapper : DistanceCallBackBase,
   typedef DistanceCallBackBase Base;
   typedef DistanceCallBackBaseWrapper Self;
 
-  void init() { this->get_override("init")(); }
+  // The callbacks may be called by a query which released the GIL.
+  void init() {
+    python::ScopedGILAcquire acquire;
+    this->get_override("init")();
+  }
   bool distance(CollisionObject* o1, CollisionObject* o2,
-                Eigen::Matrix<double, 1, 1>& dist) {
+                Eigen::Matrix<FCL_REAL, 1, 1>& dist) {
     return distance(o1, o2, dist.coeffRef(0, 0));
   }
 
   bool distance(CollisionObject* o1, CollisionObject* o2, FCL_REAL& dist) {
+    python::ScopedGILAcquire acquire;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
     return this->get_override("distance")(o1, o2, dist);
@@ -101,7 +112,7 @@ struct DistanceCallBackBaseWrapper : DistanceCallBackBase,
              bp::pure_virtual(
                  static_cast<bool (Self::*)(
                      CollisionObject* o1, CollisionObject* o2,
-                     Eigen::Matrix<double, 1, 1>& dist)>(&Self::distance)),
+                     Eigen::Matrix<FCL_REAL, 1, 1>& dist)>(&Self::distance)),
              doxygen::member_func_doc(&Base::distance))
         .def("__call__", &Base::operator(),
              doxygen::member_func_doc(&Base::operator()));
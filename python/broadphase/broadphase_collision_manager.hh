@@ -42,6 +42,7 @@
 #include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
 
 #include "../fcl.hh"
+#include "../utils/gil.hh"
 
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
@@ -79,6 +80,7 @@ struct BroadPhaseCollisionManagerWrapper
   void clear() { this->get_override("clear")(); }
 
   std::vector<CollisionObject *> getObjects() const {
+    python::ScopedGILAcquire acquire;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
     return this->get_override("getObjects")();
@@ -86,40 +88,81 @@ struct BroadPhaseCollisionManagerWrapper
   }
 
   void collide(CollisionCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("collide")(callback);
   }
   void collide(CollisionObject *obj, CollisionCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("collide")(obj, callback);
   }
   void collide(BroadPhaseCollisionManager *other_manager,
                CollisionCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("collide")(other_manager, callback);
   }
 
   void distance(DistanceCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("distance")(callback);
   }
   void distance(CollisionObject *obj, DistanceCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("collide")(obj, callback);
   }
   void distance(BroadPhaseCollisionManager *other_manager,
                 DistanceCallBackBase *callback) const {
+    python::ScopedGILAcquire acquire;
     this->get_override("collide")(other_manager, callback);
   }
 
   bool empty() const {
+    python::ScopedGILAcquire acquire;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
     return this->get_override("empty")();
 #pragma GCC diagnostic pop
   }
   size_t size() const {
+    python::ScopedGILAcquire acquire;
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
     return this->get_override("size")();
 #pragma GCC diagnostic pop
   }
 
+  // The queries release the GIL so that Python threads run them in parallel.
+  // The Python callbacks and managers acquire it back when they are called.
+  static void collideSelf(const Base &self, CollisionCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.collide(callback);
+  }
+  static void collideObject(const Base &self, CollisionObject *obj,
+                            CollisionCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.collide(obj, callback);
+  }
+  static void collideManager(const Base &self,
+                             BroadPhaseCollisionManager *other_manager,
+                             CollisionCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.collide(other_manager, callback);
+  }
+  static void distanceSelf(const Base &self, DistanceCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.distance(callback);
+  }
+  static void distanceObject(const Base &self, CollisionObject *obj,
+                             DistanceCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.distance(obj, callback);
+  }
+  static void distanceManager(const Base &self,
+                              BroadPhaseCollisionManager *other_manager,
+                              DistanceCallBackBase *callback) {
+    python::ScopedGILRelease release;
+    self.distance(other_manager, callback);
+  }
+
   static void expose() {
     bp::class_<BroadPhaseCollisionManagerWrapper, boost::noncopyable>(
         "BroadPhaseCollisionManager", bp::no_init)
@@ -166,47 +209,31 @@ struct BroadPhaseCollisionManagerWrapper
                 Base::getObjects),
             bp::with_custodian_and_ward_postcall<0, 1>())
 
-        .def(
-            "collide",
-            bp::pure_virtual((void(Base::*)(CollisionCallBackBase *) const) &
-                             Base::collide),
-            doxygen::member_func_doc(
-                (void(Base::*)(CollisionCallBackBase *) const) & Base::collide))
-        .def("collide",
-             bp::pure_virtual((void(Base::*)(CollisionObject *,
-                                             CollisionCallBackBase *) const) &
-                              Base::collide),
+        .def("collide", &collideSelf,
+             doxygen::member_func_doc(
+                 (void(Base::*)(CollisionCallBackBase *) const) &
+                 Base::collide))
+        .def("collide", &collideObject,
              doxygen::member_func_doc(
                  (void(Base::*)(CollisionObject *, CollisionCallBackBase *)
                       const) &
                  Base::collide))
-        .def("collide",
-             bp::pure_virtual((void(Base::*)(BroadPhaseCollisionManager *,
-                                             CollisionCallBackBase *) const) &
-                              Base::collide),
+        .def("collide", &collideManager,
              doxygen::member_func_doc(
                  (void(Base::*)(BroadPhaseCollisionManager *,
                                 CollisionCallBackBase *) const) &
                  Base::collide))
 
-        .def(
-            "distance",
-            bp::pure_virtual((void(Base::*)(DistanceCallBackBase *) const) &
-                             Base::distance),
-            doxygen::member_func_doc(
-                (void(Base::*)(DistanceCallBackBase *) const) & Base::distance))
-        .def("distance",
-             bp::pure_virtual((void(Base::*)(CollisionObject *,
-                                             DistanceCallBackBase *) const) &
-                              Base::distance),
+        .def("distance", &distanceSelf,
+             doxygen::member_func_doc(
+                 (void(Base::*)(DistanceCallBackBase *) const) &
+                 Base::distance))
+        .def("distance", &distanceObject,
              doxygen::member_func_doc(
                  (void(Base::*)(CollisionObject *, DistanceCallBackBase *)
                       const) &
                  Base::distance))
-        .def("distance",
-             bp::pure_virtual((void(Base::*)(BroadPhaseCollisionManager *,
-                                             DistanceCallBackBase *) const) &
-                              Base::distance),
+        .def("distance", &distanceManager,
              doxygen::member_func_doc(
                  (void(Base::*)(BroadPhaseCollisionManager *,
                                 DistanceCallBackBase *) const) &
@@ -79,7 +79,8 @@ typedef std::vector<Vec3f> Vec3fs;
 typedef std::vector<Triangle> Triangles;
 
 struct BVHModelBaseWrapper {
-  typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3;
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3, Eigen::RowMajor>
+      RowMatrixX3;
   typedef Eigen::Map<RowMatrixX3> MapRowMatrixX3;
   typedef Eigen::Ref<RowMatrixX3> RefRowMatrixX3;
 
@@ -112,6 +113,7 @@ void exposeBVHModel(const std::string& bvname) {
       .def(dv::init<BVH, const BVH&>())
       .DEF_CLASS_FUNC(BVH, getNumBVs)
       .DEF_CLASS_FUNC(BVH, makeParentRelative)
+      .DEF_CLASS_FUNC(BVH, optimizeTree)
       .DEF_CLASS_FUNC(BVHModelBase, memUsage)
       .def("clone", &BVH::clone, doxygen::member_func_doc(&BVH::clone),
            return_value_policy<manage_new_object>())
@@ -161,7 +163,8 @@ void exposeHeightField(const std::string& bvname) {
 }
 
 struct ConvexBaseWrapper {
-  typedef Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor> RowMatrixX3;
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 3, Eigen::RowMajor>
+      RowMatrixX3;
   typedef Eigen::Map<RowMatrixX3> MapRowMatrixX3;
   typedef Eigen::Ref<RowMatrixX3> RefRowMatrixX3;
   typedef Eigen::VectorXd VecOfDoubles;
@@ -189,7 +192,7 @@ struct ConvexBaseWrapper {
                           convex.num_normals_and_offsets, 3);
   }
 
-  static double offset(const ConvexBase& convex, unsigned int i) {
+  static FCL_REAL offset(const ConvexBase& convex, unsigned int i) {
     if (i >= convex.num_normals_and_offsets)
       throw std::out_of_range("index is out of range");
     return (*(convex.offsets))[i];
@@ -316,15 +319,20 @@ void exposeShapes() {
       .DEF_RO_CLASS_ATTRIB(ConvexBase, num_points)
       .DEF_RO_CLASS_ATTRIB(ConvexBase, num_normals_and_offsets)
       .def("point", &ConvexBaseWrapper::point, bp::args("self", "index"),
-           "Retrieve the point given by its index.",
+           "Retrieve the point given by its index. Call buildPointsSoA after "
+           "modifying it.",
            bp::return_internal_reference<>())
       .def("points", &ConvexBaseWrapper::point, bp::args("self", "index"),
            "Retrieve the point given by its index.",
            ::hpp::fcl::python::deprecated_member<
                bp::return_internal_reference<>>())
       .def("points", &ConvexBaseWrapper::points, bp::args("self"),
-           "Retrieve all the points.",
+           "Retrieve all the points. Call buildPointsSoA after modifying "
+           "them.",
            bp::with_custodian_and_ward_postcall<0, 1>())
+      .def("buildPointsSoA", &ConvexBase::buildPointsSoA, bp::args("self"),
+           "Rebuild the copy of the points used by the support function. "
+           "It must be called after the points are modified.")
       //    .add_property ("points",
       //                   bp::make_function(&ConvexBaseWrapper::points,bp::with_custodian_and_ward_postcall<0,1>()),
       //                   "Points of the convex.")
@@ -675,7 +683,10 @@ void exposeCollisionGeometries() {
                                                  &BVHModelBase::addSubModel))
       .def(dv::member_func<int (BVHModelBase::*)(const Vec3fs&)>(
           "addSubModel", &BVHModelBase::addSubModel))
-      .def(dv::member_func("endModel", &BVHModelBase::endModel))
+      .def(dv::member_func<int (BVHModelBase::*)()>("endModel",
+                                                    &BVHModelBase::endModel))
+      .def(dv::member_func<int (BVHModelBase::*)(unsigned int)>(
+          "endModel", &BVHModelBase::endModel))
       // Expose function to replace a BVH
       .def(dv::member_func("beginReplaceModel",
                            &BVHModelBase::beginReplaceModel))
@@ -44,6 +44,7 @@ HPP_FCL_COMPILER_DIAGNOSTIC_POP
 #include "fcl.hh"
 #include "deprecation.hh"
 #include "serializable.hh"
+#include "utils/gil.hh"
 
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
@@ -73,6 +74,34 @@ struct ContactWrapper {
   }
 };
 
+// The free queries release the GIL so that Python threads run them in
+// parallel.
+struct CollisionWrapper {
+  static std::size_t collideObjects(const CollisionObject* o1,
+                                    const CollisionObject* o2,
+                                    const CollisionRequest& request,
+                                    CollisionResult& result) {
+    ScopedGILRelease release;
+    return collide(o1, o2, request, result);
+  }
+  static std::size_t collideGeometries(const CollisionGeometry* o1,
+                                       const Transform3f& tf1,
+                                       const CollisionGeometry* o2,
+                                       const Transform3f& tf2,
+                                       const CollisionRequest& request,
+                                       CollisionResult& result) {
+    ScopedGILRelease release;
+    return collide(o1, tf1, o2, tf2, request, result);
+  }
+  static std::size_t call(const ComputeCollision& self,
+                          const Transform3f& tf1, const Transform3f& tf2,
+                          const CollisionRequest& request,
+                          CollisionResult& result) {
+    // Keeps the GIL, which serializes the calls on a shared ComputeCollision.
+    return self(tf1, tf2, request, result);
+  }
+};
+
 void exposeCollisionAPI() {
   if (!eigenpy::register_symbolic_link_to_registered_type<
           CollisionRequestFlag>()) {
@@ -130,6 +159,7 @@ void exposeCollisionAPI() {
         .DEF_RW_CLASS_ATTRIB(QueryRequest, epa_max_iterations)
         .DEF_RW_CLASS_ATTRIB(QueryRequest, epa_tolerance)
         .DEF_RW_CLASS_ATTRIB(QueryRequest, enable_timings)
+        .DEF_RW_CLASS_ATTRIB(QueryRequest, enable_front_list)
         .DEF_CLASS_FUNC(QueryRequest, updateGuess);
   }
   HPP_FCL_COMPILER_DIAGNOSTIC_POP
@@ -254,23 +284,26 @@ void exposeCollisionAPI() {
         .def(vector_indexing_suite<std::vector<CollisionResult> >());
   }
 
-  doxygen::def("collide",
-               static_cast<std::size_t (*)(
-                   const CollisionObject*, const CollisionObject*,
-                   const CollisionRequest&, CollisionResult&)>(&collide));
-  doxygen::def(
-      "collide",
-      static_cast<std::size_t (*)(const CollisionGeometry*, const Transform3f&,
-                                  const CollisionGeometry*, const Transform3f&,
-                                  const CollisionRequest&, CollisionResult&)>(
-          &collide));
+  def("collide", &CollisionWrapper::collideObjects,
+      doxygen::member_func_doc(static_cast<std::size_t (*)(
+                                   const CollisionObject*, const CollisionObject*,
+                                   const CollisionRequest&, CollisionResult&)>(
+          &collide)));
+  def("collide", &CollisionWrapper::collideGeometries,
+      doxygen::member_func_doc(
+          static_cast<std::size_t (*)(
+              const CollisionGeometry*, const Transform3f&,
+              const CollisionGeometry*, const Transform3f&,
+              const CollisionRequest&, CollisionResult&)>(&collide)));
 
   class_<ComputeCollision>("ComputeCollision",
                            doxygen::class_doc<ComputeCollision>(), no_init)
       .def(dv::init<ComputeCollision, const CollisionGeometry*,
                     const CollisionGeometry*>())
-      .def("__call__",
-           static_cast<std::size_t (ComputeCollision::*)(
-               const Transform3f&, const Transform3f&, const CollisionRequest&,
-               CollisionResult&) const>(&ComputeCollision::operator()));
+      .def("__call__", &CollisionWrapper::call,
+           doxygen::member_func_doc(
+               static_cast<std::size_t (ComputeCollision::*)(
+                   const Transform3f&, const Transform3f&,
+                   const CollisionRequest&, CollisionResult&) const>(
+                   &ComputeCollision::operator())));
 }
@@ -41,6 +41,7 @@
 #include "fcl.hh"
 #include "deprecation.hh"
 #include "serializable.hh"
+#include "utils/gil.hh"
 
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
@@ -56,6 +57,35 @@ using namespace hpp::fcl::python;
 
 namespace dv = doxygen::visitor;
 
+// The free queries release the GIL so that Python threads run them in
+// parallel.
+struct ContactPatchWrapper {
+  static void computeContactPatchObjects(
+      const CollisionObject* o1, const CollisionObject* o2,
+      const CollisionResult& collision_result,
+      const ContactPatchRequest& request, ContactPatchResult& result) {
+    ScopedGILRelease release;
+    computeContactPatch(o1, o2, collision_result, request, result);
+  }
+  static void computeContactPatchGeometries(
+      const CollisionGeometry* o1, const Transform3f& tf1,
+      const CollisionGeometry* o2, const Transform3f& tf2,
+      const CollisionResult& collision_result,
+      const ContactPatchRequest& request, ContactPatchResult& result) {
+    ScopedGILRelease release;
+    computeContactPatch(o1, tf1, o2, tf2, collision_result, request, result);
+  }
+  static void call(const ComputeContactPatch& self, const Transform3f& tf1,
+                   const Transform3f& tf2,
+                   const CollisionResult& collision_result,
+                   const ContactPatchRequest& request,
+                   ContactPatchResult& result) {
+    // Keeps the GIL, which serializes the calls on a shared
+    // ComputeContactPatch.
+    self(tf1, tf2, collision_result, request, result);
+  }
+};
+
 void exposeContactPatchAPI() {
   if (!eigenpy::register_symbolic_link_to_registered_type<
           ContactPatch::PatchDirection>()) {
@@ -133,17 +163,21 @@ void exposeContactPatchAPI() {
         .def(vector_indexing_suite<std::vector<ContactPatchResult>>());
   }
 
-  doxygen::def(
-      "computeContactPatch",
-      static_cast<void (*)(const CollisionObject*, const CollisionObject*,
-                           const CollisionResult&, const ContactPatchRequest&,
-                           ContactPatchResult&)>(&computeContactPatch));
-  doxygen::def(
-      "computeContactPatch",
-      static_cast<void (*)(const CollisionGeometry*, const Transform3f&,
-                           const CollisionGeometry*, const Transform3f&,
-                           const CollisionResult&, const ContactPatchRequest&,
-                           ContactPatchResult&)>(&computeContactPatch));
+  def("computeContactPatch",
+      &ContactPatchWrapper::computeContactPatchObjects,
+      doxygen::member_func_doc(
+          static_cast<void (*)(const CollisionObject*, const CollisionObject*,
+                               const CollisionResult&,
+                               const ContactPatchRequest&,
+                               ContactPatchResult&)>(&computeContactPatch)));
+  def("computeContactPatch",
+      &ContactPatchWrapper::computeContactPatchGeometries,
+      doxygen::member_func_doc(
+          static_cast<void (*)(const CollisionGeometry*, const Transform3f&,
+                               const CollisionGeometry*, const Transform3f&,
+                               const CollisionResult&,
+                               const ContactPatchRequest&,
+                               ContactPatchResult&)>(&computeContactPatch)));
 
   if (!eigenpy::register_symbolic_link_to_registered_type<
           ComputeContactPatch>()) {
@@ -152,10 +186,12 @@ void exposeContactPatchAPI() {
                                 no_init)
         .def(dv::init<ComputeContactPatch, const CollisionGeometry*,
                       const CollisionGeometry*>())
-        .def("__call__",
-             static_cast<void (ComputeContactPatch::*)(
-                 const Transform3f&, const Transform3f&, const CollisionResult&,
-                 const ContactPatchRequest&, ContactPatchResult&) const>(
-                 &ComputeContactPatch::operator()));
+        .def("__call__", &ContactPatchWrapper::call,
+             doxygen::member_func_doc(
+                 static_cast<void (ComputeContactPatch::*)(
+                     const Transform3f&, const Transform3f&,
+                     const CollisionResult&, const ContactPatchRequest&,
+                     ContactPatchResult&) const>(
+                     &ComputeContactPatch::operator())));
   }
 }
@@ -45,6 +45,7 @@ HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
 HPP_FCL_COMPILER_DIAGNOSTIC_POP
 
 #include "serializable.hh"
+#include "utils/gil.hh"
 
 #ifdef HPP_FCL_HAS_DOXYGEN_AUTODOC
 #include "doxygen_autodoc/functions.h"
@@ -64,6 +65,42 @@ struct DistanceResultWrapper {
   static Vec3f getNearestPoint2(const DistanceResult& res) {
     return res.nearest_points[1];
   }
+  static MatrixXf getDistanceDerivative(const DistanceResult& res) {
+    return res.dmin_distance_dtf;
+  }
+  static MatrixXf getNearestPoint1Derivative(const DistanceResult& res) {
+    return res.dnearest_points_dtf[0];
+  }
+  static MatrixXf getNearestPoint2Derivative(const DistanceResult& res) {
+    return res.dnearest_points_dtf[1];
+  }
+};
+
+// The free queries release the GIL so that Python threads run them in
+// parallel.
+struct DistanceWrapper {
+  static FCL_REAL distanceObjects(const CollisionObject* o1,
+                                  const CollisionObject* o2,
+                                  const DistanceRequest& request,
+                                  DistanceResult& result) {
+    ScopedGILRelease release;
+    return distance(o1, o2, request, result);
+  }
+  static FCL_REAL distanceGeometries(const CollisionGeometry* o1,
+                                     const Transform3f& tf1,
+                                     const CollisionGeometry* o2,
+                                     const Transform3f& tf2,
+                                     const DistanceRequest& request,
+                                     DistanceResult& result) {
+    ScopedGILRelease release;
+    return distance(o1, tf1, o2, tf2, request, result);
+  }
+  static FCL_REAL call(const ComputeDistance& self, const Transform3f& tf1,
+                       const Transform3f& tf2, const DistanceRequest& request,
+                       DistanceResult& result) {
+    // Keeps the GIL, which serializes the calls on a shared ComputeDistance.
+    return self(tf1, tf2, request, result);
+  }
 };
 
 void exposeDistanceAPI() {
@@ -108,6 +145,7 @@ void exposeDistanceAPI() {
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, enable_signed_distance)
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, rel_err)
         .DEF_RW_CLASS_ATTRIB(DistanceRequest, abs_err)
+        .DEF_RW_CLASS_ATTRIB(DistanceRequest, enable_derivatives)
         .def(SerializableVisitor<DistanceRequest>());
   }
   HPP_FCL_COMPILER_DIAGNOSTIC_POP
@@ -129,6 +167,15 @@ void exposeDistanceAPI() {
              doxygen::class_attrib_doc<DistanceResult>("nearest_points"))
         .def("getNearestPoint2", &DistanceResultWrapper::getNearestPoint2,
              doxygen::class_attrib_doc<DistanceResult>("nearest_points"))
+        .def("getDistanceDerivative",
+             &DistanceResultWrapper::getDistanceDerivative,
+             doxygen::class_attrib_doc<DistanceResult>("dmin_distance_dtf"))
+        .def("getNearestPoint1Derivative",
+             &DistanceResultWrapper::getNearestPoint1Derivative,
+             doxygen::class_attrib_doc<DistanceResult>("dnearest_points_dtf"))
+        .def("getNearestPoint2Derivative",
+             &DistanceResultWrapper::getNearestPoint2Derivative,
+             doxygen::class_attrib_doc<DistanceResult>("dnearest_points_dtf"))
         .DEF_RO_CLASS_ATTRIB(DistanceResult, nearest_points)
         .DEF_RO_CLASS_ATTRIB(DistanceResult, o1)
         .DEF_RO_CLASS_ATTRIB(DistanceResult, o2)
@@ -146,24 +193,30 @@ void exposeDistanceAPI() {
         .def(vector_indexing_suite<std::vector<DistanceResult> >());
   }
 
-  doxygen::def(
-      "distance",
-      static_cast<FCL_REAL (*)(const CollisionObject*, const CollisionObject*,
-                               const DistanceRequest&, DistanceResult&)>(
-          &distance));
-  doxygen::def(
-      "distance",
-      static_cast<FCL_REAL (*)(const CollisionGeometry*, const Transform3f&,
-                               const CollisionGeometry*, const Transform3f&,
-                               const DistanceRequest&, DistanceResult&)>(
-          &distance));
+  def("distance", &DistanceWrapper::distanceObjects,
+      doxygen::member_func_doc(
+          static_cast<FCL_REAL (*)(const CollisionObject*,
+                                   const CollisionObject*,
+                                   const DistanceRequest&, DistanceResult&)>(
+              &distance)));
+  def("distance", &DistanceWrapper::distanceGeometries,
+      doxygen::member_func_doc(
+          static_cast<FCL_REAL (*)(const CollisionGeometry*, const Transform3f&,
+                                   const CollisionGeometry*, const Transform3f&,
+                                   const DistanceRequest&, DistanceResult&)>(
+              &distance)));
+
+  def("computeDistanceDerivatives", &computeDistanceDerivatives,
+      doxygen::member_func_doc(&computeDistanceDerivatives));
 
   class_<ComputeDistance>("ComputeDistance",
                           doxygen::class_doc<ComputeDistance>(), no_init)
       .def(dv::init<ComputeDistance, const CollisionGeometry*,
                     const CollisionGeometry*>())
-      .def("__call__",
-           static_cast<FCL_REAL (ComputeDistance::*)(
-               const Transform3f&, const Transform3f&, const DistanceRequest&,
-               DistanceResult&) const>(&ComputeDistance::operator()));
+      .def("__call__", &DistanceWrapper::call,
+           doxygen::member_func_doc(
+               static_cast<FCL_REAL (ComputeDistance::*)(
+                   const Transform3f&, const Transform3f&,
+                   const DistanceRequest&, DistanceResult&) const>(
+                   &ComputeDistance::operator())));
 }
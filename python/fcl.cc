@@ -79,7 +79,16 @@ void exposeMeshLoader() {
         "CachedMeshLoader", doxygen::class_doc<MeshLoader>(),
         init<optional<NODE_TYPE> >(
             (arg("self"), arg("node_type")),
-            doxygen::constructor_doc<CachedMeshLoader, const NODE_TYPE&>()));
+            doxygen::constructor_doc<CachedMeshLoader, const NODE_TYPE&>()))
+        .def(init<NODE_TYPE, std::string>(
+            (arg("self"), arg("node_type"), arg("cache_directory")),
+            doxygen::constructor_doc<CachedMeshLoader, const NODE_TYPE&,
+                                     const std::string&>()))
+        .def(dv::member_func("setCacheDirectory",
+                             &CachedMeshLoader::setCacheDirectory))
+        .def("getCacheDirectory", &CachedMeshLoader::getCacheDirectory,
+             return_value_policy<copy_const_reference>(),
+             doxygen::member_func_doc(&CachedMeshLoader::getCacheDirectory));
   }
 }
 
@@ -156,6 +156,7 @@ void exposeGJK() {
         .value("DefaultGuess", GJKInitialGuess::DefaultGuess)
         .value("CachedGuess", GJKInitialGuess::CachedGuess)
         .value("BoundingVolumeGuess", GJKInitialGuess::BoundingVolumeGuess)
+        .value("CachedSimplex", GJKInitialGuess::CachedSimplex)
         .export_values();
   }
 
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#ifndef HPP_FCL_PYTHON_UTILS_GIL_H
+#define HPP_FCL_PYTHON_UTILS_GIL_H
+
+#include <Python.h>
+
+namespace hpp {
+namespace fcl {
+namespace python {
+
+/// @brief Release the Python global interpreter lock (GIL) for the lifetime
+/// of the object, so that other Python threads run while a C++ query is
+/// computed. No Python object may be accessed while it is alive.
+struct ScopedGILRelease {
+  ScopedGILRelease() : state(PyEval_SaveThread()) {}
+  ~ScopedGILRelease() { PyEval_RestoreThread(state); }
+
+ private:
+  ScopedGILRelease(const ScopedGILRelease&);
+  ScopedGILRelease& operator=(const ScopedGILRelease&);
+
+  PyThreadState* state;
+};
+
+/// @brief Acquire the GIL for the lifetime of the object, whether or not the
+/// calling thread already holds it. Used by the C++ methods which call Python
+/// overrides, since they may be reached from a query run by
+/// ScopedGILRelease.
+struct ScopedGILAcquire {
+  ScopedGILAcquire() : state(PyGILState_Ensure()) {}
+  ~ScopedGILAcquire() { PyGILState_Release(state); }
+
+ private:
+  ScopedGILAcquire(const ScopedGILAcquire&);
+  ScopedGILAcquire& operator=(const ScopedGILAcquire&);
+
+  PyGILState_STATE state;
+};
+
+}  // namespace python
+}  // namespace fcl
+}  // namespace hpp
+
+#endif  // ifndef HPP_FCL_PYTHON_UTILS_GIL_H
@@ -132,17 +132,26 @@ FCL_REAL AABB::distance(const AABB& other) const {
   return std::sqrt(result);
 }
 
+namespace {
+/// @brief AABB of b1 placed in configuration (R0, T0).
+/// Same as translate(rotate(b1, R0), T0), computed from the center and the
+/// half extents of b1 instead of its 8 corners.
+inline AABB transformAABB(const Matrix3f& R0, const Vec3f& T0, const AABB& b1) {
+  const Vec3f center(R0 * b1.center() + T0);
+  const Vec3f half_extents(R0.cwiseAbs() * ((b1.max_ - b1.min_) / 2));
+  return AABB(AABB(center), half_extents);
+}
+}  // namespace
+
 bool overlap(const Matrix3f& R0, const Vec3f& T0, const AABB& b1,
              const AABB& b2) {
-  AABB bb1(translate(rotate(b1, R0), T0));
-  return bb1.overlap(b2);
+  return transformAABB(R0, T0, b1).overlap(b2);
 }
 
 bool overlap(const Matrix3f& R0, const Vec3f& T0, const AABB& b1,
              const AABB& b2, const CollisionRequest& request,
              FCL_REAL& sqrDistLowerBound) {
-  AABB bb1(translate(rotate(b1, R0), T0));
-  return bb1.overlap(b2, request, sqrDistLowerBound);
+  return transformAABB(R0, T0, b1).overlap(b2, request, sqrDistLowerBound);
 }
 
 bool AABB::overlap(const Plane& p) const {
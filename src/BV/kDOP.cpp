@@ -237,6 +237,49 @@ KDOP<N> translate(const KDOP<N>& bv, const Vec3f& t) {
   return res;
 }
 
+namespace {
+/// @brief KDOP, in the identity frame, bounding b1 placed in configuration
+/// (R0, T0).
+/// b1 is bounded by the box defined by its AABB planes. Since the distances of
+/// a point to the KDOP planes are linear in the point, the planes of the KDOP
+/// are the projections of the box center, plus or minus the sums of the
+/// absolute projections of the half axes of the box.
+template <short N>
+KDOP<N> transformKDOP(const Matrix3f& R0, const Vec3f& T0, const KDOP<N>& b1) {
+  enum { P = ((N - 6) / 2) };
+  KDOP<N> res(R0 * b1.center() + T0);
+
+  const Vec3f half_extents(b1.width() / 2, b1.height() / 2, b1.depth() / 2);
+  FCL_REAL extents[N / 2] = {0};
+  FCL_REAL d[P];
+  for (Eigen::DenseIndex j = 0; j < 3; ++j) {
+    const Vec3f axis(R0.col(j) * half_extents[j]);
+    for (short i = 0; i < 3; ++i) extents[i] += std::abs(axis[i]);
+    getDistances<P>(axis, d);
+    for (short i = 0; i < P; ++i) extents[3 + i] += std::abs(d[i]);
+  }
+
+  for (short i = 0; i < N / 2; ++i) {
+    res.dist(i) -= extents[i];
+    res.dist(short(N / 2 + i)) += extents[i];
+  }
+  return res;
+}
+}  // namespace
+
+template <short N>
+bool overlap(const Matrix3f& R0, const Vec3f& T0, const KDOP<N>& b1,
+             const KDOP<N>& b2) {
+  return transformKDOP(R0, T0, b1).overlap(b2);
+}
+
+template <short N>
+bool overlap(const Matrix3f& R0, const Vec3f& T0, const KDOP<N>& b1,
+             const KDOP<N>& b2, const CollisionRequest& request,
+             FCL_REAL& sqrDistLowerBound) {
+  return transformKDOP(R0, T0, b1).overlap(b2, request, sqrDistLowerBound);
+}
+
 template class KDOP<16>;
 template class KDOP<18>;
 template class KDOP<24>;
@@ -245,6 +288,20 @@ template KDOP<16> translate<16>(const KDOP<16>&, const Vec3f&);
 template KDOP<18> translate<18>(const KDOP<18>&, const Vec3f&);
 template KDOP<24> translate<24>(const KDOP<24>&, const Vec3f&);
 
+template bool overlap<16>(const Matrix3f&, const Vec3f&, const KDOP<16>&,
+                          const KDOP<16>&);
+template bool overlap<18>(const Matrix3f&, const Vec3f&, const KDOP<18>&,
+                          const KDOP<18>&);
+template bool overlap<24>(const Matrix3f&, const Vec3f&, const KDOP<24>&,
+                          const KDOP<24>&);
+
+template bool overlap<16>(const Matrix3f&, const Vec3f&, const KDOP<16>&,
+                          const KDOP<16>&, const CollisionRequest&, FCL_REAL&);
+template bool overlap<18>(const Matrix3f&, const Vec3f&, const KDOP<18>&,
+                          const KDOP<18>&, const CollisionRequest&, FCL_REAL&);
+template bool overlap<24>(const Matrix3f&, const Vec3f&, const KDOP<24>&,
+                          const KDOP<24>&, const CollisionRequest&, FCL_REAL&);
+
 }  // namespace fcl
 
 }  // namespace hpp
@@ -38,8 +38,12 @@
 
 #include "hpp/fcl/BV/BV_node.h"
 #include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/BVH/BVH_wide.h>
+#include <hpp/fcl/internal/parallel.h>
 
 #include <iostream>
+#include <limits>
+#include <queue>
 #include <string.h>
 
 #include <hpp/fcl/BV/BV.h>
@@ -175,6 +179,10 @@ BVHModel<BV>::BVHModel(const BVHModel<BV>& other)
     bvs.reset(new bv_node_vector_t(*(other.bvs)));
   } else
     bvs.reset();
+  // The wide and compressed hierarchies are immutable and only refer to node
+  // indices.
+  wide_bvh = other.wide_bvh;
+  quantized_bvh = other.quantized_bvh;
 }
 
 int BVHModelBase::beginModel(unsigned int num_tris_,
@@ -505,7 +513,7 @@ int BVHModelBase::addSubModel(const std::vector<Vec3f>& ps,
   return BVH_OK;
 }
 
-int BVHModelBase::endModel() {
+int BVHModelBase::endModel(unsigned int num_threads) {
   if (build_state != BVH_BUILD_STATE_BEGUN) {
     std::cerr << "BVH Warning! Call endModel() in wrong order. endModel() was "
                  "ignored."
@@ -567,7 +575,7 @@ int BVHModelBase::endModel() {
   // construct BVH tree
   if (!allocateBVs()) return BVH_ERR_MODEL_OUT_OF_MEMORY;
 
-  buildTree();
+  buildTree(num_threads);
 
   // finish constructing
   build_state = BVH_BUILD_STATE_PROCESSED;
@@ -660,10 +668,10 @@ int BVHModelBase::endReplaceModel(bool refit, bool bottomup) {
 
   if (refit)  // refit, do not change BVH structure
   {
-    refitTree(bottomup);
+    refitTree(bottomup, 1);
   } else  // reconstruct bvh tree based on current frame data
   {
-    buildTree();
+    buildTree(1);
   }
 
   build_state = BVH_BUILD_STATE_PROCESSED;
@@ -747,7 +755,8 @@ int BVHModelBase::updateSubModel(const std::vector<Vec3f>& ps) {
   return BVH_OK;
 }
 
-int BVHModelBase::endUpdateModel(bool refit, bool bottomup) {
+int BVHModelBase::endUpdateModel(bool refit, bool bottomup,
+                                 unsigned int num_threads) {
   if (build_state != BVH_BUILD_STATE_UPDATE_BEGUN) {
     std::cerr << "BVH Warning! Call endUpdateModel() in a wrong order. "
                  "endUpdateModel() was ignored. "
@@ -764,14 +773,14 @@ int BVHModelBase::endUpdateModel(bool refit, bool bottomup) {
 
   if (refit)  // refit, do not change BVH structure
   {
-    refitTree(bottomup);
+    refitTree(bottomup, num_threads);
   } else  // reconstruct bvh tree based on current frame data
   {
-    buildTree();
+    buildTree(num_threads);
 
     // then refit
 
-    refitTree(bottomup);
+    refitTree(bottomup, num_threads);
   }
 
   build_state = BVH_BUILD_STATE_UPDATED;
@@ -779,6 +788,42 @@ int BVHModelBase::endUpdateModel(bool refit, bool bottomup) {
   return BVH_OK;
 }
 
+int BVHModelBase::updateVertices(const std::vector<unsigned int>& indices,
+                                 const std::vector<Vec3f>& ps) {
+  if (build_state != BVH_BUILD_STATE_PROCESSED &&
+      build_state != BVH_BUILD_STATE_UPDATED) {
+    std::cerr << "BVH Error! Call updateVertices() on a BVHModel whose "
+                 "hierarchy is not built."
+              << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  if (indices.size() != ps.size()) {
+    std::cerr << "BVH Error! updateVertices() needs one point per index."
+              << std::endl;
+    return BVH_ERR_INCORRECT_DATA;
+  }
+  for (std::size_t k = 0; k < indices.size(); ++k) {
+    if (indices[k] >= num_vertices) {
+      std::cerr << "BVH Error! updateVertices() got the index " << indices[k]
+                << " in a model with " << num_vertices << " vertices."
+                << std::endl;
+      return BVH_ERR_INCORRECT_DATA;
+    }
+  }
+
+  std::vector<Vec3f>& vertices_ = *vertices;
+  for (std::size_t k = 0; k < indices.size(); ++k) {
+    if (prev_vertices.get())
+      (*prev_vertices)[indices[k]] = vertices_[indices[k]];
+    vertices_[indices[k]] = ps[k];
+  }
+
+  const int res = refitVertices(indices);
+  build_state = BVH_BUILD_STATE_UPDATED;
+  return res;
+}
+
 void BVHModelBase::computeLocalAABB() {
   AABB aabb_;
   const std::vector<Vec3f>& vertices_ = *vertices;
@@ -811,6 +856,9 @@ BVHModel<BV>::BVHModel()
 template <typename BV>
 void BVHModel<BV>::deleteBVs() {
   bvs.reset();
+  wide_bvh.reset();
+  quantized_bvh.reset();
+  clearVertexLeaves();
   primitive_indices.reset();
   num_bvs_allocated = num_bvs = 0;
 }
@@ -839,7 +887,9 @@ bool BVHModel<BV>::allocateBVs() {
 
 template <typename BV>
 int BVHModel<BV>::memUsage(const bool msg) const {
-  unsigned int mem_bv_list = (unsigned int)sizeof(BV) * num_bvs;
+  unsigned int mem_bv_list =
+      isCompressed() ? (unsigned int)quantized_bvh->memUsage()
+                     : (unsigned int)sizeof(BV) * num_bvs;
   unsigned int mem_tri_list = (unsigned int)sizeof(Triangle) * num_tris;
   unsigned int mem_vertex_list = (unsigned int)sizeof(Vec3f) * num_vertices;
 
@@ -856,7 +906,11 @@ int BVHModel<BV>::memUsage(const bool msg) const {
 }
 
 template <typename BV>
-int BVHModel<BV>::buildTree() {
+int BVHModel<BV>::buildTree(unsigned int num_threads) {
+  wide_bvh.reset();
+  quantized_bvh.reset();
+  clearVertexLeaves();
+
   // set BVFitter
   Vec3f* vertices_ = vertices.get() ? vertices->data() : NULL;
   Triangle* tri_indices_ = tri_indices.get() ? tri_indices->data() : NULL;
@@ -864,8 +918,6 @@ int BVHModel<BV>::buildTree() {
   // set SplitRule
   bv_splitter->set(vertices_, tri_indices_, getModelType());
 
-  num_bvs = 1;
-
   unsigned int num_primitives = 0;
   switch (getModelType()) {
     case BVH_MODEL_TRIANGLES:
@@ -881,17 +933,76 @@ int BVHModel<BV>::buildTree() {
 
   std::vector<unsigned int>& primitive_indices_ = *primitive_indices;
   for (unsigned int i = 0; i < num_primitives; ++i) primitive_indices_[i] = i;
-  recursiveBuildTree(0, 0, num_primitives);
+
+  // A subtree is built by a single thread, the first levels are split
+  // serially until there are enough subtrees for all the threads.
+  struct Subtree {
+    int bv_id, first_child;
+    unsigned int first_primitive, num_primitives;
+  };
+  static const unsigned int min_primitives_per_thread = 1024;
+  const unsigned int num_workers = internal::getNumWorkers(
+      num_threads, num_primitives / min_primitives_per_thread);
+  std::vector<Subtree> subtrees(1);
+  subtrees[0].bv_id = 0;
+  subtrees[0].first_child = 1;
+  subtrees[0].first_primitive = 0;
+  subtrees[0].num_primitives = num_primitives;
+  int res = BVH_OK;
+  if (num_workers > 1) {
+    bv_fitter->setNumThreads(num_workers);
+    std::vector<Subtree> children;
+    while (!subtrees.empty() && subtrees.size() < 4 * num_workers &&
+           res == BVH_OK) {
+      children.clear();
+      for (std::size_t k = 0; k < subtrees.size() && res == BVH_OK; ++k) {
+        const Subtree& st = subtrees[k];
+        unsigned int num_first_half;
+        res = splitNode(*bv_splitter, st.bv_id, st.first_primitive,
+                        st.num_primitives, num_first_half);
+        if (st.num_primitives == 1) continue;
+        (*bvs)[(size_t)st.bv_id].first_child = st.first_child;
+        const Subtree left = {st.first_child, st.first_child + 2,
+                              st.first_primitive, num_first_half};
+        const Subtree right = {
+            st.first_child + 1, st.first_child + 2 * (int)num_first_half,
+            st.first_primitive + num_first_half,
+            st.num_primitives - num_first_half};
+        children.push_back(left);
+        children.push_back(right);
+      }
+      subtrees.swap(children);
+    }
+    bv_fitter->setNumThreads(1);
+  }
+
+  std::vector<int> results(subtrees.size(), BVH_OK);
+  internal::parallelFor(
+      subtrees.size(),
+      internal::getNumWorkers(num_workers, subtrees.size()),
+      [&](unsigned int, std::size_t k) {
+        // computeRule stores the split rule in the splitter.
+        BVSplitter<BV> splitter(*bv_splitter);
+        const Subtree& st = subtrees[k];
+        results[k] =
+            recursiveBuildTree(splitter, st.bv_id, st.first_primitive,
+                               st.num_primitives, st.first_child);
+      });
+  for (std::size_t k = 0; k < results.size() && res == BVH_OK; ++k)
+    res = results[k];
+  num_bvs = 2 * num_primitives - 1;
 
   bv_fitter->clear();
   bv_splitter->clear();
 
-  return BVH_OK;
+  return res;
 }
 
 template <typename BV>
-int BVHModel<BV>::recursiveBuildTree(int bv_id, unsigned int first_primitive,
-                                     unsigned int num_primitives) {
+int BVHModel<BV>::splitNode(BVSplitter<BV>& splitter, int bv_id,
+                            unsigned int first_primitive,
+                            unsigned int num_primitives,
+                            unsigned int& num_first_half) {
   BVHModelType type = getModelType();
   BVNode<BV>* bvnode = bvs->data() + bv_id;
   unsigned int* cur_primitive_indices =
@@ -899,7 +1010,7 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, unsigned int first_primitive,
 
   // constructing BV
   BV bv = bv_fitter->fit(cur_primitive_indices, num_primitives);
-  bv_splitter->computeRule(bv, cur_primitive_indices, num_primitives);
+  splitter.computeRule(bv, cur_primitive_indices, num_primitives);
 
   bvnode->bv = bv;
   bvnode->first_primitive = first_primitive;
@@ -907,155 +1018,585 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, unsigned int first_primitive,
 
   if (num_primitives == 1) {
     bvnode->first_child = -((int)(*cur_primitive_indices) + 1);
-  } else {
-    bvnode->first_child = (int)num_bvs;
-    num_bvs += 2;
-
-    unsigned int c1 = 0;
-    const std::vector<Vec3f>& vertices_ = *vertices;
-    const std::vector<Triangle>& tri_indices_ = *tri_indices;
-    for (unsigned int i = 0; i < num_primitives; ++i) {
-      Vec3f p;
-      if (type == BVH_MODEL_POINTCLOUD)
-        p = vertices_[cur_primitive_indices[i]];
-      else if (type == BVH_MODEL_TRIANGLES) {
-        const Triangle& t = tri_indices_[cur_primitive_indices[i]];
-        const Vec3f& p1 = vertices_[t[0]];
-        const Vec3f& p2 = vertices_[t[1]];
-        const Vec3f& p3 = vertices_[t[2]];
-
-        p = (p1 + p2 + p3) / 3.;
-      } else {
-        std::cerr << "BVH Error: Model type not supported!" << std::endl;
-        return BVH_ERR_UNSUPPORTED_FUNCTION;
-      }
+    num_first_half = 0;
+    return BVH_OK;
+  }
 
-      // loop invariant: up to (but not including) index c1 in group 1,
-      // then up to (but not including) index i in group 2
-      //
-      //  [1] [1] [1] [1] [2] [2] [2] [x] [x] ... [x]
-      //                   c1          i
-      //
-      if (bv_splitter->apply(p))  // in the right side
-      {
-        // do nothing
-      } else {
-        unsigned int temp = cur_primitive_indices[i];
-        cur_primitive_indices[i] = cur_primitive_indices[c1];
-        cur_primitive_indices[c1] = temp;
-        c1++;
-      }
+  unsigned int c1 = 0;
+  const std::vector<Vec3f>& vertices_ = *vertices;
+  const std::vector<Triangle>& tri_indices_ = *tri_indices;
+  for (unsigned int i = 0; i < num_primitives; ++i) {
+    Vec3f p;
+    if (type == BVH_MODEL_POINTCLOUD)
+      p = vertices_[cur_primitive_indices[i]];
+    else if (type == BVH_MODEL_TRIANGLES) {
+      const Triangle& t = tri_indices_[cur_primitive_indices[i]];
+      const Vec3f& p1 = vertices_[t[0]];
+      const Vec3f& p2 = vertices_[t[1]];
+      const Vec3f& p3 = vertices_[t[2]];
+
+      p = (p1 + p2 + p3) / 3.;
+    } else {
+      std::cerr << "BVH Error: Model type not supported!" << std::endl;
+      return BVH_ERR_UNSUPPORTED_FUNCTION;
     }
 
-    if ((c1 == 0) || (c1 == num_primitives)) c1 = num_primitives / 2;
-
-    const unsigned int num_first_half = c1;
-
-    recursiveBuildTree(bvnode->leftChild(), first_primitive, num_first_half);
-    recursiveBuildTree(bvnode->rightChild(), first_primitive + num_first_half,
-                       num_primitives - num_first_half);
+    // loop invariant: up to (but not including) index c1 in group 1,
+    // then up to (but not including) index i in group 2
+    //
+    //  [1] [1] [1] [1] [2] [2] [2] [x] [x] ... [x]
+    //                   c1          i
+    //
+    if (splitter.apply(p))  // in the right side
+    {
+      // do nothing
+    } else {
+      unsigned int temp = cur_primitive_indices[i];
+      cur_primitive_indices[i] = cur_primitive_indices[c1];
+      cur_primitive_indices[c1] = temp;
+      c1++;
+    }
   }
 
+  if ((c1 == 0) || (c1 == num_primitives)) c1 = num_primitives / 2;
+
+  num_first_half = c1;
   return BVH_OK;
 }
 
 template <typename BV>
-int BVHModel<BV>::refitTree(bool bottomup) {
+int BVHModel<BV>::recursiveBuildTree(BVSplitter<BV>& splitter, int bv_id,
+                                     unsigned int first_primitive,
+                                     unsigned int num_primitives,
+                                     int first_child) {
+  unsigned int num_first_half;
+  int res = splitNode(splitter, bv_id, first_primitive, num_primitives,
+                      num_first_half);
+  if (res != BVH_OK || num_primitives == 1) return res;
+
+  (*bvs)[(size_t)bv_id].first_child = first_child;
+  // The left subtree has 2 * num_first_half - 1 nodes.
+  res = recursiveBuildTree(splitter, first_child, first_primitive,
+                           num_first_half, first_child + 2);
+  if (res != BVH_OK) return res;
+  return recursiveBuildTree(splitter, first_child + 1,
+                            first_primitive + num_first_half,
+                            num_primitives - num_first_half,
+                            first_child + 2 * (int)num_first_half);
+}
+
+template <typename BV>
+int BVHModel<BV>::refitTree(bool bottomup, unsigned int num_threads) {
+  wide_bvh.reset();
+  decompressBVH();
   if (bottomup)
-    return refitTree_bottomup();
+    return refitTree_bottomup(num_threads);
   else
-    return refitTree_topdown();
+    return refitTree_topdown(num_threads);
 }
 
 template <typename BV>
-int BVHModel<BV>::refitTree_bottomup() {
+int BVHModel<BV>::refitTree_bottomup(unsigned int num_threads) {
   // TODO the recomputation of the BV is done manually, without using
   // bv_fitter. The manual BV recomputation seems bugged. Using bv_fitter
   // seems to correct the bug.
   // bv_fitter->set(vertices, tri_indices, getModelType());
 
-  int res = recursiveRefitTree_bottomup(0);
+  static const unsigned int min_bvs_per_thread = 2048;
+  const unsigned int num_workers =
+      internal::getNumWorkers(num_threads, num_bvs / min_bvs_per_thread);
+  if (num_workers <= 1) return recursiveRefitTree_bottomup(0);
+
+  // The first levels are split serially until there are enough subtrees for
+  // all the threads. Each subtree is refitted by a single thread, and then
+  // the nodes above them.
+  const bv_node_vector_t& bvs_ = *bvs;
+  std::vector<int> top, subtrees(1, 0), children;
+  while (subtrees.size() < 4 * num_workers) {
+    children.clear();
+    for (std::size_t k = 0; k < subtrees.size(); ++k) {
+      const BVNode<BV>& node = bvs_[(size_t)subtrees[k]];
+      if (node.isLeaf()) {
+        children.push_back(subtrees[k]);
+      } else {
+        top.push_back(subtrees[k]);
+        children.push_back(node.leftChild());
+        children.push_back(node.rightChild());
+      }
+    }
+    const bool split = children.size() > subtrees.size();
+    subtrees.swap(children);
+    if (!split) break;
+  }
+
+  std::vector<int> results(subtrees.size(), BVH_OK);
+  internal::parallelFor(
+      subtrees.size(), internal::getNumWorkers(num_workers, subtrees.size()),
+      [&](unsigned int, std::size_t k) {
+        results[k] = recursiveRefitTree_bottomup(subtrees[k]);
+      });
+  int res = BVH_OK;
+  for (std::size_t k = 0; k < results.size() && res == BVH_OK; ++k)
+    res = results[k];
+
+  // The children of the nodes of top follow them in top.
+  for (std::size_t k = top.size(); k-- > 0;) {
+    BVNode<BV>& bvnode = (*bvs)[(size_t)top[k]];
+    bvnode.bv = bvs_[(size_t)bvnode.leftChild()].bv +
+                bvs_[(size_t)bvnode.rightChild()].bv;
+  }
 
   // bv_fitter->clear();
   return res;
 }
 
+template <typename BV>
+int BVHModel<BV>::refitLeaf(int bv_id) {
+  BVNode<BV>* bvnode = bvs->data() + bv_id;
+  BVHModelType type = getModelType();
+  int primitive_id = -(bvnode->first_child + 1);
+  if (type == BVH_MODEL_POINTCLOUD) {
+    BV bv;
+
+    if (prev_vertices.get()) {
+      Vec3f v[2];
+      v[0] = (*prev_vertices)[static_cast<size_t>(primitive_id)];
+      v[1] = (*vertices)[static_cast<size_t>(primitive_id)];
+      fit(v, 2, bv);
+    } else
+      fit(vertices->data() + primitive_id, 1, bv);
+
+    bvnode->bv = bv;
+  } else if (type == BVH_MODEL_TRIANGLES) {
+    BV bv;
+    const Triangle& triangle =
+        (*tri_indices)[static_cast<size_t>(primitive_id)];
+
+    if (prev_vertices.get()) {
+      Vec3f v[6];
+      for (Triangle::index_type i = 0; i < 3; ++i) {
+        v[i] = (*prev_vertices)[triangle[i]];
+        v[i + 3] = (*vertices)[triangle[i]];
+      }
+
+      fit(v, 6, bv);
+    } else {
+      // TODO use bv_fitter to build BV. See comment in refitTree_bottomup
+      // unsigned int* cur_primitive_indices = primitive_indices +
+      // bvnode->first_primitive; bv = bv_fitter->fit(cur_primitive_indices,
+      // bvnode->num_primitives);
+      Vec3f v[3];
+      for (int i = 0; i < 3; ++i) {
+        v[i] = (*vertices)[triangle[(Triangle::index_type)i]];
+      }
+
+      fit(v, 3, bv);
+    }
+
+    bvnode->bv = bv;
+  } else {
+    std::cerr << "BVH Error: Model type not supported!" << std::endl;
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+  return BVH_OK;
+}
+
 template <typename BV>
 int BVHModel<BV>::recursiveRefitTree_bottomup(int bv_id) {
   BVNode<BV>* bvnode = bvs->data() + bv_id;
-  if (bvnode->isLeaf()) {
-    BVHModelType type = getModelType();
-    int primitive_id = -(bvnode->first_child + 1);
-    if (type == BVH_MODEL_POINTCLOUD) {
-      BV bv;
-
-      if (prev_vertices.get()) {
-        Vec3f v[2];
-        v[0] = (*prev_vertices)[static_cast<size_t>(primitive_id)];
-        v[1] = (*vertices)[static_cast<size_t>(primitive_id)];
-        fit(v, 2, bv);
-      } else
-        fit(vertices->data() + primitive_id, 1, bv);
-
-      bvnode->bv = bv;
-    } else if (type == BVH_MODEL_TRIANGLES) {
-      BV bv;
-      const Triangle& triangle =
-          (*tri_indices)[static_cast<size_t>(primitive_id)];
-
-      if (prev_vertices.get()) {
-        Vec3f v[6];
-        for (Triangle::index_type i = 0; i < 3; ++i) {
-          v[i] = (*prev_vertices)[triangle[i]];
-          v[i + 3] = (*vertices)[triangle[i]];
-        }
+  if (bvnode->isLeaf()) return refitLeaf(bv_id);
+
+  const int res = recursiveRefitTree_bottomup(bvnode->leftChild());
+  recursiveRefitTree_bottomup(bvnode->rightChild());
+  bvnode->bv = (*bvs)[static_cast<size_t>(bvnode->leftChild())].bv +
+               (*bvs)[static_cast<size_t>(bvnode->rightChild())].bv;
+  // TODO use bv_fitter to build BV. See comment in refitTree_bottomup
+  // unsigned int* cur_primitive_indices = primitive_indices +
+  // bvnode->first_primitive; bvnode->bv =
+  // bv_fitter->fit(cur_primitive_indices, bvnode->num_primitives);
+  return res;
+}
 
-        fit(v, 6, bv);
+template <typename BV>
+int BVHModel<BV>::refitVertices(const std::vector<unsigned int>& indices) {
+  wide_bvh.reset();
+  decompressBVH();
+  const bv_node_vector_t& bvs_ = *bvs;
+  if (bv_parents.empty()) {
+    bv_parents.assign(num_bvs, -1);
+    std::vector<unsigned int> primitive_leaves(
+        getModelType() == BVH_MODEL_TRIANGLES ? num_tris : num_vertices);
+    for (unsigned int i = 0; i < num_bvs; ++i) {
+      const BVNode<BV>& node = bvs_[i];
+      if (node.isLeaf()) {
+        primitive_leaves[(size_t)node.primitiveId()] = i;
       } else {
-        // TODO use bv_fitter to build BV. See comment in refitTree_bottomup
-        // unsigned int* cur_primitive_indices = primitive_indices +
-        // bvnode->first_primitive; bv = bv_fitter->fit(cur_primitive_indices,
-        // bvnode->num_primitives);
-        Vec3f v[3];
-        for (int i = 0; i < 3; ++i) {
-          v[i] = (*vertices)[triangle[(Triangle::index_type)i]];
-        }
+        bv_parents[(size_t)node.leftChild()] = (int)i;
+        bv_parents[(size_t)node.rightChild()] = (int)i;
+      }
+    }
 
-        fit(v, 3, bv);
+    vertex_leaves_offsets.assign(num_vertices + 1, 0);
+    if (getModelType() == BVH_MODEL_TRIANGLES) {
+      const std::vector<Triangle>& tri_indices_ = *tri_indices;
+      for (unsigned int i = 0; i < num_tris; ++i)
+        for (Triangle::index_type j = 0; j < 3; ++j)
+          ++vertex_leaves_offsets[tri_indices_[i][j] + 1];
+      for (unsigned int i = 0; i < num_vertices; ++i)
+        vertex_leaves_offsets[i + 1] += vertex_leaves_offsets[i];
+      vertex_leaves.resize(vertex_leaves_offsets[num_vertices]);
+      std::vector<unsigned int> next(vertex_leaves_offsets.begin(),
+                                     vertex_leaves_offsets.end() - 1);
+      for (unsigned int i = 0; i < num_tris; ++i)
+        for (Triangle::index_type j = 0; j < 3; ++j)
+          vertex_leaves[next[tri_indices_[i][j]]++] = primitive_leaves[i];
+    } else {
+      for (unsigned int i = 0; i < num_vertices; ++i)
+        vertex_leaves_offsets[i + 1] = i + 1;
+      vertex_leaves.swap(primitive_leaves);
+    }
+  }
+
+  // Nodes to refit, by decreasing index. The children of a node have a
+  // greater index than the node, so that it is refitted after them, and only
+  // once.
+  std::priority_queue<int> nodes;
+  for (std::size_t k = 0; k < indices.size(); ++k)
+    for (unsigned int l = vertex_leaves_offsets[indices[k]];
+         l < vertex_leaves_offsets[indices[k] + 1]; ++l)
+      nodes.push((int)vertex_leaves[l]);
+
+  int res = BVH_OK, last = -1;
+  while (!nodes.empty()) {
+    const int n = nodes.top();
+    nodes.pop();
+    if (n == last) continue;
+    last = n;
+    BVNode<BV>& bvnode = (*bvs)[(size_t)n];
+    if (bvnode.isLeaf()) {
+      const int leaf_res = refitLeaf(n);
+      if (res == BVH_OK) res = leaf_res;
+    } else
+      bvnode.bv = bvs_[(size_t)bvnode.leftChild()].bv +
+                  bvs_[(size_t)bvnode.rightChild()].bv;
+    if (bv_parents[(size_t)n] >= 0) nodes.push(bv_parents[(size_t)n]);
+  }
+  return res;
+}
+
+namespace internal {
+inline FCL_REAL surfaceArea(const AABB& box) {
+  const Vec3f d = box.max_ - box.min_;
+  return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+}
+
+/// Tree rotations of Kensler, "Tree Rotations for Improving Bounding Volume
+/// Hierarchies", 2008, applied in post order below node n.
+/// @return whether a rotation was applied.
+inline bool rotateTree(int n, std::vector<int>& left, std::vector<int>& right,
+                       std::vector<AABB>& boxes) {
+  if (left[n] < 0) return false;
+  bool rotated = rotateTree(left[n], left, right, boxes);
+  rotated = rotateTree(right[n], left, right, boxes) || rotated;
+
+  // Candidate swaps of a child of n with a grandchild on the other side. Only
+  // the area of the other child changes.
+  const int l = left[n], r = right[n];
+  int* best_child = NULL;
+  int* best_grandchild = NULL;
+  int best_node = -1;
+  AABB best_box;
+  FCL_REAL best_gain = 1e-6 * surfaceArea(boxes[n]);
+  for (int side = 0; side < 2; ++side) {
+    int& child = (side == 0) ? left[n] : right[n];
+    const int other = (side == 0) ? r : l;
+    if (left[other] < 0) continue;
+    for (int g = 0; g < 2; ++g) {
+      int& grandchild = (g == 0) ? left[other] : right[other];
+      const int kept = (g == 0) ? right[other] : left[other];
+      const AABB box = boxes[child] + boxes[kept];
+      const FCL_REAL gain = surfaceArea(boxes[other]) - surfaceArea(box);
+      if (gain > best_gain) {
+        best_gain = gain;
+        best_child = &child;
+        best_grandchild = &grandchild;
+        best_node = other;
+        best_box = box;
       }
+    }
+  }
+  if (best_node < 0) return rotated;
+  std::swap(*best_child, *best_grandchild);
+  boxes[best_node] = best_box;
+  return true;
+}
+}  // namespace internal
+
+template <typename BV>
+int BVHModel<BV>::optimizeTree() {
+  if (build_state != BVH_BUILD_STATE_PROCESSED &&
+      build_state != BVH_BUILD_STATE_UPDATED) {
+    std::cerr << "BVH Error! Call optimizeTree() on a BVHModel whose "
+                 "hierarchy is not built."
+              << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+  wide_bvh.reset();
+  decompressBVH();
+  if (num_bvs < 5) return BVH_OK;
 
-      bvnode->bv = bv;
+  // Explicit topology of the tree, and boxes of the primitives of each node.
+  // The children of a node have a greater index than the node.
+  const bv_node_vector_t& bvs_ = *bvs;
+  const std::vector<Vec3f>& vertices_ = *vertices;
+  std::vector<int> left(num_bvs, -1), right(num_bvs, -1);
+  std::vector<AABB> boxes(num_bvs);
+  for (int i = (int)num_bvs - 1; i >= 0; --i) {
+    const BVNode<BV>& node = bvs_[(size_t)i];
+    if (node.isLeaf()) {
+      const unsigned int primitive = (unsigned int)node.primitiveId();
+      if (getModelType() == BVH_MODEL_TRIANGLES) {
+        const Triangle& t = (*tri_indices)[primitive];
+        boxes[(size_t)i] =
+            AABB(vertices_[t[0]], vertices_[t[1]], vertices_[t[2]]);
+      } else
+        boxes[(size_t)i] = AABB(vertices_[primitive]);
     } else {
-      std::cerr << "BVH Error: Model type not supported!" << std::endl;
-      return BVH_ERR_UNSUPPORTED_FUNCTION;
+      left[(size_t)i] = node.leftChild();
+      right[(size_t)i] = node.rightChild();
+      boxes[(size_t)i] = boxes[(size_t)node.leftChild()] +
+                         boxes[(size_t)node.rightChild()];
+    }
+  }
+
+  static const int max_passes = 8;
+  bool rotated = false;
+  for (int pass = 0; pass < max_passes; ++pass) {
+    if (!internal::rotateTree(0, left, right, boxes)) break;
+    rotated = true;
+  }
+  if (!rotated) return BVH_OK;
+  clearVertexLeaves();
+
+  // Lay the tree out again, in the same order as recursiveBuildTree.
+  Vec3f* vertices_ptr = vertices->data();
+  Triangle* tri_indices_ptr = tri_indices.get() ? tri_indices->data() : NULL;
+  bv_fitter->set(vertices_ptr, tri_indices_ptr, getModelType());
+  const bv_node_vector_t old_bvs(bvs_.begin(), bvs_.begin() + num_bvs);
+  num_bvs = 1;
+  recursiveRelayoutTree(old_bvs, left, right, 0, 0, 0);
+  bv_fitter->clear();
+
+  return BVH_OK;
+}
+
+template <typename BV>
+unsigned int BVHModel<BV>::recursiveRelayoutTree(
+    const bv_node_vector_t& old_bvs, const std::vector<int>& left,
+    const std::vector<int>& right, int old_id, int bv_id,
+    unsigned int first_primitive) {
+  const BVNode<BV>& old_node = old_bvs[(size_t)old_id];
+  BVNode<BV>& bvnode = (*bvs)[(size_t)bv_id];
+  bvnode.first_primitive = first_primitive;
+  if (left[(size_t)old_id] < 0) {
+    bvnode.bv = old_node.bv;
+    bvnode.first_child = old_node.first_child;
+    bvnode.num_primitives = 1;
+    (*primitive_indices)[first_primitive] =
+        (unsigned int)old_node.primitiveId();
+    return 1;
+  }
+
+  const int first_child = (int)num_bvs;
+  num_bvs += 2;
+  const unsigned int num_left =
+      recursiveRelayoutTree(old_bvs, left, right, left[(size_t)old_id],
+                            first_child, first_primitive);
+  const unsigned int num_right = recursiveRelayoutTree(
+      old_bvs, left, right, right[(size_t)old_id], first_child + 1,
+      first_primitive + num_left);
+
+  bvnode.first_child = first_child;
+  bvnode.num_primitives = num_left + num_right;
+  bvnode.bv = bv_fitter->fit(primitive_indices->data() + first_primitive,
+                             bvnode.num_primitives);
+  return bvnode.num_primitives;
+}
+
+namespace internal {
+template <typename BV, bool Supported = WideBVHSupport<BV>::value>
+struct WideBVHBuilder {
+  static WideBVH<BV>* run(const BVHModel<BV>&, unsigned int) {
+    HPP_FCL_THROW_PRETTY(
+        "Wide hierarchies are only supported for OBB and OBBRSS.",
+        std::invalid_argument);
+  }
+};
+
+template <typename BV>
+struct WideBVHBuilder<BV, true> {
+  static WideBVH<BV>* run(const BVHModel<BV>& model, unsigned int width) {
+    return new WideBVH<BV>(model, width);
+  }
+};
+}  // namespace internal
+
+template <typename BV>
+int BVHModel<BV>::reorderPrimitives(std::vector<unsigned int>* primitive_order,
+                                    std::vector<unsigned int>* vertex_order) {
+  if (build_state != BVH_BUILD_STATE_PROCESSED &&
+      build_state != BVH_BUILD_STATE_UPDATED) {
+    std::cerr << "BVH Error! Call reorderPrimitives() on a BVHModel whose "
+                 "hierarchy is not built."
+              << std::endl;
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+  decompressBVH();
+  wide_bvh.reset();
+  clearVertexLeaves();
+
+  // The leaves are ordered by first_primitive, hence the primitives in the
+  // order of primitive_indices follow the leaves.
+  const bool triangles = getModelType() == BVH_MODEL_TRIANGLES;
+  const unsigned int num_primitives = triangles ? num_tris : num_vertices;
+  std::vector<unsigned int>& primitive_indices_ = *primitive_indices;
+  std::vector<unsigned int> old_vertex;
+  old_vertex.reserve(num_vertices);
+  if (triangles) {
+    static const unsigned int unused =
+        (std::numeric_limits<unsigned int>::max)();
+    std::vector<unsigned int> new_vertex(num_vertices, unused);
+    shared_ptr<std::vector<Triangle>> new_tris(
+        new std::vector<Triangle>(num_tris));
+    for (unsigned int k = 0; k < num_tris; ++k) {
+      const Triangle& t = (*tri_indices)[primitive_indices_[k]];
+      Triangle& new_t = (*new_tris)[k];
+      for (Triangle::index_type j = 0; j < 3; ++j) {
+        if (new_vertex[t[j]] == unused) {
+          new_vertex[t[j]] = (unsigned int)old_vertex.size();
+          old_vertex.push_back((unsigned int)t[j]);
+        }
+        new_t[j] = new_vertex[t[j]];
+      }
     }
+    for (unsigned int v = 0; v < num_vertices; ++v)
+      if (new_vertex[v] == unused) old_vertex.push_back(v);
+    tri_indices = new_tris;
   } else {
-    recursiveRefitTree_bottomup(bvnode->leftChild());
-    recursiveRefitTree_bottomup(bvnode->rightChild());
-    bvnode->bv = (*bvs)[static_cast<size_t>(bvnode->leftChild())].bv +
-                 (*bvs)[static_cast<size_t>(bvnode->rightChild())].bv;
-    // TODO use bv_fitter to build BV. See comment in refitTree_bottomup
-    // unsigned int* cur_primitive_indices = primitive_indices +
-    // bvnode->first_primitive; bvnode->bv =
-    // bv_fitter->fit(cur_primitive_indices, bvnode->num_primitives);
+    old_vertex.assign(primitive_indices_.begin(),
+                      primitive_indices_.begin() + num_vertices);
   }
 
+  // New arrays are allocated, since a convex representation may share the
+  // former vertices.
+  shared_ptr<std::vector<Vec3f>> new_vertices(
+      new std::vector<Vec3f>(num_vertices));
+  for (unsigned int v = 0; v < num_vertices; ++v)
+    (*new_vertices)[v] = (*vertices)[old_vertex[v]];
+  vertices = new_vertices;
+  if (prev_vertices.get()) {
+    shared_ptr<std::vector<Vec3f>> new_prev_vertices(
+        new std::vector<Vec3f>(num_vertices));
+    for (unsigned int v = 0; v < num_vertices; ++v)
+      (*new_prev_vertices)[v] = (*prev_vertices)[old_vertex[v]];
+    prev_vertices = new_prev_vertices;
+  }
+
+  if (primitive_order)
+    primitive_order->assign(primitive_indices_.begin(),
+                            primitive_indices_.begin() + num_primitives);
+  if (vertex_order) vertex_order->swap(old_vertex);
+  for (unsigned int k = 0; k < num_primitives; ++k) primitive_indices_[k] = k;
+  bv_node_vector_t& bvs_ = *bvs;
+  for (unsigned int i = 0; i < num_bvs; ++i)
+    if (bvs_[i].isLeaf())
+      bvs_[i].first_child = -((int)bvs_[i].first_primitive + 1);
   return BVH_OK;
 }
 
 template <typename BV>
-int BVHModel<BV>::refitTree_topdown() {
+void BVHModel<BV>::buildWideBVH(unsigned int width) {
+  decompressBVH();
+  wide_bvh.reset(internal::WideBVHBuilder<BV>::run(*this, width));
+}
+
+template <typename BV>
+void BVHModel<BV>::compressBVH(unsigned int bits) {
+  if (isCompressed()) {
+    if (quantized_bvh->bits() == bits) return;
+    decompressBVH();
+  }
+  quantized_bvh.reset(new QuantizedBVH(*this, bits));
+  bvs.reset();
+  primitive_indices.reset();
+  num_bvs_allocated = 0;
+  wide_bvh.reset();
+  clearVertexLeaves();
+}
+
+template <typename BV>
+void BVHModel<BV>::decompressBVH() {
+  if (!isCompressed()) return;
+  const QuantizedBVH& qbvh = *quantized_bvh;
+  bvs.reset(new bv_node_vector_t(num_bvs));
+  primitive_indices.reset(new std::vector<unsigned int>(num_bvs));
+  num_bvs_allocated = num_bvs;
+  bv_node_vector_t& bvs_ = *bvs;
+  std::vector<unsigned int>& primitive_indices_ = *primitive_indices;
+
+  // The children of a node have a greater index than the node: the
+  // primitives are counted bottom up and laid out top down, in the order of
+  // the leaves.
+  for (unsigned int i = num_bvs; i-- > 0;) {
+    BVNode<BV>& node = bvs_[i];
+    if (qbvh.isLeaf(i)) {
+      node.first_child = -(qbvh.primitiveId(i) + 1);
+      node.num_primitives = 1;
+    } else {
+      node.first_child = qbvh.leftChild(i);
+      node.num_primitives = bvs_[(size_t)node.leftChild()].num_primitives +
+                            bvs_[(size_t)node.rightChild()].num_primitives;
+    }
+  }
+  bvs_[0].first_primitive = 0;
+  for (unsigned int i = 0; i < num_bvs; ++i) {
+    const BVNode<BV>& node = bvs_[i];
+    if (node.isLeaf()) {
+      primitive_indices_[node.first_primitive] =
+          (unsigned int)node.primitiveId();
+    } else {
+      BVNode<BV>& left = bvs_[(size_t)node.leftChild()];
+      left.first_primitive = node.first_primitive;
+      bvs_[(size_t)node.rightChild()].first_primitive =
+          node.first_primitive + left.num_primitives;
+    }
+  }
+  quantized_bvh.reset();
+  refitTree_topdown(1);
+}
+
+template <typename BV>
+int BVHModel<BV>::refitTree_topdown(unsigned int num_threads) {
   Vec3f* vertices_ = vertices.get() ? vertices->data() : NULL;
   Vec3f* prev_vertices_ = prev_vertices.get() ? prev_vertices->data() : NULL;
   Triangle* tri_indices_ = tri_indices.get() ? tri_indices->data() : NULL;
   bv_fitter->set(vertices_, prev_vertices_, tri_indices_, getModelType());
   BVNode<BV>* bvs_ = bvs->data();
   unsigned int* primitive_indices_ = primitive_indices->data();
-  for (unsigned int i = 0; i < num_bvs; ++i) {
-    BV bv = bv_fitter->fit(primitive_indices_ + bvs_[i].first_primitive,
-                           bvs_[i].num_primitives);
-    bvs_[i].bv = bv;
-  }
+  // The nodes are fitted independently, by blocks.
+  static const unsigned int bvs_per_task = 256;
+  const std::size_t num_tasks = (num_bvs + bvs_per_task - 1) / bvs_per_task;
+  internal::parallelFor(
+      num_tasks, internal::getNumWorkers(num_threads, num_tasks),
+      [&](unsigned int, std::size_t k) {
+        const unsigned int end =
+            (std::min)(num_bvs, (unsigned int)(k + 1) * bvs_per_task);
+        for (unsigned int i = (unsigned int)k * bvs_per_task; i < end; ++i) {
+          BV bv = bv_fitter->fit(primitive_indices_ + bvs_[i].first_primitive,
+                                 bvs_[i].num_primitives);
+          bvs_[i].bv = bv;
+        }
+      });
 
   bv_fitter->clear();
 
@@ -0,0 +1,144 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/BVH/BVH_quantized.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include <cmath>
+#include <limits>
+
+namespace hpp {
+namespace fcl {
+
+template <typename BV>
+QuantizedBVH::QuantizedBVH(const BVHModel<BV>& model, unsigned int bits)
+    : bits_(bits) {
+  if (bits != 8 && bits != 16)
+    HPP_FCL_THROW_PRETTY(
+        "The boxes of a QuantizedBVH should have either 8 or 16 bits.",
+        std::invalid_argument);
+  if (model.getNumBVs() == 0 ||
+      (model.build_state != BVH_BUILD_STATE_PROCESSED &&
+       model.build_state != BVH_BUILD_STATE_UPDATED))
+    HPP_FCL_THROW_PRETTY(
+        "The hierarchy of the BVHModel should be built before compressing it.",
+        std::invalid_argument);
+  inv_scale = 1 / FCL_REAL((1u << bits) - 1);
+
+  // Boxes of the primitives of each node. The children of a node have a
+  // greater index than the node.
+  const unsigned int n = model.getNumBVs();
+  const std::vector<Vec3f>& vertices = *model.vertices;
+  const std::vector<Vec3f>* prev_vertices = model.prev_vertices.get();
+  first_child.resize(n);
+  std::vector<AABB> boxes(n);
+  for (unsigned int i = n; i-- > 0;) {
+    const BVNode<BV>& node = model.getBV(i);
+    first_child[i] = node.first_child;
+    AABB& box = boxes[i];
+    if (!node.isLeaf()) {
+      box = boxes[(size_t)node.leftChild()] + boxes[(size_t)node.rightChild()];
+    } else if (model.getModelType() == BVH_MODEL_TRIANGLES) {
+      const Triangle& t = (*model.tri_indices)[(size_t)node.primitiveId()];
+      box = AABB(vertices[t[0]], vertices[t[1]], vertices[t[2]]);
+      if (prev_vertices)
+        for (Triangle::index_type j = 0; j < 3; ++j)
+          box += (*prev_vertices)[t[j]];
+    } else {
+      box = AABB(vertices[(size_t)node.primitiveId()]);
+      if (prev_vertices) box += (*prev_vertices)[(size_t)node.primitiveId()];
+    }
+  }
+  root_box = boxes[0];
+
+  // Each box is quantized relative to the decoded box of its parent, which
+  // the traversal computes in the same way.
+  if (bits_ == 8)
+    codes8.assign(6 * (size_t)n, 0);
+  else
+    codes16.assign(6 * (size_t)n, 0);
+  for (unsigned int i = 0; i < n; ++i) {
+    if (first_child[i] < 0) continue;
+    for (unsigned int c = (unsigned int)first_child[i];
+         c <= (unsigned int)first_child[i] + 1; ++c) {
+      if (bits_ == 8)
+        encode(boxes[i], boxes[c], codes8.data() + 6 * c);
+      else
+        encode(boxes[i], boxes[c], codes16.data() + 6 * c);
+    }
+  }
+}
+
+template <typename Code>
+void QuantizedBVH::encode(const AABB& parent, AABB& box, Code* code) const {
+  const FCL_REAL max_code = FCL_REAL((1u << bits_) - 1);
+  const Vec3f step = (parent.max_ - parent.min_) * inv_scale;
+  // Margin for the rounding errors of the decoding, which may be compiled
+  // differently.
+  const FCL_REAL eps = 8 * std::numeric_limits<FCL_REAL>::epsilon();
+  for (int k = 0; k < 3; ++k) {
+    FCL_REAL lo = 0, hi = 0;
+    if (step[k] > 0) {
+      const FCL_REAL tol =
+          eps * (std::abs(parent.min_[k]) + std::abs(parent.max_[k]));
+      lo = std::floor((box.min_[k] - parent.min_[k]) / step[k]);
+      lo = (std::min)((std::max)(lo, FCL_REAL(0)), max_code);
+      while (lo > 0 && parent.min_[k] + step[k] * lo > box.min_[k] - tol)
+        lo -= 1;
+      hi = std::floor((parent.max_[k] - box.max_[k]) / step[k]);
+      hi = (std::min)((std::max)(hi, FCL_REAL(0)), max_code);
+      while (hi > 0 && parent.max_[k] - step[k] * hi < box.max_[k] + tol)
+        hi -= 1;
+    }
+    code[k] = (Code)lo;
+    code[k + 3] = (Code)hi;
+  }
+  decodeBox(code, parent, step, box);
+}
+
+#define HPP_FCL_QUANTIZED_BVH_INSTANTIATE(BV) \
+  template HPP_FCL_DLLAPI QuantizedBVH::QuantizedBVH(const BVHModel<BV>&, \
+                                                     unsigned int)
+
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(AABB);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(OBB);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(RSS);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(kIOS);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(OBBRSS);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(KDOP<16>);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(KDOP<18>);
+HPP_FCL_QUANTIZED_BVH_INSTANTIATE(KDOP<24>);
+
+}  // namespace fcl
+}  // namespace hpp
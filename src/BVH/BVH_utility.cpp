@@ -39,6 +39,10 @@
 #include <hpp/fcl/narrowphase/narrowphase.h>
 #include <hpp/fcl/shape/geometric_shapes_utility.h>
 #include <hpp/fcl/internal/shape_shape_func.h>
+#include <hpp/fcl/internal/parallel.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace hpp {
 namespace fcl {
@@ -180,13 +184,32 @@ BVHModel<KDOP<24> >* BVHExtract(const BVHModel<KDOP<24> >& model,
   return details::BVHExtract(model, pose, aabb);
 }
 
-void getCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts, unsigned int* indices,
-                   unsigned int n, Matrix3f& M) {
-  Vec3f S1(Vec3f::Zero());
-  Vec3f S2[3] = {Vec3f::Zero(), Vec3f::Zero(), Vec3f::Zero()};
+namespace {
+/// Number of primitives processed as one block by getCovariance and
+/// getExtentAndCenter.
+const unsigned int primitive_block_size = 1 << 14;
+
+/// Sums of the coordinates and of their products, for getCovariance.
+struct CovarianceSums {
+  Vec3f S1;
+  Vec3f S2[3];
+
+  CovarianceSums() : S1(Vec3f::Zero()) {
+    S2[0].setZero();
+    S2[1].setZero();
+    S2[2].setZero();
+  }
+};
+
+/// Accumulate the contribution of the primitives in [begin, end) to sums.
+void accumulateCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts,
+                          unsigned int* indices, unsigned int begin,
+                          unsigned int end, CovarianceSums& sums) {
+  Vec3f& S1 = sums.S1;
+  Vec3f* S2 = sums.S2;
 
   if (ts) {
-    for (unsigned int i = 0; i < n; ++i) {
+    for (unsigned int i = begin; i < end; ++i) {
       const Triangle& t = (indices) ? ts[indices[i]] : ts[i];
 
       const Vec3f& p1 = ps[t[0]];
@@ -221,7 +244,7 @@ void getCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts, unsigned int* indices,
       }
     }
   } else {
-    for (unsigned int i = 0; i < n; ++i) {
+    for (unsigned int i = begin; i < end; ++i) {
       const Vec3f& p = (indices) ? ps[indices[i]] : ps[i];
       S1 += p;
       S2[0][0] += (p[0] * p[0]);
@@ -244,6 +267,33 @@ void getCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts, unsigned int* indices,
       }
     }
   }
+}
+}  // namespace
+
+void getCovariance(Vec3f* ps, Vec3f* ps2, Triangle* ts, unsigned int* indices,
+                   unsigned int n, Matrix3f& M, unsigned int num_threads) {
+  CovarianceSums sums;
+  const std::size_t num_blocks =
+      (n + primitive_block_size - 1) / primitive_block_size;
+  if (num_blocks <= 1)
+    accumulateCovariance(ps, ps2, ts, indices, 0, n, sums);
+  else {
+    std::vector<CovarianceSums> block_sums(num_blocks);
+    internal::parallelFor(
+        num_blocks, internal::getNumWorkers(num_threads, num_blocks),
+        [&](unsigned int, std::size_t b) {
+          const unsigned int begin = (unsigned int)b * primitive_block_size;
+          accumulateCovariance(ps, ps2, ts, indices, begin,
+                               (std::min)(n, begin + primitive_block_size),
+                               block_sums[b]);
+        });
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+      sums.S1 += block_sums[b].S1;
+      for (int k = 0; k < 3; ++k) sums.S2[k] += block_sums[b].S2[k];
+    }
+  }
+  const Vec3f& S1 = sums.S1;
+  const Vec3f* S2 = sums.S2;
 
   unsigned int n_points = ((ps2) ? 2 : 1) * ((ts) ? 3 : 1) * n;
 
@@ -481,22 +531,20 @@ void getRadiusAndOriginAndRectangleSize(Vec3f* ps, Vec3f* ps2, Triangle* ts,
   delete[] P;
 }
 
-/** @brief Compute the bounding volume extent and center for a set or subset of
- * points. The bounding volume axes are known.
+/** @brief Compute the bounds of the projections on the bounding volume axes
+ * of the points of [begin, end). The bounding volume axes are known.
  */
 static inline void getExtentAndCenter_pointcloud(Vec3f* ps, Vec3f* ps2,
                                                  unsigned int* indices,
-                                                 unsigned int n, Matrix3f& axes,
-                                                 Vec3f& center, Vec3f& extent) {
+                                                 unsigned int begin,
+                                                 unsigned int end,
+                                                 const Matrix3f& axes,
+                                                 Vec3f& min_coord,
+                                                 Vec3f& max_coord) {
   bool indirect_index = true;
   if (!indices) indirect_index = false;
 
-  FCL_REAL real_max = (std::numeric_limits<FCL_REAL>::max)();
-
-  Vec3f min_coord(real_max, real_max, real_max);
-  Vec3f max_coord(-real_max, -real_max, -real_max);
-
-  for (unsigned int i = 0; i < n; ++i) {
+  for (unsigned int i = begin; i < end; ++i) {
     unsigned int index = indirect_index ? indices[i] : i;
 
     const Vec3f& p = ps[index];
@@ -517,28 +565,20 @@ static inline void getExtentAndCenter_pointcloud(Vec3f* ps, Vec3f* ps2,
       }
     }
   }
-
-  center.noalias() = axes * (max_coord + min_coord) / 2;
-
-  extent.noalias() = (max_coord - min_coord) / 2;
 }
 
-/** @brief Compute the bounding volume extent and center for a set or subset of
- * points. The bounding volume axes are known.
+/** @brief Compute the bounds of the projections on the bounding volume axes
+ * of the triangles of [begin, end). The bounding volume axes are known.
  */
 static inline void getExtentAndCenter_mesh(Vec3f* ps, Vec3f* ps2, Triangle* ts,
                                            unsigned int* indices,
-                                           unsigned int n, Matrix3f& axes,
-                                           Vec3f& center, Vec3f& extent) {
+                                           unsigned int begin, unsigned int end,
+                                           const Matrix3f& axes,
+                                           Vec3f& min_coord, Vec3f& max_coord) {
   bool indirect_index = true;
   if (!indices) indirect_index = false;
 
-  FCL_REAL real_max = (std::numeric_limits<FCL_REAL>::max)();
-
-  Vec3f min_coord(real_max, real_max, real_max);
-  Vec3f max_coord(-real_max, -real_max, -real_max);
-
-  for (unsigned int i = 0; i < n; ++i) {
+  for (unsigned int i = begin; i < end; ++i) {
     unsigned int index = indirect_index ? indices[i] : i;
     const Triangle& t = ts[index];
 
@@ -566,6 +606,48 @@ static inline void getExtentAndCenter_mesh(Vec3f* ps, Vec3f* ps2, Triangle* ts,
       }
     }
   }
+}
+
+void getExtentAndCenter(Vec3f* ps, Vec3f* ps2, Triangle* ts,
+                        unsigned int* indices, unsigned int n, Matrix3f& axes,
+                        Vec3f& center, Vec3f& extent,
+                        unsigned int num_threads) {
+  FCL_REAL real_max = (std::numeric_limits<FCL_REAL>::max)();
+
+  Vec3f min_coord(real_max, real_max, real_max);
+  Vec3f max_coord(-real_max, -real_max, -real_max);
+
+  const std::size_t num_blocks =
+      (n + primitive_block_size - 1) / primitive_block_size;
+  const unsigned int num_workers =
+      internal::getNumWorkers(num_threads, num_blocks);
+  if (num_workers <= 1) {
+    if (ts)
+      getExtentAndCenter_mesh(ps, ps2, ts, indices, 0, n, axes, min_coord,
+                              max_coord);
+    else
+      getExtentAndCenter_pointcloud(ps, ps2, indices, 0, n, axes, min_coord,
+                                    max_coord);
+  } else {
+    // The bounds do not depend on the order of the points.
+    std::vector<Vec3f> block_min(num_blocks, min_coord),
+        block_max(num_blocks, max_coord);
+    internal::parallelFor(
+        num_blocks, num_workers, [&](unsigned int, std::size_t b) {
+          const unsigned int begin = (unsigned int)b * primitive_block_size;
+          const unsigned int end = (std::min)(n, begin + primitive_block_size);
+          if (ts)
+            getExtentAndCenter_mesh(ps, ps2, ts, indices, begin, end, axes,
+                                    block_min[b], block_max[b]);
+          else
+            getExtentAndCenter_pointcloud(ps, ps2, indices, begin, end, axes,
+                                          block_min[b], block_max[b]);
+        });
+    for (std::size_t b = 0; b < num_blocks; ++b) {
+      min_coord = min_coord.cwiseMin(block_min[b]);
+      max_coord = max_coord.cwiseMax(block_max[b]);
+    }
+  }
 
   Vec3f o((max_coord + min_coord) / 2);
 
@@ -574,15 +656,6 @@ static inline void getExtentAndCenter_mesh(Vec3f* ps, Vec3f* ps2, Triangle* ts,
   extent.noalias() = (max_coord - min_coord) / 2;
 }
 
-void getExtentAndCenter(Vec3f* ps, Vec3f* ps2, Triangle* ts,
-                        unsigned int* indices, unsigned int n, Matrix3f& axes,
-                        Vec3f& center, Vec3f& extent) {
-  if (ts)
-    getExtentAndCenter_mesh(ps, ps2, ts, indices, n, axes, center, extent);
-  else
-    getExtentAndCenter_pointcloud(ps, ps2, indices, n, axes, center, extent);
-}
-
 void circumCircleComputation(const Vec3f& a, const Vec3f& b, const Vec3f& c,
                              Vec3f& center, FCL_REAL& radius) {
   Vec3f e1 = a - c;
@@ -0,0 +1,117 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <hpp/fcl/BVH/BVH_wide.h>
+
+#include <deque>
+
+namespace hpp {
+namespace fcl {
+
+template <typename BV>
+WideBVH<BV>::WideBVH(const BVHModel<BV>& model, unsigned int width)
+    : width_(width), num_nodes(0) {
+  if (width != 4 && width != 8)
+    HPP_FCL_THROW_PRETTY("The width of a WideBVH should be either 4 or 8.",
+                         std::invalid_argument);
+  if (model.getNumBVs() == 0 ||
+      (model.build_state != BVH_BUILD_STATE_PROCESSED &&
+       model.build_state != BVH_BUILD_STATE_UPDATED))
+    HPP_FCL_THROW_PRETTY(
+        "The hierarchy of the BVHModel should be built before collapsing it.",
+        std::invalid_argument);
+
+  // A wide node has at least two children, except when the whole tree is a
+  // single leaf. So there are at most as many wide nodes as internal binary
+  // nodes.
+  const std::size_t max_nodes = (std::max)(1u, model.getNumBVs() / 2);
+  packets.reserve(max_nodes * packetsPerNode());
+  children.reserve(max_nodes * width_);
+  binary_nodes.reserve(max_nodes * width_);
+
+  // Breadth first traversal: the binary node each wide node stands for.
+  std::deque<unsigned int> queue(1, 0u);
+  std::vector<unsigned int> slots;
+  slots.reserve(width_);
+  while (!queue.empty()) {
+    const unsigned int b = queue.front();
+    queue.pop_front();
+    const unsigned int w = num_nodes++;
+
+    // Open the largest internal node until the node is full.
+    slots.clear();
+    const BVNode<BV>& node = model.getBV(b);
+    if (node.isLeaf())
+      slots.push_back(b);
+    else {
+      slots.push_back((unsigned int)node.leftChild());
+      slots.push_back((unsigned int)node.rightChild());
+    }
+    while (slots.size() < width_) {
+      int largest = -1;
+      FCL_REAL largest_size = -1;
+      for (std::size_t k = 0; k < slots.size(); ++k) {
+        const BVNode<BV>& child = model.getBV(slots[k]);
+        if (!child.isLeaf() && child.bv.size() > largest_size) {
+          largest = (int)k;
+          largest_size = child.bv.size();
+        }
+      }
+      if (largest < 0) break;
+      const BVNode<BV>& child = model.getBV(slots[(std::size_t)largest]);
+      slots[(std::size_t)largest] = (unsigned int)child.leftChild();
+      slots.insert(slots.begin() + largest + 1,
+                   (unsigned int)child.rightChild());
+    }
+
+    packets.resize(packets.size() + packetsPerNode());
+    children.resize(children.size() + width_, -1);
+    binary_nodes.resize(binary_nodes.size() + width_, 0);
+    for (std::size_t k = 0; k < slots.size(); ++k) {
+      const BVNode<BV>& child = model.getBV(slots[k]);
+      packets[w * packetsPerNode() + k / PacketWidth].push_back(child.bv);
+      binary_nodes[w * width_ + k] = slots[k];
+      if (!child.isLeaf()) {
+        children[w * width_ + k] = int(num_nodes + queue.size());
+        queue.push_back(slots[k]);
+      }
+    }
+  }
+}
+
+template class WideBVH<OBB>;
+template class WideBVH<OBBRSS>;
+
+}  // namespace fcl
+}  // namespace hpp
@@ -486,14 +486,14 @@ OBB BVFitter<OBB>::fit(unsigned int* primitive_indices,
   Matrix3f::Scalar s[3];  // three eigen values
 
   getCovariance(vertices, prev_vertices, tri_indices, primitive_indices,
-                num_primitives, M);
+                num_primitives, M, num_threads);
   eigen(M, s, E);
 
   axisFromEigen(E, s, bv.axes);
 
   // set obb centers and extensions
   getExtentAndCenter(vertices, prev_vertices, tri_indices, primitive_indices,
-                     num_primitives, bv.axes, bv.To, bv.extent);
+                     num_primitives, bv.axes, bv.To, bv.extent, num_threads);
 
   return bv;
 }
@@ -506,14 +506,15 @@ OBBRSS BVFitter<OBBRSS>::fit(unsigned int* primitive_indices,
   Matrix3f::Scalar s[3];
 
   getCovariance(vertices, prev_vertices, tri_indices, primitive_indices,
-                num_primitives, M);
+                num_primitives, M, num_threads);
   eigen(M, s, E);
 
   axisFromEigen(E, s, bv.obb.axes);
   bv.rss.axes.noalias() = bv.obb.axes;
 
   getExtentAndCenter(vertices, prev_vertices, tri_indices, primitive_indices,
-                     num_primitives, bv.obb.axes, bv.obb.To, bv.obb.extent);
+                     num_primitives, bv.obb.axes, bv.obb.To, bv.obb.extent,
+                     num_threads);
 
   Vec3f origin;
   FCL_REAL l[2];
@@ -538,7 +539,7 @@ RSS BVFitter<RSS>::fit(unsigned int* primitive_indices,
   Vec3f E[3];             // row first eigen-vectors
   Matrix3f::Scalar s[3];  // three eigen values
   getCovariance(vertices, prev_vertices, tri_indices, primitive_indices,
-                num_primitives, M);
+                num_primitives, M, num_threads);
   eigen(M, s, E);
   axisFromEigen(E, s, bv.axes);
 
@@ -568,7 +569,7 @@ kIOS BVFitter<kIOS>::fit(unsigned int* primitive_indices,
   Matrix3f::Scalar s[3];
 
   getCovariance(vertices, prev_vertices, tri_indices, primitive_indices,
-                num_primitives, M);
+                num_primitives, M, num_threads);
   eigen(M, s, E);
 
   Matrix3f& axes = bv.obb.axes;
@@ -576,7 +577,8 @@ kIOS BVFitter<kIOS>::fit(unsigned int* primitive_indices,
 
   // get centers and extensions
   getExtentAndCenter(vertices, prev_vertices, tri_indices, primitive_indices,
-                     num_primitives, axes, bv.obb.To, bv.obb.extent);
+                     num_primitives, axes, bv.obb.To, bv.obb.extent,
+                     num_threads);
 
   const Vec3f& center = bv.obb.To;
   const Vec3f& extent = bv.obb.extent;
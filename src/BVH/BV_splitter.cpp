@@ -37,6 +37,8 @@
 
 #include <hpp/fcl/internal/BV_splitter.h>
 
+#include <limits>
+
 namespace hpp {
 namespace fcl {
 
@@ -83,6 +85,130 @@ void computeSplitVector<OBBRSS>(const OBBRSS& bv, Vec3f& split_vector) {
   split_vector = bv.obb.axes.col(0);
 }
 
+template <typename BV>
+const Matrix3f& getSplitAxes(const BV& bv) {
+  return bv.axes;
+}
+
+template <>
+const Matrix3f& getSplitAxes<kIOS>(const kIOS& bv) {
+  return bv.obb.axes;
+}
+
+template <>
+const Matrix3f& getSplitAxes<OBBRSS>(const OBBRSS& bv) {
+  return bv.obb.axes;
+}
+
+namespace details {
+namespace {
+/// Box aligned with the axes used by computeSplit_sah, stored as the min and
+/// max of the projections on these axes.
+struct SAHBox {
+  Vec3f min_, max_;
+
+  SAHBox()
+      : min_(Vec3f::Constant((std::numeric_limits<FCL_REAL>::max)())),
+        max_(Vec3f::Constant(-(std::numeric_limits<FCL_REAL>::max)())) {}
+
+  void merge(const Vec3f& p) {
+    min_ = min_.cwiseMin(p);
+    max_ = max_.cwiseMax(p);
+  }
+
+  void merge(const SAHBox& other) {
+    min_ = min_.cwiseMin(other.min_);
+    max_ = max_.cwiseMax(other.max_);
+  }
+
+  FCL_REAL area() const {
+    const Vec3f d = max_ - min_;
+    return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+  }
+};
+
+struct SAHBin {
+  SAHBox box;
+  unsigned int count;
+
+  SAHBin() : count(0) {}
+};
+}  // namespace
+
+bool computeSplit_sah(const Matrix3f& axes, const Vec3f* vertices,
+                      const Triangle* triangles,
+                      const unsigned int* primitive_indices,
+                      unsigned int num_primitives, BVHModelType type,
+                      int& axis, FCL_REAL& split_value) {
+  static const int num_bins = 16;
+
+  // Box and centroid of each primitive, in the frame of axes.
+  std::vector<SAHBox> boxes(num_primitives);
+  std::vector<Vec3f> centroids(num_primitives);
+  SAHBox centroid_bounds;
+  for (unsigned int i = 0; i < num_primitives; ++i) {
+    if (type == BVH_MODEL_TRIANGLES) {
+      const Triangle& t = triangles[primitive_indices[i]];
+      Vec3f c(Vec3f::Zero());
+      for (int k = 0; k < 3; ++k) {
+        const Vec3f p(axes.transpose() * vertices[t[k]]);
+        boxes[i].merge(p);
+        c += p;
+      }
+      centroids[i] = c / 3;
+    } else {
+      centroids[i].noalias() =
+          axes.transpose() * vertices[primitive_indices[i]];
+      boxes[i].merge(centroids[i]);
+    }
+    centroid_bounds.merge(centroids[i]);
+  }
+
+  FCL_REAL best_cost = (std::numeric_limits<FCL_REAL>::max)();
+  axis = -1;
+  for (int a = 0; a < 3; ++a) {
+    const FCL_REAL cmin = centroid_bounds.min_[a],
+                   extent = centroid_bounds.max_[a] - cmin;
+    if (extent <= 0) continue;
+
+    SAHBin bins[num_bins];
+    const FCL_REAL scale = num_bins / extent;
+    for (unsigned int i = 0; i < num_primitives; ++i) {
+      int b = static_cast<int>((centroids[i][a] - cmin) * scale);
+      if (b >= num_bins) b = num_bins - 1;
+      bins[b].box.merge(boxes[i]);
+      ++bins[b].count;
+    }
+
+    // Sweep from the right to get the cost of the right side of each split,
+    // then from the left.
+    FCL_REAL right_cost[num_bins];
+    SAHBox right;
+    unsigned int right_count = 0;
+    for (int b = num_bins - 1; b > 0; --b) {
+      right.merge(bins[b].box);
+      right_count += bins[b].count;
+      right_cost[b] = right_count > 0 ? right.area() * right_count : 0;
+    }
+    SAHBox left;
+    unsigned int left_count = 0;
+    for (int b = 0; b < num_bins - 1; ++b) {
+      left.merge(bins[b].box);
+      left_count += bins[b].count;
+      if (left_count == 0 || left_count == num_primitives) continue;
+      // Split between bins b and b + 1.
+      const FCL_REAL cost = left.area() * left_count + right_cost[b + 1];
+      if (cost < best_cost) {
+        best_cost = cost;
+        axis = a;
+        split_value = cmin + (b + 1) / scale;
+      }
+    }
+  }
+  return axis >= 0;
+}
+}  // namespace details
+
 template <typename BV>
 void computeSplitValue_bvcenter(const BV& bv, FCL_REAL& split_value) {
   Vec3f center = bv.center();
@@ -179,6 +305,19 @@ void BVSplitter<OBB>::computeRule_median(const OBB& bv,
                                 split_value);
 }
 
+template <>
+void BVSplitter<OBB>::computeRule_sah(const OBB& bv,
+                                      unsigned int* primitive_indices,
+                                      unsigned int num_primitives) {
+  const Matrix3f& axes = getSplitAxes<OBB>(bv);
+  int axis;
+  if (details::computeSplit_sah(axes, vertices, tri_indices, primitive_indices,
+                                num_primitives, type, axis, split_value))
+    split_vector = axes.col(axis);
+  else
+    computeRule_mean(bv, primitive_indices, num_primitives);
+}
+
 template <>
 void BVSplitter<RSS>::computeRule_bvcenter(const RSS& bv, unsigned int*,
                                            unsigned int) {
@@ -205,6 +344,19 @@ void BVSplitter<RSS>::computeRule_median(const RSS& bv,
                                 split_value);
 }
 
+template <>
+void BVSplitter<RSS>::computeRule_sah(const RSS& bv,
+                                      unsigned int* primitive_indices,
+                                      unsigned int num_primitives) {
+  const Matrix3f& axes = getSplitAxes<RSS>(bv);
+  int axis;
+  if (details::computeSplit_sah(axes, vertices, tri_indices, primitive_indices,
+                                num_primitives, type, axis, split_value))
+    split_vector = axes.col(axis);
+  else
+    computeRule_mean(bv, primitive_indices, num_primitives);
+}
+
 template <>
 void BVSplitter<kIOS>::computeRule_bvcenter(const kIOS& bv, unsigned int*,
                                             unsigned int) {
@@ -231,6 +383,19 @@ void BVSplitter<kIOS>::computeRule_median(const kIOS& bv,
                                  split_value);
 }
 
+template <>
+void BVSplitter<kIOS>::computeRule_sah(const kIOS& bv,
+                                       unsigned int* primitive_indices,
+                                       unsigned int num_primitives) {
+  const Matrix3f& axes = getSplitAxes<kIOS>(bv);
+  int axis;
+  if (details::computeSplit_sah(axes, vertices, tri_indices, primitive_indices,
+                                num_primitives, type, axis, split_value))
+    split_vector = axes.col(axis);
+  else
+    computeRule_mean(bv, primitive_indices, num_primitives);
+}
+
 template <>
 void BVSplitter<OBBRSS>::computeRule_bvcenter(const OBBRSS& bv, unsigned int*,
                                               unsigned int) {
@@ -258,6 +423,19 @@ void BVSplitter<OBBRSS>::computeRule_median(const OBBRSS& bv,
                                    split_value);
 }
 
+template <>
+void BVSplitter<OBBRSS>::computeRule_sah(const OBBRSS& bv,
+                                         unsigned int* primitive_indices,
+                                         unsigned int num_primitives) {
+  const Matrix3f& axes = getSplitAxes<OBBRSS>(bv);
+  int axis;
+  if (details::computeSplit_sah(axes, vertices, tri_indices, primitive_indices,
+                                num_primitives, type, axis, split_value))
+    split_vector = axes.col(axis);
+  else
+    computeRule_mean(bv, primitive_indices, num_primitives);
+}
+
 template <>
 bool BVSplitter<OBB>::apply(const Vec3f& q) const {
   return split_vector.dot(Vec3f(q[0], q[1], q[2])) > split_value;
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#include "hpp/fcl/broadphase/broadphase_continuous_SSaP.h"
+
+#include <algorithm>
+
+namespace hpp {
+namespace fcl {
+
+namespace {
+/// Sorts the objects according to the lower bound of their AABB along an axis.
+struct SortByLow {
+  explicit SortByLow(int axis_) : axis(axis_) {}
+  bool operator()(const ContinuousCollisionObject* a,
+                  const ContinuousCollisionObject* b) const {
+    return a->getAABB().min_[axis] < b->getAABB().min_[axis];
+  }
+  int axis;
+};
+}  // namespace
+
+//==============================================================================
+SSaPContinuousCollisionManager::SSaPContinuousCollisionManager()
+    : axis(0), setup_(false) {
+  // Do nothing
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::registerObject(
+    ContinuousCollisionObject* obj) {
+  objs.push_back(obj);
+  setup_ = false;
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::unregisterObject(
+    ContinuousCollisionObject* obj) {
+  auto it = std::find(objs.begin(), objs.end(), obj);
+  if (it != objs.end()) objs.erase(it);
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::setup() {
+  if (setup_) return;
+  if (!objs.empty()) {
+    // Sweep along the axis of largest variance of the AABB centers.
+    Vec3f sum(Vec3f::Zero()), sum_sq(Vec3f::Zero());
+    for (size_t i = 0; i < objs.size(); ++i) {
+      const Vec3f c = objs[i]->getAABB().center();
+      sum += c;
+      sum_sq += c.cwiseProduct(c);
+    }
+    const FCL_REAL n = FCL_REAL(objs.size());
+    Eigen::Index i;
+    (sum_sq / n - (sum / n).cwiseProduct(sum / n)).maxCoeff(&i);
+    axis = static_cast<int>(i);
+  }
+  std::sort(objs.begin(), objs.end(), SortByLow(axis));
+  setup_ = true;
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::update() {
+  setup_ = false;
+  setup();
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::clear() {
+  objs.clear();
+  setup_ = false;
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::getObjects(
+    std::vector<ContinuousCollisionObject*>& objs_) const {
+  objs_ = objs;
+}
+
+//==============================================================================
+bool SSaPContinuousCollisionManager::collide_(
+    ContinuousCollisionObject* obj,
+    ContinuousCollisionCallBackBase* callback) const {
+  const AABB& aabb = obj->getAABB();
+  for (size_t i = 0; i < objs.size(); ++i) {
+    // The following objects start after the end of obj.
+    if (objs[i]->getAABB().min_[axis] > aabb.max_[axis]) break;
+    if (objs[i] != obj && objs[i]->getAABB().overlap(aabb)) {
+      if ((*callback)(objs[i], obj)) return true;
+    }
+  }
+  return false;
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::collide(
+    ContinuousCollisionObject* obj,
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  collide_(obj, callback);
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::collide(
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  if (size() == 0) return;
+
+  for (size_t i = 0; i < objs.size(); ++i) {
+    const AABB& aabb = objs[i]->getAABB();
+    for (size_t j = i + 1; j < objs.size(); ++j) {
+      if (objs[j]->getAABB().min_[axis] > aabb.max_[axis]) break;
+      if (objs[j]->getAABB().overlap(aabb)) {
+        if ((*callback)(objs[i], objs[j])) return;
+      }
+    }
+  }
+}
+
+//==============================================================================
+void SSaPContinuousCollisionManager::collide(
+    BroadPhaseContinuousCollisionManager* other_manager,
+    ContinuousCollisionCallBackBase* callback) const {
+  callback->init();
+  if ((size() == 0) || (other_manager->size() == 0)) return;
+
+  if (this == other_manager) {
+    collide(callback);
+    return;
+  }
+
+  std::vector<ContinuousCollisionObject*> other_objs;
+  other_manager->getObjects(other_objs);
+  for (size_t i = 0; i < other_objs.size(); ++i)
+    if (collide_(other_objs[i], callback)) return;
+}
+
+//==============================================================================
+bool SSaPContinuousCollisionManager::empty() const { return objs.empty(); }
+
+//==============================================================================
+size_t SSaPContinuousCollisionManager::size() const { return objs.size(); }
+
+}  // namespace fcl
+}  // namespace hpp
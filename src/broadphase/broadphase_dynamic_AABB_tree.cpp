@@ -45,6 +45,7 @@
 
 #include "hpp/fcl/BV/BV.h"
 #include "hpp/fcl/shape/geometric_shapes_utility.h"
+#include "hpp/fcl/internal/parallel.h"
 
 namespace hpp {
 namespace fcl {
@@ -405,6 +406,89 @@ bool selfCollisionRecurse(
   return false;
 }
 
+//==============================================================================
+/// @brief Callback which only records the pairs it is called on.
+struct CandidatePairsCallback : CollisionCallBackBase {
+  std::vector<DynamicAABBTreeCollisionManager::CollisionPair> pairs;
+
+  bool collide(CollisionObject* o1, CollisionObject* o2) {
+    pairs.push_back(std::make_pair(o1, o2));
+    return false;
+  }
+};
+
+//==============================================================================
+/// @brief Part of the self collision traversal: the self collision of the
+/// subtree node1 if node2 is null, the collision between the subtrees node1
+/// and node2 otherwise.
+struct SelfCollisionTask {
+  DynamicAABBTreeCollisionManager::DynamicAABBNode* node1;
+  DynamicAABBTreeCollisionManager::DynamicAABBNode* node2;
+};
+
+//==============================================================================
+/// @brief Unroll the first levels of selfCollisionRecurse into independent
+/// tasks, until there are at least min_num_tasks of them or nothing can be
+/// split anymore. Running the tasks in order visits the pairs in the same
+/// order as selfCollisionRecurse(root, ...).
+void splitSelfCollisionTasks(
+    DynamicAABBTreeCollisionManager::DynamicAABBNode* root,
+    std::size_t min_num_tasks, std::vector<SelfCollisionTask>& tasks) {
+  tasks.assign(1, SelfCollisionTask{root, nullptr});
+  std::vector<SelfCollisionTask> next;
+  bool split = true;
+  while (split && tasks.size() < min_num_tasks) {
+    split = false;
+    next.clear();
+    for (const SelfCollisionTask& task : tasks) {
+      DynamicAABBTreeCollisionManager::DynamicAABBNode* node1 = task.node1;
+      DynamicAABBTreeCollisionManager::DynamicAABBNode* node2 = task.node2;
+      if (node2 == nullptr) {
+        // Same order as in selfCollisionRecurse.
+        if (node1->isLeaf()) continue;
+        next.push_back(SelfCollisionTask{node1->children[0], nullptr});
+        next.push_back(SelfCollisionTask{node1->children[1], nullptr});
+        next.push_back(
+            SelfCollisionTask{node1->children[0], node1->children[1]});
+        split = true;
+      } else if (node1->isLeaf() && node2->isLeaf()) {
+        next.push_back(task);
+      } else if (!nodeCollide(node1, node2)) {
+        split = true;
+      } else if (node2->isLeaf() || (!node1->isLeaf() &&
+                                     (node1->bv.size() > node2->bv.size()))) {
+        // Same order as in collisionRecurse.
+        next.push_back(SelfCollisionTask{node1->children[0], node2});
+        next.push_back(SelfCollisionTask{node1->children[1], node2});
+        split = true;
+      } else {
+        next.push_back(SelfCollisionTask{node1, node2->children[0]});
+        next.push_back(SelfCollisionTask{node1, node2->children[1]});
+        split = true;
+      }
+    }
+    tasks.swap(next);
+  }
+}
+
+//==============================================================================
+/// @brief Accumulate the result of one pair into the result of the whole
+/// manager, as successive calls to collide would do.
+void mergeCollisionResult(const CollisionRequest& request,
+                          const CollisionResult& pair_result,
+                          CollisionResult& result) {
+  const std::vector<Contact>& contacts = pair_result.getContacts();
+  for (std::size_t k = 0; k < contacts.size(); ++k) {
+    if (result.numContacts() >= request.num_max_contacts) break;
+    result.addContact(contacts[k]);
+  }
+  if (pair_result.distance_lower_bound < result.distance_lower_bound) {
+    result.distance_lower_bound = pair_result.distance_lower_bound;
+    result.nearest_points = pair_result.nearest_points;
+    result.normal = pair_result.normal;
+  }
+}
+
 //==============================================================================
 bool distanceRecurse(DynamicAABBTreeCollisionManager::DynamicAABBNode* root1,
                      DynamicAABBTreeCollisionManager::DynamicAABBNode* root2,
@@ -720,6 +804,75 @@ void DynamicAABBTreeCollisionManager::collide(
   detail::dynamic_AABB_tree::selfCollisionRecurse(dtree.getRoot(), callback);
 }
 
+//==============================================================================
+void DynamicAABBTreeCollisionManager::getCandidatePairs(
+    std::vector<CollisionPair>& pairs, unsigned int num_threads) const {
+  pairs.clear();
+  if (size() == 0) return;
+
+  const unsigned int num_workers = internal::getNumWorkers(num_threads, size());
+  // Create more tasks than workers: the subtrees are not balanced in terms
+  // of overlapping pairs.
+  std::vector<detail::dynamic_AABB_tree::SelfCollisionTask> tasks;
+  detail::dynamic_AABB_tree::splitSelfCollisionTasks(
+      dtree.getRoot(), num_workers > 1 ? 8 * num_workers : 1, tasks);
+
+  std::vector<detail::dynamic_AABB_tree::CandidatePairsCallback> callbacks(
+      tasks.size());
+  internal::parallelFor(
+      tasks.size(), num_workers, [&](unsigned int, std::size_t i) {
+        if (tasks[i].node2 == nullptr)
+          detail::dynamic_AABB_tree::selfCollisionRecurse(tasks[i].node1,
+                                                          &callbacks[i]);
+        else
+          detail::dynamic_AABB_tree::collisionRecurse(
+              tasks[i].node1, tasks[i].node2, &callbacks[i]);
+      });
+
+  std::size_t num_pairs = 0;
+  for (std::size_t i = 0; i < callbacks.size(); ++i)
+    num_pairs += callbacks[i].pairs.size();
+  pairs.reserve(num_pairs);
+  for (std::size_t i = 0; i < callbacks.size(); ++i)
+    pairs.insert(pairs.end(), callbacks[i].pairs.begin(),
+                 callbacks[i].pairs.end());
+}
+
+//==============================================================================
+void DynamicAABBTreeCollisionManager::collideParallel(
+    CollisionCallBackDefault* callback, unsigned int num_threads) const {
+  callback->init();
+  if (size() == 0) return;
+
+  std::vector<CollisionPair> pairs;
+  getCandidatePairs(pairs, num_threads);
+  if (pairs.empty()) return;
+
+  CollisionData& data = callback->data;
+  const unsigned int num_workers =
+      internal::getNumWorkers(num_threads, pairs.size());
+  // collide may update the cached guess of the request: each thread works
+  // on its own copy of the collision data.
+  HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
+  HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
+  std::vector<CollisionData> thread_data(num_workers, data);
+  HPP_FCL_COMPILER_DIAGNOSTIC_POP
+  std::vector<CollisionResult> results(pairs.size());
+  internal::parallelFor(
+      pairs.size(), num_workers, [&](unsigned int worker, std::size_t i) {
+        ::hpp::fcl::collide(pairs[i].first, pairs[i].second,
+                            thread_data[worker].request, results[i]);
+      });
+
+  for (std::size_t i = 0; i < results.size() && !data.done; ++i) {
+    detail::dynamic_AABB_tree::mergeCollisionResult(data.request, results[i],
+                                                    data.result);
+    if (data.result.isCollision() &&
+        data.result.numContacts() >= data.request.num_max_contacts)
+      data.done = true;
+  }
+}
+
 //==============================================================================
 void DynamicAABBTreeCollisionManager::distance(
     DistanceCallBackBase* callback) const {
@@ -64,6 +64,33 @@ bool CollisionCallBackDefault::collide(CollisionObject* o1,
   return defaultCollisionFunction(o1, o2, &data);
 }
 
+bool defaultContinuousCollisionFunction(ContinuousCollisionObject* o1,
+                                        ContinuousCollisionObject* o2,
+                                        void* data) {
+  assert(data != nullptr);
+  auto* cdata = static_cast<DefaultContinuousCollisionData*>(data);
+
+  if (cdata->done) return true;
+
+  ContinuousCollisionResult result;
+  collide(o1, o2, cdata->request, result);
+  if (result.is_collide &&
+      (!cdata->result.is_collide ||
+       result.time_of_contact < cdata->result.time_of_contact)) {
+    cdata->result = result;
+    cdata->o1 = o1;
+    cdata->o2 = o2;
+    if (result.time_of_contact <= 0) cdata->done = true;
+  }
+
+  return cdata->done;
+}
+
+bool ContinuousCollisionCallBackDefault::collide(
+    ContinuousCollisionObject* o1, ContinuousCollisionObject* o2) {
+  return defaultContinuousCollisionFunction(o1, o2, &data);
+}
+
 bool defaultDistanceFunction(CollisionObject* o1, CollisionObject* o2,
                              void* data, FCL_REAL& dist) {
   assert(data != nullptr);
@@ -39,6 +39,7 @@
 #include <hpp/fcl/collision_utility.h>
 #include <hpp/fcl/collision_func_matrix.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/parallel.h>
 
 namespace hpp {
 namespace fcl {
@@ -155,19 +156,34 @@ ComputeCollision::ComputeCollision(const CollisionGeometry* o1,
     func = looktable.collision_matrix[node_type2][node_type1];
   else
     func = looktable.collision_matrix[node_type1][node_type2];
+  front_func = swap_geoms
+                   ? NULL
+                   : looktable.front_collision_matrix[node_type1][node_type2];
+
+  solver.keep_simplex_cached_guess =
+      object_type1 == OT_GEOM && object_type2 == OT_GEOM;
 }
 
-std::size_t ComputeCollision::run(const Transform3f& tf1,
-                                  const Transform3f& tf2,
-                                  const CollisionRequest& request,
-                                  CollisionResult& result) const {
+namespace {
+/// Body of ComputeCollision::run, with the solver given explicitly so that
+/// ComputeCollision::batch can provide one solver per thread, and without
+/// front list.
+std::size_t runCollision(
+    CollisionFunctionMatrix::CollisionFunc func, bool swap_geoms,
+    const CollisionGeometry* o1, const CollisionGeometry* o2,
+    const Transform3f& tf1, const Transform3f& tf2, const GJKSolver& solver,
+    const CollisionRequest& request, CollisionResult& result,
+    CollisionFunctionMatrix::BVHFrontCollisionFunc front_func = NULL,
+    BVHFrontList* front_list = NULL) {
   // If security margin is set to -infinity, return that there is no collision
   if (request.security_margin == -std::numeric_limits<FCL_REAL>::infinity()) {
     result.clear();
     return false;
   }
   std::size_t res;
-  if (swap_geoms) {
+  if (front_func && front_list && request.enable_front_list) {
+    res = front_func(o1, tf1, o2, tf2, request, result, *front_list);
+  } else if (swap_geoms) {
     res = func(o2, tf2, o1, tf1, &solver, request, result);
     result.swapObjects();
     result.nearest_points[0].swap(result.nearest_points[1]);
@@ -183,6 +199,15 @@ std::size_t ComputeCollision::run(const Transform3f& tf1,
 
   return res;
 }
+}  // namespace
+
+std::size_t ComputeCollision::run(const Transform3f& tf1,
+                                  const Transform3f& tf2,
+                                  const CollisionRequest& request,
+                                  CollisionResult& result) const {
+  return runCollision(func, swap_geoms, o1, o2, tf1, tf2, solver, request,
+                      result, front_func, &front_list);
+}
 
 std::size_t ComputeCollision::operator()(const Transform3f& tf1,
                                          const Transform3f& tf2,
@@ -203,5 +228,60 @@ std::size_t ComputeCollision::operator()(const Transform3f& tf1,
   return res;
 }
 
+std::size_t ComputeCollision::batch(const std::vector<Transform3f>& tf1s,
+                                    const std::vector<Transform3f>& tf2s,
+                                    const CollisionRequest& request,
+                                    std::vector<CollisionResult>& results,
+                                    unsigned int num_threads) const {
+  if (tf1s.size() != tf2s.size())
+    HPP_FCL_THROW_PRETTY("The number of placements of the first ("
+                             << tf1s.size() << ") and second (" << tf2s.size()
+                             << ") geometries differ.",
+                         std::invalid_argument);
+
+  const std::size_t num_queries = tf1s.size();
+  results.resize(num_queries);
+  if (num_queries == 0) return 0;
+
+  // Each worker has its own copy of the request and its own solver, which
+  // chain the cached guesses of its queries without locking.
+  const unsigned int num_workers =
+      internal::getNumWorkers(num_threads, num_queries);
+  HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
+  HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
+  const std::vector<CollisionRequest> requests(num_workers, request);
+  HPP_FCL_COMPILER_DIAGNOSTIC_POP
+  GJKSolver worker_solver(request);
+  worker_solver.keep_simplex_cached_guess = solver.keep_simplex_cached_guess;
+  std::vector<GJKSolver, Eigen::aligned_allocator<GJKSolver> > solvers(
+      num_workers, worker_solver);
+  std::vector<std::size_t> num_collisions(num_workers, 0);
+
+  internal::parallelFor(
+      num_queries, num_workers, [&](unsigned int worker, std::size_t i) {
+        const CollisionRequest& req = requests[worker];
+        GJKSolver& slv = solvers[worker];
+        CollisionResult& result = results[i];
+        result.clear();
+        slv.set(req);
+
+        std::size_t res;
+        if (req.enable_timings) {
+          Timer timer;
+          res = runCollision(func, swap_geoms, o1, o2, tf1s[i], tf2s[i], slv,
+                             req, result);
+          result.timings = timer.elapsed();
+        } else
+          res = runCollision(func, swap_geoms, o1, o2, tf1s[i], tf2s[i], slv,
+                             req, result);
+        if (res > 0) ++num_collisions[worker];
+      });
+
+  std::size_t total = 0;
+  for (std::size_t k = 0; k < num_collisions.size(); ++k)
+    total += num_collisions[k];
+  return total;
+}
+
 }  // namespace fcl
 }  // namespace hpp
@@ -76,29 +76,10 @@ std::size_t OctreeCollide(const CollisionGeometry* o1, const Transform3f& tf1,
 
 #endif
 
-namespace details {
+/// @brief Collider functor for BVHModel and shapes.
+/// The bounding volumes of the model are placed by tf1 during the traversal,
+/// so that the model is neither copied nor refitted.
 template <typename T_BVH, typename T_SH>
-struct bvh_shape_traits {
-  enum { Options = RelativeTransformationIsIdentity };
-};
-#define BVH_SHAPE_DEFAULT_TO_ORIENTED(bv) \
-  template <typename T_SH>                \
-  struct bvh_shape_traits<bv, T_SH> {     \
-    enum { Options = 0 };                 \
-  }
-BVH_SHAPE_DEFAULT_TO_ORIENTED(OBB);
-BVH_SHAPE_DEFAULT_TO_ORIENTED(RSS);
-BVH_SHAPE_DEFAULT_TO_ORIENTED(kIOS);
-BVH_SHAPE_DEFAULT_TO_ORIENTED(OBBRSS);
-#undef BVH_SHAPE_DEFAULT_TO_ORIENTED
-}  // namespace details
-
-/// \tparam _Options takes two values.
-///         - RelativeTransformationIsIdentity if object 1 should be moved
-///           into the frame of object 2 before computing collisions.
-///         - 0 if the query should be made with non-aligned object frames.
-template <typename T_BVH, typename T_SH,
-          int _Options = details::bvh_shape_traits<T_BVH, T_SH>::Options>
 struct HPP_FCL_LOCAL BVHShapeCollider {
   static std::size_t collide(const CollisionGeometry* o1,
                              const Transform3f& tf1,
@@ -113,43 +94,6 @@ struct HPP_FCL_LOCAL BVHShapeCollider {
           "Negative security margin are not handled yet for BVHModel",
           std::invalid_argument);
 
-    if (_Options & RelativeTransformationIsIdentity)
-      return aligned(o1, tf1, o2, tf2, nsolver, request, result);
-    else
-      return oriented(o1, tf1, o2, tf2, nsolver, request, result);
-  }
-
-  static std::size_t aligned(const CollisionGeometry* o1,
-                             const Transform3f& tf1,
-                             const CollisionGeometry* o2,
-                             const Transform3f& tf2, const GJKSolver* nsolver,
-                             const CollisionRequest& request,
-                             CollisionResult& result) {
-    if (request.isSatisfied(result)) return result.numContacts();
-
-    MeshShapeCollisionTraversalNode<T_BVH, T_SH,
-                                    RelativeTransformationIsIdentity>
-        node(request);
-    const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-    BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
-    Transform3f tf1_tmp = tf1;
-    const T_SH* obj2 = static_cast<const T_SH*>(o2);
-
-    initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, result);
-    fcl::collide(&node, request, result);
-
-    delete obj1_tmp;
-    return result.numContacts();
-  }
-
-  static std::size_t oriented(const CollisionGeometry* o1,
-                              const Transform3f& tf1,
-                              const CollisionGeometry* o2,
-                              const Transform3f& tf2, const GJKSolver* nsolver,
-                              const CollisionRequest& request,
-                              CollisionResult& result) {
-    if (request.isSatisfied(result)) return result.numContacts();
-
     MeshShapeCollisionTraversalNode<T_BVH, T_SH, 0> node(request);
     const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
     const T_SH* obj2 = static_cast<const T_SH*>(o2);
@@ -188,90 +132,28 @@ struct HPP_FCL_LOCAL HeightFieldShapeCollider {
   }
 };
 
-namespace details {
-template <typename OrientedMeshCollisionTraversalNode, typename T_BVH>
-std::size_t orientedMeshCollide(const CollisionGeometry* o1,
-                                const Transform3f& tf1,
-                                const CollisionGeometry* o2,
-                                const Transform3f& tf2,
-                                const CollisionRequest& request,
-                                CollisionResult& result) {
-  if (request.isSatisfied(result)) return result.numContacts();
-
-  OrientedMeshCollisionTraversalNode node(request);
-  const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
-  const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
-
-  initialize(node, *obj1, tf1, *obj2, tf2, result);
-  collide(&node, request, result);
-
-  return result.numContacts();
-}
-
-}  // namespace details
-
+/// The bounding volumes of the second model are placed in the frame of the
+/// first one during the traversal, so that the models are neither copied nor
+/// refitted. This holds for the axis-aligned AABB and KDOP as well: they are
+/// bounded on the fly by a volume aligned with the frame of the first model.
 template <typename T_BVH>
 std::size_t BVHCollide(const CollisionGeometry* o1, const Transform3f& tf1,
                        const CollisionGeometry* o2, const Transform3f& tf2,
                        const CollisionRequest& request,
-                       CollisionResult& result) {
+                       CollisionResult& result,
+                       BVHFrontList* front_list = NULL) {
   if (request.isSatisfied(result)) return result.numContacts();
 
-  // TODO(louis): each time we call collide on BVH-BVH, we:
-  //   - Allocate 2 new BVHs
-  //   - Copy and transform the vertices in both BVHs so that they are in the
-  //     same frame
-  //   - Recompute BVs of the BVH structure
-  // -> all that just to avoid doing (a few) rotations/translations of AABBs.
-  // Is it really worth it?
-  MeshCollisionTraversalNode<T_BVH> node(request);
+  MeshCollisionTraversalNode<T_BVH, 0> node(request);
   const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
   const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
-  BVHModel<T_BVH>* obj1_tmp = new BVHModel<T_BVH>(*obj1);
-  Transform3f tf1_tmp = tf1;
-  BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
-  Transform3f tf2_tmp = tf2;
-
-  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, result);
-  fcl::collide(&node, request, result);
 
-  delete obj1_tmp;
-  delete obj2_tmp;
+  initialize(node, *obj1, tf1, *obj2, tf2, result);
+  collide(&node, request, result, front_list);
 
   return result.numContacts();
 }
 
-template <>
-std::size_t BVHCollide<OBB>(const CollisionGeometry* o1, const Transform3f& tf1,
-                            const CollisionGeometry* o2, const Transform3f& tf2,
-                            const CollisionRequest& request,
-                            CollisionResult& result) {
-  return details::orientedMeshCollide<MeshCollisionTraversalNodeOBB, OBB>(
-      o1, tf1, o2, tf2, request, result);
-}
-
-template <>
-std::size_t BVHCollide<OBBRSS>(const CollisionGeometry* o1,
-                               const Transform3f& tf1,
-                               const CollisionGeometry* o2,
-                               const Transform3f& tf2,
-                               const CollisionRequest& request,
-                               CollisionResult& result) {
-  return details::orientedMeshCollide<MeshCollisionTraversalNodeOBBRSS, OBBRSS>(
-      o1, tf1, o2, tf2, request, result);
-}
-
-template <>
-std::size_t BVHCollide<kIOS>(const CollisionGeometry* o1,
-                             const Transform3f& tf1,
-                             const CollisionGeometry* o2,
-                             const Transform3f& tf2,
-                             const CollisionRequest& request,
-                             CollisionResult& result) {
-  return details::orientedMeshCollide<MeshCollisionTraversalNodekIOS, kIOS>(
-      o1, tf1, o2, tf2, request, result);
-}
-
 template <typename T_BVH>
 std::size_t BVHCollide(const CollisionGeometry* o1, const Transform3f& tf1,
                        const CollisionGeometry* o2, const Transform3f& tf2,
@@ -281,9 +163,23 @@ std::size_t BVHCollide(const CollisionGeometry* o1, const Transform3f& tf1,
   return BVHCollide<T_BVH>(o1, tf1, o2, tf2, request, result);
 }
 
+template <typename T_BVH>
+std::size_t BVHFrontCollide(const CollisionGeometry* o1,
+                            const Transform3f& tf1,
+                            const CollisionGeometry* o2,
+                            const Transform3f& tf2,
+                            const CollisionRequest& request,
+                            CollisionResult& result,
+                            BVHFrontList& front_list) {
+  return BVHCollide<T_BVH>(o1, tf1, o2, tf2, request, result, &front_list);
+}
+
 CollisionFunctionMatrix::CollisionFunctionMatrix() {
   for (int i = 0; i < NODE_COUNT; ++i) {
-    for (int j = 0; j < NODE_COUNT; ++j) collision_matrix[i][j] = NULL;
+    for (int j = 0; j < NODE_COUNT; ++j) {
+      collision_matrix[i][j] = NULL;
+      front_collision_matrix[i][j] = NULL;
+    }
   }
 
   collision_matrix[GEOM_BOX][GEOM_BOX] = &ShapeShapeCollide<Box, Box>;
@@ -662,6 +558,15 @@ CollisionFunctionMatrix::CollisionFunctionMatrix() {
   collision_matrix[BV_kIOS][BV_kIOS] = &BVHCollide<kIOS>;
   collision_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHCollide<OBBRSS>;
 
+  front_collision_matrix[BV_AABB][BV_AABB] = &BVHFrontCollide<AABB>;
+  front_collision_matrix[BV_OBB][BV_OBB] = &BVHFrontCollide<OBB>;
+  front_collision_matrix[BV_RSS][BV_RSS] = &BVHFrontCollide<RSS>;
+  front_collision_matrix[BV_KDOP16][BV_KDOP16] = &BVHFrontCollide<KDOP<16> >;
+  front_collision_matrix[BV_KDOP18][BV_KDOP18] = &BVHFrontCollide<KDOP<18> >;
+  front_collision_matrix[BV_KDOP24][BV_KDOP24] = &BVHFrontCollide<KDOP<24> >;
+  front_collision_matrix[BV_kIOS][BV_kIOS] = &BVHFrontCollide<kIOS>;
+  front_collision_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHFrontCollide<OBBRSS>;
+
 #ifdef HPP_FCL_HAS_OCTOMAP
   collision_matrix[GEOM_OCTREE][GEOM_BOX] = &OctreeCollide<OcTree, Box>;
   collision_matrix[GEOM_OCTREE][GEOM_SPHERE] = &OctreeCollide<OcTree, Sphere>;
@@ -64,11 +64,24 @@ void checkResultLowerBound(const CollisionResult& result,
 void collide(CollisionTraversalNodeBase* node, const CollisionRequest& request,
              CollisionResult& result, BVHFrontList* front_list,
              bool recursive) {
-  if (front_list && front_list->size() > 0) {
+  if (node->isQuantized()) {
+    // The boxes of a compressed hierarchy are decoded from the root, hence
+    // the traversal cannot restart from a front.
+    if (front_list) front_list->clear();
+    AABB box1, box2;
+    node->getRootBoxes(box1, box2);
+    FCL_REAL sqrDistLowerBound = 0;
+    collisionRecurseQuantized(node, 0, box1, 0, box2, sqrDistLowerBound);
+    if (!std::isnan(sqrDistLowerBound)) {
+      checkResultLowerBound(result, sqrDistLowerBound);
+    }
+  } else if (front_list && front_list->size() > 0) {
     propagateBVHFrontListCollisionRecurse(node, request, result, front_list);
   } else {
     FCL_REAL sqrDistLowerBound = 0;
-    if (recursive)
+    if (recursive && !front_list && node->isFirstModelWide())
+      collisionRecurseWide(node, 0, 0, sqrDistLowerBound);
+    else if (recursive)
       collisionRecurse(node, 0, 0, front_list, sqrDistLowerBound);
     else
       collisionNonRecurse(node, front_list, sqrDistLowerBound);
@@ -79,13 +92,17 @@ void collide(CollisionTraversalNodeBase* node, const CollisionRequest& request,
 }
 
 void distance(DistanceTraversalNodeBase* node, BVHFrontList* front_list,
-              unsigned int qsize) {
+              unsigned int qsize, bool recursive) {
   node->preprocess();
 
-  if (qsize <= 2)
+  if (front_list && front_list->size() > 0)
+    propagateBVHFrontListDistanceRecurse(node, front_list);
+  else if (qsize > 2)
+    distanceQueueRecurse(node, 0, 0, front_list, qsize);
+  else if (recursive)
     distanceRecurse(node, 0, 0, front_list);
   else
-    distanceQueueRecurse(node, 0, 0, front_list, qsize);
+    distanceNonRecurse(node, front_list);
 
   node->postprocess();
 }
@@ -66,9 +66,13 @@ HPP_FCL_DLLAPI void collide(CollisionTraversalNodeBase* node,
 
 /// @brief distance computation on distance traversal node; can use front list
 /// to accelerate \todo should be HPP_FCL_LOCAL but used in unit test.
+/// @param qsize size of the queue of the best first traversal, which is used
+///        when greater than 2.
+/// @param recursive whether to use distanceRecurse rather than
+///        distanceNonRecurse.
 HPP_FCL_DLLAPI void distance(DistanceTraversalNodeBase* node,
                              BVHFrontList* front_list = NULL,
-                             unsigned int qsize = 2);
+                             unsigned int qsize = 2, bool recursive = true);
 }  // namespace fcl
 
 }  // namespace hpp
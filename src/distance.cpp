@@ -39,6 +39,7 @@
 #include <hpp/fcl/collision_utility.h>
 #include <hpp/fcl/distance_func_matrix.h>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/internal/parallel.h>
 
 #include <iostream>
 
@@ -84,6 +85,7 @@ FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
       res = looktable.distance_matrix[node_type2][node_type1](
           o2, tf2, o1, tf1, &solver, request, result);
       std::swap(result.o1, result.o2);
+      std::swap(result.b1, result.b2);
       result.nearest_points[0].swap(result.nearest_points[1]);
       result.normal *= -1;
     }
@@ -100,6 +102,9 @@ FCL_REAL distance(const CollisionGeometry* o1, const Transform3f& tf1,
           o1, tf1, o2, tf2, &solver, request, result);
     }
   }
+  if (request.enable_derivatives)
+    internal::computeDistanceDerivatives(o1, tf1, o2, tf2, &solver, request,
+                                         result);
   // Cache narrow phase solver result. If the option in the request is selected,
   // also store the solver result in the request for the next call.
   result.cached_gjk_guess = solver.cached_guess;
@@ -134,21 +139,41 @@ ComputeDistance::ComputeDistance(const CollisionGeometry* o1,
     func = looktable.distance_matrix[node_type2][node_type1];
   else
     func = looktable.distance_matrix[node_type1][node_type2];
+  front_func = swap_geoms
+                   ? NULL
+                   : looktable.front_distance_matrix[node_type1][node_type2];
+
+  solver.keep_simplex_cached_guess =
+      object_type1 == OT_GEOM && object_type2 == OT_GEOM;
 }
 
-FCL_REAL ComputeDistance::run(const Transform3f& tf1, const Transform3f& tf2,
-                              const DistanceRequest& request,
-                              DistanceResult& result) const {
+namespace {
+/// Body of ComputeDistance::run, with the solver given explicitly so that
+/// ComputeDistance::batch can provide one solver per thread, and without
+/// front list.
+FCL_REAL runDistance(
+    DistanceFunctionMatrix::DistanceFunc func, bool swap_geoms,
+    const CollisionGeometry* o1, const CollisionGeometry* o2,
+    const Transform3f& tf1, const Transform3f& tf2, const GJKSolver& solver,
+    const DistanceRequest& request, DistanceResult& result,
+    DistanceFunctionMatrix::BVHFrontDistanceFunc front_func = NULL,
+    BVHFrontList* front_list = NULL) {
   FCL_REAL res;
 
-  if (swap_geoms) {
+  if (front_func && front_list && request.enable_front_list) {
+    res = front_func(o1, tf1, o2, tf2, request, result, *front_list);
+  } else if (swap_geoms) {
     res = func(o2, tf2, o1, tf1, &solver, request, result);
     std::swap(result.o1, result.o2);
+    std::swap(result.b1, result.b2);
     result.nearest_points[0].swap(result.nearest_points[1]);
     result.normal *= -1;
   } else {
     res = func(o1, tf1, o2, tf2, &solver, request, result);
   }
+  if (request.enable_derivatives)
+    internal::computeDistanceDerivatives(o1, tf1, o2, tf2, &solver, request,
+                                         result);
   // Cache narrow phase solver result. If the option in the request is selected,
   // also store the solver result in the request for the next call.
   result.cached_gjk_guess = solver.cached_guess;
@@ -156,6 +181,14 @@ FCL_REAL ComputeDistance::run(const Transform3f& tf1, const Transform3f& tf2,
   request.updateGuess(result);
   return res;
 }
+}  // namespace
+
+FCL_REAL ComputeDistance::run(const Transform3f& tf1, const Transform3f& tf2,
+                              const DistanceRequest& request,
+                              DistanceResult& result) const {
+  return runDistance(func, swap_geoms, o1, o2, tf1, tf2, solver, request,
+                     result, front_func, &front_list);
+}
 
 FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
                                      const Transform3f& tf2,
@@ -173,5 +206,52 @@ FCL_REAL ComputeDistance::operator()(const Transform3f& tf1,
   return res;
 }
 
+void ComputeDistance::batch(const std::vector<Transform3f>& tf1s,
+                            const std::vector<Transform3f>& tf2s,
+                            const DistanceRequest& request,
+                            std::vector<DistanceResult>& results,
+                            unsigned int num_threads) const {
+  if (tf1s.size() != tf2s.size())
+    HPP_FCL_THROW_PRETTY("The number of placements of the first ("
+                             << tf1s.size() << ") and second (" << tf2s.size()
+                             << ") geometries differ.",
+                         std::invalid_argument);
+
+  const std::size_t num_queries = tf1s.size();
+  results.resize(num_queries);
+  if (num_queries == 0) return;
+
+  // Each worker has its own copy of the request and its own solver, which
+  // chain the cached guesses of its queries without locking.
+  const unsigned int num_workers =
+      internal::getNumWorkers(num_threads, num_queries);
+  HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
+  HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
+  const std::vector<DistanceRequest> requests(num_workers, request);
+  HPP_FCL_COMPILER_DIAGNOSTIC_POP
+  GJKSolver worker_solver(request);
+  worker_solver.keep_simplex_cached_guess = solver.keep_simplex_cached_guess;
+  std::vector<GJKSolver, Eigen::aligned_allocator<GJKSolver> > solvers(
+      num_workers, worker_solver);
+
+  internal::parallelFor(
+      num_queries, num_workers, [&](unsigned int worker, std::size_t i) {
+        const DistanceRequest& req = requests[worker];
+        GJKSolver& slv = solvers[worker];
+        DistanceResult& result = results[i];
+        result.clear();
+        slv.set(req);
+
+        if (req.enable_timings) {
+          Timer timer;
+          runDistance(func, swap_geoms, o1, o2, tf1s[i], tf2s[i], slv, req,
+                      result);
+          result.timings = timer.elapsed();
+        } else
+          runDistance(func, swap_geoms, o1, o2, tf1s[i], tf2s[i], slv, req,
+                      result);
+      });
+}
+
 }  // namespace fcl
 }  // namespace hpp
@@ -67,6 +67,7 @@ FCL_REAL ShapeShapeDistance<TriangleP, TriangleP>(
   // Get GJK initial guess
   Vec3f guess;
   if (solver->gjk_initial_guess == GJKInitialGuess::CachedGuess ||
+      solver->gjk_initial_guess == GJKInitialGuess::CachedSimplex ||
       solver->enable_cached_guess) {
     guess = solver->cached_guess;
   } else {
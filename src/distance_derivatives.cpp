@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace {
+/// Vertices of the final simplex of GJK or EPA, moving with the objects.
+struct WitnessSimplex {
+  /// Number of vertices.
+  int rank;
+  /// Points of the first object, in its frame.
+  Vec3f a[4];
+  /// Points of the second object, in its frame.
+  Vec3f b[4];
+  /// Swept sphere radii of the objects.
+  FCL_REAL radius[2];
+  /// Whether the cores of the objects, without their swept spheres, overlap,
+  /// i.e. the simplex comes from EPA.
+  bool penetration;
+};
+
+/// Gets the simplex of the last run of \p solver, if it ran on \p o1 and \p
+/// o2.
+bool getSimplex(const CollisionGeometry* o1, const CollisionGeometry* o2,
+                const GJKSolver& solver, WitnessSimplex& simplex) {
+  const details::MinkowskiDiff& md = solver.minkowski_difference;
+  bool swap;
+  if (md.shapes[0] == o1 && md.shapes[1] == o2)
+    swap = false;
+  else if (md.shapes[0] == o2 && md.shapes[1] == o1)
+    swap = true;
+  else
+    return false;
+
+  const details::GJK::Simplex* s;
+  switch (solver.gjk.status) {
+    case details::GJK::Failed:
+    case details::GJK::NoCollision:
+    case details::GJK::CollisionWithPenetrationInformation:
+      s = solver.gjk.getSimplex();
+      simplex.penetration = false;
+      break;
+    case details::GJK::Collision:
+      if (solver.epa.status == details::EPA::DidNotRun ||
+          solver.epa.status == details::EPA::FallBack)
+        return false;
+      s = &solver.epa.result;
+      simplex.penetration = true;
+      break;
+    default:
+      return false;
+  }
+  if (s == nullptr || s->rank == 0) return false;
+
+  simplex.rank = s->rank;
+  for (int i = 0; i < simplex.rank; ++i) {
+    const Vec3f w0 = s->vertex[i]->w0;
+    const Vec3f w1 = md.oR1.transpose() * (s->vertex[i]->w1 - md.ot1);
+    simplex.a[i] = swap ? w1 : w0;
+    simplex.b[i] = swap ? w0 : w1;
+  }
+  simplex.radius[0] = md.swept_sphere_radius[swap ? 1 : 0];
+  simplex.radius[1] = md.swept_sphere_radius[swap ? 0 : 1];
+  return true;
+}
+
+/// Gets the shape of \p o on which the nearest point lies: \p o itself or
+/// the triangle \p b of a mesh.
+const ShapeBase* getPrimitive(const CollisionGeometry* o, int b,
+                              TriangleP& triangle) {
+  switch (o->getObjectType()) {
+    case OT_GEOM:
+      return static_cast<const ShapeBase*>(o);
+    case OT_BVH: {
+      const BVHModelBase* model = static_cast<const BVHModelBase*>(o);
+      if (b < 0 || !model->vertices || !model->tri_indices ||
+          b >= int(model->num_tris))
+        return nullptr;
+      const std::vector<Vec3f>& vertices = *model->vertices;
+      const Triangle& tri = (*model->tri_indices)[std::size_t(b)];
+      triangle.a = vertices[tri[0]];
+      triangle.b = vertices[tri[1]];
+      triangle.c = vertices[tri[2]];
+      return &triangle;
+    }
+    default:
+      return nullptr;
+  }
+}
+
+/// Runs GJK and EPA between the shapes supporting the nearest points.
+bool computeSimplex(const CollisionGeometry* o1, const Transform3f& tf1,
+                    const CollisionGeometry* o2, const Transform3f& tf2,
+                    const DistanceRequest& request,
+                    const DistanceResult& result, WitnessSimplex& simplex) {
+  TriangleP triangles[2];
+  const ShapeBase* s1 = getPrimitive(o1, result.b1, triangles[0]);
+  const ShapeBase* s2 = getPrimitive(o2, result.b2, triangles[1]);
+  if (s1 == nullptr || s2 == nullptr) return false;
+
+  GJKSolver solver(request);
+  if (result.normal.allFinite()) {
+    // GJK converges at once from the separating direction.
+    solver.gjk_initial_guess = GJKInitialGuess::CachedGuess;
+    solver.cached_guess = -(tf1.getRotation().transpose() * result.normal);
+  }
+  Vec3f p1, p2, normal;
+  solver.shapeDistance(*s1, tf1, *s2, tf2, true, p1, p2, normal);
+  if (!getSimplex(s1, s2, solver, simplex)) return false;
+  return true;
+}
+
+typedef Eigen::Matrix<FCL_REAL, 3, 12> Jacobian;
+
+/// Cross product matrix of \p p.
+Matrix3f skew(const Vec3f& p) {
+  Matrix3f p_cross;
+  p_cross << 0, -p[2], p[1], p[2], 0, -p[0], -p[1], p[0], 0;
+  return p_cross;
+}
+
+/// Differentiates the projection of the origin onto the affine hull of the
+/// simplex, with respect to the poses of the objects, to get the derivatives
+/// of the nearest points.
+bool differentiateSimplex(const Transform3f& tf1, const Transform3f& tf2,
+                          WitnessSimplex simplex, DistanceResult& result) {
+  Vec3f A[4], B[4], W[4];
+
+  // Projection x = W0 + E mu of the origin, with the vertices of null weight
+  // removed, as they do not belong to the feature supporting the nearest
+  // points. The n edges E and the Gram matrix G = E^T E are padded to 3x3
+  // with null edges and the identity, so that mu and its derivatives are
+  // padded with zeros.
+  Matrix3f E, G_inv;
+  Vec3f mu;
+  int n;
+  bool reduced = true;
+  while (reduced) {
+    for (int i = 0; i < simplex.rank; ++i) {
+      A[i] = tf1.transform(simplex.a[i]);
+      B[i] = tf2.transform(simplex.b[i]);
+      W[i] = A[i] - B[i];
+    }
+    n = simplex.rank - 1;
+    E.setZero();
+    for (int j = 0; j < n; ++j) E.col(j) = W[j + 1] - W[0];
+    Matrix3f G(E.transpose() * E);
+    for (int j = n; j < 3; ++j) G(j, j) = 1;
+    bool invertible;
+    G.computeInverseWithCheck(
+        G_inv, invertible,
+        std::pow(G.trace(), n) * Eigen::NumTraits<FCL_REAL>::epsilon());
+    if (!invertible) return false;
+    mu.noalias() = -G_inv * (E.transpose() * W[0]);
+
+    reduced = false;
+    const FCL_REAL eps =
+        std::sqrt(Eigen::NumTraits<FCL_REAL>::dummy_precision());
+    const FCL_REAL weight0 = 1 - mu.sum();
+    for (int i = 0; i < simplex.rank && simplex.rank > 1; ++i) {
+      const FCL_REAL weight = i == 0 ? weight0 : mu[i - 1];
+      if (weight < eps) {
+        for (int k = i; k + 1 < simplex.rank; ++k) {
+          simplex.a[k] = simplex.a[k + 1];
+          simplex.b[k] = simplex.b[k + 1];
+        }
+        --simplex.rank;
+        reduced = true;
+        break;
+      }
+    }
+  }
+
+  const Vec3f x(W[0] + E * mu);
+  const FCL_REAL x_norm = x.norm();
+  const bool inflated = simplex.radius[0] > 0 || simplex.radius[1] > 0;
+  if (inflated && x_norm < Eigen::NumTraits<FCL_REAL>::dummy_precision())
+    return false;
+
+  // Velocities of the nearest points c1 = sum_i lambda_i A_i and c2 at
+  // constant weights, then of the weights, from the normal equations
+  // E^T (W0 + E mu) = 0, for the 12 unit velocities of the objects at once.
+  const Matrix3f& R1 = tf1.getRotation();
+  const Matrix3f& R2 = tf2.getRotation();
+  Vec3f a((1 - mu.sum()) * simplex.a[0]), b((1 - mu.sum()) * simplex.b[0]);
+  for (int j = 0; j < n; ++j) {
+    a += mu[j] * simplex.a[j + 1];
+    b += mu[j] * simplex.b[j + 1];
+  }
+  Jacobian dc1(Jacobian::Zero()), dc2(Jacobian::Zero());
+  dc1.block<3, 3>(0, 0) = R1;
+  dc1.block<3, 3>(0, 3).noalias() = -R1 * skew(a);
+  dc2.block<3, 3>(0, 6) = R2;
+  dc2.block<3, 3>(0, 9).noalias() = -R2 * skew(b);
+  Jacobian dx(dc1 - dc2);
+  if (n > 0) {
+    // The edges only vary with the rotations.
+    const Vec3f u1(R1.transpose() * x), u2(R2.transpose() * x);
+    Matrix3f EA(Matrix3f::Zero()), EB(Matrix3f::Zero());
+    Jacobian rhs(-E.transpose() * dx);
+    for (int j = 0; j < n; ++j) {
+      EA.col(j) = A[j + 1] - A[0];
+      EB.col(j) = B[j + 1] - B[0];
+      rhs.block<1, 3>(j, 3) +=
+          u1.cross(simplex.a[j + 1] - simplex.a[0]).transpose();
+      rhs.block<1, 3>(j, 9) -=
+          u2.cross(simplex.b[j + 1] - simplex.b[0]).transpose();
+    }
+    const Jacobian dmu(G_inv * rhs);
+    dc1.noalias() += EA * dmu;
+    dc2.noalias() += EB * dmu;
+    dx.noalias() += E * dmu;
+  }
+
+  if (inflated) {
+    // The normal points from the first to the second object: the swept
+    // spheres move with it.
+    const FCL_REAL sign = simplex.penetration ? 1 : -1;
+    const Vec3f normal(sign * x / x_norm);
+    const Jacobian dnormal(
+        sign * (dx - normal * (normal.transpose() * dx)) / x_norm);
+    dc1 += simplex.radius[0] * dnormal;
+    dc2 -= simplex.radius[1] * dnormal;
+  }
+  result.dnearest_points_dtf[0] = dc1;
+  result.dnearest_points_dtf[1] = dc2;
+  return true;
+}
+}  // namespace
+
+namespace internal {
+void computeDistanceDerivatives(const CollisionGeometry* o1,
+                                const Transform3f& tf1,
+                                const CollisionGeometry* o2,
+                                const Transform3f& tf2,
+                                const GJKSolver* solver,
+                                const DistanceRequest& request,
+                                DistanceResult& result) {
+  result.clearDerivatives();
+  const Vec3f& n = result.normal;
+  if (!n.allFinite() || !result.nearest_points[0].allFinite() ||
+      !result.nearest_points[1].allFinite())
+    return;
+
+  // The distance varies as the velocity of the second object relative to the
+  // first one, at a point of the line of the nearest points, along the
+  // normal.
+  const Vec3f p = (result.nearest_points[0] + result.nearest_points[1]) / 2;
+  const Vec3f n1 = tf1.getRotation().transpose() * n;
+  const Vec3f n2 = tf2.getRotation().transpose() * n;
+  const Vec3f p1 = tf1.inverseTransform(p);
+  const Vec3f p2 = tf2.inverseTransform(p);
+  result.dmin_distance_dtf.segment<3>(0) = -n1;
+  result.dmin_distance_dtf.segment<3>(3) = -p1.cross(n1);
+  result.dmin_distance_dtf.segment<3>(6) = n2;
+  result.dmin_distance_dtf.segment<3>(9) = p2.cross(n2);
+
+  WitnessSimplex simplex;
+  const bool has_simplex =
+      (solver != nullptr && o1->getObjectType() == OT_GEOM &&
+       o2->getObjectType() == OT_GEOM &&
+       getSimplex(o1, o2, *solver, simplex)) ||
+      computeSimplex(o1, tf1, o2, tf2, request, result, simplex);
+  if (!has_simplex || !differentiateSimplex(tf1, tf2, simplex, result)) {
+    const FCL_REAL nan = std::numeric_limits<FCL_REAL>::quiet_NaN();
+    result.dnearest_points_dtf[0].setConstant(nan);
+    result.dnearest_points_dtf[1].setConstant(nan);
+  }
+}
+}  // namespace internal
+
+void computeDistanceDerivatives(const CollisionGeometry* o1,
+                                const Transform3f& tf1,
+                                const CollisionGeometry* o2,
+                                const Transform3f& tf2,
+                                const DistanceRequest& request,
+                                DistanceResult& result) {
+  internal::computeDistanceDerivatives(o1, tf1, o2, tf2, nullptr, request,
+                                       result);
+}
+
+}  // namespace fcl
+}  // namespace hpp
@@ -98,7 +98,7 @@ struct HPP_FCL_LOCAL BVHShapeDistancer {
     const T_SH* obj2 = static_cast<const T_SH*>(o2);
 
     initialize(node, *obj1_tmp, tf1_tmp, *obj2, tf2, nsolver, request, result);
-    fcl::distance(&node);
+    fcl::distance(&node, NULL, 2, false);
 
     delete obj1_tmp;
     return result.min_distance;
@@ -122,7 +122,7 @@ FCL_REAL orientedBVHShapeDistance(const CollisionGeometry* o1,
   const T_SH* obj2 = static_cast<const T_SH*>(o2);
 
   initialize(node, *obj1, tf1, *obj2, tf2, nsolver, request, result);
-  fcl::distance(&node);
+  fcl::distance(&node, NULL, 2, false);
 
   return result.min_distance;
 }
@@ -201,7 +201,8 @@ struct HPP_FCL_LOCAL HeightFieldShapeDistancer {
 template <typename T_BVH>
 FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
                      const CollisionGeometry* o2, const Transform3f& tf2,
-                     const DistanceRequest& request, DistanceResult& result) {
+                     const DistanceRequest& request, DistanceResult& result,
+                     BVHFrontList* front_list) {
   if (request.isSatisfied(result)) return result.min_distance;
   MeshDistanceTraversalNode<T_BVH> node;
   const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
@@ -211,8 +212,11 @@ FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
   BVHModel<T_BVH>* obj2_tmp = new BVHModel<T_BVH>(*obj2);
   Transform3f tf2_tmp = tf2;
 
-  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, request, result);
-  distance(&node);
+  // The BVHs are refitted rather than rebuilt to keep the front valid, and
+  // the recursive traversal records its structure.
+  initialize(node, *obj1_tmp, tf1_tmp, *obj2_tmp, tf2_tmp, request, result,
+             front_list != NULL);
+  distance(&node, front_list, 2, front_list != NULL);
   delete obj1_tmp;
   delete obj2_tmp;
 
@@ -226,14 +230,16 @@ FCL_REAL orientedMeshDistance(const CollisionGeometry* o1,
                               const CollisionGeometry* o2,
                               const Transform3f& tf2,
                               const DistanceRequest& request,
-                              DistanceResult& result) {
+                              DistanceResult& result,
+                              BVHFrontList* front_list) {
   if (request.isSatisfied(result)) return result.min_distance;
   OrientedMeshDistanceTraversalNode node;
   const BVHModel<T_BVH>* obj1 = static_cast<const BVHModel<T_BVH>*>(o1);
   const BVHModel<T_BVH>* obj2 = static_cast<const BVHModel<T_BVH>*>(o2);
 
   initialize(node, *obj1, tf1, *obj2, tf2, request, result);
-  distance(&node);
+  // The recursive traversal records the structure of the front.
+  distance(&node, front_list, 2, front_list != NULL);
 
   return result.min_distance;
 }
@@ -244,18 +250,20 @@ template <>
 FCL_REAL BVHDistance<RSS>(const CollisionGeometry* o1, const Transform3f& tf1,
                           const CollisionGeometry* o2, const Transform3f& tf2,
                           const DistanceRequest& request,
-                          DistanceResult& result) {
+                          DistanceResult& result,
+                          BVHFrontList* front_list) {
   return details::orientedMeshDistance<MeshDistanceTraversalNodeRSS, RSS>(
-      o1, tf1, o2, tf2, request, result);
+      o1, tf1, o2, tf2, request, result, front_list);
 }
 
 template <>
 FCL_REAL BVHDistance<kIOS>(const CollisionGeometry* o1, const Transform3f& tf1,
                            const CollisionGeometry* o2, const Transform3f& tf2,
                            const DistanceRequest& request,
-                           DistanceResult& result) {
+                           DistanceResult& result,
+                           BVHFrontList* front_list) {
   return details::orientedMeshDistance<MeshDistanceTraversalNodekIOS, kIOS>(
-      o1, tf1, o2, tf2, request, result);
+      o1, tf1, o2, tf2, request, result, front_list);
 }
 
 template <>
@@ -264,9 +272,10 @@ FCL_REAL BVHDistance<OBBRSS>(const CollisionGeometry* o1,
                              const CollisionGeometry* o2,
                              const Transform3f& tf2,
                              const DistanceRequest& request,
-                             DistanceResult& result) {
+                             DistanceResult& result,
+                             BVHFrontList* front_list) {
   return details::orientedMeshDistance<MeshDistanceTraversalNodeOBBRSS, OBBRSS>(
-      o1, tf1, o2, tf2, request, result);
+      o1, tf1, o2, tf2, request, result, front_list);
 }
 
 template <typename T_BVH>
@@ -274,12 +283,23 @@ FCL_REAL BVHDistance(const CollisionGeometry* o1, const Transform3f& tf1,
                      const CollisionGeometry* o2, const Transform3f& tf2,
                      const GJKSolver* /*nsolver*/,
                      const DistanceRequest& request, DistanceResult& result) {
-  return BVHDistance<T_BVH>(o1, tf1, o2, tf2, request, result);
+  return BVHDistance<T_BVH>(o1, tf1, o2, tf2, request, result, NULL);
+}
+
+template <typename T_BVH>
+FCL_REAL BVHFrontDistance(const CollisionGeometry* o1, const Transform3f& tf1,
+                          const CollisionGeometry* o2, const Transform3f& tf2,
+                          const DistanceRequest& request,
+                          DistanceResult& result, BVHFrontList& front_list) {
+  return BVHDistance<T_BVH>(o1, tf1, o2, tf2, request, result, &front_list);
 }
 
 DistanceFunctionMatrix::DistanceFunctionMatrix() {
   for (int i = 0; i < NODE_COUNT; ++i) {
-    for (int j = 0; j < NODE_COUNT; ++j) distance_matrix[i][j] = NULL;
+    for (int j = 0; j < NODE_COUNT; ++j) {
+      distance_matrix[i][j] = NULL;
+      front_distance_matrix[i][j] = NULL;
+    }
   }
 
   distance_matrix[GEOM_BOX][GEOM_BOX] = &ShapeShapeDistance<Box, Box>;
@@ -603,6 +623,12 @@ DistanceFunctionMatrix::DistanceFunctionMatrix() {
   distance_matrix[BV_kIOS][BV_kIOS] = &BVHDistance<kIOS>;
   distance_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHDistance<OBBRSS>;
 
+  front_distance_matrix[BV_AABB][BV_AABB] = &BVHFrontDistance<AABB>;
+  front_distance_matrix[BV_OBB][BV_OBB] = &BVHFrontDistance<OBB>;
+  front_distance_matrix[BV_RSS][BV_RSS] = &BVHFrontDistance<RSS>;
+  front_distance_matrix[BV_kIOS][BV_kIOS] = &BVHFrontDistance<kIOS>;
+  front_distance_matrix[BV_OBBRSS][BV_OBBRSS] = &BVHFrontDistance<OBBRSS>;
+
 #ifdef HPP_FCL_HAS_OCTOMAP
   distance_matrix[GEOM_OCTREE][GEOM_BOX] = &Distance<OcTree, Box>;
   distance_matrix[GEOM_OCTREE][GEOM_SPHERE] = &Distance<OcTree, Sphere>;
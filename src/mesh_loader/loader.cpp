@@ -36,9 +36,15 @@
 
 #include <hpp/fcl/mesh_loader/loader.h>
 #include <hpp/fcl/mesh_loader/assimp.h>
+#include <hpp/fcl/serialization/flat_binary.h>
+#include <hpp/fcl/internal/parallel.h>
 
 #include <boost/filesystem.hpp>
 
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
 #ifdef HPP_FCL_HAS_OCTOMAP
 #include <hpp/fcl/octree.h>
 #endif
@@ -65,6 +71,82 @@ BVHModelPtr_t _load(const std::string& filename, const Vec3f& scale) {
   return polyhedron;
 }
 
+template <typename BV>
+BVHModelPtr_t _loadFlatBinary(const std::string& filename) {
+  shared_ptr<BVHModel<BV> > polyhedron(new BVHModel<BV>);
+  serialization::loadFromFlatBinary(*polyhedron, filename);
+  return polyhedron;
+}
+
+template <typename BV>
+void _saveFlatBinary(const BVHModelBase& model, const std::string& filename) {
+  serialization::saveToFlatBinary(static_cast<const BVHModel<BV>&>(model),
+                                  filename);
+}
+
+static BVHModelPtr_t loadFlatBinary(NODE_TYPE bvType,
+                                    const std::string& filename) {
+  switch (bvType) {
+    case BV_AABB:
+      return _loadFlatBinary<AABB>(filename);
+    case BV_OBB:
+      return _loadFlatBinary<OBB>(filename);
+    case BV_RSS:
+      return _loadFlatBinary<RSS>(filename);
+    case BV_kIOS:
+      return _loadFlatBinary<kIOS>(filename);
+    case BV_OBBRSS:
+      return _loadFlatBinary<OBBRSS>(filename);
+    case BV_KDOP16:
+      return _loadFlatBinary<KDOP<16> >(filename);
+    case BV_KDOP18:
+      return _loadFlatBinary<KDOP<18> >(filename);
+    case BV_KDOP24:
+      return _loadFlatBinary<KDOP<24> >(filename);
+    default:
+      HPP_FCL_THROW_PRETTY("Unhandled bouding volume type.",
+                           std::invalid_argument);
+  }
+}
+
+static void saveFlatBinary(NODE_TYPE bvType, const BVHModelBase& model,
+                           const std::string& filename) {
+  switch (bvType) {
+    case BV_AABB:
+      return _saveFlatBinary<AABB>(model, filename);
+    case BV_OBB:
+      return _saveFlatBinary<OBB>(model, filename);
+    case BV_RSS:
+      return _saveFlatBinary<RSS>(model, filename);
+    case BV_kIOS:
+      return _saveFlatBinary<kIOS>(model, filename);
+    case BV_OBBRSS:
+      return _saveFlatBinary<OBBRSS>(model, filename);
+    case BV_KDOP16:
+      return _saveFlatBinary<KDOP<16> >(model, filename);
+    case BV_KDOP18:
+      return _saveFlatBinary<KDOP<18> >(model, filename);
+    case BV_KDOP24:
+      return _saveFlatBinary<KDOP<24> >(model, filename);
+    default:
+      HPP_FCL_THROW_PRETTY("Unhandled bouding volume type.",
+                           std::invalid_argument);
+  }
+}
+
+namespace {
+/// FNV-1a hash of \p size bytes, starting from \p hash.
+std::uint64_t hashBytes(const void* data, std::size_t size,
+                        std::uint64_t hash = 14695981039346656037ULL) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
 BVHModelPtr_t MeshLoader::load(const std::string& filename,
                                const Vec3f& scale) {
   switch (bvType_) {
@@ -90,6 +172,23 @@ BVHModelPtr_t MeshLoader::load(const std::string& filename,
   }
 }
 
+std::vector<BVHModelPtr_t> MeshLoader::loadMany(
+    const std::vector<std::string>& filenames,
+    const std::vector<Vec3f>& scales, unsigned int num_threads) {
+  if (!scales.empty() && scales.size() != filenames.size())
+    HPP_FCL_THROW_PRETTY("There should be as many scales as files.",
+                         std::invalid_argument);
+
+  std::vector<BVHModelPtr_t> models(filenames.size());
+  internal::parallelFor(
+      filenames.size(), internal::getNumWorkers(num_threads, filenames.size()),
+      [&](unsigned int, std::size_t i) {
+        models[i] =
+            load(filenames[i], scales.empty() ? Vec3f::Ones() : scales[i]);
+      });
+  return models;
+}
+
 CollisionGeometryPtr_t MeshLoader::loadOctree(const std::string& filename) {
 #ifdef HPP_FCL_HAS_OCTOMAP
   shared_ptr<octomap::OcTree> octree(new octomap::OcTree(filename));
@@ -101,28 +200,118 @@ CollisionGeometryPtr_t MeshLoader::loadOctree(const std::string& filename) {
 #endif
 }
 
+std::string CachedMeshLoader::cachePath(const std::string& filename,
+                                       const Vec3f& scale) const {
+  std::ifstream file(filename.c_str(), std::ios::binary);
+  if (!file) return std::string();
+  std::uint64_t hash = hashBytes(NULL, 0);
+  std::vector<char> buffer(1 << 16);
+  while (file) {
+    file.read(buffer.data(), (std::streamsize)buffer.size());
+    hash = hashBytes(buffer.data(), (std::size_t)file.gcount(), hash);
+  }
+  if (file.bad()) return std::string();
+
+  char name[64];
+  std::snprintf(name, sizeof(name), "%016llx-%016llx-%d.hppfcl",
+                (unsigned long long)hash,
+                (unsigned long long)hashBytes(scale.data(), sizeof(Vec3f)),
+                (int)getNodeType());
+  return (boost::filesystem::path(cache_directory_) / name).string();
+}
+
+CachedMeshLoader::CachedMeshLoader(const CachedMeshLoader& other)
+    : MeshLoader(other),
+      cache_(other.cache_),
+      cache_directory_(other.cache_directory_) {}
+
 BVHModelPtr_t CachedMeshLoader::load(const std::string& filename,
                                      const Vec3f& scale) {
   Key key(filename, scale);
 
   std::time_t mtime = 0;
+  bool has_mtime = false;
   try {
     mtime = boost::filesystem::last_write_time(filename);
+    has_mtime = true;
+  } catch (boost::filesystem::filesystem_error&) {
+    // Could not stat. Make sure we will try to load the file so that
+    // there will be a file not found error.
+  }
 
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (has_mtime) {
     Cache_t::const_iterator _cached = cache_.find(key);
     if (_cached != cache_.end() && _cached->second.mtime == mtime)
       // File found in cache and mtime is the same
       return _cached->second.model;
-  } catch (boost::filesystem::filesystem_error&) {
-    // Could not stat. Make sure we will try to load the file so that
-    // there will be a file not found error.
+  }
+  std::map<Key, std::shared_future<BVHModelPtr_t> >::const_iterator _pending =
+      pending_.find(key);
+  if (_pending != pending_.end()) {
+    // Another thread is loading the file.
+    std::shared_future<BVHModelPtr_t> future = _pending->second;
+    lock.unlock();
+    return future.get();
+  }
+  std::promise<BVHModelPtr_t> promise;
+  pending_[key] = promise.get_future().share();
+  lock.unlock();
+
+  BVHModelPtr_t geom;
+  try {
+    geom = loadUncached(filename, scale);
+  } catch (...) {
+    lock.lock();
+    pending_.erase(key);
+    lock.unlock();
+    promise.set_exception(std::current_exception());
+    throw;
   }
 
-  BVHModelPtr_t geom = MeshLoader::load(filename, scale);
   Value val;
   val.model = geom;
   val.mtime = mtime;
+  lock.lock();
   cache_[key] = val;
+  pending_.erase(key);
+  lock.unlock();
+  promise.set_value(geom);
+  return geom;
+}
+
+BVHModelPtr_t CachedMeshLoader::loadUncached(const std::string& filename,
+                                             const Vec3f& scale) {
+  const std::string cache_path =
+      cache_directory_.empty() ? std::string() : cachePath(filename, scale);
+  BVHModelPtr_t geom;
+  if (!cache_path.empty() && boost::filesystem::exists(cache_path)) {
+    try {
+      geom = loadFlatBinary(getNodeType(), cache_path);
+    } catch (std::invalid_argument&) {
+      // Written by another version of the library: build the model again.
+    }
+  }
+  if (geom) return geom;
+
+  geom = MeshLoader::load(filename, scale);
+  if (!cache_path.empty()) {
+    // Write in a temporary file first so that other processes never read a
+    // partially written file.
+    const boost::filesystem::path tmp_path =
+        boost::filesystem::path(cache_directory_) /
+        boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+    try {
+      boost::filesystem::create_directories(cache_directory_);
+      saveFlatBinary(getNodeType(), *geom, tmp_path.string());
+      boost::filesystem::rename(tmp_path, cache_path);
+    } catch (std::exception& e) {
+      boost::system::error_code ec;
+      boost::filesystem::remove(tmp_path, ec);
+      std::cerr << "Warning: could not store " << filename << " in "
+                << cache_directory_ << ": " << e.what() << std::endl;
+    }
+  }
   return geom;
 }
 }  // namespace fcl
@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#include <hpp/fcl/narrowphase/continuous_collision.h>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace {
+/// Distance from the origin of the frame of the geometry to its farthest
+/// point.
+FCL_REAL getRadius(const CollisionGeometry* cgeom) {
+  return cgeom->aabb_center.norm() + cgeom->aabb_radius;
+}
+}  // namespace
+
+Transform3f InterpMotion::getTransform(FCL_REAL t) const {
+  const Quatf q = tf_beg.getQuatRotation().slerp(t, tf_end.getQuatRotation());
+  return Transform3f(q, (1 - t) * tf_beg.getTranslation() +
+                            t * tf_end.getTranslation());
+}
+
+FCL_REAL InterpMotion::getMotionBound(FCL_REAL radius) const {
+  const FCL_REAL angle =
+      tf_beg.getQuatRotation().angularDistance(tf_end.getQuatRotation());
+  return (tf_end.getTranslation() - tf_beg.getTranslation()).norm() +
+         angle * radius;
+}
+
+void ContinuousCollisionObject::computeAABB() {
+  if (!cgeom) return;
+  if (tf_beg.getRotation() == tf_end.getRotation()) {
+    // A translation sweeps the AABB between its end positions.
+    CollisionObject beg(cgeom, tf_beg, false), end(cgeom, tf_end, false);
+    beg.computeAABB();
+    end.computeAABB();
+    aabb = beg.getAABB();
+    aabb += end.getAABB();
+  } else {
+    // The geometry stays in the ball around the origin of its frame, which
+    // moves along a segment.
+    const Vec3f radius = Vec3f::Constant(getRadius(cgeom.get()));
+    aabb = AABB(tf_beg.getTranslation() - radius,
+                tf_beg.getTranslation() + radius);
+    aabb += AABB(tf_end.getTranslation() - radius,
+                 tf_end.getTranslation() + radius);
+  }
+}
+
+Transform3f ContinuousCollisionObject::getTransform(FCL_REAL t) const {
+  return InterpMotion(tf_beg, tf_end).getTransform(t);
+}
+
+FCL_REAL ContinuousCollisionObject::getMotionBound() const {
+  return InterpMotion(tf_beg, tf_end).getMotionBound(getRadius(cgeom.get()));
+}
+
+FCL_REAL collide(const ContinuousCollisionObject* o1,
+                 const ContinuousCollisionObject* o2,
+                 const ContinuousCollisionRequest& request,
+                 ContinuousCollisionResult& result) {
+  return collide(o1->collisionGeometryPtr(), o1->getTransformBeg(),
+                 o1->getTransformEnd(), o2->collisionGeometryPtr(),
+                 o2->getTransformBeg(), o2->getTransformEnd(), request,
+                 result);
+}
+
+FCL_REAL collide(const CollisionGeometry* o1, const Transform3f& tf1_beg,
+                 const Transform3f& tf1_end, const CollisionGeometry* o2,
+                 const Transform3f& tf2_beg, const Transform3f& tf2_end,
+                 const ContinuousCollisionRequest& request,
+                 ContinuousCollisionResult& result) {
+  return collide(o1, InterpMotion(tf1_beg, tf1_end), o2,
+                 InterpMotion(tf2_beg, tf2_end), request, result);
+}
+
+FCL_REAL collide(const CollisionGeometry* o1, const MotionBase& motion1,
+                 const CollisionGeometry* o2, const MotionBase& motion2,
+                 const ContinuousCollisionRequest& request,
+                 ContinuousCollisionResult& result) {
+  if (o1->aabb_radius < 0 || o2->aabb_radius < 0)
+    HPP_FCL_THROW_PRETTY(
+        "computeLocalAABB must have been called on the geometries.",
+        std::invalid_argument);
+  if (request.tolerance <= 0)
+    HPP_FCL_THROW_PRETTY("The tolerance must be positive.",
+                         std::invalid_argument);
+
+  result.clear();
+  const FCL_REAL bound = motion1.getMotionBound(getRadius(o1)) +
+                         motion2.getMotionBound(getRadius(o2));
+  if (bound < 0)
+    HPP_FCL_THROW_PRETTY("The motion bounds must be non negative.",
+                         std::invalid_argument);
+
+  // The objects are in contact when they are closer than the tolerance.
+  CollisionRequest collision_request(NO_REQUEST, 1);
+  collision_request.security_margin = request.tolerance;
+  DistanceRequest distance_request;
+  ComputeCollision compute_collision(o1, o2);
+  ComputeDistance compute_distance(o1, o2);
+  // The distance lower bound of pairs of shapes is their distance.
+  const bool exact_lower_bound =
+      o1->getObjectType() == OT_GEOM && o2->getObjectType() == OT_GEOM;
+
+  FCL_REAL t = 0;
+  for (size_t i = 0; i < request.max_iterations; ++i) {
+    const Transform3f tf1 = motion1.getTransform(t);
+    const Transform3f tf2 = motion2.getTransform(t);
+
+    CollisionResult collision_result;
+    ++result.num_queries;
+    bool in_contact =
+        compute_collision(tf1, tf2, collision_request, collision_result) > 0;
+    FCL_REAL distance =
+        collision_result.distance_lower_bound + request.tolerance;
+    if (!in_contact && !exact_lower_bound &&
+        collision_result.distance_lower_bound <=
+            collision_request.break_distance) {
+      // The bounding volumes overlap: the lower bound does not allow to
+      // advance.
+      DistanceResult distance_result;
+      ++result.num_queries;
+      distance =
+          compute_distance(tf1, tf2, distance_request, distance_result);
+      in_contact = distance <= request.tolerance;
+    }
+
+    if (in_contact) {
+      result.is_collide = true;
+      result.time_of_contact = t;
+      result.contact_tf1 = tf1;
+      result.contact_tf2 = tf2;
+      return t;
+    }
+    if (bound == 0) {
+      // The objects do not move relatively to each other.
+      t = 1;
+      break;
+    }
+    t += distance / bound;
+    if (t >= 1) break;
+  }
+
+  if (t < 1) {
+    // Out of iterations: the contact is reported at the last time proven
+    // free.
+    result.is_collide = true;
+    result.time_of_contact = t;
+    result.contact_tf1 = motion1.getTransform(t);
+    result.contact_tf2 = motion2.getTransform(t);
+    return t;
+  }
+  result.contact_tf1 = motion1.getTransform(1);
+  result.contact_tf2 = motion2.getTransform(1);
+  return 1;
+}
+
+}  // namespace fcl
+}  // namespace hpp
@@ -43,6 +43,8 @@
 #include <hpp/fcl/shape/geometric_shapes_traits.h>
 #include <hpp/fcl/narrowphase/narrowphase_defaults.h>
 
+#include "support_functions.hxx"
+
 namespace hpp {
 namespace fcl {
 
@@ -70,6 +72,21 @@ void GJK::reset(size_t max_iterations_, FCL_REAL tolerance_) {
 
 Vec3f GJK::getGuessFromSimplex() const { return ray; }
 
+void GJK::getSimplexGuess(SimplexGuess& simplex_guess) const {
+  if (simplex == nullptr) {
+    simplex_guess.rank = 0;
+    return;
+  }
+  simplex_guess.shapes[0] = shape->shapes[0];
+  simplex_guess.shapes[1] = shape->shapes[1];
+  simplex_guess.rank = simplex->rank;
+  for (vertex_id_t i = 0; i < simplex->rank; ++i) {
+    simplex_guess.w0[i] = simplex->vertex[i]->w0;
+    simplex_guess.w1[i].noalias() =
+        shape->oR1.transpose() * (simplex->vertex[i]->w1 - shape->ot1);
+  }
+}
+
 namespace details {
 
 // This function computes the weights associated with projecting the origin
@@ -185,32 +202,85 @@ void GJK::getWitnessPointsAndNormal(const MinkowskiDiff& shape, Vec3f& w0,
   details::inflate<true>(shape, normal, w0, w1);
 }
 
+inline void GJK::removeVertex(Simplex& simplex) {
+  free_v[nfree++] = simplex.vertex[--simplex.rank];
+}
+
+inline void GJK::appendVertex(Simplex& simplex, const Vec3f& v,
+                              support_func_guess_t& hint) {
+  simplex.vertex[simplex.rank] = free_v[--nfree];  // set the memory
+  getSupport(v, *simplex.vertex[simplex.rank++], hint);
+}
+
+template <typename MinkowskiDiffType>
+inline void GJK::appendVertex(Simplex& simplex, const Vec3f& v,
+                              support_func_guess_t& hint,
+                              const MinkowskiDiffType& support_shape) {
+  SimplexV& sv = *(simplex.vertex[simplex.rank++] = free_v[--nfree]);
+  support_shape.support(v, sv.w0, sv.w1, hint);
+  sv.w = sv.w0 - sv.w1;
+}
+
 GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
-                          const support_func_guess_t& supportHint) {
+                          const support_func_guess_t& supportHint,
+                          const SimplexGuess* simplex_guess) {
+  return evaluateTpl(shape_, shape_, guess, supportHint, simplex_guess);
+}
+
+template <typename Shape0, typename Shape1>
+GJK::Status GJK::evaluate(const MinkowskiDiffT<Shape0, Shape1>& shape_,
+                          const Vec3f& guess,
+                          const support_func_guess_t& supportHint,
+                          const SimplexGuess* simplex_guess) {
+  return evaluateTpl(shape_.minkowski_difference, shape_, guess, supportHint,
+                     simplex_guess);
+}
+
+template <typename MinkowskiDiffType>
+GJK::Status GJK::evaluateTpl(const MinkowskiDiff& shape_,
+                             const MinkowskiDiffType& support_shape,
+                             const Vec3f& guess,
+                             const support_func_guess_t& supportHint,
+                             const SimplexGuess* simplex_guess) {
   FCL_REAL alpha = 0;
   iterations = 0;
   const FCL_REAL swept_sphere_radius = shape_.swept_sphere_radius.sum();
   const FCL_REAL upper_bound = distance_upper_bound + swept_sphere_radius;
 
-  free_v[0] = &store_v[0];
-  free_v[1] = &store_v[1];
-  free_v[2] = &store_v[2];
-  free_v[3] = &store_v[3];
-
-  nfree = 4;
   status = NoCollision;
   shape = &shape_;
   distance = 0.0;
   current = 0;
-  simplices[current].rank = 0;
   support_hint = supportHint;
 
-  FCL_REAL rl = guess.norm();
-  if (rl < tolerance) {
-    ray = Vec3f(-1, 0, 0);
-    rl = 1;
-  } else
-    ray = guess;
+  // When warm-started from a simplex, the ray is a point of the Minkowski
+  // difference, so that the convergence check is meaningful from the first
+  // iteration. A simplex enclosing the origin is discarded: EPA would start
+  // from vertices which are not supports of the Minkowski difference.
+  const bool warm_start = simplex_guess != nullptr &&
+                          simplex_guess->rank > 0 &&
+                          simplex_guess->shapes[0] == shape->shapes[0] &&
+                          simplex_guess->shapes[1] == shape->shapes[1] &&
+                          !projectSimplexGuessOrigin(*simplex_guess);
+  FCL_REAL rl;
+  if (warm_start) {
+    rl = ray.norm();
+  } else {
+    free_v[0] = &store_v[0];
+    free_v[1] = &store_v[1];
+    free_v[2] = &store_v[2];
+    free_v[3] = &store_v[3];
+
+    nfree = 4;
+    simplices[current].rank = 0;
+
+    rl = guess.norm();
+    if (rl < tolerance) {
+      ray = Vec3f(-1, 0, 0);
+      rl = 1;
+    } else
+      ray = guess;
+  }
 
   // Momentum
   GJKVariant current_gjk_variant = gjk_variant;
@@ -278,7 +348,7 @@ GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
     }
 
     // see below, ray points away from origin
-    appendVertex(curr_simplex, -dir, support_hint);
+    appendVertex(curr_simplex, -dir, support_hint, support_shape);
 
     // check removed (by ?): when the new support point is close to previous
     // support points, stop (as the new simplex is degenerated)
@@ -306,8 +376,8 @@ GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
     // check C: when the new support point is close to the sub-simplex where the
     // ray point lies, stop (as the new simplex again is degenerated)
     bool cv_check_passed = checkConvergence(w, rl, alpha, omega);
-    if (iterations > 0 && cv_check_passed) {
-      if (iterations > 0) removeVertex(simplices[current]);
+    if ((iterations > 0 || warm_start) && cv_check_passed) {
+      removeVertex(simplices[current]);
       if (current_gjk_variant != DefaultGJK) {
         current_gjk_variant = DefaultGJK;  // move back to classic GJK
         iterations_momentum_stop = iterations;
@@ -369,6 +439,34 @@ GJK::Status GJK::evaluate(const MinkowskiDiff& shape_, const Vec3f& guess,
   return status;
 }
 
+#define HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Shape1)                     \
+  template GJK::Status HPP_FCL_DLLAPI GJK::evaluate<Shape0, Shape1>(           \
+      const MinkowskiDiffT<Shape0, Shape1>&, const Vec3f&,                     \
+      const support_func_guess_t&, const SimplexGuess*);
+#define HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Shape0)                            \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, TriangleP)                        \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Box)                              \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Sphere)                           \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Ellipsoid)                        \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Capsule)                          \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Cone)                             \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, Cylinder)                         \
+  HPP_FCL_GJK_EVALUATE_INSTANTIATION(Shape0, ConvexBase)
+
+// clang-format off
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(TriangleP)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Box)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Sphere)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Ellipsoid)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Capsule)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Cone)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(Cylinder)
+HPP_FCL_GJK_EVALUATE_INSTANTIATIONS(ConvexBase)
+// clang-format on
+
+#undef HPP_FCL_GJK_EVALUATE_INSTANTIATIONS
+#undef HPP_FCL_GJK_EVALUATE_INSTANTIATION
+
 bool GJK::checkConvergence(const Vec3f& w, const FCL_REAL& rl, FCL_REAL& alpha,
                            const FCL_REAL& omega) const {
   // x^* is the optimal solution (projection of origin onto the Minkowski
@@ -424,16 +522,6 @@ bool GJK::checkConvergence(const Vec3f& w, const FCL_REAL& rl, FCL_REAL& alpha,
   }
 }
 
-inline void GJK::removeVertex(Simplex& simplex) {
-  free_v[nfree++] = simplex.vertex[--simplex.rank];
-}
-
-inline void GJK::appendVertex(Simplex& simplex, const Vec3f& v,
-                              support_func_guess_t& hint) {
-  simplex.vertex[simplex.rank] = free_v[--nfree];  // set the memory
-  getSupport(v, *simplex.vertex[simplex.rank++], hint);
-}
-
 bool GJK::encloseOrigin() {
   Vec3f axis(Vec3f::Zero());
   support_func_guess_t hint = support_func_guess_t::Zero();
@@ -540,6 +628,78 @@ inline bool originToTriangle(const GJK::Simplex& current, GJK::vertex_id_t a,
   return false;
 }
 
+bool GJK::projectSimplexGuessOrigin(const SimplexGuess& simplex_guess) {
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, Eigen::Dynamic, 0, 3, 3>
+      GramMatrix;
+  typedef Eigen::Matrix<FCL_REAL, Eigen::Dynamic, 1, 0, 3, 1> GramVector;
+
+  const vertex_id_t rank = simplex_guess.rank;
+  for (vertex_id_t i = 0; i < rank; ++i) {
+    SimplexV& v = store_v[i];
+    v.w0 = simplex_guess.w0[i];
+    v.w1.noalias() = shape->oR1 * simplex_guess.w1[i] + shape->ot1;
+    v.w.noalias() = v.w0 - v.w1;
+  }
+
+  // Among the faces whose affine hull contains the projection of the origin
+  // with positive barycentric coordinates, the closest to the origin holds
+  // the projection onto the simplex. A face is a bit mask of the vertices.
+  int best_face = 1;
+  FCL_REAL best_norm = (std::numeric_limits<FCL_REAL>::max)();
+  for (int face = 1; face < (1 << rank); ++face) {
+    vertex_id_t ids[4];
+    Eigen::Index n = 0;
+    for (vertex_id_t i = 0; i < rank; ++i)
+      if (face & (1 << i)) ids[n++] = i;
+
+    const Vec3f& O = store_v[ids[0]].w;
+    Vec3f point(O);
+    if (n > 1) {
+      GramMatrix G(n - 1, n - 1);
+      GramVector b(n - 1);
+      for (Eigen::Index j = 1; j < n; ++j) {
+        const Vec3f Ej(store_v[ids[j]].w - O);
+        b[j - 1] = -Ej.dot(O);
+        for (Eigen::Index k = 1; k <= j; ++k)
+          G(j - 1, k - 1) = G(k - 1, j - 1) = Ej.dot(store_v[ids[k]].w - O);
+      }
+      Eigen::FullPivLU<GramMatrix> lu(G);
+      if (!lu.isInvertible()) continue;
+      const GramVector mu(lu.solve(b));
+      if ((mu.array() <= 0).any() || mu.sum() >= 1) continue;
+      for (Eigen::Index j = 1; j < n; ++j)
+        point += mu[j - 1] * (store_v[ids[j]].w - O);
+    }
+    const FCL_REAL norm = point.squaredNorm();
+    if (norm < best_norm) {
+      best_norm = norm;
+      best_face = face;
+      ray = point;
+    }
+  }
+
+  Simplex& curr_simplex = simplices[current];
+  curr_simplex.rank = 0;
+  nfree = 0;
+  for (vertex_id_t i = 0; i < 4; ++i) {
+    if (i < rank && (best_face & (1 << i)))
+      curr_simplex.vertex[curr_simplex.rank++] = &store_v[i];
+    else
+      free_v[nfree++] = &store_v[i];
+  }
+
+  // The projections expect the origin to be below the triangle, as oriented
+  // by originToTriangle.
+  if (curr_simplex.rank == 3) {
+    const Vec3f& A = curr_simplex.vertex[0]->w;
+    if ((curr_simplex.vertex[1]->w - A)
+            .cross(curr_simplex.vertex[2]->w - A)
+            .dot(A) < 0)
+      std::swap(curr_simplex.vertex[0], curr_simplex.vertex[1]);
+  }
+  return curr_simplex.rank == 4 || ray.isZero();
+}
+
 bool GJK::projectLineOrigin(const Simplex& current, Simplex& next) {
   const vertex_id_t a = 1, b = 0;
   // A is the last point we added.
@@ -1009,16 +1169,32 @@ bool GJK::projectTetrahedraOrigin(const Simplex& current, Simplex& next) {
   return false;
 }
 
+void EPA::Storage::reserve(size_t max_iterations) {
+  // EPA creates only 2 faces and 1 vertex per iteration.
+  // (+ the 4 (or 8 in the future) faces at the beginning
+  //  + the 4 vertices (or 6 in the future) at the beginning)
+  if (sv_store.size() < max_iterations + 4) sv_store.resize(max_iterations + 4);
+  if (fc_store.size() < 2 * max_iterations + 4)
+    fc_store.resize(2 * max_iterations + 4);
+}
+
+EPA::Storage& EPA::threadStorage() {
+  static thread_local Storage thread_storage;
+  return thread_storage;
+}
+
 void EPA::initialize() { reset(max_iterations, tolerance); }
 
 void EPA::reset(size_t max_iterations_, FCL_REAL tolerance_) {
   max_iterations = max_iterations_;
   tolerance = tolerance_;
-  // EPA creates only 2 faces and 1 vertex per iteration.
-  // (+ the 4 (or 8 in the future) faces at the beginning
-  //  + the 4 vertices (or 6 in the future) at the beginning)
-  sv_store.resize(max_iterations + 4);
-  fc_store.resize(2 * max_iterations + 4);
+  Storage& s = getStorage();
+  s.reserve(max_iterations);
+  s.user = this;
+  sv_store = s.sv_store.data();
+  fc_store = s.fc_store.data();
+  max_vertex_num = max_iterations + 4;
+  max_face_num = 2 * max_iterations + 4;
   status = DidNotRun;
   normal.setZero();
   support_hint.setZero();
@@ -1031,8 +1207,8 @@ void EPA::reset(size_t max_iterations_, FCL_REAL tolerance_) {
   // The stock is initialized with the faces in reverse order so that the
   // hull and the stock do not overlap (the stock will shring as the hull will
   // grow).
-  for (size_t i = 0; i < fc_store.size(); ++i)
-    stock.append(&fc_store[fc_store.size() - i - 1]);
+  for (size_t i = 0; i < max_face_num; ++i)
+    stock.append(&fc_store[max_face_num - i - 1]);
   iterations = 0;
 }
 
@@ -1056,7 +1232,8 @@ bool EPA::getEdgeDist(SimplexFace* face, const SimplexVertex& a,
       dist = b.w.norm();
     else {
       dist = std::sqrt(std::max(
-          a.w.squaredNorm() - a_dot_ab * a_dot_ab / ab.squaredNorm(), 0.));
+          a.w.squaredNorm() - a_dot_ab * a_dot_ab / ab.squaredNorm(),
+          FCL_REAL(0)));
     }
 
     return true;
@@ -1132,7 +1309,7 @@ EPA::SimplexFace* EPA::newFace(size_t id_a, size_t id_b, size_t id_c,
     return nullptr;
   }
 
-  assert(hull.count >= fc_store.size() && "EPA: should not be out of faces.");
+  assert(hull.count >= max_face_num && "EPA: should not be out of faces.");
   status = OutOfFaces;
   return nullptr;
 }
@@ -1154,6 +1331,12 @@ EPA::SimplexFace* EPA::findClosestFace() {
 }
 
 EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
+  // The faces of the storage are linked by the last EPA which used it.
+  const Storage& s = getStorage();
+  if (s.user != this || s.sv_store.data() != sv_store ||
+      s.fc_store.data() != fc_store)
+    reset(max_iterations, tolerance);
+
   GJK::Simplex& simplex = *gjk.getSimplex();
   support_hint = gjk.support_hint;
 
@@ -1169,7 +1352,7 @@ EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
       stock.append(f);
     }
     assert(hull.count == 0);
-    assert(stock.count == fc_store.size());
+    assert(stock.count == max_face_num);
 
     status = Valid;
     num_vertices = 0;
@@ -1211,7 +1394,7 @@ EPA::Status EPA::evaluate(GJK& gjk, const Vec3f& guess) {
       iterations = 0;
       size_t pass = 0;
       for (; iterations < max_iterations; ++iterations) {
-        if (num_vertices >= sv_store.size()) {
+        if (num_vertices >= max_vertex_num) {
           status = OutOfVertices;
           break;
         }
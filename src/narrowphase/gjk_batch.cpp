@@ -0,0 +1,397 @@
+//
+// Copyright (c) 2024 INRIA
+//
+
+#include <hpp/fcl/narrowphase/gjk_batch.h>
+
+namespace hpp {
+namespace fcl {
+
+namespace {
+
+typedef Eigen::Array<FCL_REAL, GJK_BATCH_SIZE, 1> Lanes;
+/// Row i is the vector of lane i, so that each coordinate is a SIMD packet.
+typedef Eigen::Array<FCL_REAL, GJK_BATCH_SIZE, 3> LaneVec3;
+
+inline Lanes dot(const LaneVec3& a, const LaneVec3& b) {
+  return a.col(0) * b.col(0) + a.col(1) * b.col(1) + a.col(2) * b.col(2);
+}
+
+/// Support of the shapes of each lane, without their swept-sphere radius, as
+/// getShapeSupport with SupportOptions::NoSweptSphere.
+template <typename S>
+struct LaneShape;
+
+template <>
+struct LaneShape<Sphere> {
+  void set(int lane, const Sphere& s) {
+    radius[lane] = s.radius + s.getSweptSphereRadius();
+  }
+  void support(const LaneVec3& /*dir*/, LaneVec3& s) const { s.setZero(); }
+
+  /// Radius which GJK adds to the distance.
+  Lanes radius;
+};
+
+template <>
+struct LaneShape<Capsule> {
+  void set(int lane, const Capsule& s) {
+    half_length[lane] = s.halfLength;
+    radius[lane] = s.radius + s.getSweptSphereRadius();
+  }
+  void support(const LaneVec3& dir, LaneVec3& s) const {
+    const FCL_REAL eps = Eigen::NumTraits<FCL_REAL>::dummy_precision();
+    s.col(0).setZero();
+    s.col(1).setZero();
+    s.col(2) = (dir.col(2) > eps)
+                   .select(half_length,
+                           (dir.col(2) < -eps).select(-half_length, 0));
+  }
+
+  Lanes half_length, radius;
+};
+
+template <>
+struct LaneShape<Box> {
+  void set(int lane, const Box& s) {
+    half_side.row(lane) = s.halfSide.transpose().array();
+    radius[lane] = s.getSweptSphereRadius();
+  }
+  void support(const LaneVec3& dir, LaneVec3& s) const {
+    const FCL_REAL eps = Eigen::NumTraits<FCL_REAL>::dummy_precision();
+    for (int c = 0; c < 3; ++c)
+      s.col(c) = (dir.col(c) > eps)
+                     .select(half_side.col(c),
+                             (dir.col(c) < -eps).select(-half_side.col(c), 0));
+  }
+
+  LaneVec3 half_side;
+  Lanes radius;
+};
+
+/// Rotations of the lanes, stored by coefficient.
+struct LaneRotation {
+  Lanes m[3][3];
+
+  void set(int lane, const Matrix3f& R) {
+    for (int i = 0; i < 3; ++i)
+      for (int j = 0; j < 3; ++j) m[i][j][lane] = R(i, j);
+  }
+  void apply(const LaneVec3& v, LaneVec3& out) const {
+    for (int i = 0; i < 3; ++i)
+      out.col(i) = m[i][0] * v.col(0) + m[i][1] * v.col(1) + m[i][2] * v.col(2);
+  }
+  void applyTranspose(const LaneVec3& v, LaneVec3& out) const {
+    for (int i = 0; i < 3; ++i)
+      out.col(i) = m[0][i] * v.col(0) + m[1][i] * v.col(1) + m[2][i] * v.col(2);
+  }
+};
+
+enum LaneStatus { Running, Converged, EarlyStopped, FallBack };
+
+/// State of GJK for a batch of pairs.
+///
+/// Slot 0 of the vertices holds the last support point and the slots 1 to
+/// rank[lane] hold the simplex of the lane. The supports, the Gram matrix of
+/// the vertices, the cofactors of Johnson's sub-algorithm and the norms of the
+/// projections are computed for all the lanes at once. Each lane then picks
+/// its sub-simplex and the lanes which stop are no longer updated.
+template <typename S1, typename S2>
+struct LockstepGJK {
+  LaneShape<S1> shape0;
+  LaneShape<S2> shape1;
+  // Pose of the second shape in the frame of the first one.
+  LaneRotation oR1;
+  LaneVec3 ot1;
+
+  LaneVec3 w[4], w0[4], w1[4];
+  LaneVec3 ray;
+  Lanes rl, alpha;
+
+  int rank[GJK_BATCH_SIZE];
+  int status[GJK_BATCH_SIZE];
+  FCL_REAL lambda[GJK_BATCH_SIZE][4];
+  FCL_REAL distance[GJK_BATCH_SIZE];
+
+  void set(int lane, const ShapePair<S1, S2>& pair) {
+    shape0.set(lane, *pair.s1);
+    shape1.set(lane, *pair.s2);
+    const Matrix3f& R0 = pair.tf1.getRotation();
+    oR1.set(lane, R0.transpose() * pair.tf2.getRotation());
+    ot1.row(lane) = (R0.transpose() * (pair.tf2.getTranslation() -
+                                       pair.tf1.getTranslation()))
+                        .transpose()
+                        .array();
+  }
+
+  /// Support of the Minkowski difference in direction -dir, as
+  /// MinkowskiDiff::support, stored in slot 0.
+  void support(const LaneVec3& dir) {
+    LaneVec3 dir1, local;
+    shape0.support(-dir, w0[0]);
+    oR1.applyTranspose(dir, dir1);
+    shape1.support(dir1, local);
+    oR1.apply(local, w1[0]);
+    w1[0] += ot1;
+    w[0] = w0[0] - w1[0];
+  }
+
+  void run(const GJKSolver& solver);
+  /// Projects the origin onto the simplex made of the new support point and
+  /// the simplex of each running lane.
+  void projectOrigin();
+  void getResult(int lane, const Transform3f& tf1,
+                 ShapeDistanceResult& result) const;
+};
+
+template <typename S1, typename S2>
+void LockstepGJK<S1, S2>::run(const GJKSolver& solver) {
+  const FCL_REAL tolerance = solver.gjk_tolerance;
+  const Lanes swept_sphere_radius = shape0.radius + shape1.radius;
+  const Lanes upper_bound = solver.distance_upper_bound + swept_sphere_radius;
+
+  for (int k = 0; k < 4; ++k) {
+    w[k].setZero();
+    w0[k].setZero();
+    w1[k].setZero();
+  }
+  for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane) {
+    rank[lane] = 0;
+    status[lane] = Running;
+  }
+  // Default guess of GJKSolver.
+  ray.setZero();
+  ray.col(0).setOnes();
+  rl.setOnes();
+  alpha.setZero();
+
+  for (size_t iterations = 0;; ++iterations) {
+    bool running = false;
+    for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane) {
+      if (status[lane] != Running) continue;
+      if (iterations >= solver.gjk_max_iterations) {
+        status[lane] = FallBack;
+      } else if (rl[lane] < tolerance) {
+        // The origin is on the simplex: EPA is needed.
+        status[lane] = FallBack;
+      } else {
+        running = true;
+      }
+    }
+    if (!running) break;
+
+    support(ray);
+    const Lanes omega = dot(ray, w[0]) / rl;
+    alpha = alpha.max(omega);
+
+    for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane) {
+      if (status[lane] != Running) continue;
+      if (omega[lane] > upper_bound[lane]) {
+        distance[lane] = omega[lane] - swept_sphere_radius[lane];
+        status[lane] = EarlyStopped;
+      } else if (iterations > 0 && (rl[lane] - alpha[lane]) -
+                                           (tolerance + tolerance * rl[lane]) <=
+                                       0) {
+        // The new support point is dropped: the result is the simplex.
+        distance[lane] = rl[lane] - swept_sphere_radius[lane];
+        status[lane] = Converged;
+      }
+    }
+
+    projectOrigin();
+  }
+}
+
+template <typename S1, typename S2>
+void LockstepGJK<S1, S2>::projectOrigin() {
+  // Johnson's sub-algorithm: delta[Y][i] is the cofactor of vertex i in the
+  // subset Y of the slots. The origin projects into the relative interior of
+  // the sub-simplex Y when all its cofactors are positive; the closest of
+  // these projections is the projection onto the simplex. The projection v
+  // onto the affine hull of Y verifies v.v = v.w_i for all i in Y.
+  // Only the slots used by a running lane are projected.
+  int max_rank = 0;
+  for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane)
+    if (status[lane] == Running) max_rank = (std::max)(max_rank, rank[lane]);
+  const int num_slots = max_rank + 1, num_subsets = 1 << num_slots;
+
+  Lanes dots[4][4];
+  for (int i = 0; i < num_slots; ++i)
+    for (int j = i; j < num_slots; ++j)
+      dots[i][j] = dots[j][i] = dot(w[i], w[j]);
+
+  Lanes delta[16][4], sum[16], norm[16];
+  for (int Y = 1; Y < num_subsets; ++Y) {
+    sum[Y].setZero();
+    for (int j = 0; j < 4; ++j) {
+      if (!(Y & (1 << j))) continue;
+      const int X = Y ^ (1 << j);
+      if (X == 0) {
+        delta[Y][j].setOnes();
+      } else {
+        int first = 0;
+        while (!(X & (1 << first))) ++first;
+        delta[Y][j].setZero();
+        for (int i = 0; i < 4; ++i)
+          if (X & (1 << i))
+            delta[Y][j] += delta[X][i] * (dots[i][first] - dots[i][j]);
+      }
+      sum[Y] += delta[Y][j];
+    }
+  }
+  // The subsets which contain the new support point (slot 0) are odd.
+  for (int Y = 1; Y < num_subsets; Y += 2) {
+    Lanes n = Lanes::Zero();
+    for (int i = 0; i < 4; ++i)
+      if (Y & (1 << i)) n += delta[Y][i] * dots[i][0];
+    norm[Y] = n / sum[Y];
+  }
+
+  const FCL_REAL eps = Eigen::NumTraits<FCL_REAL>::dummy_precision();
+  for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane) {
+    if (status[lane] != Running) continue;
+    FCL_REAL scale = 0;
+    for (int i = 0; i <= rank[lane]; ++i)
+      scale = (std::max)(scale, dots[i][i][lane]);
+
+    int best = 0;
+    FCL_REAL best_norm = (std::numeric_limits<FCL_REAL>::max)();
+    for (int Y = 1; Y < (2 << rank[lane]); Y += 2) {
+      bool valid = true;
+      FCL_REAL threshold = eps;
+      for (int i = 1; i < 4; ++i) {
+        if (!(Y & (1 << i))) continue;
+        valid = valid && delta[Y][i][lane] > 0;
+        threshold *= scale;
+      }
+      // Discard the degenerate sub-simplices.
+      valid = valid && delta[Y][0][lane] > 0 && sum[Y][lane] > threshold;
+      if (valid && norm[Y][lane] < best_norm) {
+        best = Y;
+        best_norm = norm[Y][lane];
+      }
+    }
+    // No valid sub-simplex (numerical issue), or the origin is inside the
+    // tetrahedron: the pair is computed by the scalar GJK and EPA.
+    if (best == 0 || best == 15 || best_norm <= 0) {
+      status[lane] = FallBack;
+      continue;
+    }
+
+    // Move the vertices of the sub-simplex to the slots 1 to rank.
+    Vec3f v(Vec3f::Zero()), sw[3], sw0[3], sw1[3];
+    FCL_REAL slambda[3];
+    int new_rank = 0;
+    for (int i = 0; i < 4; ++i) {
+      if (!(best & (1 << i))) continue;
+      slambda[new_rank] = delta[best][i][lane] / sum[best][lane];
+      sw[new_rank] = w[i].row(lane).transpose().matrix();
+      sw0[new_rank] = w0[i].row(lane).transpose().matrix();
+      sw1[new_rank] = w1[i].row(lane).transpose().matrix();
+      v += slambda[new_rank] * sw[new_rank];
+      ++new_rank;
+    }
+    for (int k = 0; k < new_rank; ++k) {
+      w[k + 1].row(lane) = sw[k].transpose().array();
+      w0[k + 1].row(lane) = sw0[k].transpose().array();
+      w1[k + 1].row(lane) = sw1[k].transpose().array();
+      lambda[lane][k + 1] = slambda[k];
+    }
+    rank[lane] = new_rank;
+    ray.row(lane) = v.transpose().array();
+    rl[lane] = std::sqrt(best_norm);
+  }
+}
+
+template <typename S1, typename S2>
+void LockstepGJK<S1, S2>::getResult(int lane, const Transform3f& tf1,
+                                    ShapeDistanceResult& result) const {
+  const FCL_REAL d = distance[lane];
+  result.distance = d;
+  if (status[lane] == EarlyStopped) {
+    result.p1 = result.p2 = result.normal =
+        Vec3f::Constant(std::numeric_limits<FCL_REAL>::quiet_NaN());
+    return;
+  }
+  // As GJK::getWitnessPointsAndNormal and
+  // GJKSolver::GJKExtractWitnessPointsAndNormal.
+  Vec3f p0(Vec3f::Zero()), p1(Vec3f::Zero());
+  for (int k = 1; k <= rank[lane]; ++k) {
+    p0 += lambda[lane][k] * w0[k].row(lane).transpose().matrix();
+    p1 += lambda[lane][k] * w1[k].row(lane).transpose().matrix();
+  }
+  Vec3f normal;
+  if ((p1 - p0).norm() > Eigen::NumTraits<FCL_REAL>::dummy_precision())
+    normal = (p1 - p0).normalized();
+  else
+    normal = -ray.row(lane).transpose().matrix().normalized();
+  p0 += shape0.radius[lane] * normal;
+  p1 -= shape1.radius[lane] * normal;
+
+  const Vec3f p = tf1.transform(0.5 * (p0 + p1));
+  result.normal.noalias() = tf1.getRotation() * normal;
+  result.p1.noalias() = p - 0.5 * d * result.normal;
+  result.p2.noalias() = p + 0.5 * d * result.normal;
+}
+
+}  // namespace
+
+template <typename S1, typename S2>
+void GJKBatchSolver<S1, S2>::shapeDistance(const Pair* pairs,
+                                           std::size_t num_pairs,
+                                           const bool compute_penetration,
+                                           ShapeDistanceResult* results) const {
+  num_fallbacks = 0;
+  const bool lockstep =
+      solver.gjk_variant == GJKVariant::DefaultGJK &&
+      solver.gjk_convergence_criterion == GJKConvergenceCriterion::Default &&
+      solver.gjk_initial_guess == GJKInitialGuess::DefaultGuess &&
+      !solver.enable_cached_guess;
+
+  if (lockstep) {
+    LockstepGJK<S1, S2> gjk;
+    for (std::size_t begin = 0; begin < num_pairs; begin += GJK_BATCH_SIZE) {
+      // The lanes past the last pair repeat it.
+      for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane)
+        gjk.set(lane, pairs[(std::min)(begin + std::size_t(lane),
+                                       num_pairs - 1)]);
+      gjk.run(solver);
+
+      for (int lane = 0; lane < GJK_BATCH_SIZE; ++lane) {
+        const std::size_t i = begin + std::size_t(lane);
+        if (i >= num_pairs) break;
+        ShapeDistanceResult& result = results[i];
+        if (gjk.status[lane] == FallBack) {
+          ++num_fallbacks;
+          result.distance = solver.shapeDistance(
+              *pairs[i].s1, pairs[i].tf1, *pairs[i].s2, pairs[i].tf2,
+              compute_penetration, result.p1, result.p2, result.normal);
+        } else {
+          gjk.getResult(lane, pairs[i].tf1, result);
+        }
+      }
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < num_pairs; ++i) {
+    ++num_fallbacks;
+    ShapeDistanceResult& result = results[i];
+    result.distance = solver.shapeDistance(
+        *pairs[i].s1, pairs[i].tf1, *pairs[i].s2, pairs[i].tf2,
+        compute_penetration, result.p1, result.p2, result.normal);
+  }
+}
+
+template struct GJKBatchSolver<Sphere, Sphere>;
+template struct GJKBatchSolver<Sphere, Capsule>;
+template struct GJKBatchSolver<Sphere, Box>;
+template struct GJKBatchSolver<Capsule, Sphere>;
+template struct GJKBatchSolver<Capsule, Capsule>;
+template struct GJKBatchSolver<Capsule, Box>;
+template struct GJKBatchSolver<Box, Sphere>;
+template struct GJKBatchSolver<Box, Capsule>;
+template struct GJKBatchSolver<Box, Box>;
+
+}  // namespace fcl
+}  // namespace hpp
@@ -39,6 +39,8 @@
 #include "hpp/fcl/narrowphase/minkowski_difference.h"
 #include "hpp/fcl/shape/geometric_shapes_traits.h"
 
+#include "support_functions.hxx"
+
 namespace hpp {
 namespace fcl {
 namespace details {
@@ -0,0 +1,323 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hpp/fcl/serialization/flat_binary.h"
+
+#include <cstddef>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hpp {
+namespace fcl {
+namespace serialization {
+namespace internal {
+
+namespace {
+const char flat_binary_magic[8] = {'H', 'P', 'P', 'F', 'C', 'L', 'F', 'B'};
+const std::uint32_t flat_binary_byte_order = 0x01020304;
+/// Alignment of the records, and size of their size field.
+const std::size_t record_alignment = 16;
+
+std::size_t align(std::size_t offset) {
+  return (offset + record_alignment - 1) & ~(record_alignment - 1);
+}
+}  // namespace
+
+FlatBinaryWriter::FlatBinaryWriter(const std::string& filename_,
+                                   FlatBinaryObjectType type,
+                                   std::uint32_t element_type,
+                                   std::uint32_t element_size)
+    : os(filename_.c_str(), std::ios::binary | std::ios::trunc),
+      filename(filename_),
+      size(0) {
+  if (!os) {
+    HPP_FCL_THROW_PRETTY(filename + " cannot be opened for writing.",
+                         std::invalid_argument);
+  }
+  FlatBinaryHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, flat_binary_magic, sizeof(header.magic));
+  header.version = flat_binary_version;
+  header.byte_order = flat_binary_byte_order;
+  header.scalar_size = (std::uint32_t)sizeof(FCL_REAL);
+  header.object_type = (std::uint32_t)type;
+  header.element_type = element_type;
+  header.element_size = element_size;
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  size = sizeof(header);
+}
+
+void FlatBinaryWriter::pad() {
+  static const char zeros[record_alignment] = {0};
+  const std::size_t aligned = align(size);
+  os.write(zeros, (std::streamsize)(aligned - size));
+  size = aligned;
+}
+
+void FlatBinaryWriter::write(const void* data, std::size_t data_size) {
+  pad();
+  char record_size[record_alignment] = {0};
+  const std::uint64_t size64 = data_size;
+  std::memcpy(record_size, &size64, sizeof(size64));
+  os.write(record_size, record_alignment);
+  if (data_size > 0)
+    os.write(reinterpret_cast<const char*>(data), (std::streamsize)data_size);
+  size += record_alignment + data_size;
+}
+
+void FlatBinaryWriter::close() {
+  pad();
+  const std::uint64_t size64 = size;
+  os.seekp((std::streamoff)offsetof(FlatBinaryHeader, size));
+  os.write(reinterpret_cast<const char*>(&size64), sizeof(size64));
+  os.close();
+  if (!os) {
+    HPP_FCL_THROW_PRETTY("Writing " + filename + " failed.",
+                         std::invalid_argument);
+  }
+}
+
+FlatBinaryReader::FlatBinaryReader(const std::string& filename_,
+                                   FlatBinaryObjectType type,
+                                   std::uint32_t element_type,
+                                   std::uint32_t element_size)
+    : filename(filename_), data(NULL), size(0), offset(0), mapping(NULL) {
+#ifndef _WIN32
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = ::mmap(NULL, (std::size_t)st.st_size, PROT_READ,
+                          MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        mapping = addr;
+        data = static_cast<const char*>(addr);
+        size = (std::size_t)st.st_size;
+      }
+    }
+    ::close(fd);
+  }
+#endif
+  if (mapping == NULL) {
+    std::ifstream is(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (!is) {
+      HPP_FCL_THROW_PRETTY(filename + " does not seem to be a valid file.",
+                           std::invalid_argument);
+    }
+    buffer.resize((std::size_t)is.tellg());
+    is.seekg(0);
+    is.read(buffer.data(), (std::streamsize)buffer.size());
+    data = buffer.data();
+    size = buffer.size();
+  }
+
+  try {
+    checkHeader(type, element_type, element_size);
+  } catch (...) {
+    unmap();
+    throw;
+  }
+  offset = sizeof(FlatBinaryHeader);
+}
+
+void FlatBinaryReader::checkHeader(FlatBinaryObjectType type,
+                                   std::uint32_t element_type,
+                                   std::uint32_t element_size) const {
+  FlatBinaryHeader header;
+  if (size < sizeof(header)) {
+    HPP_FCL_THROW_PRETTY(filename + " is not a flat binary file.",
+                         std::invalid_argument);
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, flat_binary_magic, sizeof(header.magic)) != 0 ||
+      header.size != size) {
+    HPP_FCL_THROW_PRETTY(filename + " is not a flat binary file.",
+                         std::invalid_argument);
+  }
+  if (header.version != flat_binary_version ||
+      header.byte_order != flat_binary_byte_order ||
+      header.scalar_size != sizeof(FCL_REAL)) {
+    HPP_FCL_THROW_PRETTY(filename +
+                             " was written by another version of the library "
+                             "or on another kind of machine.",
+                         std::invalid_argument);
+  }
+  if (header.object_type != (std::uint32_t)type ||
+      header.element_type != element_type ||
+      header.element_size != element_size) {
+    HPP_FCL_THROW_PRETTY(filename + " does not store an object of this type.",
+                         std::invalid_argument);
+  }
+}
+
+FlatBinaryReader::~FlatBinaryReader() { unmap(); }
+
+void FlatBinaryReader::unmap() {
+#ifndef _WIN32
+  if (mapping) ::munmap(mapping, size);
+#endif
+  mapping = NULL;
+}
+
+std::size_t FlatBinaryReader::nextSize() const {
+  const std::size_t record = align(offset);
+  if (record + record_alignment > size) {
+    HPP_FCL_THROW_PRETTY(filename + " is truncated.", std::invalid_argument);
+  }
+  std::uint64_t record_size;
+  std::memcpy(&record_size, data + record, sizeof(record_size));
+  return (std::size_t)record_size;
+}
+
+const void* FlatBinaryReader::read(std::size_t record_size) {
+  if (nextSize() != record_size) {
+    HPP_FCL_THROW_PRETTY(filename + " is corrupted.", std::invalid_argument);
+  }
+  const std::size_t begin = align(offset) + record_alignment;
+  if (record_size > size - begin) {
+    HPP_FCL_THROW_PRETTY(filename + " is truncated.", std::invalid_argument);
+  }
+  offset = begin + record_size;
+  return record_size > 0 ? data + begin : NULL;
+}
+
+void writeCollisionGeometry(FlatBinaryWriter& writer,
+                            const CollisionGeometry& geometry) {
+  writer.write(geometry.aabb_center);
+  writer.write(geometry.aabb_radius);
+  writer.write(geometry.aabb_local);
+  writer.write(geometry.cost_density);
+  writer.write(geometry.threshold_occupied);
+  writer.write(geometry.threshold_free);
+}
+
+void readCollisionGeometry(FlatBinaryReader& reader,
+                           CollisionGeometry& geometry) {
+  reader.read(geometry.aabb_center);
+  reader.read(geometry.aabb_radius);
+  reader.read(geometry.aabb_local);
+  reader.read(geometry.cost_density);
+  reader.read(geometry.threshold_occupied);
+  reader.read(geometry.threshold_free);
+}
+
+void writeConvexBase(FlatBinaryWriter& writer, const ConvexBase& convex_) {
+  const ConvexBaseAccessor& convex =
+      reinterpret_cast<const ConvexBaseAccessor&>(convex_);
+  writeCollisionGeometry(writer, convex);
+  writer.write(convex.getSweptSphereRadius());
+  writer.write(convex.num_points);
+  writer.write(convex.points, convex.num_points);
+  writer.write(convex.num_normals_and_offsets);
+  writer.write(convex.normals, convex.num_normals_and_offsets);
+  writer.write(convex.offsets, convex.num_normals_and_offsets);
+  writer.write(convex.center);
+
+  const std::vector<Vec3f>& ws_points = convex.support_warm_starts.points;
+  const std::vector<int>& ws_indices = convex.support_warm_starts.indices;
+  writer.write(ws_points.data(), ws_points.size() * sizeof(Vec3f));
+  writer.write(ws_indices.data(), ws_indices.size() * sizeof(int));
+
+  // The neighbors of each vertex are contiguous in nneighbors_, in the order
+  // of the vertices: only their number is needed to restore the pointers.
+  std::vector<unsigned char> counts;
+  if (convex.neighbors.get()) {
+    counts.resize(convex.neighbors->size());
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      counts[i] = (*convex.neighbors)[i].count();
+  }
+  writer.write(counts.data(), counts.size());
+  writer.write(convex.nneighbors_,
+               convex.nneighbors_.get() ? convex.nneighbors_->size() : 0);
+}
+
+void readConvexBase(FlatBinaryReader& reader, ConvexBase& convex_) {
+  ConvexBaseAccessor& convex = reinterpret_cast<ConvexBaseAccessor&>(convex_);
+  readCollisionGeometry(reader, convex);
+  FCL_REAL swept_sphere_radius;
+  reader.read(swept_sphere_radius);
+  convex.setSweptSphereRadius(swept_sphere_radius);
+  reader.read(convex.num_points);
+  reader.read(convex.points, convex.num_points);
+  reader.read(convex.num_normals_and_offsets);
+  reader.read(convex.normals, convex.num_normals_and_offsets);
+  reader.read(convex.offsets, convex.num_normals_and_offsets);
+  reader.read(convex.center);
+  convex.buildPointsSoA();
+
+  std::vector<Vec3f>& ws_points = convex.support_warm_starts.points;
+  std::vector<int>& ws_indices = convex.support_warm_starts.indices;
+  ws_points.resize(reader.nextSize() / sizeof(Vec3f));
+  const void* ws_data = reader.read(ws_points.size() * sizeof(Vec3f));
+  if (!ws_points.empty())
+    std::memcpy(static_cast<void*>(ws_points.data()), ws_data,
+                ws_points.size() * sizeof(Vec3f));
+  ws_indices.resize(reader.nextSize() / sizeof(int));
+  ws_data = reader.read(ws_indices.size() * sizeof(int));
+  if (!ws_indices.empty())
+    std::memcpy(ws_indices.data(), ws_data, ws_indices.size() * sizeof(int));
+
+  const std::size_t num_counts = reader.nextSize();
+  const unsigned char* counts =
+      static_cast<const unsigned char*>(reader.read(num_counts));
+  reader.read(convex.nneighbors_, reader.nextSize() / sizeof(unsigned int));
+  if (num_counts == 0) {
+    convex.neighbors.reset();
+    return;
+  }
+  convex.neighbors.reset(new std::vector<ConvexBase::Neighbors>(num_counts));
+  std::size_t first = 0;
+  const std::size_t num_nneighbors =
+      convex.nneighbors_.get() ? convex.nneighbors_->size() : 0;
+  for (std::size_t i = 0; i < num_counts; ++i) {
+    ConvexBase::Neighbors& n = (*convex.neighbors)[i];
+    n.count_ = counts[i];
+    if (first + n.count_ > num_nneighbors) {
+      HPP_FCL_THROW_PRETTY("The neighbors of the convex are corrupted.",
+                           std::invalid_argument);
+    }
+    n.n_ = n.count_ > 0 ? convex.nneighbors_->data() + first : NULL;
+    first += n.count_;
+  }
+}
+
+}  // namespace internal
+}  // namespace serialization
+}  // namespace fcl
+}  // namespace hpp
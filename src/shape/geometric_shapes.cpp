@@ -53,6 +53,7 @@ void ConvexBase::initialize(std::shared_ptr<std::vector<Vec3f>> points_,
   this->normals.reset();
   this->offsets.reset();
   this->computeCenter();
+  this->buildPointsSoA();
 }
 
 void ConvexBase::set(std::shared_ptr<std::vector<Vec3f>> points_,
@@ -63,6 +64,7 @@ void ConvexBase::set(std::shared_ptr<std::vector<Vec3f>> points_,
 ConvexBase::ConvexBase(const ConvexBase& other)
     : ShapeBase(other),
       num_points(other.num_points),
+      points_soa(other.points_soa),
       num_normals_and_offsets(other.num_normals_and_offsets),
       center(other.center) {
   if (other.points.get() && other.points->size() > 0) {
@@ -70,6 +72,7 @@ ConvexBase::ConvexBase(const ConvexBase& other)
     points.reset(new std::vector<Vec3f>(*other.points));
   } else
     points.reset();
+  if (other.isPointsSoAUpToDate()) points_soa_source = points;
 
   if (other.nneighbors_.get() && other.nneighbors_->size() > 0) {
     // Deep copy the list of all the neighbors of all the points
@@ -99,7 +102,7 @@ ConvexBase::ConvexBase(const ConvexBase& other)
     normals.reset();
 
   if (other.offsets.get() && other.offsets->size() > 0) {
-    offsets.reset(new std::vector<double>(*(other.offsets)));
+    offsets.reset(new std::vector<FCL_REAL>(*(other.offsets)));
   } else
     offsets.reset();
 
@@ -118,6 +121,25 @@ void ConvexBase::computeCenter() {
   center /= num_points;
 }
 
+void ConvexBase::buildPointsSoA() {
+  points_soa_source = points;
+  if (!points.get() || num_points == 0) {
+    points_soa.resize(3, 0);
+    return;
+  }
+  const std::vector<Vec3f>& points_ = *points;
+  const Eigen::Index n = static_cast<Eigen::Index>(num_points);
+  const Eigen::Index padded_n =
+      (n + points_soa_block_size - 1) / points_soa_block_size *
+      points_soa_block_size;
+  points_soa.resize(3, padded_n);
+  for (Eigen::Index i = 0; i < n; ++i)
+    points_soa.col(i) = points_[static_cast<std::size_t>(i)];
+  // Copies of the first point never change which point is the support.
+  for (Eigen::Index i = n; i < padded_n; ++i)
+    points_soa.col(i) = points_[0];
+}
+
 void Halfspace::unitNormalTest() {
   FCL_REAL l = n.norm();
   if (l > 0) {
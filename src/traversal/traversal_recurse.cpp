@@ -37,14 +37,56 @@
 
 #include <hpp/fcl/internal/traversal_recurse.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace hpp {
 namespace fcl {
+namespace {
+/// Moves the subtree of \p front at position \p second before its siblings
+/// from position \p first. The subtree holding the nearest pair found by a
+/// distance query is moved first, so that the next query visits it first and
+/// tightens the distance early.
+void moveFrontSubtreeFirst(BVHFrontList& front, std::size_t first,
+                           std::size_t second) {
+  std::rotate(front.begin() + (std::ptrdiff_t)first,
+              front.begin() + (std::ptrdiff_t)second,
+              front.begin() + (std::ptrdiff_t)(second + front[second].size));
+}
+
+/// Visits the children of the pair (b1, b2), whose BVs overlap. When the
+/// query can stop after the first child, the second one is added unvisited
+/// to the front.
+void collisionRecurseChildren(CollisionTraversalNodeBase* node,
+                              unsigned int b1, unsigned int b2,
+                              BVHFrontList* front_list,
+                              FCL_REAL& sqrDistLowerBound) {
+  FCL_REAL sqrDistLowerBound1 = 0, sqrDistLowerBound2 = 0;
+  unsigned int a1 = b1, a2 = b2, c1 = b1, c2 = b2;
+  if (node->firstOverSecond(b1, b2)) {
+    a1 = (unsigned int)node->getFirstLeftChild(b1);
+    c1 = (unsigned int)node->getFirstRightChild(b1);
+  } else {
+    a2 = (unsigned int)node->getSecondLeftChild(b2);
+    c2 = (unsigned int)node->getSecondRightChild(b2);
+  }
+
+  const std::size_t root = beginFrontSubtree(front_list, b1, b2);
+  collisionRecurse(node, a1, a2, front_list, sqrDistLowerBound1);
+  if (node->canStop()) {
+    updateFrontList(front_list, c1, c2);
+    sqrDistLowerBound = sqrDistLowerBound1;
+  } else {
+    collisionRecurse(node, c1, c2, front_list, sqrDistLowerBound2);
+    sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+  }
+  endFrontSubtree(front_list, root);
+}
+}  // namespace
+
 void collisionRecurse(CollisionTraversalNodeBase* node, unsigned int b1,
                       unsigned int b2, BVHFrontList* front_list,
                       FCL_REAL& sqrDistLowerBound) {
-  FCL_REAL sqrDistLowerBound1 = 0, sqrDistLowerBound2 = 0;
   bool l1 = node->isFirstNodeLeaf(b1);
   bool l2 = node->isSecondNodeLeaf(b2);
   if (l1 && l2) {
@@ -59,28 +101,78 @@ void collisionRecurse(CollisionTraversalNodeBase* node, unsigned int b1,
     updateFrontList(front_list, b1, b2);
     return;
   }
-  if (node->firstOverSecond(b1, b2)) {
-    unsigned int c1 = (unsigned int)node->getFirstLeftChild(b1);
-    unsigned int c2 = (unsigned int)node->getFirstRightChild(b1);
-
-    collisionRecurse(node, c1, b2, front_list, sqrDistLowerBound1);
-
-    // early stop is disabled is front_list is used
-    if (node->canStop() && !front_list) return;
+  collisionRecurseChildren(node, b1, b2, front_list, sqrDistLowerBound);
+}
 
-    collisionRecurse(node, c2, b2, front_list, sqrDistLowerBound2);
-    sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+void collisionRecurseQuantized(CollisionTraversalNodeBase* node,
+                               unsigned int b1, const AABB& box1,
+                               unsigned int b2, const AABB& box2,
+                               FCL_REAL& sqrDistLowerBound) {
+  const bool l1 = node->isFirstNodeLeaf(b1);
+  const bool l2 = node->isSecondNodeLeaf(b2);
+  if (l1 && l2) {
+    node->leafCollides(b1, b2, sqrDistLowerBound);
+    return;
+  }
+  if (node->boxesDisjoint(box1, box2, sqrDistLowerBound)) return;
+
+  // The larger box is split, as in firstOverSecond().
+  FCL_REAL sqrDistLowerBound1 = 0,
+           sqrDistLowerBound2 = std::numeric_limits<FCL_REAL>::infinity();
+  AABB left, right;
+  if (l2 || (!l1 && box1.size() > box2.size())) {
+    node->getFirstChildBoxes(b1, box1, left, right);
+    collisionRecurseQuantized(node, (unsigned int)node->getFirstLeftChild(b1),
+                              left, b2, box2, sqrDistLowerBound1);
+    if (!node->canStop())
+      collisionRecurseQuantized(
+          node, (unsigned int)node->getFirstRightChild(b1), right, b2, box2,
+          sqrDistLowerBound2);
   } else {
-    unsigned int c1 = (unsigned int)node->getSecondLeftChild(b2);
-    unsigned int c2 = (unsigned int)node->getSecondRightChild(b2);
-
-    collisionRecurse(node, b1, c1, front_list, sqrDistLowerBound1);
-
-    // early stop is disabled is front_list is used
-    if (node->canStop() && !front_list) return;
+    node->getSecondChildBoxes(b2, box2, left, right);
+    collisionRecurseQuantized(node, b1, box1,
+                              (unsigned int)node->getSecondLeftChild(b2), left,
+                              sqrDistLowerBound1);
+    if (!node->canStop())
+      collisionRecurseQuantized(node, b1, box1,
+                                (unsigned int)node->getSecondRightChild(b2),
+                                right, sqrDistLowerBound2);
+  }
+  sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+}
 
-    collisionRecurse(node, b1, c2, front_list, sqrDistLowerBound2);
-    sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
+void collisionRecurseWide(CollisionTraversalNodeBase* node, unsigned int w1,
+                          unsigned int b2, FCL_REAL& sqrDistLowerBound) {
+  // The children of w1 which do not overlap b2 are handled by this test.
+  unsigned int mask = node->BVOverlapsWide(w1, b2, sqrDistLowerBound);
+  const bool l2 = node->isSecondNodeLeaf(b2);
+
+  for (int k = 0; mask != 0; ++k, mask >>= 1) {
+    if (!(mask & 1u)) continue;
+    unsigned int b1;
+    const int c1 = node->getFirstWideChild(w1, k, b1);
+    FCL_REAL sdlb = std::numeric_limits<FCL_REAL>::infinity();
+    if (c1 < 0) {
+      // b1 is a leaf: finish with the binary trees.
+      if (l2)
+        node->leafCollides(b1, b2, sdlb);
+      else
+        collisionRecurse(node, b1, b2, NULL, sdlb);
+    } else if (node->firstOverSecond(b1, b2)) {
+      collisionRecurseWide(node, (unsigned int)c1, b2, sdlb);
+    } else {
+      // The children of b2 are directly tested against the children of c1.
+      FCL_REAL sdlb2 = std::numeric_limits<FCL_REAL>::infinity();
+      collisionRecurseWide(node, (unsigned int)c1,
+                           (unsigned int)node->getSecondLeftChild(b2), sdlb);
+      if (!node->canStop())
+        collisionRecurseWide(node, (unsigned int)c1,
+                             (unsigned int)node->getSecondRightChild(b2),
+                             sdlb2);
+      sdlb = std::min(sdlb, sdlb2);
+    }
+    sqrDistLowerBound = std::min(sqrDistLowerBound, sdlb);
+    if (node->canStop()) return;
   }
 }
 
@@ -116,7 +208,12 @@ void collisionNonRecurse(CollisionTraversalNodeBase* node,
       //}
       node->leafCollides(a, b, sdlb);
       if (sdlb < sqrDistLowerBound) sqrDistLowerBound = sdlb;
-      if (node->canStop() && !front_list) return;
+      if (node->canStop()) {
+        // The pairs left are added unvisited to the front.
+        for (std::size_t k = 0; k < pairs.size(); ++k)
+          updateFrontList(front_list, pairs[k].first, pairs[k].second);
+        return;
+      }
       continue;
     }
 
@@ -179,26 +276,89 @@ void distanceRecurse(DistanceTraversalNodeBase* node, unsigned int b1,
   FCL_REAL d1 = node->BVDistanceLowerBound(a1, a2);
   FCL_REAL d2 = node->BVDistanceLowerBound(c1, c2);
 
+  // The nearest pair is visited first.
   if (d2 < d1) {
-    if (!node->canStop(d2))
-      distanceRecurse(node, c1, c2, front_list);
-    else
-      updateFrontList(front_list, c1, c2);
-
-    if (!node->canStop(d1))
-      distanceRecurse(node, a1, a2, front_list);
-    else
-      updateFrontList(front_list, a1, a2);
-  } else {
-    if (!node->canStop(d1))
-      distanceRecurse(node, a1, a2, front_list);
-    else
-      updateFrontList(front_list, a1, a2);
-
-    if (!node->canStop(d2))
-      distanceRecurse(node, c1, c2, front_list);
-    else
-      updateFrontList(front_list, c1, c2);
+    std::swap(a1, c1);
+    std::swap(a2, c2);
+    std::swap(d1, d2);
+  }
+
+  const std::size_t root = beginFrontSubtree(front_list, b1, b2);
+  if (!node->canStop(d1))
+    distanceRecurse(node, a1, a2, front_list);
+  else
+    updateFrontList(front_list, a1, a2);
+
+  const std::size_t second = front_list ? front_list->size() : 0;
+  const FCL_REAL min_distance = node->result->min_distance;
+  if (!node->canStop(d2))
+    distanceRecurse(node, c1, c2, front_list);
+  else
+    updateFrontList(front_list, c1, c2);
+  endFrontSubtree(front_list, root);
+
+  if (front_list && node->result->min_distance < min_distance)
+    moveFrontSubtreeFirst(*front_list, root + 1, second);
+}
+
+void distanceNonRecurse(DistanceTraversalNodeBase* node,
+                        BVHFrontList* front_list) {
+  struct BVPair_t {
+    FCL_REAL d;
+    unsigned int b1, b2;
+  };
+  // The pairs to visit, sorted by decreasing distance lower bound: the pair
+  // on top has the least lower bound. Among equal lower bounds, the last
+  // pushed pair is on top, so that the traversal goes down to the leaves and
+  // tightens the distance early. When the capacity is reached, the subtrees
+  // of the pair being visited are traversed recursively.
+  const int capacity = 256;
+  BVPair_t pairs[capacity];
+  int size = 0;
+
+  pairs[size++] = BVPair_t{0, 0, 0};
+  while (size > 0) {
+    const BVPair_t pair = pairs[--size];
+    // The distance found since the pair was pushed may be enough, in which
+    // case it is also enough for all the pairs below.
+    if (node->canStop(pair.d)) {
+      updateFrontList(front_list, pair.b1, pair.b2);
+      for (int k = 0; k < size; ++k)
+        updateFrontList(front_list, pairs[k].b1, pairs[k].b2);
+      return;
+    }
+
+    const bool l1 = node->isFirstNodeLeaf(pair.b1);
+    const bool l2 = node->isSecondNodeLeaf(pair.b2);
+    if (l1 && l2) {
+      updateFrontList(front_list, pair.b1, pair.b2);
+      node->leafComputeDistance(pair.b1, pair.b2);
+      continue;
+    }
+    if (size + 2 > capacity) {
+      distanceRecurse(node, pair.b1, pair.b2, front_list);
+      continue;
+    }
+
+    unsigned int c1[2] = {pair.b1, pair.b1}, c2[2] = {pair.b2, pair.b2};
+    if (node->firstOverSecond(pair.b1, pair.b2)) {
+      c1[0] = (unsigned int)node->getFirstLeftChild(pair.b1);
+      c1[1] = (unsigned int)node->getFirstRightChild(pair.b1);
+    } else {
+      c2[0] = (unsigned int)node->getSecondLeftChild(pair.b2);
+      c2[1] = (unsigned int)node->getSecondRightChild(pair.b2);
+    }
+    for (int i = 0; i < 2; ++i) {
+      const BVPair_t child{node->BVDistanceLowerBound(c1[i], c2[i]), c1[i],
+                           c2[i]};
+      if (node->canStop(child.d)) {
+        updateFrontList(front_list, child.b1, child.b2);
+        continue;
+      }
+      int k = size++;
+      for (; k > 0 && pairs[k - 1].d < child.d; --k) pairs[k] = pairs[k - 1];
+      pairs[k] = child;
+    }
   }
 }
 
@@ -305,59 +465,122 @@ void distanceQueueRecurse(DistanceTraversalNodeBase* node, unsigned int b1,
   }
 }
 
-void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase* node,
-                                           const CollisionRequest& /*request*/,
-                                           CollisionResult& result,
-                                           BVHFrontList* front_list) {
-  FCL_REAL sqrDistLowerBound = -1, sqrDistLowerBound1 = 0,
-           sqrDistLowerBound2 = 0;
-  BVHFrontList::iterator front_iter;
-  BVHFrontList append;
-  for (front_iter = front_list->begin(); front_iter != front_list->end();
-       ++front_iter) {
-    unsigned int b1 = front_iter->left;
-    unsigned int b2 = front_iter->right;
-    bool l1 = node->isFirstNodeLeaf(b1);
-    bool l2 = node->isSecondNodeLeaf(b2);
-
-    if (l1 & l2) {
-      front_iter->valid = false;  // the front node is no longer valid, in
-                                  // collideRecurse will add again.
-      collisionRecurse(node, b1, b2, &append, sqrDistLowerBound);
+namespace {
+/// Updates the subtree of \p front at position \p i into \p next and
+/// returns the position following it. \p separated tells whether the subtree
+/// became a single node of the front whose BVs are disjoint.
+std::size_t propagateFrontCollision(CollisionTraversalNodeBase* node,
+                                    const BVHFrontList& front, std::size_t i,
+                                    BVHFrontList& next, bool& separated) {
+  const BVHFrontNode& front_node = front[i];
+  const std::size_t end = i + front_node.size;
+  separated = false;
+  if (node->canStop()) {
+    // The rest of the front is kept as is for the next query.
+    next.insert(next.end(), front.begin() + (std::ptrdiff_t)i,
+                front.begin() + (std::ptrdiff_t)end);
+    return end;
+  }
+
+  const unsigned int b1 = front_node.left, b2 = front_node.right;
+  FCL_REAL sdlb = std::numeric_limits<FCL_REAL>::infinity();
+  if (front_node.size == 1) {
+    if (node->BVDisjoints(b1, b2, sdlb)) {
+      separated = true;
+      updateFrontList(&next, b1, b2);
+    } else if (node->isFirstNodeLeaf(b1) && node->isSecondNodeLeaf(b2)) {
+      updateFrontList(&next, b1, b2);
+      node->leafCollides(b1, b2, sdlb);
     } else {
-      if (!node->BVDisjoints(b1, b2, sqrDistLowerBound)) {
-        front_iter->valid = false;
-        if (node->firstOverSecond(b1, b2)) {
-          unsigned int c1 = (unsigned int)node->getFirstLeftChild(b1);
-          unsigned int c2 = (unsigned int)node->getFirstRightChild(b1);
-
-          collisionRecurse(node, c1, b2, front_list, sqrDistLowerBound1);
-          collisionRecurse(node, c2, b2, front_list, sqrDistLowerBound2);
-          sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
-        } else {
-          unsigned int c1 = (unsigned int)node->getSecondLeftChild(b2);
-          unsigned int c2 = (unsigned int)node->getSecondRightChild(b2);
-
-          collisionRecurse(node, b1, c1, front_list, sqrDistLowerBound1);
-          collisionRecurse(node, b1, c2, front_list, sqrDistLowerBound2);
-          sqrDistLowerBound = std::min(sqrDistLowerBound1, sqrDistLowerBound2);
-        }
-      }
+      collisionRecurseChildren(node, b1, b2, &next, sdlb);
+    }
+    return end;
+  }
+
+  // The BVs of an inner node overlapped during the previous query. They are
+  // only tested again when all its children are separated, to collapse them.
+  const std::size_t root = beginFrontSubtree(&next, b1, b2);
+  bool children_separated = true;
+  for (std::size_t j = i + 1; j < end;) {
+    bool child_separated;
+    j = propagateFrontCollision(node, front, j, next, child_separated);
+    children_separated = children_separated && child_separated;
+  }
+  if (children_separated && node->BVDisjoints(b1, b2, sdlb)) {
+    next.erase(next.begin() + (std::ptrdiff_t)root, next.end());
+    updateFrontList(&next, b1, b2);
+    separated = true;
+  } else {
+    endFrontSubtree(&next, root);
+  }
+  return end;
+}
+
+/// Same as propagateFrontCollision for the distance: \p pruned tells whether
+/// the subtree became a single node of the front whose BV distance lower
+/// bound is enough to skip it.
+std::size_t propagateFrontDistance(DistanceTraversalNodeBase* node,
+                                   const BVHFrontList& front, std::size_t i,
+                                   BVHFrontList& next, bool& pruned) {
+  const BVHFrontNode& front_node = front[i];
+  const std::size_t end = i + front_node.size;
+  const unsigned int b1 = front_node.left, b2 = front_node.right;
+  pruned = false;
+  if (front_node.size == 1) {
+    if (node->canStop(node->BVDistanceLowerBound(b1, b2))) {
+      pruned = true;
+      updateFrontList(&next, b1, b2);
+    } else {
+      distanceRecurse(node, b1, b2, &next);
     }
-    result.updateDistanceLowerBound(sqrt(sqrDistLowerBound));
+    return end;
   }
 
-  // clean the old front list (remove invalid node)
-  for (front_iter = front_list->begin(); front_iter != front_list->end();) {
-    if (!front_iter->valid)
-      front_iter = front_list->erase(front_iter);
-    else
-      ++front_iter;
+  const std::size_t root = beginFrontSubtree(&next, b1, b2);
+  bool children_pruned = true;
+  std::size_t nearest = root + 1;
+  for (std::size_t j = i + 1; j < end;) {
+    const std::size_t child = next.size();
+    const FCL_REAL min_distance = node->result->min_distance;
+    bool child_pruned;
+    j = propagateFrontDistance(node, front, j, next, child_pruned);
+    children_pruned = children_pruned && child_pruned;
+    if (node->result->min_distance < min_distance) nearest = child;
   }
+  if (children_pruned && node->canStop(node->BVDistanceLowerBound(b1, b2))) {
+    next.erase(next.begin() + (std::ptrdiff_t)root, next.end());
+    updateFrontList(&next, b1, b2);
+    pruned = true;
+  } else {
+    endFrontSubtree(&next, root);
+    if (nearest > root + 1) moveFrontSubtreeFirst(next, root + 1, nearest);
+  }
+  return end;
+}
+}  // namespace
+
+void propagateBVHFrontListCollisionRecurse(CollisionTraversalNodeBase* node,
+                                           const CollisionRequest& /*request*/,
+                                           CollisionResult& /*result*/,
+                                           BVHFrontList* front_list) {
+  BVHFrontList next;
+  next.reserve(front_list->size());
+  for (std::size_t i = 0; i < front_list->size();) {
+    bool separated;
+    i = propagateFrontCollision(node, *front_list, i, next, separated);
+  }
+  front_list->swap(next);
+}
 
-  for (front_iter = append.begin(); front_iter != append.end(); ++front_iter) {
-    front_list->push_back(*front_iter);
+void propagateBVHFrontListDistanceRecurse(DistanceTraversalNodeBase* node,
+                                          BVHFrontList* front_list) {
+  BVHFrontList next;
+  next.reserve(front_list->size());
+  for (std::size_t i = 0; i < front_list->size();) {
+    bool pruned;
+    i = propagateFrontDistance(node, *front_list, i, next, pruned);
   }
+  front_list->swap(next);
 }
 
 }  // namespace fcl
@@ -0,0 +1,175 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_BATCH_QUERIES
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/internal/parallel.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+namespace {
+void makeTransforms(std::size_t n, std::vector<Transform3f>& tf1s,
+                    std::vector<Transform3f>& tf2s) {
+  FCL_REAL extents[] = {-1., -1., -1., 1., 1., 1.};
+  generateRandomTransforms(extents, tf1s, n);
+  generateRandomTransforms(extents, tf2s, n);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(batch_collide_matches_sequential) {
+  const std::size_t n = 500;
+  std::vector<Transform3f> tf1s, tf2s;
+  makeTransforms(n, tf1s, tf2s);
+
+  Capsule capsule(0.2, 0.8);
+  BVHModel<OBBRSS> box_mesh;
+  generateBVHModel(box_mesh, Box(0.6, 0.5, 0.4), Transform3f());
+
+  const CollisionGeometry* geoms[] = {&capsule, &box_mesh};
+  for (int k = 0; k < 2; ++k) {
+    ComputeCollision compute(&capsule, geoms[k]);
+    CollisionRequest request(CONTACT, 1);
+    request.security_margin = 0.05;
+
+    std::vector<CollisionResult> results;
+    std::size_t num_collisions =
+        compute.batch(tf1s, tf2s, request, results, 4);
+    BOOST_REQUIRE_EQUAL(results.size(), n);
+
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      CollisionResult result;
+      compute(tf1s[i], tf2s[i], request, result);
+      if (result.isCollision()) ++expected;
+      BOOST_CHECK_EQUAL(result.isCollision(), results[i].isCollision());
+      BOOST_CHECK_CLOSE(result.distance_lower_bound,
+                        results[i].distance_lower_bound, 1e-6);
+    }
+    BOOST_CHECK_EQUAL(expected, num_collisions);
+    BOOST_CHECK(expected > 0 && expected < n);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(batch_distance_matches_sequential) {
+  const std::size_t n = 500;
+  std::vector<Transform3f> tf1s, tf2s;
+  makeTransforms(n, tf1s, tf2s);
+
+  Box box(0.3, 0.4, 0.5);
+  Sphere sphere(0.25);
+  ComputeDistance compute(&box, &sphere);
+  DistanceRequest request;
+
+  std::vector<DistanceResult> results;
+  compute.batch(tf1s, tf2s, request, results);
+  BOOST_REQUIRE_EQUAL(results.size(), n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    DistanceResult result;
+    compute(tf1s[i], tf2s[i], request, result);
+    BOOST_CHECK_CLOSE(result.min_distance, results[i].min_distance, 1e-6);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(batch_invalid_sizes) {
+  Sphere s1(1), s2(1);
+  ComputeCollision compute(&s1, &s2);
+  std::vector<Transform3f> tf1s(3), tf2s(2);
+  std::vector<CollisionResult> results;
+  BOOST_CHECK_THROW(compute.batch(tf1s, tf2s, CollisionRequest(), results),
+                    std::invalid_argument);
+  tf1s.clear();
+  tf2s.clear();
+  BOOST_CHECK_EQUAL(compute.batch(tf1s, tf2s, CollisionRequest(), results),
+                    0);
+  BOOST_CHECK(results.empty());
+}
+
+BOOST_AUTO_TEST_CASE(functor_copy_per_thread) {
+  const std::size_t n = 500;
+  const unsigned int num_threads = 4;
+  std::vector<Transform3f> tf1s, tf2s;
+  makeTransforms(n, tf1s, tf2s);
+
+  Capsule capsule(0.2, 0.8);
+  Box box(0.6, 0.5, 0.4);
+  ComputeCollision compute_collision(&capsule, &box);
+  ComputeDistance compute_distance(&capsule, &box);
+
+  // The functors are not thread safe: every thread uses its own copy of
+  // them, and its own requests and results.
+  std::vector<ComputeCollision, Eigen::aligned_allocator<ComputeCollision>>
+      compute_collisions(num_threads, compute_collision);
+  std::vector<ComputeDistance, Eigen::aligned_allocator<ComputeDistance>>
+      compute_distances(num_threads, compute_distance);
+  std::vector<CollisionRequest> collision_requests(
+      num_threads, CollisionRequest(CONTACT, 1));
+  std::vector<DistanceRequest> distance_requests(num_threads);
+  std::vector<CollisionResult> functor_results(n), function_results(n);
+  std::vector<DistanceResult> distance_results(n);
+  internal::parallelFor(
+      n, num_threads, [&](unsigned int worker, std::size_t i) {
+        compute_collisions[worker](tf1s[i], tf2s[i],
+                                   collision_requests[worker],
+                                   functor_results[i]);
+        collide(&capsule, tf1s[i], &box, tf2s[i], collision_requests[worker],
+                function_results[i]);
+        compute_distances[worker](tf1s[i], tf2s[i], distance_requests[worker],
+                                  distance_results[i]);
+      });
+
+  const CollisionRequest collision_request(CONTACT, 1);
+  const DistanceRequest distance_request;
+  for (std::size_t i = 0; i < n; ++i) {
+    CollisionResult collision_result;
+    compute_collision(tf1s[i], tf2s[i], collision_request, collision_result);
+    BOOST_CHECK_EQUAL(collision_result.isCollision(),
+                      functor_results[i].isCollision());
+    BOOST_CHECK_EQUAL(collision_result.isCollision(),
+                      function_results[i].isCollision());
+
+    DistanceResult distance_result;
+    compute_distance(tf1s[i], tf2s[i], distance_request, distance_result);
+    BOOST_CHECK_CLOSE(distance_result.min_distance,
+                      distance_results[i].min_distance, 1e-6);
+  }
+}
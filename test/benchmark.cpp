@@ -16,6 +16,9 @@
 
 #include <boost/filesystem.hpp>
 
+#include <cstring>
+#include <fstream>
+
 #include <hpp/fcl/internal/traversal_node_setup.h>
 #include <hpp/fcl/internal/traversal_node_bvhs.h>
 #include "../src/collision_node.h"
@@ -27,15 +30,68 @@
 #define RUN_CASE(BV, tf, models, split) \
   run<BV>(tf, models, split, #BV " - " #split ":\t")
 
+/// Index of the models built with SPLIT_METHOD_SAH and optimized with
+/// BVHModel::optimizeTree.
+#define SPLIT_METHOD_SAH_OPTIMIZED (SPLIT_METHOD_SAH + 1)
+#define NB_SPLIT_CONFIGS (SPLIT_METHOD_SAH + 2)
+
 using namespace hpp::fcl;
 
 bool verbose = false;
 FCL_REAL DELTA = 0.001;
 
+/// Prefixes and (collision, distance) times of the cases, in the order they
+/// run.
+std::vector<std::string> case_names;
+std::vector<std::pair<double, double> > case_times;
+
+const char* scalarName() {
+  return sizeof(FCL_REAL) == sizeof(float) ? "float" : "double";
+}
+
+const char* getOption(int argc, char* argv[], const char* name) {
+  for (int i = 1; i + 1 < argc; ++i)
+    if (strcmp(argv[i], name) == 0) return argv[i + 1];
+  return NULL;
+}
+
+/// Writes the times of the cases, to be compared by another build.
+void saveTimes(const char* filename) {
+  std::ofstream file(filename);
+  file << scalarName() << '\n';
+  for (std::size_t i = 0; i < case_times.size(); ++i)
+    file << case_times[i].first << ' ' << case_times[i].second << '\n';
+}
+
+/// Prints the times of the cases next to the ones saved by another build,
+/// e.g. the build linked with hpp-fcl-float.
+void compareTimes(const char* filename) {
+  std::ifstream file(filename);
+  std::string other;
+  if (!(file >> other)) {
+    std::cerr << "Cannot read the times in " << filename << std::endl;
+    return;
+  }
+  std::cout << "\n\nTimes (collision, distance) in us\n"
+            << "case\t" << scalarName() << "\t" << other << "\n";
+  double total = 0, other_total = 0;
+  for (std::size_t i = 0; i < case_times.size(); ++i) {
+    std::pair<double, double> other_times;
+    if (!(file >> other_times.first >> other_times.second)) break;
+    std::cout << case_names[i] << "(" << case_times[i].first << ", "
+              << case_times[i].second << ")\t(" << other_times.first << ", "
+              << other_times.second << ")\n";
+    total += case_times[i].first + case_times[i].second;
+    other_total += other_times.first + other_times.second;
+  }
+  std::cout << "Total\t" << total << "\t" << other_total << std::endl;
+}
+
 template <typename BV>
 void makeModel(const std::vector<Vec3f>& vertices,
                const std::vector<Triangle>& triangles,
-               SplitMethodType split_method, BVHModel<BV>& model);
+               SplitMethodType split_method, BVHModel<BV>& model,
+               bool optimize = false);
 
 template <typename BV, typename TraversalNode>
 double distance(const std::vector<Transform3f>& tf, const BVHModel<BV>& m1,
@@ -47,7 +103,7 @@ double collide(const std::vector<Transform3f>& tf, const BVHModel<BV>& m1,
 
 template <typename BV>
 double run(const std::vector<Transform3f>& tf,
-           const BVHModel<BV> (&models)[2][3], int split_method,
+           const BVHModel<BV> (&models)[2][NB_SPLIT_CONFIGS], int split_method,
            const char* sm_name);
 
 template <typename BV>
@@ -71,6 +127,11 @@ struct traits<OBB> {
   // typedef MeshDistanceTraversalNodeOBB  DistanceTraversalNode;
 };
 
+template <>
+struct traits<AABB> {
+  typedef MeshCollisionTraversalNodeAABB CollisionTraversalNode;
+};
+
 template <>
 struct traits<OBBRSS> {
   typedef MeshCollisionTraversalNodeOBBRSS CollisionTraversalNode;
@@ -80,13 +141,15 @@ struct traits<OBBRSS> {
 template <typename BV>
 void makeModel(const std::vector<Vec3f>& vertices,
                const std::vector<Triangle>& triangles,
-               SplitMethodType split_method, BVHModel<BV>& model) {
+               SplitMethodType split_method, BVHModel<BV>& model,
+               bool optimize) {
   model.bv_splitter.reset(new BVSplitter<BV>(split_method));
   model.bv_splitter.reset(new BVSplitter<BV>(split_method));
 
   model.beginModel();
   model.addSubModel(vertices, triangles);
   model.endModel();
+  if (optimize) model.optimizeTree();
 }
 
 template <typename BV, typename TraversalNode>
@@ -142,7 +205,7 @@ double collide(const std::vector<Transform3f>& tf, const BVHModel<BV>& m1,
 
 template <typename BV>
 double run(const std::vector<Transform3f>& tf,
-           const BVHModel<BV> (&models)[2][3], int split_method,
+           const BVHModel<BV> (&models)[2][NB_SPLIT_CONFIGS], int split_method,
            const char* prefix) {
   double col = collide<BV, typename traits<BV>::CollisionTraversalNode>(
       tf, models[0][split_method], models[1][split_method], verbose);
@@ -150,22 +213,44 @@ double run(const std::vector<Transform3f>& tf,
       tf, models[0][split_method], models[1][split_method], verbose);
 
   std::cout << prefix << " (" << col << ", " << dist << ")\n";
+  case_names.push_back(prefix);
+  case_times.push_back(std::make_pair(col, dist));
   return col + dist;
 }
 
-template <>
-double run<OBB>(const std::vector<Transform3f>& tf,
-                const BVHModel<OBB> (&models)[2][3], int split_method,
-                const char* prefix) {
-  double col = collide<OBB, traits<OBB>::CollisionTraversalNode>(
+/// Run the collision queries only, for the BVs without distance traversal node.
+template <typename BV>
+double runCollision(const std::vector<Transform3f>& tf,
+                    const BVHModel<BV> (&models)[2][NB_SPLIT_CONFIGS],
+                    int split_method, const char* prefix) {
+  double col = collide<BV, typename traits<BV>::CollisionTraversalNode>(
       tf, models[0][split_method], models[1][split_method], verbose);
   double dist = 0;
 
   std::cout << prefix << " (\t" << col << ", \tNaN)\n";
+  case_names.push_back(prefix);
+  case_times.push_back(std::make_pair(col, dist));
   return col + dist;
 }
 
-int main(int, char*[]) {
+template <>
+double run<OBB>(const std::vector<Transform3f>& tf,
+                const BVHModel<OBB> (&models)[2][NB_SPLIT_CONFIGS],
+                int split_method, const char* prefix) {
+  return runCollision(tf, models, split_method, prefix);
+}
+
+template <>
+double run<AABB>(const std::vector<Transform3f>& tf,
+                 const BVHModel<AABB> (&models)[2][NB_SPLIT_CONFIGS],
+                 int split_method, const char* prefix) {
+  return runCollision(tf, models, split_method, prefix);
+}
+
+/// Options:
+/// --save-times FILE writes the times of the cases to FILE.
+/// --compare-times FILE prints the times next to the ones of FILE.
+int main(int argc, char* argv[]) {
   std::vector<Vec3f> p1, p2;
   std::vector<Triangle> t1, t2;
   boost::filesystem::path path(TEST_RESOURCES_DIR);
@@ -173,31 +258,49 @@ int main(int, char*[]) {
   loadOBJFile((path / "rob.obj").string().c_str(), p2, t2);
 
   // Make models
-  BVHModel<RSS> ms_rss[2][3];
+  BVHModel<RSS> ms_rss[2][NB_SPLIT_CONFIGS];
   makeModel(p1, t1, SPLIT_METHOD_MEAN, ms_rss[0][SPLIT_METHOD_MEAN]);
   makeModel(p1, t1, SPLIT_METHOD_BV_CENTER, ms_rss[0][SPLIT_METHOD_BV_CENTER]);
   makeModel(p1, t1, SPLIT_METHOD_MEDIAN, ms_rss[0][SPLIT_METHOD_MEDIAN]);
   makeModel(p2, t2, SPLIT_METHOD_MEAN, ms_rss[1][SPLIT_METHOD_MEAN]);
   makeModel(p2, t2, SPLIT_METHOD_BV_CENTER, ms_rss[1][SPLIT_METHOD_BV_CENTER]);
   makeModel(p2, t2, SPLIT_METHOD_MEDIAN, ms_rss[1][SPLIT_METHOD_MEDIAN]);
-
-  BVHModel<kIOS> ms_kios[2][3];
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_rss[0][SPLIT_METHOD_SAH]);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_rss[1][SPLIT_METHOD_SAH]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_rss[0][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_rss[1][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+
+  BVHModel<kIOS> ms_kios[2][NB_SPLIT_CONFIGS];
   makeModel(p1, t1, SPLIT_METHOD_MEAN, ms_kios[0][SPLIT_METHOD_MEAN]);
   makeModel(p1, t1, SPLIT_METHOD_BV_CENTER, ms_kios[0][SPLIT_METHOD_BV_CENTER]);
   makeModel(p1, t1, SPLIT_METHOD_MEDIAN, ms_kios[0][SPLIT_METHOD_MEDIAN]);
   makeModel(p2, t2, SPLIT_METHOD_MEAN, ms_kios[1][SPLIT_METHOD_MEAN]);
   makeModel(p2, t2, SPLIT_METHOD_BV_CENTER, ms_kios[1][SPLIT_METHOD_BV_CENTER]);
   makeModel(p2, t2, SPLIT_METHOD_MEDIAN, ms_kios[1][SPLIT_METHOD_MEDIAN]);
-
-  BVHModel<OBB> ms_obb[2][3];
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_kios[0][SPLIT_METHOD_SAH]);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_kios[1][SPLIT_METHOD_SAH]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_kios[0][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_kios[1][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+
+  BVHModel<OBB> ms_obb[2][NB_SPLIT_CONFIGS];
   makeModel(p1, t1, SPLIT_METHOD_MEAN, ms_obb[0][SPLIT_METHOD_MEAN]);
   makeModel(p1, t1, SPLIT_METHOD_BV_CENTER, ms_obb[0][SPLIT_METHOD_BV_CENTER]);
   makeModel(p1, t1, SPLIT_METHOD_MEDIAN, ms_obb[0][SPLIT_METHOD_MEDIAN]);
   makeModel(p2, t2, SPLIT_METHOD_MEAN, ms_obb[1][SPLIT_METHOD_MEAN]);
   makeModel(p2, t2, SPLIT_METHOD_BV_CENTER, ms_obb[1][SPLIT_METHOD_BV_CENTER]);
   makeModel(p2, t2, SPLIT_METHOD_MEDIAN, ms_obb[1][SPLIT_METHOD_MEDIAN]);
-
-  BVHModel<OBBRSS> ms_obbrss[2][3];
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_obb[0][SPLIT_METHOD_SAH]);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_obb[1][SPLIT_METHOD_SAH]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_obb[0][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_obb[1][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+
+  BVHModel<OBBRSS> ms_obbrss[2][NB_SPLIT_CONFIGS];
   makeModel(p1, t1, SPLIT_METHOD_MEAN, ms_obbrss[0][SPLIT_METHOD_MEAN]);
   makeModel(p1, t1, SPLIT_METHOD_BV_CENTER,
             ms_obbrss[0][SPLIT_METHOD_BV_CENTER]);
@@ -206,6 +309,26 @@ int main(int, char*[]) {
   makeModel(p2, t2, SPLIT_METHOD_BV_CENTER,
             ms_obbrss[1][SPLIT_METHOD_BV_CENTER]);
   makeModel(p2, t2, SPLIT_METHOD_MEDIAN, ms_obbrss[1][SPLIT_METHOD_MEDIAN]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_obbrss[0][SPLIT_METHOD_SAH]);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_obbrss[1][SPLIT_METHOD_SAH]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_obbrss[0][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_obbrss[1][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+
+  BVHModel<AABB> ms_aabb[2][NB_SPLIT_CONFIGS];
+  makeModel(p1, t1, SPLIT_METHOD_MEAN, ms_aabb[0][SPLIT_METHOD_MEAN]);
+  makeModel(p1, t1, SPLIT_METHOD_BV_CENTER, ms_aabb[0][SPLIT_METHOD_BV_CENTER]);
+  makeModel(p1, t1, SPLIT_METHOD_MEDIAN, ms_aabb[0][SPLIT_METHOD_MEDIAN]);
+  makeModel(p2, t2, SPLIT_METHOD_MEAN, ms_aabb[1][SPLIT_METHOD_MEAN]);
+  makeModel(p2, t2, SPLIT_METHOD_BV_CENTER, ms_aabb[1][SPLIT_METHOD_BV_CENTER]);
+  makeModel(p2, t2, SPLIT_METHOD_MEDIAN, ms_aabb[1][SPLIT_METHOD_MEDIAN]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_aabb[0][SPLIT_METHOD_SAH]);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_aabb[1][SPLIT_METHOD_SAH]);
+  makeModel(p1, t1, SPLIT_METHOD_SAH, ms_aabb[0][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
+  makeModel(p2, t2, SPLIT_METHOD_SAH, ms_aabb[1][SPLIT_METHOD_SAH_OPTIMIZED],
+            true);
 
   std::vector<Transform3f> transforms;  // t0
   FCL_REAL extents[] = {-3000, -3000, -3000, 3000, 3000, 3000};
@@ -214,21 +337,47 @@ int main(int, char*[]) {
   generateRandomTransforms(extents, transforms, n);
   double total_time = 0;
 
+  // Compare the builds linked with hpp-fcl and hpp-fcl-float.
+  std::cout << "Scalar type: " << scalarName() << ", OBBRSS model memory: "
+            << ms_obbrss[0][SPLIT_METHOD_MEAN].memUsage(false) +
+                   ms_obbrss[1][SPLIT_METHOD_MEAN].memUsage(false)
+            << " bytes\n";
+
   total_time += RUN_CASE(RSS, transforms, ms_rss, SPLIT_METHOD_MEAN);
   total_time += RUN_CASE(RSS, transforms, ms_rss, SPLIT_METHOD_BV_CENTER);
   total_time += RUN_CASE(RSS, transforms, ms_rss, SPLIT_METHOD_MEDIAN);
+  total_time += RUN_CASE(RSS, transforms, ms_rss, SPLIT_METHOD_SAH);
+  total_time += RUN_CASE(RSS, transforms, ms_rss, SPLIT_METHOD_SAH_OPTIMIZED);
 
   total_time += RUN_CASE(kIOS, transforms, ms_kios, SPLIT_METHOD_MEAN);
   total_time += RUN_CASE(kIOS, transforms, ms_kios, SPLIT_METHOD_BV_CENTER);
   total_time += RUN_CASE(kIOS, transforms, ms_kios, SPLIT_METHOD_MEDIAN);
+  total_time += RUN_CASE(kIOS, transforms, ms_kios, SPLIT_METHOD_SAH);
+  total_time += RUN_CASE(kIOS, transforms, ms_kios, SPLIT_METHOD_SAH_OPTIMIZED);
 
   total_time += RUN_CASE(OBB, transforms, ms_obb, SPLIT_METHOD_MEAN);
   total_time += RUN_CASE(OBB, transforms, ms_obb, SPLIT_METHOD_BV_CENTER);
   total_time += RUN_CASE(OBB, transforms, ms_obb, SPLIT_METHOD_MEDIAN);
+  total_time += RUN_CASE(OBB, transforms, ms_obb, SPLIT_METHOD_SAH);
+  total_time += RUN_CASE(OBB, transforms, ms_obb, SPLIT_METHOD_SAH_OPTIMIZED);
 
   total_time += RUN_CASE(OBBRSS, transforms, ms_obbrss, SPLIT_METHOD_MEAN);
   total_time += RUN_CASE(OBBRSS, transforms, ms_obbrss, SPLIT_METHOD_BV_CENTER);
   total_time += RUN_CASE(OBBRSS, transforms, ms_obbrss, SPLIT_METHOD_MEDIAN);
+  total_time += RUN_CASE(OBBRSS, transforms, ms_obbrss, SPLIT_METHOD_SAH);
+  total_time +=
+      RUN_CASE(OBBRSS, transforms, ms_obbrss, SPLIT_METHOD_SAH_OPTIMIZED);
+
+  total_time += RUN_CASE(AABB, transforms, ms_aabb, SPLIT_METHOD_MEAN);
+  total_time += RUN_CASE(AABB, transforms, ms_aabb, SPLIT_METHOD_BV_CENTER);
+  total_time += RUN_CASE(AABB, transforms, ms_aabb, SPLIT_METHOD_MEDIAN);
+  total_time += RUN_CASE(AABB, transforms, ms_aabb, SPLIT_METHOD_SAH);
+  total_time += RUN_CASE(AABB, transforms, ms_aabb, SPLIT_METHOD_SAH_OPTIMIZED);
 
   std::cout << "\n\nTotal time: " << total_time << std::endl;
+
+  if (const char* filename = getOption(argc, argv, "--save-times"))
+    saveTimes(filename);
+  if (const char* filename = getOption(argc, argv, "--compare-times"))
+    compareTimes(filename);
 }
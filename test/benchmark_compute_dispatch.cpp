@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the cost of the dispatch of the queries on cheap pairs of shapes:
+/// the time per query of `collide` and `distance`, of ComputeCollision and
+/// ComputeDistance and of ComputeCollisionT and ComputeDistanceT, on pairs of
+/// shapes and on meshes and shapes. Also compare the time of GJK on
+/// MinkowskiDiff, whose support functions are called through a function
+/// pointer, and on MinkowskiDiffT, whose support functions are inlined.
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/compute_shape_pair.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/narrowphase/gjk.h>
+#include <hpp/fcl/narrowphase/narrowphase_defaults.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Time in nanoseconds per query of \p query over the placements.
+template <typename Query>
+double timeQueries(Query query, const std::vector<Transform3f>& tf1s,
+                   const std::vector<Transform3f>& tf2s, std::size_t nb_run) {
+  Timer timer;
+  for (std::size_t r = 0; r < nb_run; ++r)
+    for (std::size_t i = 0; i < tf1s.size(); ++i) query(tf1s[i], tf2s[i]);
+  timer.stop();
+  return timer.elapsed().user * 1e3 / (double)(nb_run * tf1s.size());
+}
+
+template <typename S1, typename S2>
+void benchmark(const char* name, const S1& s1, const S2& s2,
+               std::size_t nb_run) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 1000);
+  generateRandomTransforms(extents, tf2s, 1000);
+
+  CollisionRequest collision_request;
+  CollisionResult collision_result;
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  ComputeCollision compute_collision(&s1, &s2);
+  ComputeCollisionT<S1, S2> compute_collision_t(&s1, &s2);
+  ComputeDistance compute_distance(&s1, &s2);
+  ComputeDistanceT<S1, S2> compute_distance_t(&s1, &s2);
+
+  const double collide_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        collide(&s1, tf1, &s2, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_collision_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        compute_collision(tf1, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_collision_t_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        compute_collision_t(tf1, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double distance_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        distance_result.clear();
+        distance(&s1, tf1, &s2, tf2, distance_request, distance_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_distance_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        distance_result.clear();
+        compute_distance(tf1, tf2, distance_request, distance_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_distance_t_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        distance_result.clear();
+        compute_distance_t(tf1, tf2, distance_request, distance_result);
+      },
+      tf1s, tf2s, nb_run);
+
+  std::cout << name << "\t" << collide_time << "\t" << compute_collision_time
+            << "\t" << compute_collision_t_time << "\t\t" << distance_time
+            << "\t" << compute_distance_time << "\t" << compute_distance_t_time
+            << "\n";
+}
+
+template <typename BV, typename S>
+void benchmarkMesh(const char* name, const BVHModel<BV>& mesh, const S& s,
+                   std::size_t nb_run) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 1000);
+  generateRandomTransforms(extents, tf2s, 1000);
+
+  CollisionRequest collision_request;
+  CollisionResult collision_result;
+  ComputeCollision compute_collision(&mesh, &s);
+  ComputeCollisionT<BVHModel<BV>, S> compute_collision_t(&mesh, &s);
+
+  const double collide_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        collide(&mesh, tf1, &s, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_collision_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        compute_collision(tf1, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+  const double compute_collision_t_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        collision_result.clear();
+        compute_collision_t(tf1, tf2, collision_request, collision_result);
+      },
+      tf1s, tf2s, nb_run);
+
+  std::cout << name << "\t" << collide_time << "\t" << compute_collision_time
+            << "\t" << compute_collision_t_time << "\n";
+}
+
+template <typename S1, typename S2>
+void benchmarkGJK(const char* name, const S1& s1, const S2& s2,
+                  std::size_t nb_run) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 1000);
+  generateRandomTransforms(extents, tf2s, 1000);
+
+  typedef typename details::minkowski_diff_shape<S1>::type Shape1;
+  typedef typename details::minkowski_diff_shape<S2>::type Shape2;
+  details::MinkowskiDiff md;
+  details::GJK gjk(GJK_DEFAULT_MAX_ITERATIONS, GJK_DEFAULT_TOLERANCE);
+  const Vec3f guess(1, 0, 0);
+
+  const double dynamic_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        md.set(&s1, &s2, tf1, tf2);
+        gjk.evaluate(md, guess);
+      },
+      tf1s, tf2s, nb_run);
+  const double static_time = timeQueries(
+      [&](const Transform3f& tf1, const Transform3f& tf2) {
+        md.set(&s1, &s2, tf1, tf2);
+        gjk.evaluate(details::MinkowskiDiffT<Shape1, Shape2>(md), guess);
+      },
+      tf1s, tf2s, nb_run);
+
+  std::cout << name << "\t" << dynamic_time << "\t" << static_time << "\n";
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_run = getNbRun(argc, argv, 100);
+
+  Sphere sphere(0.2);
+  Capsule capsule(0.1, 0.5);
+  Box box(0.3, 0.2, 0.4);
+  Ellipsoid ellipsoid(0.2, 0.1, 0.3);
+  Cylinder cylinder(0.1, 0.4);
+  Convex<Triangle> convex = constructPolytopeFromEllipsoid(ellipsoid);
+  TriangleP triangle(Vec3f(0, 0, 0), Vec3f(0.3, 0, 0), Vec3f(0, 0.3, 0.1));
+
+  std::cout << "Time (ns) per query\n"
+            << "\t\tcollision\t\t\tdistance\n"
+            << "pair\t\tcollide\tCompute\tComputeT\tdistance\tCompute\t"
+               "ComputeT\n";
+  benchmark("sphere-sphere", sphere, sphere, nb_run);
+  benchmark("capsule-capsule", capsule, capsule, nb_run);
+  benchmark("box-sphere", box, sphere, nb_run);
+  benchmark("capsule-box", capsule, box, nb_run);
+  benchmark("convex-box", convex, box, nb_run);
+
+  BVHModel<OBBRSS> mesh;
+  generateBVHModel(mesh, Sphere(0.5), Transform3f(), 16, 16);
+  std::cout << "\npair\t\tcollide\tCompute\tComputeT\n";
+  benchmarkMesh("mesh-box", mesh, box, nb_run);
+  benchmarkMesh("mesh-capsule", mesh, capsule, nb_run);
+
+  std::cout << "\nTime (ns) per GJK run\n"
+            << "pair\t\tMinkowskiDiff\tMinkowskiDiffT\n";
+  benchmarkGJK("capsule-box", capsule, box, nb_run);
+  benchmarkGJK("ellipsoid-cylinder", ellipsoid, cylinder, nb_run);
+  benchmarkGJK("convex-box", convex, box, nb_run);
+  benchmarkGJK("triangle-box", triangle, box, nb_run);
+  return 0;
+}
@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the support functions of convex polytopes of increasing size:
+/// the scalar linear scan, the linear scan over ConvexBase::points_soa and
+/// the hill climbing through the neighbors. The crossover between the last
+/// two sets ConvexBase::num_vertices_large_convex_threshold.
+
+#include <boost/math/constants/constants.hpp>
+
+#include <hpp/fcl/shape/convex.h>
+#include <hpp/fcl/narrowphase/support_functions.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+using hpp::fcl::details::LargeConvex;
+using hpp::fcl::details::ShapeSupportData;
+using hpp::fcl::details::SmallConvex;
+
+/// Triangulated sphere with 2 + (rings - 1) * segments vertices.
+Convex<Triangle> makeSphere(Triangle::index_type rings,
+                            Triangle::index_type segments) {
+  typedef Triangle::index_type index_type;
+  std::shared_ptr<std::vector<Vec3f> > pts(new std::vector<Vec3f>());
+  std::shared_ptr<std::vector<Triangle> > tris(new std::vector<Triangle>());
+  const FCL_REAL pi = boost::math::constants::pi<FCL_REAL>();
+  pts->push_back(Vec3f(0, 0, 1));
+  for (index_type r = 1; r < rings; ++r) {
+    const FCL_REAL theta = pi * FCL_REAL(r) / FCL_REAL(rings);
+    for (index_type s = 0; s < segments; ++s) {
+      const FCL_REAL phi = 2 * pi * FCL_REAL(s) / FCL_REAL(segments);
+      pts->push_back(Vec3f(std::sin(theta) * std::cos(phi),
+                           std::sin(theta) * std::sin(phi), std::cos(theta)));
+    }
+  }
+  pts->push_back(Vec3f(0, 0, -1));
+
+  const index_type last = pts->size() - 1;
+  for (index_type s = 0; s < segments; ++s) {
+    const index_type s1 = (s + 1) % segments;
+    tris->push_back(Triangle(0, 1 + s, 1 + s1));
+    for (index_type r = 1; r + 1 < rings; ++r) {
+      const index_type a = 1 + (r - 1) * segments, b = a + segments;
+      tris->push_back(Triangle(a + s, b + s, b + s1));
+      tris->push_back(Triangle(a + s, b + s1, a + s1));
+    }
+    const index_type a = 1 + (rings - 2) * segments;
+    tris->push_back(Triangle(a + s, last, a + s1));
+  }
+  return Convex<Triangle>(pts, (unsigned int)pts->size(), tris,
+                          (unsigned int)tris->size());
+}
+
+/// Time in nanoseconds per call of the support function of ShapeType.
+template <typename ShapeType>
+double timeSupport(const ConvexBase& convex, const std::vector<Vec3f>& dirs,
+                   std::size_t nb_run, FCL_REAL& checksum) {
+  const ShapeType* shape = reinterpret_cast<const ShapeType*>(&convex);
+  ShapeSupportData data;
+  Vec3f support;
+  int hint = 0;
+  Timer timer;
+  for (std::size_t k = 0; k < nb_run; ++k) {
+    for (std::size_t i = 0; i < dirs.size(); ++i) {
+      details::getShapeSupport<details::SupportOptions::NoSweptSphere>(
+          shape, dirs[i], support, hint, data);
+      checksum += support[0];
+    }
+  }
+  timer.stop();
+  return timer.elapsed().user * 1e3 / (double)(nb_run * dirs.size());
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_run = getNbRun(argc, argv, 100);
+
+  // Successive directions are close, as in the iterations of GJK.
+  std::vector<Vec3f> dirs(1000);
+  dirs[0] = Vec3f::Random().normalized();
+  for (std::size_t i = 1; i < dirs.size(); ++i)
+    dirs[i] = (dirs[i - 1] + 0.3 * Vec3f::Random()).normalized();
+
+  FCL_REAL checksum = 0;
+  std::cout << "vertices\tscalar linear\tSoA linear\thill climbing (ns)\n";
+  const Triangle::index_type sizes[][2] = {{3, 4},   {4, 6},   {5, 8},
+                                           {6, 10},  {8, 12},  {9, 16},
+                                           {12, 20}, {16, 24}, {20, 32},
+                                           {28, 40}};
+  for (std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+    Convex<Triangle> convex(makeSphere(sizes[k][0], sizes[k][1]));
+    const double soa = timeSupport<SmallConvex>(convex, dirs, nb_run, checksum);
+    const double log = timeSupport<LargeConvex>(convex, dirs, nb_run, checksum);
+    convex.points_soa.resize(3, 0);
+    const double scalar =
+        timeSupport<SmallConvex>(convex, dirs, nb_run, checksum);
+    std::cout << convex.num_points << "\t\t" << scalar << "\t\t" << soa
+              << "\t\t" << log << "\n";
+  }
+  std::cout << "(checksum " << checksum << ")" << std::endl;
+  return 0;
+}
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the gradients of the distance given by
+/// DistanceRequest::enable_derivatives to forward finite differences, in a
+/// gradient descent which brings the second object to a target distance from
+/// the first one: time per iteration and final error.
+
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Pose tf * exp(v), to the first order.
+Transform3f integrate(const Transform3f& tf, const Vec6f& v) {
+  const FCL_REAL angle = v.tail<3>().norm();
+  Matrix3f R(Matrix3f::Identity());
+  if (angle > 0)
+    R = Eigen::AngleAxis<FCL_REAL>(angle, v.tail<3>() / angle)
+            .toRotationMatrix();
+  return tf * Transform3f(R, v.head<3>());
+}
+
+/// Gradient of the distance with respect to the pose of o2, by forward
+/// differences.
+Vec6f finiteDifferences(const CollisionGeometry* o1, const Transform3f& tf1,
+                        const CollisionGeometry* o2, const Transform3f& tf2,
+                        FCL_REAL d, const DistanceRequest& request) {
+  const FCL_REAL h = 1e-6;
+  Vec6f gradient;
+  for (int k = 0; k < 6; ++k) {
+    DistanceResult result;
+    gradient[k] = (distance(o1, tf1, o2, integrate(tf2, h * Vec6f::Unit(k)),
+                            request, result) -
+                   d) /
+                  h;
+  }
+  return gradient;
+}
+
+/// Runs the gradient descent from each initial pose of o2. Returns the time
+/// per iteration in microseconds and the mean final error.
+template <bool Analytic>
+std::pair<double, FCL_REAL> descend(const CollisionGeometry* o1,
+                                    const CollisionGeometry* o2,
+                                    const std::vector<Transform3f>& tf2s,
+                                    std::size_t nb_iterations) {
+  const Transform3f tf1;
+  const FCL_REAL target = 0.05, step = 0.2;
+  DistanceRequest request;
+  request.enable_derivatives = Analytic;
+  FCL_REAL error = 0;
+  Timer timer;
+  for (std::size_t i = 0; i < tf2s.size(); ++i) {
+    Transform3f tf2 = tf2s[i];
+    FCL_REAL d = 0;
+    for (std::size_t it = 0; it < nb_iterations; ++it) {
+      DistanceResult result;
+      d = distance(o1, tf1, o2, tf2, request, result);
+      Vec6f gradient;
+      if (Analytic)
+        gradient = result.dmin_distance_dtf.tail<6>().transpose();
+      else
+        gradient = finiteDifferences(o1, tf1, o2, tf2, d, request);
+      tf2 = integrate(tf2, -step * (d - target) * gradient);
+    }
+    error += std::abs(d - target);
+  }
+  timer.stop();
+  return std::make_pair(
+      timer.elapsed().user / double(tf2s.size() * nb_iterations),
+      error / FCL_REAL(tf2s.size()));
+}
+
+void benchmark(const char* name, const CollisionGeometry* o1,
+               const CollisionGeometry* o2, std::size_t nb_run) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf2s;
+  generateRandomTransforms(extents, tf2s, nb_run);
+  const std::size_t nb_iterations = 100;
+
+  const std::pair<double, FCL_REAL> analytic =
+      descend<true>(o1, o2, tf2s, nb_iterations);
+  const std::pair<double, FCL_REAL> finite =
+      descend<false>(o1, o2, tf2s, nb_iterations);
+  std::cout << name << "\t" << analytic.first << "\t\t" << finite.first
+            << "\t\t" << finite.first / analytic.first << "\t"
+            << analytic.second << "\t" << finite.second << "\n";
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_run = getNbRun(argc, argv, 100);
+
+  Box box(0.4, 0.6, 0.8), box2(0.3, 0.5, 0.2);
+  Capsule capsule(0.1, 0.6);
+  Sphere sphere(0.25);
+  BVHModel<OBBRSS> sphere_mesh;
+  generateBVHModel(sphere_mesh, sphere, Transform3f(), 20, 20);
+
+  std::cout << "Time (us) per iteration and mean final error |d - target|\n"
+            << "pair\t\tanalytic\tfinite diff.\tspeedup\terror\t"
+               "error f.d.\n";
+  benchmark("box-box\t", &box, &box2, nb_run);
+  benchmark("box-capsule", &box, &capsule, nb_run);
+  benchmark("capsule-sphere", &capsule, &sphere, nb_run);
+  benchmark("mesh-box", &sphere_mesh, &box2, nb_run);
+  return 0;
+}
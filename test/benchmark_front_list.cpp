@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the queries of ComputeCollision and ComputeDistance between two
+/// meshes along smooth trajectories, when restarted from the front of the
+/// previous query (QueryRequest::enable_front_list) and when traversing the
+/// BVHs from their roots.
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+#include "fcl_resources/config.h"
+#include <boost/filesystem.hpp>
+
+using namespace hpp::fcl;
+
+/// Time per query in microseconds.
+template <typename Compute, typename Request, typename Result>
+double run(const Compute& compute, const std::vector<Transform3f>& tf2s,
+           const Request& request) {
+  const Transform3f tf1;
+  Timer timer;
+  for (std::size_t i = 0; i < tf2s.size(); ++i) {
+    Result result;
+    compute(tf1, tf2s[i], request, result);
+  }
+  timer.stop();
+  return timer.elapsed().user / double(tf2s.size());
+}
+
+template <typename Compute, typename Request, typename Result>
+void compare(const char* name, const CollisionGeometry* o1,
+             const CollisionGeometry* o2, const std::vector<Transform3f>& tf2s,
+             Request request) {
+  request.enable_front_list = false;
+  const double fresh = run<Compute, Request, Result>(Compute(o1, o2), tf2s,
+                                                     request);
+  request.enable_front_list = true;
+  const double front = run<Compute, Request, Result>(Compute(o1, o2), tf2s,
+                                                     request);
+  std::cout << name << "\t" << fresh << "\t" << front << "\t" << fresh / front
+            << "\n";
+}
+
+template <typename BV>
+void benchmark(const char* bv, const std::vector<Vec3f>& p1,
+               const std::vector<Triangle>& t1, const std::vector<Vec3f>& p2,
+               const std::vector<Triangle>& t2,
+               const std::vector<Transform3f>& tf2s) {
+  BVHModel<BV> m1, m2;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  std::cout << bv << "\n";
+  compare<ComputeCollision, CollisionRequest, CollisionResult>(
+      "  first contact", &m1, &m2, tf2s, CollisionRequest());
+  compare<ComputeCollision, CollisionRequest, CollisionResult>(
+      "  all contacts", &m1, &m2, tf2s,
+      CollisionRequest(CONTACT, (std::numeric_limits<int>::max)()));
+  compare<ComputeDistance, DistanceRequest, DistanceResult>(
+      "  distance\t", &m1, &m2, tf2s, DistanceRequest());
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_waypoints = getNbRun(argc, argv, 20);
+
+  std::vector<Vec3f> p1, p2;
+  std::vector<Triangle> t1, t2;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), p1, t1);
+  loadOBJFile((path / "rob.obj").string().c_str(), p2, t2);
+
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  const std::size_t nb_steps[] = {1000, 100, 10};
+  for (std::size_t k = 0; k < 3; ++k) {
+    std::vector<Transform3f> tf2s;
+    generateRandomTrajectory(extents, nb_waypoints, nb_steps[k], tf2s);
+    std::cout << "Time (us) per query, " << nb_steps[k]
+              << " steps between the waypoints\n"
+              << "query\t\tfresh\tfront\tspeedup\n";
+    benchmark<OBBRSS>("OBBRSS", p1, t1, p2, t2, tf2s);
+    benchmark<RSS>("RSS", p1, t1, p2, t2, tf2s);
+    benchmark<AABB>("AABB", p1, t1, p2, t2, tf2s);
+  }
+  return 0;
+}
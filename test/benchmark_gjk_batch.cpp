@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the distance of 1000 random pairs of capsules and of boxes
+/// computed one by one by GJKSolver::shapeDistance and by batches of
+/// GJK_BATCH_SIZE pairs by GJKBatchSolver.
+
+#include <hpp/fcl/narrowphase/gjk_batch.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+template <typename S>
+void benchmark(const char* name, const std::vector<S>& shapes,
+               std::size_t nb_run) {
+  // Link approximations of a robot, spread as in a self-collision check.
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  const std::size_t num_pairs = 1000;
+  std::vector<ShapePair<S, S> > pairs(num_pairs);
+  for (std::size_t i = 0; i < num_pairs; ++i) {
+    pairs[i].s1 = &shapes[i % shapes.size()];
+    pairs[i].s2 = &shapes[(7 * i + 3) % shapes.size()];
+    generateRandomTransform(extents, pairs[i].tf1);
+    generateRandomTransform(extents, pairs[i].tf2);
+  }
+
+  GJKSolver solver;
+  std::vector<ShapeDistanceResult> scalar(num_pairs);
+  Timer timer;
+  for (std::size_t r = 0; r < nb_run; ++r)
+    for (std::size_t i = 0; i < num_pairs; ++i)
+      scalar[i].distance = solver.shapeDistance(
+          *pairs[i].s1, pairs[i].tf1, *pairs[i].s2, pairs[i].tf2, true,
+          scalar[i].p1, scalar[i].p2, scalar[i].normal);
+  timer.stop();
+  const double scalar_time = timer.elapsed().user / (double)nb_run;
+
+  GJKBatchSolver<S, S> batch;
+  std::vector<ShapeDistanceResult> results(num_pairs);
+  timer.start();
+  for (std::size_t r = 0; r < nb_run; ++r)
+    batch.shapeDistance(pairs, true, results);
+  timer.stop();
+  const double batch_time = timer.elapsed().user / (double)nb_run;
+
+  FCL_REAL max_error = 0;
+  for (std::size_t i = 0; i < num_pairs; ++i)
+    max_error = (std::max)(max_error,
+                           std::abs(results[i].distance - scalar[i].distance));
+
+  std::cout << name << "\t" << scalar_time << "\t\t" << batch_time << "\t\t"
+            << batch.num_fallbacks << "\t\t" << max_error << "\n";
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_run = getNbRun(argc, argv, 100);
+
+  std::vector<Capsule> capsules;
+  std::vector<Box> boxes;
+  for (int i = 0; i < 10; ++i) {
+    const FCL_REAL size = 0.05 + 0.01 * FCL_REAL(i);
+    capsules.push_back(Capsule(size, 4 * size));
+    boxes.push_back(Box(size, 2 * size, 3 * size));
+  }
+
+  std::cout << "Time (us) for " << 1000 << " pairs, batches of "
+            << GJK_BATCH_SIZE << " pairs\n"
+            << "pairs\t\tscalar\t\tbatch\t\tfallbacks\tmax error\n";
+  benchmark("capsule-capsule", capsules, nb_run);
+  benchmark("box-box\t", boxes, nb_run);
+  return 0;
+}
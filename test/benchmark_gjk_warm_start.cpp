@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the warm starts of GJK along trajectories with small steps, as
+/// when checking a path: the number of GJK iterations and the time per query
+/// of ComputeDistance and ComputeCollision with the default guess, the
+/// previous ray (CachedGuess) and the previous simplex (CachedSimplex).
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Gives access to the number of iterations of the last GJK run.
+template <typename Compute>
+struct CountIterations : Compute {
+  CountIterations(const CollisionGeometry* o1, const CollisionGeometry* o2)
+      : Compute(o1, o2) {}
+  std::size_t iterations() const { return this->solver.gjk.getNumIterations(); }
+};
+
+/// Runs the queries of \p compute along the trajectory and prints the mean
+/// number of GJK iterations and the time per query in microseconds.
+template <typename Compute, typename Request, typename Result>
+void run(const CollisionGeometry* o1, const CollisionGeometry* o2,
+         const Transform3f& tf1, const std::vector<Transform3f>& tf2s,
+         Request& request, std::size_t nb_run) {
+  const GJKInitialGuess guesses[] = {GJKInitialGuess::DefaultGuess,
+                                     GJKInitialGuess::CachedGuess,
+                                     GJKInitialGuess::CachedSimplex};
+  for (std::size_t k = 0; k < 3; ++k) {
+    request.gjk_initial_guess = guesses[k];
+    CountIterations<Compute> compute(o1, o2);
+    Result result;
+    std::size_t iterations = 0;
+    Timer timer;
+    for (std::size_t r = 0; r < nb_run; ++r) {
+      for (std::size_t i = 0; i < tf2s.size(); ++i) {
+        result.clear();
+        compute(tf1, tf2s[i], request, result);
+        iterations += compute.iterations();
+      }
+    }
+    timer.stop();
+    const double num_queries = (double)(nb_run * tf2s.size());
+    std::cout << "\t" << (double)iterations / num_queries << "\t"
+              << timer.elapsed().user / num_queries;
+  }
+  std::cout << "\n";
+}
+
+void benchmark(const char* name, const CollisionGeometry* o1,
+               const CollisionGeometry* o2, std::size_t nb_run) {
+  // The second geometry crosses the first one in 2000 steps of 3mm and 1mrad.
+  const Transform3f tf1(Quatf(0.9, 0.1, -0.3, 0.2).normalized(),
+                        Vec3f(0.1, -0.2, 0.));
+  const std::size_t num_steps = 2000;
+  std::vector<Transform3f> tf2s(num_steps);
+  for (std::size_t i = 0; i < num_steps; ++i) {
+    const FCL_REAL t = FCL_REAL(i) / FCL_REAL(num_steps);
+    tf2s[i] = Transform3f(
+        Eigen::AngleAxis<FCL_REAL>(2 * t, Vec3f(1, 2, 3).normalized())
+            .toRotationMatrix(),
+        Vec3f(3 - 6 * t, 0.3, 0.1));
+  }
+
+  std::cout << name << " distance ";
+  DistanceRequest distance_request;
+  run<ComputeDistance, DistanceRequest, DistanceResult>(
+      o1, o2, tf1, tf2s, distance_request, nb_run);
+  std::cout << name << " collision";
+  CollisionRequest collision_request(CONTACT, 1);
+  run<ComputeCollision, CollisionRequest, CollisionResult>(
+      o1, o2, tf1, tf2s, collision_request, nb_run);
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_run = getNbRun(argc, argv, 10);
+
+  Ellipsoid ellipsoid(0.5, 0.8, 0.3);
+  Capsule capsule(0.2, 1.);
+  Box box(1., 0.6, 0.4);
+  Cylinder cylinder(0.3, 0.8);
+  Cone cone(0.4, 1.);
+
+  std::cout << "Mean GJK iterations and time per query (us) with the\n"
+               "\t\t\tdefault guess\t\tcached guess\t\tcached simplex\n";
+  benchmark("ellipsoid-capsule", &ellipsoid, &capsule, nb_run);
+  benchmark("box-cylinder     ", &box, &cylinder, nb_run);
+  benchmark("cone-ellipsoid   ", &cone, &ellipsoid, nb_run);
+  benchmark("box-box          ", &box, &box, nb_run);
+  return 0;
+}
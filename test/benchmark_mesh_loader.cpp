@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the time needed to load meshes with CachedMeshLoader when the
+/// cache directory is empty (cold) and when it already stores the models
+/// (warm), as when a process is restarted.
+
+#include <boost/filesystem.hpp>
+
+#include <hpp/fcl/mesh_loader/loader.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+#include "fcl_resources/config.h"
+
+using namespace hpp::fcl;
+
+template <typename Loader>
+double loadAll(Loader& loader, const std::vector<std::string>& files) {
+  Timer timer;
+  for (std::size_t i = 0; i < files.size(); ++i)
+    loader.load(files[i], Vec3f::Ones());
+  timer.stop();
+  return timer.elapsed().user * 1e-3;
+}
+
+int main(int argc, char* argv[]) {
+  namespace fs = boost::filesystem;
+  const std::size_t nb_run = getNbRun(argc, argv, 10);
+
+  fs::path path(TEST_RESOURCES_DIR);
+  std::vector<std::string> files;
+  files.push_back((path / "env.obj").string());
+  files.push_back((path / "rob.obj").string());
+  files.push_back((path / "staircases_koroibot_hr.dae").string());
+
+  const fs::path cache_dir = fs::temp_directory_path() / fs::unique_path();
+  const NODE_TYPE bv_types[] = {BV_OBBRSS, BV_OBB, BV_AABB};
+  const char* bv_names[] = {"OBBRSS", "OBB", "AABB"};
+
+  for (std::size_t k = 0; k < 3; ++k) {
+    double no_cache = 0, cold = 0, warm = 0;
+    for (std::size_t i = 0; i < nb_run; ++i) {
+      MeshLoader loader(bv_types[k]);
+      no_cache += loadAll(loader, files);
+
+      fs::remove_all(cache_dir);
+      CachedMeshLoader cold_loader(bv_types[k], cache_dir.string());
+      cold += loadAll(cold_loader, files);
+
+      // A new loader has an empty memory cache, as after a restart.
+      CachedMeshLoader warm_loader(bv_types[k], cache_dir.string());
+      warm += loadAll(warm_loader, files);
+    }
+    std::cout << bv_names[k] << " (ms per load of the " << files.size()
+              << " meshes):\n"
+              << "  MeshLoader:              " << no_cache / (double)nb_run
+              << "\n  CachedMeshLoader (cold): " << cold / (double)nb_run
+              << "\n  CachedMeshLoader (warm): " << warm / (double)nb_run
+              << std::endl;
+  }
+
+  fs::remove_all(cache_dir);
+  return 0;
+}
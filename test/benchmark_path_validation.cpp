@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compare the validation of the path segments of a 6 joint arm among
+/// obstacles by conservative advancement, with the collide overload on
+/// MotionBase, and by sampling the segments at a fixed step, as motion
+/// planners do: number of queries, time per segment and number of segments
+/// validated.
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/narrowphase/continuous_collision.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+typedef Eigen::Matrix<FCL_REAL, 6, 1> Configuration;
+
+/// Serial arm of 6 revolute joints and capsule links of length L.
+struct Arm {
+  Arm() : L(0.3), link(0.05, 0.3) {
+    link.computeLocalAABB();
+    axes[0] = axes[3] = axes[5] = Vec3f::UnitZ();
+    axes[1] = axes[2] = axes[4] = Vec3f::UnitY();
+  }
+
+  /// Pose of the capsule of the link \p i for the configuration \p q.
+  Transform3f linkPose(const Configuration& q, int i) const {
+    Transform3f joint;
+    for (int j = 0; j <= i; ++j) {
+      if (j > 0) joint = joint * Transform3f(Vec3f(0, 0, L));
+      joint = joint *
+              Transform3f(Matrix3f(Eigen::AngleAxis<FCL_REAL>(q[j], axes[j])),
+                          Vec3f::Zero());
+    }
+    return joint * Transform3f(Vec3f(0, 0, L / 2));
+  }
+
+  FCL_REAL L;
+  Capsule link;
+  Vec3f axes[6];
+};
+
+/// Motion of a link along the straight segment between two configurations.
+struct LinkMotion : MotionBase {
+  LinkMotion(const Arm& arm_, int i_, const Configuration& q_beg_,
+             const Configuration& q_end_)
+      : arm(arm_), i(i_), q_beg(q_beg_), q_end(q_end_) {}
+
+  Transform3f getTransform(FCL_REAL t) const {
+    return arm.linkPose(q_beg + t * (q_end - q_beg), i);
+  }
+
+  /// The joint j moves the points of the link at most by the variation of
+  /// q[j] times their distance to the axis of j, which is at most the length
+  /// of the chain from j to the frame of the link plus \p radius.
+  FCL_REAL getMotionBound(FCL_REAL radius) const {
+    FCL_REAL bound = 0;
+    for (int j = 0; j <= i; ++j)
+      bound += std::abs(q_end[j] - q_beg[j]) *
+               (FCL_REAL(i - j) * arm.L + arm.L / 2 + radius);
+    return bound;
+  }
+
+  const Arm& arm;
+  int i;
+  Configuration q_beg, q_end;
+};
+
+struct Obstacle {
+  shared_ptr<ShapeBase> shape;
+  Transform3f tf;
+};
+
+FCL_REAL randomReal(FCL_REAL min, FCL_REAL max) {
+  return min + (max - min) * FCL_REAL(rand()) / FCL_REAL(RAND_MAX);
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_segments = getNbRun(argc, argv, 1000);
+  // Step of the fixed step sampling along each joint, in radian.
+  const FCL_REAL resolution = 0.02;
+  // Maximum variation of each joint along a segment, in radian.
+  const FCL_REAL max_step = 0.5;
+
+  Arm arm;
+  std::vector<Obstacle> obstacles;
+  FCL_REAL extents[] = {-1.5, -1.5, -1.5, 1.5, 1.5, 1.5};
+  while (obstacles.size() < 30) {
+    Obstacle obstacle;
+    generateRandomTransform(extents, obstacle.tf);
+    // Keep the base of the arm free.
+    if (obstacle.tf.getTranslation().norm() < 0.5) continue;
+    if (obstacles.size() % 2)
+      obstacle.shape.reset(new Box(makeRandomBox(0.1, 0.3)));
+    else
+      obstacle.shape.reset(new Sphere(makeRandomSphere(0.05, 0.15)));
+    obstacle.shape->computeLocalAABB();
+    obstacles.push_back(obstacle);
+  }
+
+  std::vector<Configuration> q_begs, q_ends;
+  for (std::size_t s = 0; s < nb_segments; ++s) {
+    Configuration q_beg, q_end;
+    for (int j = 0; j < 6; ++j) {
+      q_beg[j] = randomReal(-M_PI, M_PI);
+      q_end[j] = q_beg[j] + randomReal(-max_step, max_step);
+    }
+    q_begs.push_back(q_beg);
+    q_ends.push_back(q_end);
+  }
+
+  // Fixed step sampling.
+  std::vector<bool> sampling_valid(nb_segments, true);
+  std::size_t sampling_queries = 0;
+  CollisionRequest collision_request;
+  Timer timer;
+  for (std::size_t s = 0; s < nb_segments; ++s) {
+    const std::size_t nb_steps = std::size_t(std::ceil(
+        (q_ends[s] - q_begs[s]).cwiseAbs().maxCoeff() / resolution));
+    for (std::size_t k = 0; k <= nb_steps && sampling_valid[s]; ++k) {
+      const Configuration q = q_begs[s] + FCL_REAL(k) / FCL_REAL(nb_steps) *
+                                              (q_ends[s] - q_begs[s]);
+      for (int i = 0; i < 6 && sampling_valid[s]; ++i) {
+        const Transform3f tf = arm.linkPose(q, i);
+        for (std::size_t o = 0; o < obstacles.size(); ++o) {
+          CollisionResult collision_result;
+          ++sampling_queries;
+          if (collide(&arm.link, tf, obstacles[o].shape.get(), obstacles[o].tf,
+                      collision_request, collision_result)) {
+            sampling_valid[s] = false;
+            break;
+          }
+        }
+      }
+    }
+  }
+  timer.stop();
+  const double sampling_time = timer.elapsed().user;
+
+  // Conservative advancement.
+  std::vector<bool> continuous_valid(nb_segments, true);
+  std::size_t continuous_queries = 0;
+  ContinuousCollisionRequest request;
+  timer.start();
+  for (std::size_t s = 0; s < nb_segments; ++s) {
+    for (int i = 0; i < 6 && continuous_valid[s]; ++i) {
+      const LinkMotion motion(arm, i, q_begs[s], q_ends[s]);
+      for (std::size_t o = 0; o < obstacles.size(); ++o) {
+        ContinuousCollisionResult result;
+        collide(&arm.link, motion, obstacles[o].shape.get(),
+                InterpMotion(obstacles[o].tf), request, result);
+        continuous_queries += result.num_queries;
+        if (result.is_collide) {
+          continuous_valid[s] = false;
+          break;
+        }
+      }
+    }
+  }
+  timer.stop();
+  const double continuous_time = timer.elapsed().user;
+
+  // The segments validated by the sampling and not by the conservative
+  // advancement go through obstacles between two samples.
+  std::size_t nb_sampling_valid = 0, nb_continuous_valid = 0;
+  for (std::size_t s = 0; s < nb_segments; ++s) {
+    if (sampling_valid[s]) ++nb_sampling_valid;
+    if (continuous_valid[s]) ++nb_continuous_valid;
+  }
+  const double n = (double)nb_segments;
+  std::cout << nb_segments << " segments\n"
+            << "method\t\tqueries/segment\ttime/segment (us)\tvalid\n"
+            << "sampling\t" << (double)sampling_queries / n << "\t\t"
+            << sampling_time / n << "\t\t\t" << nb_sampling_valid << "\n"
+            << "continuous\t" << (double)continuous_queries / n << "\t\t"
+            << continuous_time / n << "\t\t\t" << nb_continuous_valid
+            << "\n";
+  return 0;
+}
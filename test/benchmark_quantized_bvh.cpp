@@ -0,0 +1,67 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Memory of the env.obj and rob.obj models and time of the collision
+/// queries between them, with uncompressed hierarchies and with hierarchies
+/// compressed by BVHModel::compressBVH() on 16 and 8 bits.
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_queries = getNbRun(argc, argv, 1000);
+
+  BVHModel<OBBRSS> env, rob;
+  loadOBJModel("env.obj", env);
+  loadOBJModel("rob.obj", rob);
+  BVHModel<OBBRSS> env16(env), rob16(rob), env8(env), rob8(rob);
+  env16.compressBVH(16);
+  rob16.compressBVH(16);
+  env8.compressBVH(8);
+  rob8.compressBVH(8);
+  const BVHModel<OBBRSS>* envs[] = {&env, &env16, &env8};
+  const BVHModel<OBBRSS>* robs[] = {&rob, &rob16, &rob8};
+  const char* names[] = {"uncompressed", "16 bits", "8 bits"};
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTransforms(extents, transforms, nb_queries);
+
+  CollisionRequest request(CONTACT, 1);
+  std::cout << "env.obj (" << env.num_tris << " triangles) / rob.obj ("
+            << rob.num_tris << " triangles), " << nb_queries << " queries\n"
+            << "hierarchy\tenv (B)\trob (B)\tus/query\tcollisions\n";
+  for (int m = 0; m < 3; ++m) {
+    std::size_t num_collisions = 0;
+    Timer timer;
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+      CollisionResult result;
+      collide(envs[m], Transform3f(), robs[m], transforms[i], request, result);
+      if (result.isCollision()) ++num_collisions;
+    }
+    timer.stop();
+    std::cout << names[m] << "\t" << envs[m]->memUsage(false) << "\t"
+              << robs[m]->memUsage(false) << "\t"
+              << timer.elapsed().user / double(nb_queries) << "\t"
+              << num_collisions << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Per frame update cost of a deforming grid of about 200k triangles: full
+/// refits with endUpdateModel(), serial and parallel, and partial refits with
+/// updateVertices() when only a disk of the grid moves.
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+static const std::size_t grid_size = 317;
+
+/// Height of the vertex p of the grid at the given frame.
+FCL_REAL wave(const Vec3f& p, std::size_t frame) {
+  return std::sin(p[0] / 20 + FCL_REAL(frame) / 10) * std::cos(p[1] / 20);
+}
+
+/// Time (us) per frame of a full update of all the vertices.
+template <typename BV>
+double fullUpdate(BVHModel<BV> model, const std::vector<Vec3f>& points,
+                  std::size_t nb_frames, bool bottomup,
+                  unsigned int num_threads) {
+  std::vector<Vec3f> ps(points);
+  Timer timer;
+  for (std::size_t frame = 0; frame < nb_frames; ++frame) {
+    for (std::size_t i = 0; i < ps.size(); ++i)
+      ps[i][2] = wave(points[i], frame);
+    model.beginUpdateModel();
+    model.updateSubModel(ps);
+    model.endUpdateModel(true, bottomup, num_threads);
+  }
+  timer.stop();
+  return timer.elapsed().user / double(nb_frames);
+}
+
+/// Time (us) per frame of a partial update of the vertices of a disk of
+/// radius r.
+template <typename BV>
+double partialUpdate(BVHModel<BV> model, const std::vector<Vec3f>& points,
+                     std::size_t nb_frames, FCL_REAL r,
+                     std::size_t& num_moved) {
+  const Vec3f center(FCL_REAL(grid_size) / 2, FCL_REAL(grid_size) / 2, 0);
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    if ((points[i] - center).norm() < r) indices.push_back(i);
+  num_moved = indices.size();
+
+  std::vector<Vec3f> ps(indices.size());
+  Timer timer;
+  for (std::size_t frame = 0; frame < nb_frames; ++frame) {
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+      ps[k] = points[indices[k]];
+      ps[k][2] = wave(ps[k], frame);
+    }
+    model.updateVertices(indices, ps);
+  }
+  timer.stop();
+  return timer.elapsed().user / double(nb_frames);
+}
+
+template <typename BV>
+void benchmark(const char* bv, const std::vector<Vec3f>& points,
+               const std::vector<Triangle>& triangles,
+               std::size_t nb_frames) {
+  BVHModel<BV> model;
+  model.beginModel();
+  model.addSubModel(points, triangles);
+  model.endModel();
+
+  std::cout << bv << "\n";
+  const double serial = fullUpdate(model, points, nb_frames, true, 1);
+  std::cout << "  full bottom-up refit, 1 thread\t" << serial << "\n";
+  const double parallel = fullUpdate(model, points, nb_frames, true, 0);
+  std::cout << "  full bottom-up refit, all threads\t" << parallel << "\t"
+            << serial / parallel << "\n";
+  const double topdown = fullUpdate(model, points, 1, false, 1);
+  std::cout << "  full top-down refit, 1 thread\t\t" << topdown << "\n";
+  const double topdown_parallel = fullUpdate(model, points, 1, false, 0);
+  std::cout << "  full top-down refit, all threads\t" << topdown_parallel
+            << "\t" << topdown / topdown_parallel << "\n";
+
+  const FCL_REAL radii[] = {50, 16, 5};
+  for (std::size_t k = 0; k < 3; ++k) {
+    std::size_t num_moved;
+    const double partial =
+        partialUpdate(model, points, nb_frames, radii[k], num_moved);
+    std::cout << "  partial refit, " << num_moved << " vertices\t" << partial
+              << "\t" << serial / partial << "\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_frames = getNbRun(argc, argv, 20);
+
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  generateGridMesh(grid_size, grid_size, points, triangles);
+  std::cout << triangles.size() << " triangles, " << points.size()
+            << " vertices\n"
+            << "Time (us) per frame\tspeedup vs 1 thread full refit\n";
+  benchmark<OBBRSS>("OBBRSS", points, triangles, nb_frames);
+  benchmark<AABB>("AABB", points, triangles, nb_frames);
+  return 0;
+}
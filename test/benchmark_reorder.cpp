@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Throughput of the leaf tests of the collision queries between two meshes
+/// of about 200k triangles, whose triangles and vertices are stored in a
+/// random order, before and after BVHModel::reorderPrimitives(). The meshes
+/// are two bumpy grids crossing each other along a curve.
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/internal/traversal_node_bvhs.h>
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/timings.h>
+#include <../src/collision_node.h>
+
+#include "utility.h"
+
+#include <random>
+
+using namespace hpp::fcl;
+
+static const std::size_t grid_size = 317;
+
+/// Bumpy grid whose triangles and vertices are shuffled.
+void generateShuffledMesh(std::vector<Vec3f>& points,
+                          std::vector<Triangle>& triangles) {
+  generateGridMesh(grid_size, grid_size, points, triangles);
+  for (std::size_t i = 0; i < points.size(); ++i)
+    points[i][2] =
+        5 * std::sin(points[i][0] / 20) * std::cos(points[i][1] / 20);
+
+  shuffleMesh(points, triangles);
+}
+
+/// Time (us) per query, and number of leaf tests per query.
+template <typename BV>
+double run(const BVHModel<BV>& m1, const BVHModel<BV>& m2,
+           const std::vector<Transform3f>& tf2s, double& num_leaf_tests) {
+  CollisionRequest request(CONTACT, 1000000);
+  request.security_margin = 1;
+  num_leaf_tests = 0;
+  Timer timer;
+  for (std::size_t i = 0; i < tf2s.size(); ++i) {
+    CollisionResult result;
+    MeshCollisionTraversalNode<BV, 0> node(request);
+    initialize(node, m1, Transform3f(), m2, tf2s[i], result);
+    node.enableStatistics(true);
+    collide(&node, request, result);
+    num_leaf_tests += node.num_leaf_tests;
+  }
+  timer.stop();
+  num_leaf_tests /= double(tf2s.size());
+  return timer.elapsed().user / double(tf2s.size());
+}
+
+template <typename BV>
+void benchmark(const char* bv, const std::vector<Vec3f>& points,
+               const std::vector<Triangle>& triangles,
+               const std::vector<Transform3f>& tf2s) {
+  BVHModel<BV> model;
+  model.beginModel();
+  model.addSubModel(points, triangles);
+  model.endModel();
+  BVHModel<BV> reordered(model);
+  reordered.reorderPrimitives();
+
+  double num_leaf_tests;
+  const double shuffled = run(model, model, tf2s, num_leaf_tests);
+  const double sorted = run(reordered, reordered, tf2s, num_leaf_tests);
+  std::cout << bv << "\t" << num_leaf_tests << "\t" << shuffled << "\t"
+            << 1000 * shuffled / num_leaf_tests << "\t" << sorted << "\t"
+            << 1000 * sorted / num_leaf_tests << "\t" << shuffled / sorted
+            << "\n";
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t nb_queries = getNbRun(argc, argv, 20);
+
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  generateShuffledMesh(points, triangles);
+
+  // The second grid is vertical and crosses the first one.
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<FCL_REAL> angle(0, 2 * M_PI);
+  const Vec3f center(FCL_REAL(grid_size) / 2, FCL_REAL(grid_size) / 2, 0);
+  std::vector<Transform3f> tf2s;
+  for (std::size_t i = 0; i < nb_queries; ++i) {
+    const Matrix3f R =
+        (Eigen::AngleAxis<FCL_REAL>(angle(generator), Vec3f::UnitZ()) *
+         Eigen::AngleAxis<FCL_REAL>(M_PI / 2, Vec3f::UnitX()))
+            .toRotationMatrix();
+    tf2s.push_back(Transform3f(R, center - R * center));
+  }
+
+  std::cout << triangles.size() << " triangles, " << points.size()
+            << " vertices\n"
+            << "BV\tleaf tests/query\tshuffled (us/query, ns/leaf test)\t"
+               "reordered (us/query, ns/leaf test)\tspeedup\n";
+  benchmark<OBBRSS>("OBBRSS", points, triangles, tf2s);
+  benchmark<AABB>("AABB", points, triangles, tf2s);
+  return 0;
+}
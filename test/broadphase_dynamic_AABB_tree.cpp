@@ -45,6 +45,9 @@
 // #include "hpp/fcl/data_types.h"
 #include "hpp/fcl/shape/geometric_shapes.h"
 #include "hpp/fcl/broadphase/broadphase_dynamic_AABB_tree.h"
+#include "hpp/fcl/timings.h"
+
+#include "utility.h"
 
 using namespace hpp::fcl;
 
@@ -141,3 +144,94 @@ BOOST_AUTO_TEST_CASE(DynamicAABBTreeCollisionManager_class) {
     dynamic_tree.distance(&callback);
   }
 }
+
+struct CollectCallBack : CollisionCallBackBase {
+  bool collide(CollisionObject* o1, CollisionObject* o2) {
+    pairs.push_back(std::make_pair(o1, o2));
+    return false;
+  }
+
+  std::vector<DynamicAABBTreeCollisionManager::CollisionPair> pairs;
+};
+
+void checkParallelSelfCollision(std::size_t env_size,
+                                std::size_t num_max_contacts) {
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, 200, env_size);
+
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  // Candidate pairs are visited in the same order as the serial traversal.
+  CollectCallBack collect;
+  manager.collide(&collect);
+  for (unsigned int num_threads = 1; num_threads <= 4; num_threads *= 2) {
+    std::vector<DynamicAABBTreeCollisionManager::CollisionPair> pairs;
+    manager.getCandidatePairs(pairs, num_threads);
+    BOOST_CHECK(pairs == collect.pairs);
+  }
+
+  CollisionCallBackDefault serial;
+  serial.data.request.num_max_contacts = num_max_contacts;
+  manager.collide(&serial);
+
+  CollisionCallBackDefault parallel;
+  parallel.data.request.num_max_contacts = num_max_contacts;
+  manager.collideParallel(&parallel, 4);
+
+  BOOST_CHECK_EQUAL(serial.data.done, parallel.data.done);
+  BOOST_CHECK_EQUAL(serial.data.result.numContacts(),
+                    parallel.data.result.numContacts());
+  BOOST_CHECK(serial.data.result.getContacts() ==
+              parallel.data.result.getContacts());
+
+  for (std::size_t i = 0; i < env.size(); ++i) delete env[i];
+}
+
+BOOST_AUTO_TEST_CASE(DynamicAABBTreeCollisionManager_parallel_self_collision) {
+  checkParallelSelfCollision(100, 1);
+  checkParallelSelfCollision(100, 10);
+  checkParallelSelfCollision(100, 100000);
+}
+
+BOOST_AUTO_TEST_CASE(
+    DynamicAABBTreeCollisionManager_parallel_self_collision_benchmark) {
+#ifndef NDEBUG
+  std::size_t n = 0;
+#else
+  std::size_t n = 10;
+#endif
+  n = getNbRun(boost::unit_test::framework::master_test_suite().argc,
+               boost::unit_test::framework::master_test_suite().argv, n);
+  if (n == 0) return;
+
+  std::vector<CollisionObject*> env;
+  generateEnvironments(env, 2000, 2000);
+  DynamicAABBTreeCollisionManager manager;
+  manager.registerObjects(env);
+  manager.setup();
+
+  CollisionCallBackDefault callback;
+  callback.data.request.num_max_contacts = 100000;
+
+  Timer timer(false);
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) manager.collide(&callback);
+  timer.stop();
+  const double serial_time = timer.elapsed().user / double(n);
+  const std::size_t num_contacts = callback.data.result.numContacts();
+
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) manager.collideParallel(&callback);
+  timer.stop();
+  const double parallel_time = timer.elapsed().user / double(n);
+  BOOST_CHECK_EQUAL(num_contacts, callback.data.result.numContacts());
+
+  std::cout << "Self collision of " << env.size() << " objects ("
+            << num_contacts << " contacts):\n"
+            << "  serial:   " << serial_time << " us\n"
+            << "  parallel: " << parallel_time << " us" << std::endl;
+
+  for (std::size_t i = 0; i < env.size(); ++i) delete env[i];
+}
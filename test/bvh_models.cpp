@@ -49,7 +49,11 @@
 #include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
 #include <hpp/fcl/mesh_loader/assimp.h>
 #include <hpp/fcl/mesh_loader/loader.h>
+#include <hpp/fcl/internal/BV_splitter.h>
+#include <hpp/fcl/internal/BV_fitter.h>
 #include "utility.h"
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 
 using namespace hpp::fcl;
@@ -294,6 +298,353 @@ BOOST_AUTO_TEST_CASE(building_bvh_models) {
   testBVHModel<KDOP<24> >();
 }
 
+/// Check the primitive ranges of the hierarchy below node i and return the
+/// number of primitives below it.
+template <typename BV>
+unsigned int checkHierarchy(const BVHModel<BV>& model, unsigned int i,
+                            std::vector<int>& num_visits) {
+  const BVNode<BV>& node = model.getBV(i);
+  if (node.isLeaf()) {
+    BOOST_CHECK_EQUAL(node.num_primitives, 1);
+    ++num_visits[(std::size_t)node.primitiveId()];
+    return 1;
+  }
+  const BVNode<BV>& left = model.getBV((unsigned int)node.leftChild());
+  const BVNode<BV>& right = model.getBV((unsigned int)node.rightChild());
+  BOOST_CHECK_EQUAL(left.first_primitive, node.first_primitive);
+  BOOST_CHECK_EQUAL(right.first_primitive,
+                    node.first_primitive + left.num_primitives);
+  const unsigned int n =
+      checkHierarchy(model, (unsigned int)node.leftChild(), num_visits) +
+      checkHierarchy(model, (unsigned int)node.rightChild(), num_visits);
+  BOOST_CHECK_EQUAL(n, node.num_primitives);
+  return n;
+}
+
+template <typename BV>
+void testOptimizeTree() {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), points, triangles);
+
+  BVHModel<BV> sah;
+  sah.bv_splitter.reset(new BVSplitter<BV>(SPLIT_METHOD_SAH));
+  sah.beginModel();
+  sah.addSubModel(points, triangles);
+  sah.endModel();
+
+  BVHModel<BV> optimized(sah);
+  BOOST_CHECK_EQUAL(optimized.optimizeTree(), BVH_OK);
+  BOOST_CHECK_EQUAL(optimized.getNumBVs(), sah.getNumBVs());
+
+  std::vector<int> num_visits(triangles.size(), 0);
+  BOOST_CHECK_EQUAL(checkHierarchy(optimized, 0, num_visits),
+                    triangles.size());
+  BOOST_CHECK(std::count(num_visits.begin(), num_visits.end(), 1) ==
+              (std::ptrdiff_t)triangles.size());
+
+  loadOBJFile((path / "rob.obj").string().c_str(), points, triangles);
+  BVHModel<BV> rob;
+  rob.beginModel();
+  rob.addSubModel(points, triangles);
+  rob.endModel();
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTransforms(extents, transforms, 100);
+  CollisionRequest request(CONTACT, 100000);
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult r1, r2;
+    collide(&sah, Transform3f(), &rob, transforms[i], request, r1);
+    collide(&optimized, Transform3f(), &rob, transforms[i], request, r2);
+    BOOST_CHECK_EQUAL(r1.isCollision(), r2.isCollision());
+    BOOST_CHECK_EQUAL(r1.numContacts(), r2.numContacts());
+  }
+
+  BVHModel<BV> empty;
+  BOOST_CHECK_EQUAL(empty.optimizeTree(), BVH_ERR_BUILD_OUT_OF_SEQUENCE);
+}
+
+BOOST_AUTO_TEST_CASE(optimize_tree) {
+  testOptimizeTree<AABB>();
+  testOptimizeTree<OBB>();
+  testOptimizeTree<RSS>();
+  testOptimizeTree<kIOS>();
+  testOptimizeTree<OBBRSS>();
+  testOptimizeTree<KDOP<24> >();
+}
+
+template <typename BV>
+void testParallelBuild(const std::vector<Vec3f>& points,
+                       const std::vector<Triangle>& triangles) {
+  BVHModel<BV> serial;
+  serial.beginModel();
+  if (triangles.empty())
+    serial.addSubModel(points);
+  else
+    serial.addSubModel(points, triangles);
+  BOOST_CHECK_EQUAL(serial.endModel(), BVH_OK);
+
+  unsigned int num_threads[] = {2, 4, 0};
+  for (std::size_t k = 0; k < 3; ++k) {
+    BVHModel<BV> parallel;
+    parallel.beginModel();
+    if (triangles.empty())
+      parallel.addSubModel(points);
+    else
+      parallel.addSubModel(points, triangles);
+    BOOST_CHECK_EQUAL(parallel.endModel(num_threads[k]), BVH_OK);
+    BOOST_CHECK_EQUAL(parallel.getNumBVs(), serial.getNumBVs());
+    // The hierarchy does not depend on the number of threads.
+    BOOST_CHECK(parallel == serial);
+  }
+}
+
+template <typename BV>
+void testParallelBuild() {
+  // Enough primitives for the fitting of the root BV to be split in blocks.
+  const std::size_t n = 40000;
+  std::vector<Vec3f> points(3 * n);
+  std::vector<Triangle> triangles(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const Vec3f p(Vec3f::Random());
+    points[3 * i] = p;
+    points[3 * i + 1] = p + 0.01 * Vec3f::Random();
+    points[3 * i + 2] = p + 0.01 * Vec3f::Random();
+    triangles[i].set(3 * i, 3 * i + 1, 3 * i + 2);
+  }
+
+  testParallelBuild<BV>(points, triangles);
+  testParallelBuild<BV>(points, std::vector<Triangle>());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_build) {
+  testParallelBuild<AABB>();
+  testParallelBuild<OBB>();
+  testParallelBuild<RSS>();
+  testParallelBuild<kIOS>();
+  testParallelBuild<OBBRSS>();
+  testParallelBuild<KDOP<24> >();
+}
+
+/// Check that the BVs of model are those of a bottom-up refit.
+template <typename BV>
+void checkBottomUpRefit(const BVHModel<BV>& model) {
+  for (unsigned int i = 0; i < model.getNumBVs(); ++i) {
+    const BVNode<BV>& node = model.getBV(i);
+    BV bv;
+    if (node.isLeaf()) {
+      std::vector<Vec3f> v;
+      const std::size_t p = (std::size_t)node.primitiveId();
+      if (model.getModelType() == BVH_MODEL_TRIANGLES) {
+        for (Triangle::index_type j = 0; j < 3; ++j) {
+          if (model.prev_vertices)
+            v.push_back((*model.prev_vertices)[(*model.tri_indices)[p][j]]);
+        }
+        for (Triangle::index_type j = 0; j < 3; ++j)
+          v.push_back((*model.vertices)[(*model.tri_indices)[p][j]]);
+      } else {
+        if (model.prev_vertices) v.push_back((*model.prev_vertices)[p]);
+        v.push_back((*model.vertices)[p]);
+      }
+      fit(v.data(), (unsigned int)v.size(), bv);
+    } else {
+      bv = model.getBV((unsigned int)node.leftChild()).bv +
+           model.getBV((unsigned int)node.rightChild()).bv;
+    }
+    BOOST_CHECK(node.bv == bv);
+  }
+}
+
+template <typename BV>
+void testRefit(const std::vector<Vec3f>& points,
+               const std::vector<Triangle>& triangles) {
+  BVHModel<BV> model;
+  model.beginModel();
+  if (triangles.empty())
+    model.addSubModel(points);
+  else
+    model.addSubModel(points, triangles);
+  model.endModel();
+
+  std::vector<Vec3f> moved(points);
+  for (std::size_t i = 0; i < moved.size(); ++i)
+    moved[i][2] = std::sin(moved[i][0] / 10) * std::cos(moved[i][1] / 10);
+
+  // Full refits with several threads give the same BVs.
+  for (int bottomup = 0; bottomup < 2; ++bottomup) {
+    BVHModel<BV> serial(model), parallel(model);
+    serial.beginUpdateModel();
+    serial.updateSubModel(moved);
+    BOOST_CHECK_EQUAL(serial.endUpdateModel(true, bottomup != 0), BVH_OK);
+    parallel.beginUpdateModel();
+    parallel.updateSubModel(moved);
+    BOOST_CHECK_EQUAL(parallel.endUpdateModel(true, bottomup != 0, 4),
+                      BVH_OK);
+    BOOST_CHECK(parallel == serial);
+    if (bottomup) checkBottomUpRefit(parallel);
+  }
+
+  // Partial refit, without and with a previous frame.
+  std::vector<unsigned int> indices;
+  std::vector<Vec3f> ps;
+  for (unsigned int i = 0; i < moved.size(); ++i) {
+    if ((points[i] - points[0]).norm() < 10) {
+      indices.push_back(i);
+      ps.push_back(points[i] + Vec3f(0, 0, 1));
+    }
+  }
+  BVHModel<BV> replaced(model);
+  replaced.beginReplaceModel();
+  replaced.replaceSubModel(points);
+  replaced.endReplaceModel(true, true);
+  BOOST_CHECK_EQUAL(replaced.updateVertices(indices, ps), BVH_OK);
+  BOOST_CHECK(replaced.prev_vertices.get() == NULL);
+  checkBottomUpRefit(replaced);
+
+  BVHModel<BV> updated(model);
+  updated.beginUpdateModel();
+  updated.updateSubModel(moved);
+  updated.endUpdateModel(true, true);
+  BOOST_CHECK_EQUAL(updated.updateVertices(indices, ps), BVH_OK);
+  for (std::size_t k = 0; k < indices.size(); ++k) {
+    BOOST_CHECK_EQUAL((*updated.prev_vertices)[indices[k]], moved[indices[k]]);
+    BOOST_CHECK_EQUAL((*updated.vertices)[indices[k]], ps[k]);
+  }
+  checkBottomUpRefit(updated);
+
+  // Updating the same vertices again uses the cached parents and leaves.
+  for (std::size_t k = 0; k < ps.size(); ++k) ps[k][2] += 1;
+  BOOST_CHECK_EQUAL(updated.updateVertices(indices, ps), BVH_OK);
+  checkBottomUpRefit(updated);
+
+  std::vector<unsigned int> out_of_range(1, (unsigned int)points.size());
+  BOOST_CHECK_EQUAL(updated.updateVertices(out_of_range, ps),
+                    BVH_ERR_INCORRECT_DATA);
+  BOOST_CHECK_EQUAL(
+      updated.updateVertices(out_of_range, std::vector<Vec3f>(1)),
+      BVH_ERR_INCORRECT_DATA);
+  BVHModel<BV> empty;
+  BOOST_CHECK_EQUAL(empty.updateVertices(indices, ps),
+                    BVH_ERR_BUILD_OUT_OF_SEQUENCE);
+}
+
+template <typename BV>
+void testRefit(bool point_cloud) {
+  // Enough BVs for the bottom-up refit to be split among 4 threads.
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  generateGridMesh(100, 100, points, triangles);
+  testRefit<BV>(points, triangles);
+  if (point_cloud) testRefit<BV>(points, std::vector<Triangle>());
+}
+
+BOOST_AUTO_TEST_CASE(refit) {
+  // The oriented BVs of single points are degenerate and their bottom-up
+  // merge is not defined.
+  testRefit<AABB>(true);
+  testRefit<OBB>(false);
+  testRefit<RSS>(false);
+  testRefit<kIOS>(false);
+  testRefit<OBBRSS>(false);
+  testRefit<KDOP<24> >(true);
+}
+
+template <typename BV>
+void testReorderPrimitives(bool point_cloud) {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), points, triangles);
+  shuffleMesh(points, triangles);
+  if (point_cloud) triangles.clear();
+
+  BVHModel<BV> model;
+  model.beginModel();
+  if (point_cloud)
+    model.addSubModel(points);
+  else
+    model.addSubModel(points, triangles);
+  model.endModel();
+
+  BVHModel<BV> reordered(model);
+  std::vector<unsigned int> primitive_order, vertex_order;
+  BOOST_CHECK_EQUAL(
+      reordered.reorderPrimitives(&primitive_order, &vertex_order), BVH_OK);
+  BOOST_REQUIRE_EQUAL(vertex_order.size(), points.size());
+  BOOST_REQUIRE_EQUAL(primitive_order.size(),
+                      point_cloud ? points.size() : triangles.size());
+
+  // The nodes and their BVs are kept, the leaves refer to their position.
+  for (unsigned int i = 0; i < model.getNumBVs(); ++i) {
+    const BVNode<BV>& node = reordered.getBV(i);
+    BOOST_CHECK(node.bv == model.getBV(i).bv);
+    if (node.isLeaf()) {
+      BOOST_CHECK_EQUAL(node.primitiveId(), (int)node.first_primitive);
+      BOOST_CHECK_EQUAL(primitive_order[node.first_primitive],
+                        (unsigned int)model.getBV(i).primitiveId());
+    } else
+      BOOST_CHECK_EQUAL(node.first_child, model.getBV(i).first_child);
+  }
+  for (std::size_t v = 0; v < points.size(); ++v)
+    BOOST_CHECK_EQUAL((*reordered.vertices)[v], points[vertex_order[v]]);
+  if (point_cloud) {
+    BOOST_CHECK(primitive_order == vertex_order);
+    return;
+  }
+  // Each vertex is numbered after those of the previous triangles.
+  unsigned int next_vertex = 0;
+  for (std::size_t k = 0; k < triangles.size(); ++k) {
+    const Triangle& t = (*reordered.tri_indices)[k];
+    for (Triangle::index_type j = 0; j < 3; ++j) {
+      BOOST_CHECK_EQUAL(vertex_order[t[j]],
+                        triangles[primitive_order[k]][j]);
+      BOOST_CHECK(t[j] <= next_vertex);
+      if (t[j] == next_vertex) ++next_vertex;
+    }
+  }
+
+  // The contacts are the same, up to the numbering of the triangles.
+  loadOBJFile((path / "rob.obj").string().c_str(), points, triangles);
+  BVHModel<BV> rob;
+  rob.beginModel();
+  rob.addSubModel(points, triangles);
+  rob.endModel();
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTransforms(extents, transforms, 100);
+  CollisionRequest request(CONTACT, 100000);
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult r1, r2;
+    collide(&model, Transform3f(), &rob, transforms[i], request, r1);
+    collide(&reordered, Transform3f(), &rob, transforms[i], request, r2);
+    std::vector<std::pair<int, int> > c1, c2;
+    for (std::size_t k = 0; k < r1.numContacts(); ++k)
+      c1.push_back(std::make_pair(r1.getContact(k).b1, r1.getContact(k).b2));
+    for (std::size_t k = 0; k < r2.numContacts(); ++k)
+      c2.push_back(std::make_pair(
+          (int)primitive_order[(std::size_t)r2.getContact(k).b1],
+          r2.getContact(k).b2));
+    std::sort(c1.begin(), c1.end());
+    std::sort(c2.begin(), c2.end());
+    BOOST_CHECK(c1 == c2);
+  }
+
+  BVHModel<BV> empty;
+  BOOST_CHECK_EQUAL(empty.reorderPrimitives(), BVH_ERR_BUILD_OUT_OF_SEQUENCE);
+}
+
+BOOST_AUTO_TEST_CASE(reorder_primitives) {
+  testReorderPrimitives<AABB>(true);
+  testReorderPrimitives<AABB>(false);
+  testReorderPrimitives<OBB>(false);
+  testReorderPrimitives<RSS>(false);
+  testReorderPrimitives<kIOS>(false);
+  testReorderPrimitives<OBBRSS>(false);
+  testReorderPrimitives<KDOP<24> >(true);
+}
+
 template <class BoundingVolume>
 void testLoadPolyhedron() {
   boost::filesystem::path path(TEST_RESOURCES_DIR);
@@ -322,6 +673,96 @@ void testLoadPolyhedron() {
   BOOST_CHECK_EQUAL(geom, geom2);
 }
 
+BOOST_AUTO_TEST_CASE(load_polyhedron_cache_directory) {
+  namespace fs = boost::filesystem;
+  fs::path path(TEST_RESOURCES_DIR);
+  const std::string env = (path / "env.obj").string();
+  const fs::path cache_dir = fs::temp_directory_path() / fs::unique_path();
+  const Vec3f scale(1, 2, 3);
+
+  CachedMeshLoader cold(BV_OBBRSS, cache_dir.string());
+  BVHModelPtr_t built = cold.load(env, scale);
+  BOOST_REQUIRE(built);
+  BOOST_CHECK_EQUAL(
+      std::distance(fs::directory_iterator(cache_dir), fs::directory_iterator()),
+      1);
+
+  // Another loader, as in another process, reads the stored model.
+  CachedMeshLoader warm(BV_OBBRSS);
+  warm.setCacheDirectory(cache_dir.string());
+  BVHModelPtr_t loaded = warm.load(env, scale);
+  BOOST_REQUIRE(loaded);
+  BOOST_CHECK(*loaded == *built);
+  BOOST_CHECK_EQUAL(loaded, warm.load(env, scale));
+
+  // The scale and the BV type are part of the key.
+  CachedMeshLoader(BV_AABB, cache_dir.string()).load(env, scale);
+  warm.load(env, Vec3f::Ones());
+  BOOST_CHECK_EQUAL(
+      std::distance(fs::directory_iterator(cache_dir), fs::directory_iterator()),
+      3);
+
+  // A corrupted file is replaced.
+  for (fs::directory_iterator it(cache_dir); it != fs::directory_iterator();
+       ++it) {
+    std::ofstream os(it->path().string().c_str(), std::ios::trunc);
+    os << "corrupted";
+  }
+  loaded = CachedMeshLoader(BV_OBBRSS, cache_dir.string()).load(env, scale);
+  BOOST_REQUIRE(loaded);
+  BOOST_CHECK(*loaded == *built);
+  loaded = CachedMeshLoader(BV_OBBRSS, cache_dir.string()).load(env, scale);
+  BOOST_CHECK(*loaded == *built);
+
+  fs::remove_all(cache_dir);
+}
+
+BOOST_AUTO_TEST_CASE(load_many) {
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  const std::string env = (path / "env.obj").string(),
+                    rob = (path / "rob.obj").string();
+  std::vector<std::string> files;
+  for (int i = 0; i < 4; ++i) {
+    files.push_back(env);
+    files.push_back(rob);
+  }
+
+  MeshLoader reference_loader;
+  BVHModelPtr_t env_model = reference_loader.load(env),
+                rob_model = reference_loader.load(rob);
+
+  MeshLoader loader;
+  std::vector<BVHModelPtr_t> models =
+      loader.loadMany(files, std::vector<Vec3f>(), 4);
+  BOOST_REQUIRE_EQUAL(models.size(), files.size());
+  for (std::size_t i = 0; i < models.size(); ++i) {
+    BOOST_REQUIRE(models[i]);
+    BOOST_CHECK(*models[i] == *(i % 2 == 0 ? env_model : rob_model));
+  }
+
+  // The files requested several times are loaded once.
+  CachedMeshLoader cached_loader;
+  models = cached_loader.loadMany(files, std::vector<Vec3f>(), 4);
+  BOOST_CHECK_EQUAL(cached_loader.cache().size(), 2);
+  for (std::size_t i = 2; i < models.size(); ++i)
+    BOOST_CHECK_EQUAL(models[i], models[i % 2]);
+  BOOST_CHECK(*models[0] == *env_model);
+  BOOST_CHECK(*models[1] == *rob_model);
+
+  std::vector<Vec3f> scales(files.size(), Vec3f::Ones());
+  scales[2] = Vec3f(2, 2, 2);
+  models = cached_loader.loadMany(files, scales, 4);
+  BOOST_CHECK_EQUAL(cached_loader.cache().size(), 3);
+  BOOST_CHECK(models[2] != models[0]);
+  BOOST_CHECK_EQUAL(models[4], models[0]);
+
+  scales.pop_back();
+  BOOST_CHECK_THROW(cached_loader.loadMany(files, scales),
+                    std::invalid_argument);
+  files.push_back((path / "does_not_exist.obj").string());
+  BOOST_CHECK_THROW(cached_loader.loadMany(files), std::exception);
+}
+
 template <class BoundingVolume>
 void testLoadGerardBauzil() {
   boost::filesystem::path path(TEST_RESOURCES_DIR);
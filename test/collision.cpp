@@ -267,8 +267,9 @@ bool bs_hp = false;
 typedef std::vector<Contact> Contacts_t;
 typedef boost::mpl::vector<OBB, RSS, KDOP<24>, KDOP<18>, KDOP<16>, kIOS, OBBRSS>
     BVs_t;
-std::vector<SplitMethodType> splitMethods = boost::assign::list_of(
-    SPLIT_METHOD_MEAN)(SPLIT_METHOD_MEDIAN)(SPLIT_METHOD_BV_CENTER);
+std::vector<SplitMethodType> splitMethods =
+    boost::assign::list_of(SPLIT_METHOD_MEAN)(SPLIT_METHOD_MEDIAN)(
+        SPLIT_METHOD_BV_CENTER)(SPLIT_METHOD_SAH);
 
 #define BV_STR_SPECIALIZATION(bv) \
   template <>                     \
@@ -303,11 +304,6 @@ enum {
 template <typename BV, bool Oriented, bool recursive>
 struct traits : base_traits {};
 
-template <short N, bool recursive>
-struct traits<KDOP<N>, Oriented, recursive> : base_traits {
-  enum { IS_IMPLEMENTED = false };
-};
-
 HPP_FCL_COMPILER_DIAGNOSTIC_PUSH
 HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
 
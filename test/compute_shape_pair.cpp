@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE FCL_COMPUTE_SHAPE_PAIR
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/compute_shape_pair.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Checks that ComputeCollisionT and ComputeDistanceT give the results of
+/// ComputeCollision and ComputeDistance.
+template <typename S1, typename S2>
+void test_compute_shape_pair(const S1& s1, const S2& s2) {
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 100);
+  generateRandomTransforms(extents, tf2s, 100);
+
+  ComputeCollision compute_collision(&s1, &s2);
+  ComputeCollisionT<S1, S2> compute_collision_t(&s1, &s2);
+  ComputeDistance compute_distance(&s1, &s2);
+  ComputeDistanceT<S1, S2> compute_distance_t(&s1, &s2);
+
+  CollisionRequest collision_request(CONTACT, 1);
+  collision_request.security_margin = 0.1;
+  DistanceRequest distance_request(true);
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < tf1s.size(); ++i) {
+    CollisionResult expected, result;
+    const std::size_t n = compute_collision(tf1s[i], tf2s[i],
+                                            collision_request, expected);
+    BOOST_CHECK_EQUAL(
+        compute_collision_t(tf1s[i], tf2s[i], collision_request, result), n);
+    BOOST_CHECK_EQUAL(result.isCollision(), expected.isCollision());
+    if (expected.isCollision()) {
+      ++num_collisions;
+      const Contact& c = result.getContact(0);
+      const Contact& e = expected.getContact(0);
+      BOOST_CHECK(c.o1 == &s1 && c.o2 == &s2);
+      BOOST_CHECK_CLOSE(c.penetration_depth, e.penetration_depth, 1e-8);
+      BOOST_CHECK(c.normal.isApprox(e.normal));
+    }
+    BOOST_CHECK_EQUAL(result.distance_lower_bound,
+                      expected.distance_lower_bound);
+
+    DistanceResult dexpected, dresult;
+    const FCL_REAL d =
+        compute_distance(tf1s[i], tf2s[i], distance_request, dexpected);
+    BOOST_CHECK_EQUAL(
+        compute_distance_t(tf1s[i], tf2s[i], distance_request, dresult), d);
+    BOOST_CHECK_EQUAL(dresult.min_distance, dexpected.min_distance);
+    BOOST_CHECK(dresult.o1 == &s1 && dresult.o2 == &s2);
+    BOOST_CHECK(dresult.nearest_points[0].isApprox(dexpected.nearest_points[0]));
+    BOOST_CHECK(dresult.nearest_points[1].isApprox(dexpected.nearest_points[1]));
+  }
+  BOOST_CHECK(num_collisions > 0);
+}
+
+BOOST_AUTO_TEST_CASE(compute_shape_pair) {
+  Sphere sphere(0.4);
+  Capsule capsule(0.3, 1.);
+  Box box(0.8, 0.6, 1.);
+  Ellipsoid ellipsoid(0.5, 0.3, 0.4);
+  Cylinder cylinder(0.3, 0.8);
+  Convex<Triangle> convex = constructPolytopeFromEllipsoid(ellipsoid);
+
+  test_compute_shape_pair(sphere, sphere);
+  test_compute_shape_pair(capsule, capsule);
+  test_compute_shape_pair(box, sphere);
+  test_compute_shape_pair(sphere, box);
+  test_compute_shape_pair(capsule, box);
+  test_compute_shape_pair(ellipsoid, cylinder);
+  test_compute_shape_pair(convex, box);
+  test_compute_shape_pair(capsule, convex);
+}
+
+/// Checks that ComputeCollisionT gives the contacts of ComputeCollision
+/// between a mesh and a shape.
+template <typename BV, typename S>
+void test_compute_mesh_shape_pair(const S& s) {
+  BVHModel<BV> mesh;
+  generateBVHModel(mesh, Sphere(0.5), Transform3f(), 16, 16);
+
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 100);
+  generateRandomTransforms(extents, tf2s, 100);
+
+  ComputeCollision compute_collision(&mesh, &s);
+  ComputeCollisionT<BVHModel<BV>, S> compute_collision_t(&mesh, &s);
+
+  CollisionRequest request(CONTACT, 10);
+  request.security_margin = 0.05;
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < tf1s.size(); ++i) {
+    CollisionResult expected, result;
+    const std::size_t n =
+        compute_collision(tf1s[i], tf2s[i], request, expected);
+    BOOST_CHECK_EQUAL(compute_collision_t(tf1s[i], tf2s[i], request, result),
+                      n);
+    BOOST_REQUIRE_EQUAL(result.numContacts(), expected.numContacts());
+    if (n > 0) ++num_collisions;
+    for (std::size_t k = 0; k < n; ++k) {
+      const Contact& c = result.getContact(k);
+      const Contact& e = expected.getContact(k);
+      BOOST_CHECK(c.o1 == &mesh && c.o2 == &s);
+      BOOST_CHECK_EQUAL(c.b1, e.b1);
+      BOOST_CHECK_CLOSE(c.penetration_depth, e.penetration_depth, 1e-8);
+      BOOST_CHECK(c.normal.isApprox(e.normal));
+    }
+    BOOST_CHECK_CLOSE(result.distance_lower_bound,
+                      expected.distance_lower_bound, 1e-8);
+  }
+  BOOST_CHECK(num_collisions > 0);
+}
+
+BOOST_AUTO_TEST_CASE(compute_mesh_shape_pair) {
+  Capsule capsule(0.3, 1.);
+  Box box(0.8, 0.6, 1.);
+  Convex<Triangle> convex =
+      constructPolytopeFromEllipsoid(Ellipsoid(0.5, 0.3, 0.4));
+
+  test_compute_mesh_shape_pair<OBBRSS>(box);
+  test_compute_mesh_shape_pair<AABB>(capsule);
+  test_compute_mesh_shape_pair<OBB>(convex);
+}
+
+BOOST_AUTO_TEST_CASE(compute_shape_pair_infinite_margin) {
+  Capsule capsule(0.3, 1.);
+  Box box(0.8, 0.6, 1.);
+  ComputeCollisionT<Capsule, Box> compute(&capsule, &box);
+  CollisionRequest request(CONTACT, 1);
+  request.security_margin = -std::numeric_limits<FCL_REAL>::infinity();
+  CollisionResult result;
+  BOOST_CHECK_EQUAL(compute(Transform3f(), Transform3f(), request, result), 0);
+  BOOST_CHECK(!result.isCollision());
+}
@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE FCL_CONTINUOUS_COLLISION
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/narrowphase/continuous_collision.h>
+#include <hpp/fcl/broadphase/broadphase_continuous_SSaP.h>
+#include <hpp/fcl/broadphase/default_broadphase_callbacks.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Checks that the objects are free before the time of contact, by sampling
+/// the motion, and in contact at the time of contact.
+void checkTimeOfContact(const ContinuousCollisionObject& o1,
+                        const ContinuousCollisionObject& o2,
+                        const ContinuousCollisionRequest& request,
+                        const ContinuousCollisionResult& result) {
+  const std::size_t num_samples = 1000;
+  CollisionRequest collision_request;
+  for (std::size_t i = 0; i < num_samples; ++i) {
+    const FCL_REAL t =
+        result.time_of_contact * FCL_REAL(i) / FCL_REAL(num_samples);
+    CollisionResult collision_result;
+    collide(o1.collisionGeometryPtr(), o1.getTransform(t),
+            o2.collisionGeometryPtr(), o2.getTransform(t), collision_request,
+            collision_result);
+    BOOST_CHECK_MESSAGE(!collision_result.isCollision(),
+                        "collision at " << t << " before the time of contact "
+                                        << result.time_of_contact);
+  }
+  if (result.is_collide) {
+    DistanceRequest distance_request;
+    DistanceResult distance_result;
+    const FCL_REAL d = distance(o1.collisionGeometryPtr(), result.contact_tf1,
+                                o2.collisionGeometryPtr(), result.contact_tf2,
+                                distance_request, distance_result);
+    BOOST_CHECK_SMALL(d, 2 * request.tolerance);
+    const Transform3f tf1 = o1.getTransform(result.time_of_contact);
+    BOOST_CHECK(result.contact_tf1.getTranslation().isApprox(
+        tf1.getTranslation()));
+    BOOST_CHECK(
+        result.contact_tf1.getRotation().isApprox(tf1.getRotation()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(spheres_head_on) {
+  shared_ptr<Sphere> sphere(new Sphere(0.5));
+  ContinuousCollisionObject o1(sphere, Transform3f(), Transform3f());
+  ContinuousCollisionObject o2(sphere, Transform3f(Vec3f(5, 0, 0)),
+                               Transform3f(Vec3f(-5, 0, 0)));
+  ContinuousCollisionRequest request;
+  ContinuousCollisionResult result;
+  const FCL_REAL toc = collide(&o1, &o2, request, result);
+
+  BOOST_CHECK(result.is_collide);
+  BOOST_CHECK_EQUAL(toc, result.time_of_contact);
+  // The centers are 1 apart at x = 1.
+  BOOST_CHECK_CLOSE(toc, 0.4, 1e-2);
+  // Pure translations converge at once.
+  BOOST_CHECK(result.num_queries < 5);
+  checkTimeOfContact(o1, o2, request, result);
+
+  // Passing by.
+  o2.setMotion(Transform3f(Vec3f(5, 1.5, 0)), Transform3f(Vec3f(-5, 1.5, 0)));
+  BOOST_CHECK_EQUAL(collide(&o1, &o2, request, result), 1);
+  BOOST_CHECK(!result.is_collide);
+  BOOST_CHECK(result.contact_tf2.getTranslation().isApprox(
+      o2.getTransformEnd().getTranslation()));
+
+  // No relative motion.
+  o2.setMotion(Transform3f(Vec3f(2, 0, 0)), Transform3f(Vec3f(2, 0, 0)));
+  BOOST_CHECK_EQUAL(collide(&o1, &o2, request, result), 1);
+  BOOST_CHECK(!result.is_collide);
+}
+
+BOOST_AUTO_TEST_CASE(thin_boxes_tunneling) {
+  // The moving box goes through the wall between two samples.
+  shared_ptr<Box> wall(new Box(0.1, 2, 2)), box(new Box(0.1, 1, 1));
+  ContinuousCollisionObject o1(wall, Transform3f(), Transform3f());
+  ContinuousCollisionObject o2(box, Transform3f(Vec3f(-3, 0, 0)),
+                               Transform3f(Vec3f(3, 0, 0)));
+  CollisionRequest collision_request;
+  CollisionResult collision_result;
+  BOOST_CHECK(!collide(wall.get(), o1.getTransformBeg(), box.get(),
+                       o2.getTransformBeg(), collision_request,
+                       collision_result));
+  BOOST_CHECK(!collide(wall.get(), o1.getTransformEnd(), box.get(),
+                       o2.getTransformEnd(), collision_request,
+                       collision_result));
+
+  ContinuousCollisionRequest request;
+  ContinuousCollisionResult result;
+  collide(&o1, &o2, request, result);
+  BOOST_CHECK(result.is_collide);
+  BOOST_CHECK_CLOSE(result.time_of_contact, 2.9 / 6, 1e-2);
+  checkTimeOfContact(o1, o2, request, result);
+}
+
+BOOST_AUTO_TEST_CASE(rotating_shapes_and_meshes) {
+  shared_ptr<Cylinder> cylinder(new Cylinder(0.1, 2.));
+  shared_ptr<Box> box(new Box(0.3, 0.4, 0.5));
+  shared_ptr<BVHModel<OBBRSS> > cylinder_mesh(new BVHModel<OBBRSS>());
+  shared_ptr<BVHModel<OBBRSS> > box_mesh(new BVHModel<OBBRSS>());
+  generateBVHModel(*cylinder_mesh, *cylinder, Transform3f(), 10, 4);
+  generateBVHModel(*box_mesh, *box, Transform3f());
+
+  // The cylinder turns around the x axis and hits the box.
+  const Transform3f tf1_beg(Vec3f(0, 0, 0));
+  const Transform3f tf1_end(
+      Quatf(Eigen::AngleAxis<FCL_REAL>(3., Vec3f::UnitX())), Vec3f(0.1, 0, 0));
+  const Transform3f tf2_beg(Vec3f(0.05, 0.7, -0.2));
+  const Transform3f tf2_end(
+      Quatf(Eigen::AngleAxis<FCL_REAL>(0.5, Vec3f::UnitZ())),
+      Vec3f(0.05, 0.6, -0.3));
+
+  ContinuousCollisionRequest request;
+  request.max_iterations = 1000;
+  std::vector<FCL_REAL> tocs;
+  const shared_ptr<CollisionGeometry> geoms1[] = {cylinder, cylinder_mesh};
+  const shared_ptr<CollisionGeometry> geoms2[] = {box, box_mesh};
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      ContinuousCollisionObject o1(geoms1[i], tf1_beg, tf1_end);
+      ContinuousCollisionObject o2(geoms2[j], tf2_beg, tf2_end);
+      ContinuousCollisionResult result;
+      collide(&o1, &o2, request, result);
+      BOOST_CHECK(result.is_collide);
+      BOOST_CHECK(result.time_of_contact > 0);
+      checkTimeOfContact(o1, o2, request, result);
+      tocs.push_back(result.time_of_contact);
+    }
+  }
+  // The meshes are inside the shapes.
+  BOOST_CHECK(tocs[1] >= tocs[0] - request.tolerance);
+  BOOST_CHECK(tocs[2] >= tocs[0] - request.tolerance);
+  BOOST_CHECK_CLOSE(tocs[0], tocs[1], 5);
+}
+
+/// Translation along a circle of radius R around the origin, in the plane z =
+/// 0, at constant speed.
+struct CircularMotion : MotionBase {
+  explicit CircularMotion(FCL_REAL R_) : R(R_) {}
+  Transform3f getTransform(FCL_REAL t) const {
+    return Transform3f(
+        Vec3f(R * std::cos(2 * M_PI * t), R * std::sin(2 * M_PI * t), 0));
+  }
+  FCL_REAL getMotionBound(FCL_REAL) const { return 2 * M_PI * R; }
+  FCL_REAL R;
+};
+
+BOOST_AUTO_TEST_CASE(parametric_motion) {
+  Sphere sphere(0.2);
+  Box box(0.2, 0.2, 0.2);
+  sphere.computeLocalAABB();
+  box.computeLocalAABB();
+  const CircularMotion motion1(2);
+  const InterpMotion motion2(Transform3f(Vec3f(0, 2, 0)));
+
+  ContinuousCollisionRequest request;
+  ContinuousCollisionResult result;
+  collide(&sphere, motion1, &box, motion2, request, result);
+  BOOST_CHECK(result.is_collide);
+  BOOST_CHECK(result.time_of_contact > 0.2 && result.time_of_contact < 0.25);
+  // Much fewer queries than sampling the circle at the tolerance.
+  BOOST_CHECK(result.num_queries < 100);
+
+  CollisionRequest collision_request;
+  for (int i = 0; i < 1000; ++i) {
+    const FCL_REAL t = result.time_of_contact * i / 1000;
+    CollisionResult collision_result;
+    BOOST_CHECK(!collide(&sphere, motion1.getTransform(t), &box,
+                         motion2.getTransform(t), collision_request,
+                         collision_result));
+  }
+  DistanceRequest distance_request;
+  DistanceResult distance_result;
+  BOOST_CHECK_SMALL(distance(&sphere, result.contact_tf1, &box,
+                             result.contact_tf2, distance_request,
+                             distance_result),
+                    2 * request.tolerance);
+
+  // Farther from the circle.
+  collide(&sphere, motion1, &box, InterpMotion(Transform3f(Vec3f(0, 2.5, 0))),
+          request, result);
+  BOOST_CHECK(!result.is_collide);
+  BOOST_CHECK_EQUAL(result.time_of_contact, 1);
+
+  // The pose overload runs the interpolated motion.
+  const Transform3f tf_beg(Vec3f(-2, 2, 0)), tf_end(Vec3f(2, 2, 0));
+  ContinuousCollisionResult result2;
+  collide(&sphere, InterpMotion(tf_beg, tf_end), &box, motion2, request,
+          result);
+  collide(&sphere, tf_beg, tf_end, &box, motion2.getTransformBeg(),
+          motion2.getTransformEnd(), request, result2);
+  BOOST_CHECK(result.is_collide);
+  BOOST_CHECK_EQUAL(result.time_of_contact, result2.time_of_contact);
+  BOOST_CHECK_EQUAL(result.num_queries, result2.num_queries);
+}
+
+BOOST_AUTO_TEST_CASE(broadphase_earliest_contact) {
+  FCL_REAL extents[] = {-3, -3, -3, 3, 3, 3};
+  std::vector<Transform3f> tf_begs, tf_ends;
+  const std::size_t n = 40;
+  generateRandomTransforms(extents, tf_begs, n);
+  generateRandomTransforms(extents, tf_ends, n);
+
+  shared_ptr<Sphere> sphere(new Sphere(0.2));
+  shared_ptr<Box> box(new Box(0.3, 0.2, 0.4));
+  std::vector<shared_ptr<ContinuousCollisionObject> > objects;
+  SSaPContinuousCollisionManager manager;
+  for (std::size_t i = 0; i < n; ++i) {
+    objects.push_back(shared_ptr<ContinuousCollisionObject>(
+        new ContinuousCollisionObject(i % 2 ? shared_ptr<CollisionGeometry>(box)
+                                            : sphere,
+                                      tf_begs[i], tf_ends[i])));
+    manager.registerObject(objects.back().get());
+  }
+  manager.setup();
+  BOOST_CHECK_EQUAL(manager.size(), n);
+
+  // Brute force over all the pairs.
+  ContinuousCollisionRequest request;
+  FCL_REAL earliest = 1;
+  for (std::size_t i = 0; i < n; ++i) {
+    for (std::size_t j = i + 1; j < n; ++j) {
+      ContinuousCollisionResult result;
+      collide(objects[i].get(), objects[j].get(), request, result);
+      if (result.is_collide)
+        earliest = (std::min)(earliest, result.time_of_contact);
+    }
+  }
+  BOOST_REQUIRE(earliest < 1);
+
+  ContinuousCollisionCallBackDefault callback;
+  manager.collide(&callback);
+  BOOST_CHECK(callback.data.result.is_collide);
+  BOOST_CHECK_EQUAL(callback.data.result.time_of_contact, earliest);
+  BOOST_CHECK(callback.data.o1 != nullptr && callback.data.o2 != nullptr);
+
+  // Unregistering one object of the first contact delays it.
+  manager.unregisterObject(callback.data.o1);
+  BOOST_CHECK_EQUAL(manager.size(), n - 1);
+  ContinuousCollisionCallBackDefault callback2;
+  manager.collide(&callback2);
+  BOOST_CHECK(callback2.data.result.time_of_contact >= earliest);
+}
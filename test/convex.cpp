@@ -40,6 +40,7 @@
 #include <hpp/fcl/shape/convex.h>
 #include <hpp/fcl/collision.h>
 #include <hpp/fcl/distance.h>
+#include <hpp/fcl/narrowphase/support_functions.h>
 
 #include "utility.h"
 
@@ -172,6 +173,66 @@ BOOST_AUTO_TEST_CASE(compare_convex_box) {
   }
 }
 
+void checkLinearSupport(const ConvexBase& convex) {
+  const std::vector<Vec3f>& pts = *convex.points;
+  const details::SmallConvex* small =
+      reinterpret_cast<const details::SmallConvex*>(&convex);
+  details::ShapeSupportData data;
+  for (int k = 0; k < 1000; ++k) {
+    const Vec3f dir(Vec3f::Random());
+    int expected = 0;
+    for (int i = 1; i < (int)convex.num_points; ++i)
+      if (pts[size_t(i)].dot(dir) > pts[size_t(expected)].dot(dir))
+        expected = i;
+
+    Vec3f support;
+    int hint = 0;
+    details::getShapeSupport<details::SupportOptions::NoSweptSphere>(
+        small, dir, support, hint, data);
+    BOOST_CHECK(hint >= 0 && hint < (int)convex.num_points);
+    BOOST_CHECK_SMALL(support.dot(dir) - pts[size_t(expected)].dot(dir),
+                      1e-12);
+    BOOST_CHECK(support == pts[size_t(hint)]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(convex_support_soa) {
+  // 21 points, so that the structure of arrays is padded.
+  const unsigned int n = 21;
+  std::shared_ptr<std::vector<Vec3f>> pts(new std::vector<Vec3f>(n));
+  for (unsigned int i = 0; i < n; ++i) (*pts)[i] = Vec3f::Random();
+  std::shared_ptr<std::vector<Triangle>> tris(
+      new std::vector<Triangle>(1, Triangle(0, 1, 2)));
+  Convex<Triangle> convex(pts, n, tris, 1);
+
+  BOOST_CHECK_EQUAL(convex.points_soa.cols() %
+                        ConvexBase::points_soa_block_size,
+                    0);
+  BOOST_CHECK(convex.points_soa.cols() >= n);
+  BOOST_CHECK(convex.isPointsSoAUpToDate());
+  Convex<Triangle> copy(convex);
+  BOOST_CHECK(copy.points_soa == convex.points_soa);
+  BOOST_CHECK(copy.isPointsSoAUpToDate());
+  checkLinearSupport(convex);
+
+  // Move the vertices in place and rebuild the cache.
+  for (unsigned int i = 0; i < n; ++i) (*pts)[i] = 2 * Vec3f::Random();
+  convex.buildPointsSoA();
+  BOOST_CHECK(convex.isPointsSoAUpToDate());
+  checkLinearSupport(convex);
+
+  // Replace the points by another cloud of the same size: the cache is
+  // ignored until it is rebuilt.
+  std::shared_ptr<std::vector<Vec3f>> other_pts(new std::vector<Vec3f>(n));
+  for (unsigned int i = 0; i < n; ++i) (*other_pts)[i] = Vec3f::Random();
+  convex.points = other_pts;
+  BOOST_CHECK(!convex.isPointsSoAUpToDate());
+  checkLinearSupport(convex);
+  convex.buildPointsSoA();
+  BOOST_CHECK(convex.isPointsSoAUpToDate());
+  checkLinearSupport(convex);
+}
+
 #ifdef HPP_FCL_HAS_QHULL
 BOOST_AUTO_TEST_CASE(convex_hull_throw) {
   std::shared_ptr<std::vector<Vec3f>> points(
@@ -467,6 +467,68 @@ BOOST_AUTO_TEST_CASE(mesh_distance) {
   BOOST_TEST_MESSAGE("collision timing: " << col_time << " sec");
 }
 
+template <typename BV, typename TraversalNode>
+void compareDistanceTraversals(const std::vector<Vec3f>& vertices1,
+                               const std::vector<Triangle>& triangles1,
+                               const std::vector<Vec3f>& vertices2,
+                               const std::vector<Triangle>& triangles2,
+                               const std::vector<Transform3f>& transforms) {
+  BVHModel<BV> m1, m2;
+  m1.beginModel();
+  m1.addSubModel(vertices1, triangles1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(vertices2, triangles2);
+  m2.endModel();
+
+  int num_bv_tests[2] = {0, 0}, num_leaf_tests[2] = {0, 0};
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    DistanceResult results[2];
+    for (int k = 0; k < 2; ++k) {
+      TraversalNode node;
+      initialize(node, (const BVHModel<BV>&)m1, transforms[i],
+                 (const BVHModel<BV>&)m2, Transform3f(), DistanceRequest(true),
+                 results[k]);
+      node.enable_statistics = true;
+      distance(&node, NULL, 2, k == 0);
+      num_bv_tests[k] += node.num_bv_tests;
+      num_leaf_tests[k] += node.num_leaf_tests;
+    }
+    BOOST_CHECK_CLOSE(results[0].min_distance, results[1].min_distance, 1e-6);
+    if (results[0].min_distance > 0) {
+      BOOST_CHECK(nearlyEqual(results[0].nearest_points[0],
+                              results[1].nearest_points[0]));
+      BOOST_CHECK(nearlyEqual(results[0].nearest_points[1],
+                              results[1].nearest_points[1]));
+    }
+  }
+  BOOST_TEST_MESSAGE("recursive: " << num_bv_tests[0] << " BV tests, "
+                                   << num_leaf_tests[0] << " leaf tests");
+  BOOST_TEST_MESSAGE("non recursive: " << num_bv_tests[1] << " BV tests, "
+                                       << num_leaf_tests[1] << " leaf tests");
+  BOOST_CHECK(num_bv_tests[1] <= num_bv_tests[0]);
+  BOOST_CHECK(num_leaf_tests[1] <= num_leaf_tests[0]);
+}
+
+BOOST_AUTO_TEST_CASE(mesh_distance_non_recursive) {
+  std::vector<Vec3f> p1, p2;
+  std::vector<Triangle> t1, t2;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), p1, t1);
+  loadOBJFile((path / "rob.obj").string().c_str(), p2, t2);
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTransforms(extents, transforms, 50);
+
+  compareDistanceTraversals<RSS, MeshDistanceTraversalNodeRSS>(p1, t1, p2, t2,
+                                                               transforms);
+  compareDistanceTraversals<OBBRSS, MeshDistanceTraversalNodeOBBRSS>(
+      p1, t1, p2, t2, transforms);
+  compareDistanceTraversals<kIOS, MeshDistanceTraversalNodekIOS>(
+      p1, t1, p2, t2, transforms);
+}
+
 template <typename BV, typename TraversalNode>
 void distance_Test_Oriented(const Transform3f& tf,
                             const std::vector<Vec3f>& vertices1,
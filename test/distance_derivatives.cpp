@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE FCL_DISTANCE_DERIVATIVES
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/compute_shape_pair.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/shape/geometric_shape_to_BVH_model.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+/// Pose tf * exp(h e_k), with e_k the k-th unit velocity.
+Transform3f displace(const Transform3f& tf, int k, FCL_REAL h) {
+  if (k < 3) return tf * Transform3f(Vec3f(h * Vec3f::Unit(k)));
+  return tf * Transform3f(Matrix3f(Eigen::AngleAxis<FCL_REAL>(
+                              h, Vec3f::Unit(k - 3))),
+                          Vec3f::Zero());
+}
+
+DistanceRequest makeRequest() {
+  DistanceRequest request;
+  request.gjk_tolerance = 1e-10;
+  request.epa_tolerance = 1e-10;
+  return request;
+}
+
+/// Compares the derivatives to central finite differences.
+void checkDerivatives(const CollisionGeometry* o1, const Transform3f& tf1,
+                      const CollisionGeometry* o2, const Transform3f& tf2,
+                      bool check_points) {
+  DistanceRequest request(makeRequest());
+  request.enable_derivatives = true;
+  DistanceResult result;
+  distance(o1, tf1, o2, tf2, request, result);
+  BOOST_REQUIRE(result.dmin_distance_dtf.allFinite());
+  if (check_points) {
+    BOOST_REQUIRE(result.dnearest_points_dtf[0].allFinite());
+    BOOST_REQUIRE(result.dnearest_points_dtf[1].allFinite());
+  }
+
+  const FCL_REAL h = 1e-6;
+  const DistanceRequest fd_request(makeRequest());
+  for (int k = 0; k < 12; ++k) {
+    DistanceResult plus, minus;
+    const Transform3f& tf = k < 6 ? tf1 : tf2;
+    const Transform3f tf_plus = displace(tf, k % 6, h);
+    const Transform3f tf_minus = displace(tf, k % 6, -h);
+    distance(o1, k < 6 ? tf_plus : tf1, o2, k < 6 ? tf2 : tf_plus, fd_request,
+             plus);
+    distance(o1, k < 6 ? tf_minus : tf1, o2, k < 6 ? tf2 : tf_minus,
+             fd_request, minus);
+
+    const FCL_REAL dd = (plus.min_distance - minus.min_distance) / (2 * h);
+    BOOST_CHECK_MESSAGE(std::abs(dd - result.dmin_distance_dtf[k]) < 1e-4,
+                        "column " << k << ": " << result.dmin_distance_dtf[k]
+                                  << " != " << dd);
+    if (!check_points) continue;
+    for (int i = 0; i < 2; ++i) {
+      const Vec3f dp =
+          (plus.nearest_points[i] - minus.nearest_points[i]) / (2 * h);
+      BOOST_CHECK_MESSAGE(
+          dp.isApprox(result.dnearest_points_dtf[i].col(k), 1e-3) ||
+              (dp - result.dnearest_points_dtf[i].col(k)).norm() < 1e-4,
+          "point " << i << ", column " << k << ":\n"
+                   << result.dnearest_points_dtf[i].col(k).transpose()
+                   << "\n != " << dp.transpose());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(separated_and_penetrating_shapes) {
+  Box box1(0.4, 0.6, 0.8), box2(0.3, 0.5, 0.2);
+  Sphere sphere(0.25);
+  Capsule capsule(0.1, 0.6);
+  const Transform3f tf1(
+      Matrix3f(Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f(1, 2, 3).normalized())),
+      Vec3f(0.1, -0.05, 0.2));
+  const Matrix3f R2(
+      Eigen::AngleAxis<FCL_REAL>(0.9, Vec3f(-2, 1, 0.5).normalized()));
+
+  // Separated, then penetrating.
+  const FCL_REAL offsets[] = {1.2, 0.5};
+  for (const FCL_REAL offset : offsets) {
+    const Transform3f tf2(R2, Vec3f(offset, 0.2, 0.1));
+    checkDerivatives(&box1, tf1, &box2, tf2, true);
+    checkDerivatives(&box1, tf1, &sphere, tf2, true);
+    checkDerivatives(&capsule, tf1, &box2, tf2, true);
+    checkDerivatives(&capsule, tf1, &sphere, tf2, true);
+    checkDerivatives(&sphere, tf1, &sphere, tf2, true);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(random_box_pairs) {
+  Box box1(0.4, 0.6, 0.8), box2(0.3, 0.5, 0.2);
+  FCL_REAL extents[] = {-1, -1, -1, 1, 1, 1};
+  std::vector<Transform3f> tf1s, tf2s;
+  generateRandomTransforms(extents, tf1s, 50);
+  generateRandomTransforms(extents, tf2s, 50);
+  for (std::size_t i = 0; i < tf1s.size(); ++i)
+    checkDerivatives(&box1, tf1s[i], &box2, tf2s[i], true);
+}
+
+BOOST_AUTO_TEST_CASE(meshes) {
+  Box box(0.4, 0.6, 0.8);
+  Sphere sphere(0.25);
+  BVHModel<OBBRSS> box_mesh;
+  generateBVHModel(box_mesh, box, Transform3f());
+
+  const Transform3f tf1(
+      Matrix3f(Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f(1, 2, 3).normalized())),
+      Vec3f(0.1, -0.05, 0.2));
+  const Transform3f tf2(
+      Matrix3f(Eigen::AngleAxis<FCL_REAL>(0.9, Vec3f(-2, 1, 0.5).normalized())),
+      Vec3f(1.2, 0.2, 0.1));
+  checkDerivatives(&box_mesh, tf1, &sphere, tf2, true);
+  checkDerivatives(&sphere, tf2, &box_mesh, tf1, true);
+  checkDerivatives(&box_mesh, tf1, &box_mesh, tf2, true);
+
+  // The mesh gives the same derivatives as the shape.
+  DistanceRequest request;
+  request.enable_derivatives = true;
+  DistanceResult mesh_result, shape_result;
+  distance(&box_mesh, tf1, &sphere, tf2, request, mesh_result);
+  distance(&box, tf1, &sphere, tf2, request, shape_result);
+  BOOST_CHECK(mesh_result.dmin_distance_dtf.isApprox(
+      shape_result.dmin_distance_dtf, 1e-6));
+  BOOST_CHECK(mesh_result.dnearest_points_dtf[0].isApprox(
+      shape_result.dnearest_points_dtf[0], 1e-6));
+}
+
+BOOST_AUTO_TEST_CASE(query_functors) {
+  Box box(0.4, 0.6, 0.8);
+  Capsule capsule(0.1, 0.6);
+  const Transform3f tf1(
+      Matrix3f(Eigen::AngleAxis<FCL_REAL>(0.3, Vec3f(1, 2, 3).normalized())),
+      Vec3f(0.1, -0.05, 0.2));
+  const Transform3f tf2(Vec3f(0.8, 0.2, 0.1));
+
+  DistanceRequest request;
+  DistanceResult result, compute_result, compute_t_result;
+  distance(&box, tf1, &capsule, tf2, request, result);
+  BOOST_CHECK(!result.dmin_distance_dtf.allFinite());
+
+  request.enable_derivatives = true;
+  distance(&box, tf1, &capsule, tf2, request, result);
+  ComputeDistance compute_distance(&box, &capsule);
+  compute_distance(tf1, tf2, request, compute_result);
+  ComputeDistanceT<Box, Capsule> compute_distance_t(&box, &capsule);
+  compute_distance_t(tf1, tf2, request, compute_t_result);
+  BOOST_CHECK(result.dmin_distance_dtf.isApprox(
+      compute_result.dmin_distance_dtf));
+  BOOST_CHECK(result.dmin_distance_dtf.isApprox(
+      compute_t_result.dmin_distance_dtf));
+  BOOST_CHECK(result.dnearest_points_dtf[1].isApprox(
+      compute_t_result.dnearest_points_dtf[1]));
+
+  // Computed afterwards, by running GJK again.
+  DistanceResult later_result;
+  request.enable_derivatives = false;
+  distance(&box, tf1, &capsule, tf2, request, later_result);
+  computeDistanceDerivatives(&box, tf1, &capsule, tf2, request, later_result);
+  BOOST_CHECK(result.dmin_distance_dtf.isApprox(
+      later_result.dmin_distance_dtf));
+  BOOST_CHECK(result.dnearest_points_dtf[0].isApprox(
+      later_result.dnearest_points_dtf[0], 1e-6));
+}
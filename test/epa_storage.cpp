@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+#define BOOST_TEST_MODULE FCL_EPA_STORAGE
+#include <boost/test/included/unit_test.hpp>
+
+#include <cstdlib>
+#include <new>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+// Counts the allocations of the whole program.
+static std::size_t num_allocations = 0;
+
+static void* countedAllocate(std::size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+using namespace hpp::fcl;
+using hpp::fcl::details::EPA;
+
+/// Gives access to the solver of a ComputeCollision or a ComputeDistance.
+template <typename Compute>
+struct ComputeWithSolver : Compute {
+  ComputeWithSolver(const CollisionGeometry* o1, const CollisionGeometry* o2)
+      : Compute(o1, o2) {}
+  GJKSolver& getSolver() const { return this->solver; }
+};
+
+// The shapes penetrate each other, so that the queries run EPA.
+struct PenetratingShapes {
+  PenetratingShapes()
+      : ellipsoid(0.5, 0.8, 0.3),
+        capsule(0.2, 1.),
+        tf1(Quatf(0.9, 0.1, -0.3, 0.2).normalized(), Vec3f(0.1, -0.2, 0.)),
+        tf2(Quatf(0.3, -0.6, 0.1, 0.7).normalized(), Vec3f(0.2, 0.1, 0.1)) {}
+
+  Ellipsoid ellipsoid;
+  Capsule capsule;
+  Transform3f tf1, tf2;
+};
+
+BOOST_FIXTURE_TEST_CASE(no_allocation_after_warm_up, PenetratingShapes) {
+  CollisionRequest collision_request(CONTACT, 1);
+  CollisionResult collision_result;
+  DistanceRequest distance_request(true);
+  DistanceResult distance_result;
+  ComputeWithSolver<ComputeCollision> compute_collision(&ellipsoid, &capsule);
+  ComputeWithSolver<ComputeDistance> compute_distance(&ellipsoid, &capsule);
+
+  // Warm-up: grows the EPA storage of the thread and the results.
+  collide(&ellipsoid, tf1, &capsule, tf2, collision_request, collision_result);
+  distance(&ellipsoid, tf1, &capsule, tf2, distance_request, distance_result);
+  compute_collision(tf1, tf2, collision_request, collision_result);
+  compute_distance(tf1, tf2, distance_request, distance_result);
+
+  const std::size_t allocations_before = num_allocations;
+  for (int i = 0; i < 10; ++i) {
+    collision_result.clear();
+    collide(&ellipsoid, tf1, &capsule, tf2, collision_request,
+            collision_result);
+    distance_result.clear();
+    distance(&ellipsoid, tf1, &capsule, tf2, distance_request,
+             distance_result);
+    collision_result.clear();
+    compute_collision(tf1, tf2, collision_request, collision_result);
+    distance_result.clear();
+    compute_distance(tf1, tf2, distance_request, distance_result);
+  }
+  const std::size_t allocations = num_allocations - allocations_before;
+
+  BOOST_CHECK_EQUAL(allocations, 0);
+  BOOST_CHECK(collision_result.isCollision());
+  BOOST_CHECK(distance_result.min_distance < 0);
+  BOOST_CHECK(compute_collision.getSolver().epa.status & EPA::Valid);
+  BOOST_CHECK(compute_distance.getSolver().epa.status & EPA::Valid);
+
+  // Copying the solvers does not copy the EPA buffers.
+  const std::size_t allocations_before_copy = num_allocations;
+  {
+    ComputeWithSolver<ComputeCollision> copy(compute_collision);
+    collision_result.clear();
+    copy(tf1, tf2, collision_request, collision_result);
+  }
+  BOOST_CHECK_EQUAL(num_allocations - allocations_before_copy, 0);
+  BOOST_CHECK(collision_result.isCollision());
+}
+
+BOOST_FIXTURE_TEST_CASE(shared_storage, PenetratingShapes) {
+  CollisionRequest request(CONTACT, 1);
+  CollisionResult result_thread;
+  ComputeCollision compute(&ellipsoid, &capsule);
+  compute(tf1, tf2, request, result_thread);
+  BOOST_REQUIRE(result_thread.isCollision());
+
+  EPA::Storage storage;
+  storage.reserve(request.epa_max_iterations);
+  ComputeWithSolver<ComputeCollision> compute1(&ellipsoid, &capsule),
+      compute2(&ellipsoid, &capsule);
+  compute1.getSolver().epa.storage = &storage;
+  compute2.getSolver().epa.storage = &storage;
+
+  // Both solvers lay out their polytope in the same storage, in turn.
+  for (int i = 0; i < 3; ++i) {
+    ComputeWithSolver<ComputeCollision>& c =
+        (i % 2 == 0) ? compute1 : compute2;
+    CollisionResult result;
+    c(tf1, tf2, request, result);
+    BOOST_REQUIRE(result.isCollision());
+    BOOST_CHECK(storage.user == &c.getSolver().epa);
+    BOOST_CHECK(c.getSolver().epa.status & EPA::Valid);
+    BOOST_CHECK_CLOSE(result.getContact(0).penetration_depth,
+                      result_thread.getContact(0).penetration_depth, 1e-8);
+    BOOST_CHECK(result.getContact(0).normal.isApprox(
+        result_thread.getContact(0).normal));
+  }
+}
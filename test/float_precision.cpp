@@ -0,0 +1,143 @@
+//
+// Copyright (c) 2024 INRIA
+//
+// This file is part of hpp-fcl.
+// hpp-fcl is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-fcl is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-fcl. If not, see <http://www.gnu.org/licenses/>.
+
+/// Compares the hpp-fcl-float library with hpp-fcl. This file is built
+/// twice: linked with hpp-fcl, it writes the results of the queries to
+/// float_precision_reference.txt; linked with hpp-fcl-float, it runs the same
+/// queries and compares them with the file.
+
+#define BOOST_TEST_MODULE FCL_FLOAT_PRECISION
+#include <boost/test/included/unit_test.hpp>
+
+#include <fstream>
+#include <limits>
+
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+namespace {
+const char* reference_file = "float_precision_reference.txt";
+
+/// Result of a query, in double whatever FCL_REAL is.
+struct PairResult {
+  bool collision;
+  double distance;
+};
+
+/// Runs collide and distance between o1 and o2 at random poses. For the
+/// shape pairs handled by GJK, the signed distance of penetrating shapes is
+/// computed by EPA.
+void runQueries(const CollisionGeometry* o1, const CollisionGeometry* o2,
+                FCL_REAL extent, std::size_t n,
+                std::vector<PairResult>& results) {
+  FCL_REAL extents[] = {-extent, -extent, -extent, extent, extent, extent};
+  std::vector<Transform3f> transforms;
+  generateRandomTransforms(extents, transforms, n);
+
+  const CollisionRequest collision_request(CONTACT, 1);
+  const DistanceRequest distance_request(true);
+  for (std::size_t i = 0; i < n; ++i) {
+    CollisionResult collision_result;
+    DistanceResult distance_result;
+    collide(o1, Transform3f(), o2, transforms[i], collision_request,
+            collision_result);
+    distance(o1, Transform3f(), o2, transforms[i], distance_request,
+             distance_result);
+    PairResult result = {collision_result.isCollision(),
+                         double(distance_result.min_distance)};
+    results.push_back(result);
+  }
+}
+
+/// Runs the queries between shape pairs solved by GJK / EPA, then between the
+/// env.obj and rob.obj meshes.
+void runAllQueries(std::vector<PairResult>& results) {
+  srand(0);
+  results.clear();
+
+  Capsule capsule(0.2, 0.8);
+  Cylinder cylinder(0.3, 0.6);
+  Cone cone(0.4, 0.7);
+  Box box(0.6, 0.5, 0.4);
+  Ellipsoid ellipsoid(0.5, 0.3, 0.2);
+  runQueries(&capsule, &cylinder, 0.6, 200, results);
+  runQueries(&cone, &box, 0.6, 200, results);
+  runQueries(&ellipsoid, &capsule, 0.6, 200, results);
+  runQueries(&cylinder, &cone, 0.6, 200, results);
+
+  BVHModel<OBBRSS> env, rob;
+  loadOBJModel("env.obj", env);
+  loadOBJModel("rob.obj", rob);
+  runQueries(&env, &rob, 3000, 100, results);
+}
+}  // namespace
+
+#ifndef HPP_FCL_USE_FLOAT
+
+BOOST_AUTO_TEST_CASE(write_double_reference) {
+  std::vector<PairResult> results;
+  runAllQueries(results);
+
+  std::ofstream file(reference_file);
+  BOOST_REQUIRE(file.is_open());
+  file.precision(std::numeric_limits<double>::max_digits10);
+  file << results.size() << '\n';
+  for (std::size_t i = 0; i < results.size(); ++i)
+    file << results[i].collision << ' ' << results[i].distance << '\n';
+  BOOST_CHECK(file.good());
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE(compare_with_double_reference) {
+  std::vector<PairResult> results;
+  runAllQueries(results);
+
+  std::ifstream file(reference_file);
+  BOOST_REQUIRE_MESSAGE(file.is_open(),
+                        reference_file << " is written by the test linked "
+                                          "with the double precision library");
+  std::size_t size;
+  file >> size;
+  BOOST_REQUIRE_EQUAL(size, results.size());
+
+  // GJK and EPA stop at a tolerance of 1e-3 in float. The meshes, placed up
+  // to 3000 away from the origin, have coordinates rounded to about 3e-4.
+  const double tolerance = 2e-3;
+  for (std::size_t i = 0; i < size; ++i) {
+    PairResult expected;
+    file >> expected.collision >> expected.distance;
+    BOOST_REQUIRE(file);
+    BOOST_CHECK_MESSAGE(
+        std::abs(results[i].distance - expected.distance) <= tolerance,
+        "query " << i << ": distance " << results[i].distance
+                 << " in float, " << expected.distance << " in double");
+    // The collision status is only defined up to the tolerance.
+    if (std::abs(expected.distance) > tolerance)
+      BOOST_CHECK_MESSAGE(results[i].collision == expected.collision,
+                          "query " << i << ": collision "
+                                   << results[i].collision << " in float, "
+                                   << expected.collision << " in double");
+  }
+}
+
+#endif
@@ -42,6 +42,8 @@
 #include <hpp/fcl/internal/traversal_node_setup.h>
 #include <../src/collision_node.h>
 #include <hpp/fcl/internal/BV_splitter.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
 #include "utility.h"
 
 #include "fcl_resources/config.h"
@@ -269,6 +271,70 @@ BOOST_AUTO_TEST_CASE(front_list) {
   }
 }
 
+/// Compares the queries of ComputeCollision and ComputeDistance restarted
+/// from the front of the previous one to fresh queries, along a trajectory.
+template <typename BV>
+void compareComputeFrontList(const std::vector<Vec3f>& vertices1,
+                             const std::vector<Triangle>& triangles1,
+                             const std::vector<Vec3f>& vertices2,
+                             const std::vector<Triangle>& triangles2,
+                             const std::vector<Transform3f>& tf2s) {
+  BVHModel<BV> m1, m2;
+  m1.beginModel();
+  m1.addSubModel(vertices1, triangles1);
+  m1.endModel();
+  m2.beginModel();
+  m2.addSubModel(vertices2, triangles2);
+  m2.endModel();
+
+  const Transform3f tf1;
+  CollisionRequest first_contact,
+      all_contacts(CONTACT, (std::numeric_limits<int>::max)());
+  DistanceRequest distance_request;
+  first_contact.enable_front_list = true;
+  all_contacts.enable_front_list = true;
+  distance_request.enable_front_list = true;
+  ComputeCollision compute_first(&m1, &m2), compute_all(&m1, &m2);
+  ComputeDistance compute_distance(&m1, &m2);
+
+  std::size_t nb_collisions = 0;
+  for (std::size_t i = 0; i < tf2s.size(); ++i) {
+    CollisionResult result, front_result;
+    collide(&m1, tf1, &m2, tf2s[i], all_contacts, result);
+    compute_first(tf1, tf2s[i], first_contact, front_result);
+    BOOST_CHECK_EQUAL(result.isCollision(), front_result.isCollision());
+    front_result.clear();
+    compute_all(tf1, tf2s[i], all_contacts, front_result);
+    BOOST_CHECK_EQUAL(result.numContacts(), front_result.numContacts());
+    if (result.isCollision()) ++nb_collisions;
+
+    DistanceResult distance_result, front_distance_result;
+    distance(&m1, tf1, &m2, tf2s[i], distance_request, distance_result);
+    compute_distance(tf1, tf2s[i], distance_request, front_distance_result);
+    BOOST_CHECK_CLOSE(distance_result.min_distance,
+                      front_distance_result.min_distance, 1e-6);
+  }
+  // The trajectory goes in and out of collision.
+  BOOST_CHECK(nb_collisions > 0);
+  BOOST_CHECK(nb_collisions < tf2s.size());
+}
+
+BOOST_AUTO_TEST_CASE(compute_front_list) {
+  std::vector<Vec3f> p1, p2;
+  std::vector<Triangle> t1, t2;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), p1, t1);
+  loadOBJFile((path / "rob.obj").string().c_str(), p2, t2);
+
+  std::vector<Transform3f> tf2s;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTrajectory(extents, 5, 50, tf2s);
+
+  compareComputeFrontList<AABB>(p1, t1, p2, t2, tf2s);
+  compareComputeFrontList<RSS>(p1, t1, p2, t2, tf2s);
+  compareComputeFrontList<OBBRSS>(p1, t1, p2, t2, tf2s);
+}
+
 template <typename BV>
 bool collide_front_list_Test(const Transform3f& tf1, const Transform3f& tf2,
                              const std::vector<Vec3f>& vertices1,
@@ -40,6 +40,7 @@
 
 #include <Eigen/Geometry>
 #include <hpp/fcl/narrowphase/narrowphase.h>
+#include <hpp/fcl/narrowphase/gjk_batch.h>
 #include <hpp/fcl/shape/geometric_shapes.h>
 #include <hpp/fcl/internal/tools.h>
 #include <hpp/fcl/internal/shape_shape_func.h>
@@ -488,3 +489,120 @@ BOOST_AUTO_TEST_CASE(triangle_capsule) {
   test_gjk_triangle_capsule(Vec3f(-0.5, -0.01, 0), true, true, Vec3f(0, 1, 0),
                             Vec3f(0.5, 0, 0));
 }
+
+template <typename S1, typename S2>
+void test_gjk_cached_simplex(const S1& s1, const S2& s2) {
+  using namespace hpp::fcl;
+  GJKSolver reference, warm;
+  warm.gjk_initial_guess = GJKInitialGuess::CachedSimplex;
+  warm.keep_simplex_cached_guess = true;
+
+  // The second shape crosses the first one with small steps, so that the
+  // queries go from separated to penetrating and back.
+  const Transform3f tf1(Quatf(0.9, 0.1, -0.3, 0.2).normalized(),
+                        Vec3f(0.1, -0.2, 0.));
+  const int num_steps = 300;
+  std::size_t reference_iterations = 0, warm_iterations = 0;
+  for (int i = 0; i <= num_steps; ++i) {
+    const FCL_REAL t = FCL_REAL(i) / FCL_REAL(num_steps);
+    const Transform3f tf2(
+        Eigen::AngleAxis<FCL_REAL>(2 * t, Vec3f(1, 2, 3).normalized())
+            .toRotationMatrix(),
+        Vec3f(3 - 6 * t, 0.3, 0.1));
+
+    Vec3f p1, p2, normal;
+    const FCL_REAL d_reference =
+        reference.shapeDistance(s1, tf1, s2, tf2, true, p1, p2, normal);
+    reference_iterations += reference.gjk.getNumIterations();
+    const FCL_REAL d_warm =
+        warm.shapeDistance(s1, tf1, s2, tf2, true, p1, p2, normal);
+    warm_iterations += warm.gjk.getNumIterations();
+    BOOST_CHECK_SMALL(d_warm - d_reference, 1e-4);
+  }
+  BOOST_CHECK(warm.simplex_cached_guess.rank > 0);
+  BOOST_CHECK(2 * warm_iterations < reference_iterations);
+
+  // At the same poses, the cached simplex is already optimal.
+  const Transform3f tf2(Vec3f(3, 0.3, 0.1));
+  Vec3f p1, p2, normal;
+  const FCL_REAL d =
+      warm.shapeDistance(s1, tf1, s2, tf2, true, p1, p2, normal);
+  BOOST_CHECK_SMALL(
+      warm.shapeDistance(s1, tf1, s2, tf2, true, p1, p2, normal) - d, 1e-8);
+  BOOST_CHECK_EQUAL(warm.gjk.getNumIterations(), 0);
+
+  // A solver which does not keep the simplex ignores it.
+  warm.keep_simplex_cached_guess = false;
+  warm.simplex_cached_guess.rank = 0;
+  warm.shapeDistance(s1, tf1, s2, tf2, true, p1, p2, normal);
+  BOOST_CHECK_EQUAL(warm.simplex_cached_guess.rank, 0);
+}
+
+BOOST_AUTO_TEST_CASE(gjk_cached_simplex) {
+  using namespace hpp::fcl;
+  test_gjk_cached_simplex(Ellipsoid(0.5, 0.8, 0.3), Capsule(0.2, 1.));
+  test_gjk_cached_simplex(Box(1., 0.6, 0.4), Cylinder(0.3, 0.8));
+  test_gjk_cached_simplex(Cone(0.4, 1.), Box(0.5, 0.5, 0.5));
+}
+
+template <typename S1, typename S2>
+void test_gjk_batch(const std::vector<S1>& shapes1,
+                    const std::vector<S2>& shapes2) {
+  using namespace hpp::fcl;
+  // The poses are random in a cube of side 4: most pairs are separated, the
+  // others are computed by the scalar GJK and EPA.
+  FCL_REAL extents[] = {-2, -2, -2, 2, 2, 2};
+  const std::size_t num_pairs = 203;  // Not a multiple of the batch size.
+  std::vector<ShapePair<S1, S2> > pairs(num_pairs);
+  for (std::size_t i = 0; i < num_pairs; ++i) {
+    pairs[i].s1 = &shapes1[i % shapes1.size()];
+    pairs[i].s2 = &shapes2[i % shapes2.size()];
+    generateRandomTransform(extents, pairs[i].tf1);
+    generateRandomTransform(extents, pairs[i].tf2);
+  }
+
+  GJKBatchSolver<S1, S2> batch;
+  std::vector<ShapeDistanceResult> results;
+  batch.shapeDistance(pairs, true, results);
+  BOOST_REQUIRE_EQUAL(results.size(), num_pairs);
+  BOOST_CHECK(batch.num_fallbacks < num_pairs / 2);
+
+  GJKSolver solver;
+  for (std::size_t i = 0; i < num_pairs; ++i) {
+    Vec3f p1, p2, normal;
+    const FCL_REAL d =
+        solver.shapeDistance(*pairs[i].s1, pairs[i].tf1, *pairs[i].s2,
+                             pairs[i].tf2, true, p1, p2, normal);
+    const ShapeDistanceResult& result = results[i];
+    BOOST_CHECK_SMALL(result.distance - d, 1e-5);
+    // The witness points may differ when the closest points are not unique
+    // (e.g. parallel faces), but they are as far from each other.
+    BOOST_CHECK_SMALL((result.p2 - result.p1).dot(result.normal) - d, 1e-5);
+    if (d > 0) {
+      BOOST_CHECK(result.normal.isApprox(normal, 1e-3));
+    }
+  }
+
+  // With another GJK variant, all the pairs are computed by the solver.
+  batch.solver.gjk_variant = GJKVariant::NesterovAcceleration;
+  batch.shapeDistance(pairs, true, results);
+  BOOST_CHECK_EQUAL(batch.num_fallbacks, num_pairs);
+}
+
+BOOST_AUTO_TEST_CASE(gjk_batch) {
+  using namespace hpp::fcl;
+  std::vector<Sphere> spheres;
+  std::vector<Capsule> capsules;
+  std::vector<Box> boxes;
+  for (int i = 0; i < 7; ++i) {
+    const FCL_REAL size = 0.1 + 0.05 * FCL_REAL(i);
+    spheres.push_back(Sphere(size));
+    capsules.push_back(Capsule(0.5 * size, 3 * size));
+    boxes.push_back(Box(size, 2 * size, 3 * size));
+  }
+  test_gjk_batch(capsules, capsules);
+  test_gjk_batch(boxes, boxes);
+  test_gjk_batch(spheres, capsules);
+  test_gjk_batch(capsules, boxes);
+  test_gjk_batch(boxes, spheres);
+}
@@ -0,0 +1,208 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_OBB_PACKET
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/BV/OBB_packet.h>
+#include <hpp/fcl/distance.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+#include <hpp/fcl/timings.h>
+
+#include "utility.h"
+
+using namespace hpp::fcl;
+
+namespace {
+OBB randomOBB(FCL_REAL range, FCL_REAL max_extent) {
+  OBB obb;
+  Quatf q;
+  q.coeffs().setRandom();
+  q.normalize();
+  obb.axes = q.toRotationMatrix();
+  obb.To = range * Vec3f::Random();
+  obb.extent = max_extent * (Vec3f::Ones() + Vec3f::Random()) / 2;
+  return obb;
+}
+
+/// Distance between b1 in configuration (R0, T0) and b2.
+FCL_REAL obbDistance(const Matrix3f& R0, const Vec3f& T0, const OBB& b1,
+                     const OBB& b2) {
+  Box box1(2 * b1.extent), box2(2 * b2.extent);
+  Transform3f tf1(R0 * b1.axes, R0 * b1.To + T0), tf2(b2.axes, b2.To);
+  DistanceRequest request;
+  DistanceResult result;
+  return distance(&box1, tf1, &box2, tf2, request, result);
+}
+
+template <int N>
+void checkAgainstScalar(int size, std::size_t num_queries) {
+  CollisionRequest request;
+  request.security_margin = 0.01;
+  request.break_distance = 0.05;
+
+  std::size_t num_overlaps = 0;
+  for (std::size_t q = 0; q < num_queries; ++q) {
+    Transform3f tf0;
+    tf0.setRandom();
+    const Matrix3f& R0 = tf0.getRotation();
+    const Vec3f& T0 = tf0.getTranslation();
+    const OBB b1 = randomOBB(1, 0.5);
+
+    OBBPacket<N> packet;
+    std::vector<OBB> b2s;
+    for (int k = 0; k < size; ++k) {
+      b2s.push_back(randomOBB(2, 0.5));
+      packet.push_back(b2s.back());
+    }
+    BOOST_CHECK_EQUAL(packet.size, size);
+
+    typename OBBPacket<N>::Array sqrDistLowerBound;
+    const unsigned int mask = overlap(R0, T0, b1, packet);
+    const unsigned int mask_lb =
+        overlap(R0, T0, b1, packet, request, sqrDistLowerBound);
+    BOOST_CHECK_EQUAL(mask & ~packet.activeMask(), 0);
+    BOOST_CHECK_EQUAL(mask_lb & ~packet.activeMask(), 0);
+
+    for (int k = 0; k < size; ++k) {
+      BOOST_CHECK(packet.get(k) == b2s[k]);
+      const bool expected = overlap(R0, T0, b1, b2s[k]);
+      BOOST_CHECK_EQUAL(bool(mask & (1u << k)), expected);
+      if (expected) ++num_overlaps;
+
+      FCL_REAL sqrDist;
+      const bool expected_lb =
+          overlap(R0, T0, b1, b2s[k], request, sqrDist);
+      BOOST_CHECK_EQUAL(bool(mask_lb & (1u << k)), expected_lb);
+      if (!expected_lb) {
+        // The packet version keeps the best of all the separating axes.
+        BOOST_CHECK(sqrDistLowerBound[k] >= sqrDist - 1e-12);
+        const FCL_REAL d = obbDistance(R0, T0, b1, b2s[k]);
+        BOOST_CHECK_MESSAGE(
+            std::sqrt(sqrDistLowerBound[k]) <=
+                d + request.security_margin + 1e-6,
+            "lower bound " << std::sqrt(sqrDistLowerBound[k])
+                           << " is greater than the distance " << d);
+      }
+    }
+  }
+  BOOST_CHECK(num_overlaps > 0);
+  BOOST_CHECK(num_overlaps < num_queries * std::size_t(size));
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(obb_packet_4) {
+  checkAgainstScalar<4>(4, 2000);
+  checkAgainstScalar<4>(3, 500);
+}
+
+BOOST_AUTO_TEST_CASE(obb_packet_8) {
+  checkAgainstScalar<8>(8, 1000);
+  checkAgainstScalar<8>(5, 500);
+}
+
+BOOST_AUTO_TEST_CASE(obb_packet_empty) {
+  OBBPacket<4> packet;
+  CollisionRequest request;
+  OBBPacket<4>::Array sqrDistLowerBound;
+  OBB b1;
+  b1.axes.setIdentity();
+  b1.extent.setOnes();
+  BOOST_CHECK_EQUAL(
+      overlap(Matrix3f::Identity(), Vec3f::Zero(), b1, packet), 0);
+  BOOST_CHECK_EQUAL(overlap(Matrix3f::Identity(), Vec3f::Zero(), b1, packet,
+                            request, sqrDistLowerBound),
+                    0);
+}
+
+BOOST_AUTO_TEST_CASE(obb_packet_benchmark) {
+#ifndef NDEBUG
+  std::size_t n = 0;
+#else
+  std::size_t n = 100000;
+#endif
+  n = getNbRun(boost::unit_test::framework::master_test_suite().argc,
+               boost::unit_test::framework::master_test_suite().argv, n);
+  if (n == 0) return;
+
+  const int N = 4;
+  const std::size_t num_queries = 256;
+  std::vector<Transform3f> tfs;
+  FCL_REAL extents[] = {-1., -1., -1., 1., 1., 1.};
+  generateRandomTransforms(extents, tfs, num_queries);
+  std::vector<OBB> b1s;
+  std::vector<OBBPacket<N>, Eigen::aligned_allocator<OBBPacket<N> > > packets(
+      num_queries);
+  std::vector<OBB> b2s;
+  for (std::size_t q = 0; q < num_queries; ++q) {
+    b1s.push_back(randomOBB(1, 0.5));
+    for (int k = 0; k < N; ++k) {
+      b2s.push_back(randomOBB(2, 0.5));
+      packets[q].push_back(b2s.back());
+    }
+  }
+
+  CollisionRequest request;
+  FCL_REAL sqrDist;
+  OBBPacket<N>::Array sqrDistLowerBound;
+  std::size_t scalar_count = 0, packet_count = 0;
+  Timer timer(false);
+
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t q = i % num_queries;
+    for (int k = 0; k < N; ++k)
+      if (overlap(tfs[q].getRotation(), tfs[q].getTranslation(), b1s[q],
+                  b2s[q * N + std::size_t(k)], request, sqrDist))
+        ++scalar_count;
+  }
+  timer.stop();
+  const double scalar_time = timer.elapsed().user;
+
+  timer.start();
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::size_t q = i % num_queries;
+    unsigned int mask = overlap(tfs[q].getRotation(), tfs[q].getTranslation(),
+                                b1s[q], packets[q], request, sqrDistLowerBound);
+    for (; mask; mask &= mask - 1) ++packet_count;
+  }
+  timer.stop();
+  const double packet_time = timer.elapsed().user;
+  BOOST_CHECK_EQUAL(scalar_count, packet_count);
+
+  std::cout << "OBB overlap with lower bound, " << n << " x " << N
+            << " tests:\n"
+            << "  scalar: " << scalar_time << " us\n"
+            << "  packet: " << packet_time << " us" << std::endl;
+}
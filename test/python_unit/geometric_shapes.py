@@ -170,7 +170,10 @@ class TestGeometricShapes(TestCase):
             ]
         )
         faces.append(hppfcl.Triangle(0, 1, 2))
-        hppfcl.Convex(verts, faces)
+        convex = hppfcl.Convex(verts, faces)
+        convex.points()[0] = np.array([0, 0, -1])
+        convex.buildPointsSoA()
+        self.assertApprox(convex.points()[0], np.array([0, 0, -1]))
 
         verts.append(np.array([0, 0, 1]))
         try:
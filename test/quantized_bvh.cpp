@@ -0,0 +1,202 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_QUANTIZED_BVH
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/BV/OBBRSS.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/distance.h>
+#include "utility.h"
+
+#include <algorithm>
+
+using namespace hpp::fcl;
+
+namespace {
+/// Decode the boxes of the hierarchy top down and check that they contain the
+/// vertices of the primitives below them.
+void checkBoxes(const QuantizedBVH& qbvh, const BVHModelBase& model,
+                unsigned int i, const AABB& box, std::vector<int>& num_visits) {
+  if (qbvh.isLeaf(i)) {
+    const Triangle& t = (*model.tri_indices)[(size_t)qbvh.primitiveId(i)];
+    ++num_visits[(size_t)qbvh.primitiveId(i)];
+    for (Triangle::index_type j = 0; j < 3; ++j)
+      BOOST_CHECK(box.contain((*model.vertices)[t[j]]));
+    return;
+  }
+  AABB left, right;
+  qbvh.decode((unsigned int)qbvh.leftChild(i), box, left);
+  qbvh.decode((unsigned int)qbvh.rightChild(i), box, right);
+  BOOST_CHECK(box.contain(left));
+  BOOST_CHECK(box.contain(right));
+  checkBoxes(qbvh, model, (unsigned int)qbvh.leftChild(i), left, num_visits);
+  checkBoxes(qbvh, model, (unsigned int)qbvh.rightChild(i), right,
+             num_visits);
+}
+
+typedef std::vector<std::pair<int, int> > Contacts;
+
+Contacts collideMeshes(const CollisionGeometry* m1, const CollisionGeometry* m2,
+                       const Transform3f& tf2,
+                       const CollisionRequest& request) {
+  CollisionResult result;
+  collide(m1, Transform3f(), m2, tf2, request, result);
+  return getSortedContactPairs(result);
+}
+
+template <typename BV>
+void checkCompression(unsigned int bits) {
+  BVHModel<BV> env, rob;
+  loadOBJModel("env.obj", env);
+  loadOBJModel("rob.obj", rob);
+  BVHModel<BV> qenv(env), qrob(rob);
+  qenv.compressBVH(bits);
+  qrob.compressBVH(bits);
+  BOOST_REQUIRE(qenv.isCompressed());
+  BOOST_CHECK(!env.isCompressed());
+  BOOST_CHECK_EQUAL(qenv.getQuantizedBVH()->bits(), bits);
+  BOOST_CHECK_EQUAL(qenv.getNumBVs(), env.getNumBVs());
+  BOOST_CHECK(qenv.memUsage(false) < env.memUsage(false));
+
+  std::vector<int> num_visits(env.num_tris, 0);
+  const QuantizedBVH& qbvh = *qenv.getQuantizedBVH();
+  checkBoxes(qbvh, env, 0, qbvh.getRootBox(), num_visits);
+  BOOST_CHECK(std::count(num_visits.begin(), num_visits.end(), 1) ==
+              int(env.num_tris));
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifndef NDEBUG
+  std::size_t n = 10;
+#else
+  std::size_t n = 100;
+#endif
+  generateRandomTransforms(extents, transforms, n);
+
+  CollisionRequest request(CONTACT, 100000);
+  request.security_margin = 1.;
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    const Contacts ref = collideMeshes(&env, &rob, transforms[i], request);
+    BOOST_CHECK(collideMeshes(&qenv, &qrob, transforms[i], request) == ref);
+    BOOST_CHECK(collideMeshes(&qenv, &rob, transforms[i], request) == ref);
+    BOOST_CHECK(collideMeshes(&env, &qrob, transforms[i], request) == ref);
+    if (!ref.empty()) ++num_collisions;
+
+    CollisionResult binary, quantized;
+    CollisionRequest first_contact;
+    collide(&env, Transform3f(), &rob, transforms[i], first_contact, binary);
+    collide(&qenv, Transform3f(), &qrob, transforms[i], first_contact,
+            quantized);
+    BOOST_CHECK_EQUAL(binary.isCollision(), quantized.isCollision());
+  }
+  BOOST_CHECK(num_collisions > 0);
+
+  // Decompressing gives back the nodes built by endModel(), fitted top down.
+  qenv.decompressBVH();
+  BOOST_CHECK(!qenv.isCompressed());
+  for (unsigned int i = 0; i < env.getNumBVs(); ++i) {
+    BOOST_CHECK_EQUAL(qenv.getBV(i).first_child, env.getBV(i).first_child);
+    BOOST_CHECK_EQUAL(qenv.getBV(i).num_primitives,
+                      env.getBV(i).num_primitives);
+  }
+  env.beginReplaceModel();
+  env.replaceSubModel(*env.vertices);
+  env.endReplaceModel(true, false);
+  BOOST_CHECK(qenv == env);
+
+  // Models compressed differently are not equal.
+  BVHModel<BV> qenv16(env), other_qenv16(env), qenv8(env);
+  qenv16.compressBVH(16);
+  other_qenv16.compressBVH(16);
+  qenv8.compressBVH(8);
+  BOOST_CHECK(qenv16 == other_qenv16);
+  BOOST_CHECK(qenv16 != env);
+  BOOST_CHECK(qenv16 != qenv8);
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(quantized_bvh_OBBRSS) {
+  checkCompression<OBBRSS>(16);
+  checkCompression<OBBRSS>(8);
+}
+
+BOOST_AUTO_TEST_CASE(quantized_bvh_AABB) { checkCompression<AABB>(16); }
+
+BOOST_AUTO_TEST_CASE(quantized_bvh_invalid) {
+  BVHModel<OBBRSS> model;
+  BOOST_CHECK_THROW(model.compressBVH(), std::invalid_argument);
+  loadOBJModel("rob.obj", model);
+  BOOST_CHECK_THROW(model.compressBVH(12), std::invalid_argument);
+  BOOST_CHECK(!model.isCompressed());
+
+  // Only the collision queries between two meshes support compressed models.
+  BVHModel<OBBRSS> other(model);
+  model.compressBVH();
+  BOOST_CHECK(model.getWideBVH() == NULL);
+  Box box(1, 1, 1);
+  CollisionRequest request;
+  CollisionResult result;
+  BOOST_CHECK_THROW(
+      collide(&model, Transform3f(), &box, Transform3f(), request, result),
+      std::invalid_argument);
+  DistanceRequest drequest;
+  DistanceResult dresult;
+  BOOST_CHECK_THROW(
+      distance(&model, Transform3f(), &other, Transform3f(), drequest, dresult),
+      std::invalid_argument);
+
+  // Updating the model decompresses it.
+  model.beginUpdateModel();
+  for (unsigned int i = 0; i < model.num_vertices; ++i)
+    model.updateVertex((*model.vertices)[i] + Vec3f(1, 0, 0));
+  model.endUpdateModel();
+  BOOST_CHECK(!model.isCompressed());
+}
+
+BOOST_AUTO_TEST_CASE(quantized_bvh_single_triangle) {
+  BVHModel<OBBRSS> model;
+  buildSingleTriangleModel(model);
+  BVHModel<OBBRSS> other(model);
+  model.compressBVH(8);
+  BOOST_CHECK_EQUAL(model.getQuantizedBVH()->getNumNodes(), 1);
+
+  CollisionRequest request;
+  CollisionResult result;
+  collide(&model, Transform3f(), &other, getSingleTriangleCrossingPose(),
+          request, result);
+  BOOST_CHECK(result.isCollision());
+}
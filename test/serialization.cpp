@@ -56,6 +56,7 @@ HPP_FCL_COMPILER_DIAGNOSTIC_IGNORED_DEPRECECATED_DECLARATIONS
 #include <hpp/fcl/serialization/geometric_shapes.h>
 #include <hpp/fcl/serialization/convex.h>
 #include <hpp/fcl/serialization/archive.h>
+#include <hpp/fcl/serialization/flat_binary.h>
 #include <hpp/fcl/serialization/memory.h>
 
 #ifdef HPP_FCL_HAS_OCTOMAP
@@ -569,6 +570,77 @@ BOOST_AUTO_TEST_CASE(test_octree) {
 }
 #endif
 
+template <typename T>
+void test_flat_binary(const T& value, T& other_value) {
+  const boost::filesystem::path tmp_path(boost::archive::tmpdir());
+  const std::string filename = (tmp_path / "file.fb").string();
+  hpp::fcl::serialization::saveToFlatBinary(value, filename);
+  hpp::fcl::serialization::loadFromFlatBinary(other_value, filename);
+  BOOST_CHECK(check(value, other_value));
+}
+
+BOOST_AUTO_TEST_CASE(test_flat_binary_format) {
+  std::vector<Vec3f> p1;
+  std::vector<Triangle> t1;
+  boost::filesystem::path path(TEST_RESOURCES_DIR);
+  loadOBJFile((path / "env.obj").string().c_str(), p1, t1);
+
+  BVHModel<OBBRSS> m1;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+  {
+    BVHModel<OBBRSS> m1_copy;
+    test_flat_binary(m1, m1_copy);
+    // The loaded model can be updated as the original one.
+    BOOST_CHECK_EQUAL(m1_copy.beginUpdateModel(), BVH_OK);
+    BOOST_CHECK_EQUAL(m1_copy.updateSubModel(p1), BVH_OK);
+    BOOST_CHECK_EQUAL(m1_copy.endUpdateModel(), BVH_OK);
+  }
+  {
+    BVHModel<OBBRSS> point_cloud;
+    point_cloud.beginModel();
+    point_cloud.addVertices(Matrixx3f::Random(1000, 3));
+    point_cloud.endModel();
+    BVHModel<OBBRSS> point_cloud_copy;
+    test_flat_binary(point_cloud, point_cloud_copy);
+  }
+
+  Convex<Triangle> convex =
+      constructPolytopeFromEllipsoid(Ellipsoid(1., 2., 3.));
+  {
+    Convex<Triangle> convex_copy;
+    test_flat_binary(convex, convex_copy);
+    // The neighbors point into the arrays of the copy.
+    const ConvexBase::Neighbors& n = (*convex_copy.neighbors)[0];
+    BOOST_CHECK(n.count() == (*convex.neighbors)[0].count());
+    BOOST_CHECK(&n[0] != &(*convex.neighbors)[0][0]);
+  }
+
+  HeightField<OBBRSS> hfield(1., 2., MatrixXf::Random(20, 10), -1.);
+  {
+    HeightField<OBBRSS> hfield_copy;
+    test_flat_binary(hfield, hfield_copy);
+  }
+
+  // Loading a file into an object of another type fails.
+  const boost::filesystem::path tmp_path(boost::archive::tmpdir());
+  const std::string filename = (tmp_path / "file.fb").string();
+  hpp::fcl::serialization::saveToFlatBinary(m1, filename);
+  BVHModel<AABB> aabb_model;
+  BOOST_CHECK_THROW(
+      hpp::fcl::serialization::loadFromFlatBinary(aabb_model, filename),
+      std::invalid_argument);
+  BOOST_CHECK_THROW(
+      hpp::fcl::serialization::loadFromFlatBinary(hfield, filename),
+      std::invalid_argument);
+  hpp::fcl::serialization::saveToBinary(m1, filename);
+  BVHModel<OBBRSS> m1_copy;
+  BOOST_CHECK_THROW(
+      hpp::fcl::serialization::loadFromFlatBinary(m1_copy, filename),
+      std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(test_memory_footprint) {
   Sphere sphere(1.);
   BOOST_CHECK(sizeof(Sphere) == computeMemoryFootprint(sphere));
@@ -590,6 +662,15 @@ BOOST_AUTO_TEST_CASE(test_memory_footprint) {
   BOOST_CHECK(sizeof(BVHModel<OBBRSS>) < computeMemoryFootprint(m1));
   BOOST_CHECK(static_cast<size_t>(m1.memUsage(false)) ==
               computeMemoryFootprint(m1));
+
+  m1.buildConvexRepresentation(false);
+  const Convex<Triangle>& convex =
+      static_cast<const Convex<Triangle>&>(*m1.convex);
+  BOOST_CHECK(sizeof(Convex<Triangle>) +
+                  convex.num_points * sizeof(Vec3f) +
+                  static_cast<size_t>(convex.points_soa.size()) *
+                      sizeof(FCL_REAL) <=
+              computeMemoryFootprint(convex));
 }
 
 HPP_FCL_COMPILER_DIAGNOSTIC_POP
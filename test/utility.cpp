@@ -9,10 +9,14 @@
 #include <hpp/fcl/collision.h>
 #include <hpp/fcl/distance.h>
 
+#include "fcl_resources/config.h"
+
+#include <algorithm>
 #include <cstdio>
 #include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <random>
 
 namespace hpp {
 namespace fcl {
@@ -182,6 +186,38 @@ void saveOBJFile(const char* filename, std::vector<Vec3f>& points,
   os.close();
 }
 
+void loadOBJModel(const char* filename, BVHModelBase& model) {
+  std::vector<Vec3f> points;
+  std::vector<Triangle> triangles;
+  loadOBJFile((std::string(TEST_RESOURCES_DIR) + "/" + filename).c_str(),
+              points, triangles);
+  model.beginModel();
+  model.addSubModel(points, triangles);
+  model.endModel();
+}
+
+void buildSingleTriangleModel(BVHModelBase& model) {
+  model.beginModel();
+  model.addTriangle(Vec3f(0, 0, 0), Vec3f(1, 0, 0), Vec3f(0, 1, 0));
+  model.endModel();
+}
+
+Transform3f getSingleTriangleCrossingPose() {
+  return Transform3f(
+      Eigen::AngleAxis<FCL_REAL>(M_PI / 2, Vec3f::UnitX()).toRotationMatrix(),
+      Vec3f(0.2, 0.2, -0.5));
+}
+
+std::vector<std::pair<int, int> > getSortedContactPairs(
+    const CollisionResult& result) {
+  std::vector<std::pair<int, int> > pairs;
+  for (std::size_t i = 0; i < result.numContacts(); ++i)
+    pairs.push_back(
+        std::make_pair(result.getContact(i).b1, result.getContact(i).b2));
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
 #ifdef HPP_FCL_HAS_OCTOMAP
 OcTree loadOctreeFile(const std::string& filename, const FCL_REAL& resolution) {
   octomap::OcTreePtr_t octree(new octomap::OcTree(filename));
@@ -287,6 +323,56 @@ void generateRandomTransforms(FCL_REAL extents[6], FCL_REAL delta_trans[3],
   }
 }
 
+void generateRandomTrajectory(FCL_REAL extents[6], std::size_t n,
+                              std::size_t nb_steps,
+                              std::vector<Transform3f>& transforms) {
+  std::vector<Transform3f> waypoints;
+  generateRandomTransforms(extents, waypoints, n);
+  transforms.clear();
+  for (std::size_t i = 0; i + 1 < waypoints.size(); ++i) {
+    const Quatf q0(waypoints[i].getQuatRotation()),
+        q1(waypoints[i + 1].getQuatRotation());
+    for (std::size_t k = 0; k < nb_steps; ++k) {
+      const FCL_REAL t = FCL_REAL(k) / FCL_REAL(nb_steps);
+      transforms.push_back(Transform3f(
+          q0.slerp(t, q1), (1 - t) * waypoints[i].getTranslation() +
+                               t * waypoints[i + 1].getTranslation()));
+    }
+  }
+  if (!waypoints.empty()) transforms.push_back(waypoints.back());
+}
+
+void generateGridMesh(std::size_t nx, std::size_t ny,
+                      std::vector<Vec3f>& points,
+                      std::vector<Triangle>& triangles) {
+  points.resize(nx * ny);
+  for (std::size_t j = 0; j < ny; ++j)
+    for (std::size_t i = 0; i < nx; ++i)
+      points[i + nx * j] = Vec3f(FCL_REAL(i), FCL_REAL(j), 0);
+  triangles.clear();
+  for (std::size_t j = 0; j + 1 < ny; ++j) {
+    for (std::size_t i = 0; i + 1 < nx; ++i) {
+      const std::size_t v = i + nx * j;
+      triangles.push_back(Triangle(v, v + 1, v + nx + 1));
+      triangles.push_back(Triangle(v, v + nx + 1, v + nx));
+    }
+  }
+}
+
+void shuffleMesh(std::vector<Vec3f>& points, std::vector<Triangle>& triangles) {
+  std::mt19937 generator(0);
+  std::vector<std::size_t> order(points.size());
+  for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::shuffle(order.begin(), order.end(), generator);
+  std::vector<Vec3f> shuffled(points.size());
+  for (std::size_t i = 0; i < order.size(); ++i) shuffled[order[i]] = points[i];
+  points.swap(shuffled);
+  for (std::size_t i = 0; i < triangles.size(); ++i)
+    for (Triangle::index_type j = 0; j < 3; ++j)
+      triangles[i][j] = order[triangles[i][j]];
+  std::shuffle(triangles.begin(), triangles.end(), generator);
+}
+
 bool defaultCollisionFunction(CollisionObject* o1, CollisionObject* o2,
                               void* cdata_) {
   CollisionData* cdata = static_cast<CollisionData*>(cdata_);
@@ -138,6 +138,22 @@ void loadOBJFile(const char* filename, std::vector<Vec3f>& points,
 void saveOBJFile(const char* filename, std::vector<Vec3f>& points,
                  std::vector<Triangle>& triangles);
 
+/// @brief Build \p model from the obj mesh file \p filename of the test
+/// resources directory.
+void loadOBJModel(const char* filename, BVHModelBase& model);
+
+/// @brief Build \p model from the single triangle (0, 0, 0), (1, 0, 0),
+/// (0, 1, 0).
+void buildSingleTriangleModel(BVHModelBase& model);
+
+/// @brief Pose of a copy of the model built by buildSingleTriangleModel which
+/// crosses it: the triangle of the copy is vertical.
+Transform3f getSingleTriangleCrossingPose();
+
+/// @brief Pairs of primitives of the contacts of \p result, sorted.
+std::vector<std::pair<int, int> > getSortedContactPairs(
+    const CollisionResult& result);
+
 #ifdef HPP_FCL_HAS_OCTOMAP
 fcl::OcTree loadOctreeFile(const std::string& filename,
                            const FCL_REAL& resolution);
@@ -164,6 +180,24 @@ void generateRandomTransforms(FCL_REAL extents[6], FCL_REAL delta_trans[3],
                               std::vector<Transform3f>& transforms2,
                               std::size_t n);
 
+/// @brief Generate a smooth trajectory through n random transforms whose
+/// translations are constrained by extents: each segment between two of them
+/// is interpolated in nb_steps steps, linearly for the translation and by
+/// slerp for the rotation.
+void generateRandomTrajectory(FCL_REAL extents[6], std::size_t n,
+                              std::size_t nb_steps,
+                              std::vector<Transform3f>& transforms);
+
+/// @brief Generate a square grid of nx by ny vertices in the plane z = 0,
+/// with a spacing of 1, made of 2 (nx - 1) (ny - 1) triangles. The index of
+/// the vertex (i, j) is i + nx j.
+void generateGridMesh(std::size_t nx, std::size_t ny,
+                      std::vector<Vec3f>& points,
+                      std::vector<Triangle>& triangles);
+
+/// @brief Shuffle the vertices and the triangles of a mesh, with a fixed seed.
+void shuffleMesh(std::vector<Vec3f>& points, std::vector<Triangle>& triangles);
+
 /// @ brief Structure for minimum distance between two meshes and the
 /// corresponding nearest point pair
 struct DistanceRes {
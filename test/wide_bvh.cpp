@@ -0,0 +1,242 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2024, INRIA
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of INRIA nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define BOOST_TEST_MODULE FCL_WIDE_BVH
+#include <boost/test/included/unit_test.hpp>
+
+#include <hpp/fcl/BVH/BVH_wide.h>
+#include <hpp/fcl/collision.h>
+#include <hpp/fcl/internal/traversal_node_bvhs.h>
+#include <hpp/fcl/internal/traversal_node_setup.h>
+#include <hpp/fcl/timings.h>
+#include <../src/collision_node.h>
+#include "utility.h"
+
+using namespace hpp::fcl;
+namespace utf = boost::unit_test::framework;
+
+namespace {
+struct MeshCollisionStats {
+  bool collision;
+  std::vector<std::pair<int, int> > contacts;
+  int num_bv_tests;
+  int num_leaf_tests;
+};
+
+template <typename BV>
+MeshCollisionStats collideMeshes(const BVHModel<BV>& m1,
+                                 const BVHModel<BV>& m2,
+                                 const Transform3f& tf2,
+                                 const CollisionRequest& request) {
+  CollisionResult result;
+  MeshCollisionTraversalNode<BV, 0> node(request);
+  initialize(node, m1, Transform3f(), m2, tf2, result);
+  node.enableStatistics(true);
+  collide(&node, request, result);
+
+  MeshCollisionStats res;
+  res.collision = result.isCollision();
+  res.contacts = getSortedContactPairs(result);
+  res.num_bv_tests = node.num_bv_tests;
+  res.num_leaf_tests = node.num_leaf_tests;
+  return res;
+}
+
+template <typename BV>
+void checkLayout(const BVHModel<BV>& model, const WideBVH<BV>& wide) {
+  const unsigned int width = wide.width();
+  std::vector<int> num_visits(model.getNumBVs(), 0);
+  int next_child = 1;
+  for (unsigned int w = 0; w < wide.getNumNodes(); ++w) {
+    const int num_children = wide.getNumChildren(w);
+    BOOST_CHECK(num_children >= 2 || wide.getNumNodes() == 1);
+    BOOST_CHECK(num_children <= int(width));
+    for (int k = 0; k < num_children; ++k) {
+      const unsigned int b = wide.getBinaryNode(w, k);
+      const BVNode<BV>& node = model.getBV(b);
+      ++num_visits[b];
+      BOOST_CHECK(wide.getChild(w, k) < 0 ? node.isLeaf() : !node.isLeaf());
+      // Breadth first layout: the children of a node are contiguous.
+      if (wide.getChild(w, k) >= 0)
+        BOOST_CHECK_EQUAL(wide.getChild(w, k), next_child++);
+    }
+    // A node is only partially filled when all its children are leaves.
+    if (num_children < int(width))
+      for (int k = 0; k < num_children; ++k)
+        BOOST_CHECK(wide.getChild(w, k) < 0);
+  }
+  BOOST_CHECK_EQUAL(next_child, int(wide.getNumNodes()));
+
+  // Every leaf of the binary tree is a child of exactly one wide node.
+  for (unsigned int b = 0; b < model.getNumBVs(); ++b)
+    if (model.getBV(b).isLeaf()) BOOST_CHECK_EQUAL(num_visits[b], 1);
+}
+
+template <typename BV>
+void checkCollisions(unsigned int width) {
+  BVHModel<BV> env, rob;
+  loadOBJModel("env.obj", env);
+  loadOBJModel("rob.obj", rob);
+  BVHModel<BV> wide_env(env);
+  wide_env.buildWideBVH(width);
+  BOOST_REQUIRE(wide_env.getWideBVH() != NULL);
+  BOOST_CHECK(env.getWideBVH() == NULL);
+  checkLayout(wide_env, *wide_env.getWideBVH());
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifndef NDEBUG
+  std::size_t n = 10;
+#else
+  std::size_t n = 100;
+#endif
+  generateRandomTransforms(extents, transforms, n);
+
+  CollisionRequest request(CONTACT, 100000);
+  request.security_margin = 1.;
+  std::size_t num_collisions = 0;
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    const MeshCollisionStats binary =
+        collideMeshes(env, rob, transforms[i], request);
+    const MeshCollisionStats wide =
+        collideMeshes(wide_env, rob, transforms[i], request);
+    BOOST_CHECK_EQUAL(binary.collision, wide.collision);
+    BOOST_CHECK(binary.contacts == wide.contacts);
+    if (binary.collision) ++num_collisions;
+  }
+  BOOST_CHECK(num_collisions > 0);
+
+  // ComputeCollision goes through the same traversal.
+  for (std::size_t i = 0; i < transforms.size(); ++i) {
+    CollisionResult binary, wide;
+    CollisionRequest first_contact;
+    collide(&env, Transform3f(), &rob, transforms[i], first_contact, binary);
+    collide(&wide_env, Transform3f(), &rob, transforms[i], first_contact, wide);
+    BOOST_CHECK_EQUAL(binary.isCollision(), wide.isCollision());
+  }
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(wide_bvh_collision_OBBRSS) {
+  checkCollisions<OBBRSS>(4);
+  checkCollisions<OBBRSS>(8);
+}
+
+BOOST_AUTO_TEST_CASE(wide_bvh_collision_OBB) { checkCollisions<OBB>(4); }
+
+BOOST_AUTO_TEST_CASE(wide_bvh_invalid) {
+  BVHModel<OBBRSS> model;
+  BOOST_CHECK_THROW(model.buildWideBVH(), std::invalid_argument);
+  loadOBJModel("rob.obj", model);
+  BOOST_CHECK_THROW(model.buildWideBVH(5), std::invalid_argument);
+  BOOST_CHECK(model.getWideBVH() == NULL);
+
+  BVHModel<AABB> aabb_model;
+  loadOBJModel("rob.obj", aabb_model);
+  BOOST_CHECK_THROW(aabb_model.buildWideBVH(), std::invalid_argument);
+
+  // Updating the model discards the wide hierarchy.
+  model.buildWideBVH();
+  BOOST_CHECK(model.getWideBVH() != NULL);
+  model.beginUpdateModel();
+  for (unsigned int i = 0; i < model.num_vertices; ++i)
+    model.updateVertex((*model.vertices)[i] + Vec3f(1, 0, 0));
+  model.endUpdateModel();
+  BOOST_CHECK(model.getWideBVH() == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(wide_bvh_single_triangle) {
+  BVHModel<OBBRSS> model;
+  buildSingleTriangleModel(model);
+  model.buildWideBVH();
+  BOOST_CHECK_EQUAL(model.getWideBVH()->getNumNodes(), 1);
+  BOOST_CHECK_EQUAL(model.getWideBVH()->getNumChildren(0), 1);
+
+  BVHModel<OBBRSS> other(model);
+  CollisionRequest request;
+  CollisionResult result;
+  collide(&model, Transform3f(), &other, getSingleTriangleCrossingPose(),
+          request, result);
+  BOOST_CHECK(result.isCollision());
+}
+
+BOOST_AUTO_TEST_CASE(wide_bvh_benchmark) {
+#ifndef NDEBUG
+  std::size_t n = 0;
+#else
+  std::size_t n = 200;
+#endif
+  n = getNbRun(utf::master_test_suite().argc, utf::master_test_suite().argv, n);
+  if (n == 0) return;
+
+  BVHModel<OBBRSS> env, rob;
+  loadOBJModel("env.obj", env);
+  loadOBJModel("rob.obj", rob);
+  BVHModel<OBBRSS> env4(env), env8(env);
+  env4.buildWideBVH(4);
+  env8.buildWideBVH(8);
+  const BVHModel<OBBRSS>* models[] = {&env, &env4, &env8};
+  const char* names[] = {"binary", "4-wide", "8-wide"};
+
+  std::vector<Transform3f> transforms;
+  FCL_REAL extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+  generateRandomTransforms(extents, transforms, n);
+
+  CollisionRequest request(CONTACT, 1);
+  std::cout << "Collision env.obj (" << env.num_tris
+            << " triangles) / rob.obj (" << rob.num_tris << " triangles), "
+            << n << " queries:\n";
+  for (int m = 0; m < 3; ++m) {
+    Timer timer(false);
+    std::size_t num_collisions = 0;
+    double num_bv_tests = 0, num_leaf_tests = 0;
+    timer.start();
+    for (std::size_t i = 0; i < transforms.size(); ++i) {
+      const MeshCollisionStats res =
+          collideMeshes(*models[m], rob, transforms[i], request);
+      if (res.collision) ++num_collisions;
+      num_bv_tests += res.num_bv_tests;
+      num_leaf_tests += res.num_leaf_tests;
+    }
+    timer.stop();
+    std::cout << "  " << names[m] << ": "
+              << timer.elapsed().user / double(n) << " us/query, "
+              << num_bv_tests / double(n) << " node visits/query, "
+              << num_leaf_tests / double(n) << " leaf tests/query, "
+              << num_collisions << " collisions" << std::endl;
+  }
+  std::cout << "  memory: binary " << env.getNumBVs() * sizeof(BVNode<OBBRSS>)
+            << " B, 4-wide " << env4.getWideBVH()->memUsage() << " B, 8-wide "
+            << env8.getWideBVH()->memUsage() << " B" << std::endl;
+}